@@ -47,6 +47,30 @@ function(add_phasar_unittest test_name)
   set(CTEST_OUTPUT_ON_FAILURE ON)
 endfunction()
 
+# Benchmarks are gtest binaries like the unittests, but are neither built by
+# default nor registered with ctest.
+function(add_phasar_benchmark benchmark_name)
+  message("Set-up benchmark: ${benchmark_name}")
+  get_filename_component(benchmark ${benchmark_name} NAME_WE)
+  add_executable(${benchmark}
+    ${benchmark_name}
+  )
+
+  if(USE_LLVM_FAT_LIB)
+    llvm_config(${benchmark} USE_SHARED ${LLVM_LINK_COMPONENTS})
+  else()
+    llvm_config(${benchmark} ${LLVM_LINK_COMPONENTS})
+  endif()
+
+  target_link_libraries(${benchmark}
+    LINK_PUBLIC
+    phasar_utils
+    ${Boost_LIBRARIES}
+    ${CMAKE_THREAD_LIBS_INIT}
+    gtest
+  )
+endfunction()
+
 function(generate_ll_file)
   set(options MEM2REG DEBUG)
   set(testfile FILE)
@@ -11,6 +11,7 @@
 #define PHASAR_CONTROLLER_ANALYSIS_CONTROLLER_H_
 
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -21,7 +22,7 @@
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
-#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Utils/EnumFlags.h"
@@ -51,7 +52,7 @@ class AnalysisController {
 private:
   ProjectIRDB &IRDB;
   LLVMTypeHierarchy TH;
-  LLVMPointsToSet PT;
+  std::unique_ptr<LLVMPointsToInfo> PT;
   LLVMBasedICFG ICF;
   std::vector<DataFlowAnalysisKind> DataFlowAnalyses;
   std::vector<std::string> AnalysisConfigs;
@@ -81,6 +82,16 @@ private:
 
   void emitRequestedHelperAnalysisResults();
 
+  /// \brief Writes the points-to cache, if any, and reports if it could not
+  /// be written.
+  void flushPointsToCache();
+
+  /// \brief Copies the call graph and slices it towards the source and sink
+  /// functions of the given taint configuration if requested by the user.
+  /// \return the sliced call graph or nullptr if no slicing is requested
+  std::unique_ptr<LLVMBasedICFG>
+  makeTaintCallGraph(const std::string &AnalysisConfigPath);
+
   template <typename T> void emitRequestedDataFlowResults(T &WPA) {
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTextReport) {
       if (!ResultDirectory.empty()) {
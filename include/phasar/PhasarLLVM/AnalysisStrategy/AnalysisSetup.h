@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_ANALYSISSETUP_H_
 
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 
@@ -22,12 +23,16 @@ struct HasNoConfigurationType {};
 struct AnalysisSetup {
   struct UnsupportedAnalysisType {};
   using PointerAnalysisTy = UnsupportedAnalysisType;
+  // the interface of the points-to analyses that may be passed instead of the
+  // default one
+  using PointsToInfoTy = UnsupportedAnalysisType;
   using CallGraphAnalysisTy = UnsupportedAnalysisType;
   using TypeHierarchyTy = UnsupportedAnalysisType;
 };
 
 struct DefaultAnalysisSetup : AnalysisSetup {
   using PointerAnalysisTy = LLVMPointsToSet;
+  using PointsToInfoTy = LLVMPointsToInfo;
   using CallGraphAnalysisTy = LLVMBasedICFG;
   using TypeHierarchyTy = LLVMTypeHierarchy;
 };
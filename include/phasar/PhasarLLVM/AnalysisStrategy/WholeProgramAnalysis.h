@@ -36,12 +36,13 @@ class WholeProgramAnalysis {
 private:
   using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
   using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using PointsToInfoTy = typename Setup::PointsToInfoTy;
   using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
   using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
 
   ProjectIRDB &IRDB;
   std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
-  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<PointsToInfoTy> PointerInfo;
   std::unique_ptr<CallGraphAnalysisTy> CallGraph;
   std::set<std::string> EntryPoints;
   std::unique_ptr<ConfigurationTy> Config;
@@ -52,7 +53,7 @@ private:
 public:
   WholeProgramAnalysis(ProjectIRDB &IRDB,
                        std::set<std::string> EntryPoints = {},
-                       PointerAnalysisTy *PointerInfo = nullptr,
+                       PointsToInfoTy *PointerInfo = nullptr,
                        CallGraphAnalysisTy *CallGraph = nullptr,
                        TypeHierarchyTy *TypeHierarchy = nullptr)
       : IRDB(IRDB),
@@ -61,7 +62,7 @@ public:
                           : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
         PointerInfo(PointerInfo == nullptr
                         ? std::make_unique<PointerAnalysisTy>(IRDB)
-                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+                        : std::unique_ptr<PointsToInfoTy>(PointerInfo)),
         CallGraph(CallGraph == nullptr
                       ? std::make_unique<CallGraphAnalysisTy>(
                             IRDB, CallGraphAnalysisType::OTF, EntryPoints,
@@ -76,7 +77,7 @@ public:
                 typename T::ConfigurationTy, HasNoConfigurationType>>>
   WholeProgramAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
                        std::set<std::string> EntryPoints = {},
-                       PointerAnalysisTy *PointerInfo = nullptr,
+                       PointsToInfoTy *PointerInfo = nullptr,
                        CallGraphAnalysisTy *CallGraph = nullptr,
                        TypeHierarchyTy *TypeHierarchy = nullptr)
       : IRDB(IRDB),
@@ -85,7 +86,7 @@ public:
                           : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
         PointerInfo(PointerInfo == nullptr
                         ? std::make_unique<PointerAnalysisTy>(IRDB)
-                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+                        : std::unique_ptr<PointsToInfoTy>(PointerInfo)),
         CallGraph(CallGraph == nullptr
                       ? std::make_unique<CallGraphAnalysisTy>(
                             IRDB, CallGraphAnalysisType::OTF, EntryPoints,
@@ -102,7 +103,7 @@ public:
                 typename T::ConfigurationTy, HasNoConfigurationType>>>
   WholeProgramAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
                        std::set<std::string> EntryPoints = {},
-                       PointerAnalysisTy *PointerInfo = nullptr,
+                       PointsToInfoTy *PointerInfo = nullptr,
                        CallGraphAnalysisTy *CallGraph = nullptr,
                        TypeHierarchyTy *TypeHierarchy = nullptr)
       : IRDB(IRDB),
@@ -111,7 +112,7 @@ public:
                           : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
         PointerInfo(PointerInfo == nullptr
                         ? std::make_unique<PointerAnalysisTy>(IRDB)
-                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+                        : std::unique_ptr<PointsToInfoTy>(PointerInfo)),
         CallGraph(CallGraph == nullptr
                       ? std::make_unique<CallGraphAnalysisTy>(
                             IRDB, CallGraphAnalysisType::OTF, EntryPoints,
@@ -151,7 +152,7 @@ public:
     releaseTypeHierarchy();
   }
 
-  PointerAnalysisTy *releasePointerInformation() {
+  PointsToInfoTy *releasePointerInformation() {
     return PointerInfo.release();
   }
 
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -89,6 +90,72 @@ public:
   virtual nlohmann::json getAsJson(F Fun) const = 0;
 };
 
+namespace detail {
+template <typename CFGTy, typename N, typename = void>
+struct HasSuccsOfAsRange : std::false_type {};
+template <typename CFGTy, typename N>
+struct HasSuccsOfAsRange<CFGTy, N,
+                         std::void_t<decltype(std::declval<const CFGTy &>()
+                                                  .getSuccsOfAsRange(
+                                                      std::declval<N>()))>>
+    : std::true_type {};
+
+template <typename CFGTy, typename F, typename = void>
+struct HasStartPointsOfAsRange : std::false_type {};
+template <typename CFGTy, typename F>
+struct HasStartPointsOfAsRange<
+    CFGTy, F,
+    std::void_t<decltype(std::declval<const CFGTy &>()
+                             .getStartPointsOfAsRange(std::declval<F>()))>>
+    : std::true_type {};
+
+template <typename CFGTy, typename F, typename = void>
+struct HasExitPointsOfAsRange : std::false_type {};
+template <typename CFGTy, typename F>
+struct HasExitPointsOfAsRange<
+    CFGTy, F,
+    std::void_t<decltype(std::declval<const CFGTy &>().getExitPointsOfAsRange(
+        std::declval<F>()))>> : std::true_type {};
+} // namespace detail
+
+/**
+ * Returns the successors of Stmt. CFGs that provide getSuccsOfAsRange(), such
+ * as the LLVMBasedCFG, return a view into their cached control flow, all
+ * others the vector returned by getSuccsOf(). The solvers use it to avoid
+ * allocating a vector per processed node.
+ */
+template <typename CFGTy, typename N> auto succsOf(const CFGTy &CF, N Stmt) {
+  if constexpr (detail::HasSuccsOfAsRange<CFGTy, N>::value) {
+    return CF.getSuccsOfAsRange(Stmt);
+  } else {
+    return CF.getSuccsOf(Stmt);
+  }
+}
+
+/**
+ * Returns the start points of Fun, analogous to succsOf().
+ */
+template <typename CFGTy, typename F>
+auto startPointsOf(const CFGTy &CF, F Fun) {
+  if constexpr (detail::HasStartPointsOfAsRange<CFGTy, F>::value) {
+    return CF.getStartPointsOfAsRange(Fun);
+  } else {
+    return CF.getStartPointsOf(Fun);
+  }
+}
+
+/**
+ * Returns the exit points of Fun, analogous to succsOf().
+ */
+template <typename CFGTy, typename F>
+auto exitPointsOf(const CFGTy &CF, F Fun) {
+  if constexpr (detail::HasExitPointsOfAsRange<CFGTy, F>::value) {
+    return CF.getExitPointsOfAsRange(Fun);
+  } else {
+    return CF.getExitPointsOf(Fun);
+  }
+}
+
 } // namespace psr
 
 #endif
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_CALLGRAPHSNAPSHOT_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_CALLGRAPHSNAPSHOT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+namespace sys {
+namespace fs {
+class mapped_file_region;
+} // namespace fs
+} // namespace sys
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * A call graph stored in a compact binary file that is memory-mapped when it
+ * is read, so that a call graph can be reused by later runs on the same IR
+ * instead of being constructed again.
+ *
+ * The functions are stored by name and the call-sites by their psr.id
+ * instruction ids. Each snapshot carries a module hash and a configuration
+ * hash that the reader has to check before using it. The file uses the
+ * native byte order and is meant as a local cache rather than an exchange
+ * format.
+ */
+class CallGraphSnapshot {
+public:
+  struct Edge {
+    uint32_t Caller;
+    uint32_t Callee;
+    uint64_t CallSiteID;
+  };
+
+private:
+  std::unique_ptr<llvm::sys::fs::mapped_file_region> Region;
+  uint64_t ModuleHash = 0;
+  uint64_t ConfigHash = 0;
+  llvm::ArrayRef<uint32_t> NameOffsets;
+  llvm::ArrayRef<Edge> Edges;
+  llvm::StringRef Names;
+
+  CallGraphSnapshot() = default;
+
+public:
+  CallGraphSnapshot(const CallGraphSnapshot &) = delete;
+  CallGraphSnapshot &operator=(const CallGraphSnapshot &) = delete;
+  ~CallGraphSnapshot();
+
+  /// Writes a snapshot of the call graph with the given function names and
+  /// edges to Path, where the edges refer to the functions by their index.
+  /// The file is replaced atomically. \return false if it could not be
+  /// written.
+  static bool write(const std::string &Path, uint64_t ModuleHash,
+                    uint64_t ConfigHash,
+                    const std::vector<std::string> &FunctionNames,
+                    const std::vector<Edge> &Edges);
+
+  /// Maps the snapshot at Path into memory. \return nullptr if the file does
+  /// not exist or is not a valid snapshot.
+  static std::unique_ptr<CallGraphSnapshot> open(const std::string &Path);
+
+  [[nodiscard]] uint64_t getModuleHash() const { return ModuleHash; }
+
+  [[nodiscard]] uint64_t getConfigHash() const { return ConfigHash; }
+
+  [[nodiscard]] size_t getNumFunctions() const {
+    return NameOffsets.size() - 1;
+  }
+
+  [[nodiscard]] llvm::StringRef getFunctionName(size_t Idx) const {
+    return Names.slice(NameOffsets[Idx], NameOffsets[Idx + 1]);
+  }
+
+  /// \return the edges in the order they have been written. The range
+  /// points into the mapped file and remains valid as long as the snapshot.
+  [[nodiscard]] llvm::ArrayRef<Edge> getEdges() const { return Edges; }
+};
+
+} // namespace psr
+
+#endif
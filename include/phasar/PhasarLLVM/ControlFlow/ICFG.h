@@ -21,6 +21,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "nlohmann/json.hpp"
 
@@ -69,6 +71,65 @@ public:
   virtual nlohmann::json getAsJson() const = 0;
 };
 
+namespace detail {
+template <typename ICFGTy, typename N, typename = void>
+struct HasCalleesOfCallAtAsRange : std::false_type {};
+template <typename ICFGTy, typename N>
+struct HasCalleesOfCallAtAsRange<
+    ICFGTy, N,
+    std::void_t<decltype(std::declval<const ICFGTy &>()
+                             .getCalleesOfCallAtAsRange(std::declval<N>()))>>
+    : std::true_type {};
+
+template <typename ICFGTy, typename F, typename = void>
+struct HasCallersOfAsRange : std::false_type {};
+template <typename ICFGTy, typename F>
+struct HasCallersOfAsRange<
+    ICFGTy, F,
+    std::void_t<decltype(std::declval<const ICFGTy &>().getCallersOfAsRange(
+        std::declval<F>()))>> : std::true_type {};
+
+/// Detects ICFGs that provide the strongly connected components of their call
+/// graph, numbered in callee-first order, such as the LLVMBasedICFG.
+template <typename ICFGTy, typename F, typename = void>
+struct HasCallGraphSCCs : std::false_type {};
+template <typename ICFGTy, typename F>
+struct HasCallGraphSCCs<
+    ICFGTy, F,
+    std::void_t<
+        decltype(std::declval<const ICFGTy &>().getSCCOf(std::declval<F>())),
+        decltype(std::declval<const ICFGTy &>().getFunctionsOfSCC(0U)),
+        decltype(std::declval<const ICFGTy &>().getCalleeSCCsOf(0U))>>
+    : std::true_type {};
+} // namespace detail
+
+/**
+ * Returns the callees of the call-site Stmt. ICFGs that provide
+ * getCalleesOfCallAtAsRange(), such as the LLVMBasedICFG, return a view into
+ * their call graph, all others the set returned by getCalleesOfCallAt(). The
+ * solvers use it to avoid allocating a set per processed call.
+ */
+template <typename ICFGTy, typename N>
+auto calleesOfCallAt(const ICFGTy &ICF, N Stmt) {
+  if constexpr (detail::HasCalleesOfCallAtAsRange<ICFGTy, N>::value) {
+    return ICF.getCalleesOfCallAtAsRange(Stmt);
+  } else {
+    return ICF.getCalleesOfCallAt(Stmt);
+  }
+}
+
+/**
+ * Returns the call-sites that may call Fun, analogous to calleesOfCallAt().
+ */
+template <typename ICFGTy, typename F>
+auto callersOf(const ICFGTy &ICF, F Fun) {
+  if constexpr (detail::HasCallersOfAsRange<ICFGTy, F>::value) {
+    return ICF.getCallersOfAsRange(Fun);
+  } else {
+    return ICF.getCallersOf(Fun);
+  }
+}
+
 } // namespace psr
 
 #endif
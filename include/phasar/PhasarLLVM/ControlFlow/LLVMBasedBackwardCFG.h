@@ -17,11 +17,15 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDBACKWARDCFG_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDBACKWARDCFG_H_
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFGCache.h"
 
 namespace llvm {
 class Function;
@@ -31,6 +35,12 @@ class Instruction;
 namespace psr {
 
 class LLVMBasedBackwardCFG : public LLVMBasedCFG {
+private:
+  // The forward control flow, including debug instructions, whose
+  // successors and predecessors are swapped.
+  std::shared_ptr<LLVMBasedCFGCache> ForwardCache =
+      std::make_shared<LLVMBasedCFGCache>(false);
+
 public:
   LLVMBasedBackwardCFG() = default;
 
@@ -48,6 +58,18 @@ public:
   [[nodiscard]] std::set<const llvm::Instruction *>
   getExitPointsOf(const llvm::Function *Fun) const override;
 
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getPredsOfAsRange(const llvm::Instruction *Stmt) const override;
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getSuccsOfAsRange(const llvm::Instruction *Stmt) const override;
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getStartPointsOfAsRange(const llvm::Function *Fun) const override;
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getExitPointsOfAsRange(const llvm::Function *Fun) const override;
+
   [[nodiscard]] bool isExitStmt(const llvm::Instruction *Stmt) const override;
 
   [[nodiscard]] bool isStartPoint(const llvm::Instruction *Stmt) const override;
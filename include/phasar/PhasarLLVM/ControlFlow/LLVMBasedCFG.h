@@ -18,11 +18,15 @@
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFG_H_
 
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include "phasar/PhasarLLVM/ControlFlow/CFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFGCache.h"
 
 namespace llvm {
 class Function;
@@ -35,7 +39,8 @@ class LLVMBasedCFG
     : public virtual CFG<const llvm::Instruction *, const llvm::Function *> {
 public:
   LLVMBasedCFG(bool IgnoreDbgInstructions = true)
-      : IgnoreDbgInstructions(IgnoreDbgInstructions) {}
+      : IgnoreDbgInstructions(IgnoreDbgInstructions),
+        Cache(std::make_shared<LLVMBasedCFGCache>(IgnoreDbgInstructions)) {}
 
   ~LLVMBasedCFG() override = default;
 
@@ -48,6 +53,21 @@ public:
   [[nodiscard]] std::vector<const llvm::Instruction *>
   getSuccsOf(const llvm::Instruction *Inst) const override;
 
+  /**
+   * Same as getPredsOf(), but returns a view into a table of the function's
+   * control flow that is built on first use, instead of a freshly allocated
+   * vector. The view remains valid as long as the CFG. Subclasses that
+   * override getPredsOf() have to override this function as well.
+   */
+  [[nodiscard]] virtual llvm::ArrayRef<const llvm::Instruction *>
+  getPredsOfAsRange(const llvm::Instruction *Inst) const;
+
+  /**
+   * Same as getSuccsOf(), but returns a view, see getPredsOfAsRange().
+   */
+  [[nodiscard]] virtual llvm::ArrayRef<const llvm::Instruction *>
+  getSuccsOfAsRange(const llvm::Instruction *Inst) const;
+
   [[nodiscard]] std::vector<
       std::pair<const llvm::Instruction *, const llvm::Instruction *>>
   getAllControlFlowEdges(const llvm::Function *Fun) const override;
@@ -61,6 +81,18 @@ public:
   [[nodiscard]] std::set<const llvm::Instruction *>
   getExitPointsOf(const llvm::Function *Fun) const override;
 
+  /**
+   * Same as getStartPointsOf(), but returns a view, see getPredsOfAsRange().
+   */
+  [[nodiscard]] virtual llvm::ArrayRef<const llvm::Instruction *>
+  getStartPointsOfAsRange(const llvm::Function *Fun) const;
+
+  /**
+   * Same as getExitPointsOf(), but returns a view, see getPredsOfAsRange().
+   */
+  [[nodiscard]] virtual llvm::ArrayRef<const llvm::Instruction *>
+  getExitPointsOfAsRange(const llvm::Function *Fun) const;
+
   [[nodiscard]] bool isCallStmt(const llvm::Instruction *Stmt) const override;
 
   [[nodiscard]] bool isExitStmt(const llvm::Instruction *Stmt) const override;
@@ -106,6 +138,8 @@ public:
 private:
   // Ignores debug instructions in control flow if set to true.
   const bool IgnoreDbgInstructions;
+  // Shared by copies of the CFG, they all describe the same IR.
+  std::shared_ptr<LLVMBasedCFGCache> Cache;
 };
 
 } // namespace psr
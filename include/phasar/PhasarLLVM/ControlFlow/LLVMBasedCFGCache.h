@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFGCACHE_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFGCACHE_H_
+
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+namespace llvm {
+class Function;
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * The instruction-level control flow of functions, stored in flat arrays.
+ * The table of a function is built on the first query that concerns it, all
+ * later queries return views into the table without allocating. The cache
+ * may be queried concurrently.
+ *
+ * The successors and predecessors are those of the forward control flow; a
+ * backward CFG simply swaps them, as well as the start and exit points.
+ */
+class LLVMBasedCFGCache {
+private:
+  struct FunctionTable {
+    std::vector<const llvm::Instruction *> Succs;
+    std::vector<const llvm::Instruction *> Preds;
+    // at most one each, empty for declarations
+    std::vector<const llvm::Instruction *> StartPoints;
+    std::vector<const llvm::Instruction *> ExitPoints;
+  };
+
+  struct Node {
+    llvm::ArrayRef<const llvm::Instruction *> Succs;
+    llvm::ArrayRef<const llvm::Instruction *> Preds;
+  };
+
+  const bool IgnoreDbgInstructions;
+  std::shared_mutex Mtx;
+  llvm::DenseMap<const llvm::Function *, std::unique_ptr<FunctionTable>>
+      Tables;
+  llvm::DenseMap<const llvm::Instruction *, Node> Nodes;
+
+  Node getNode(const llvm::Instruction *Inst);
+
+  const FunctionTable &getTable(const llvm::Function *Fun);
+
+  // requires the exclusive lock
+  FunctionTable &buildTable(const llvm::Function *Fun);
+
+public:
+  explicit LLVMBasedCFGCache(bool IgnoreDbgInstructions)
+      : IgnoreDbgInstructions(IgnoreDbgInstructions) {}
+
+  LLVMBasedCFGCache(const LLVMBasedCFGCache &) = delete;
+  LLVMBasedCFGCache &operator=(const LLVMBasedCFGCache &) = delete;
+  ~LLVMBasedCFGCache();
+
+  /// Computes the successors of Inst from the LLVM IR.
+  static std::vector<const llvm::Instruction *>
+  computeSuccsOf(const llvm::Instruction *Inst, bool IgnoreDbgInstructions);
+
+  /// Computes the predecessors of Inst from the LLVM IR.
+  static std::vector<const llvm::Instruction *>
+  computePredsOf(const llvm::Instruction *Inst, bool IgnoreDbgInstructions);
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getSuccsOf(const llvm::Instruction *Inst) {
+    return getNode(Inst).Succs;
+  }
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getPredsOf(const llvm::Instruction *Inst) {
+    return getNode(Inst).Preds;
+  }
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getStartPointsOf(const llvm::Function *Fun) {
+    return getTable(Fun).StartPoints;
+  }
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getExitPointsOf(const llvm::Function *Fun) {
+    return getTable(Fun).ExitPoints;
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -17,6 +17,7 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDICFG_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDICFG_H_
 
+#include <cstdint>
 #include <iosfwd>
 #include <iostream>
 #include <memory>
@@ -29,13 +30,20 @@
 #include "boost/graph/adjacency_list.hpp"
 #include "boost/container/flat_set.hpp"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
 #include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+#include "phasar/Utils/CSRMap.h"
 #include "phasar/Utils/SoundnessFlag.h"
 
 namespace llvm {
 class Instruction;
+class ImmutableCallSite;
 class Function;
 class Module;
 class Instruction;
@@ -63,6 +71,8 @@ private:
   LLVMPointsToInfo *PT;
   std::unique_ptr<Resolver> Res;
   std::unordered_set<const llvm::Function *> VisitedFunctions;
+  /// The number of rounds resolveToFixpoint() needed to reach its fixpoint.
+  size_t NumFixpointRounds = 0;
   /// Keeps track of the call-sites already resolved
   // std::vector<const llvm::Instruction *> CallStack;
 
@@ -107,8 +117,98 @@ private:
   /// Maps functions to the corresponding vertex id.
   std::unordered_map<const llvm::Function *, vertex_t> FunctionVertexMap;
 
+  /// A frozen copy of the call graph's edges that answers the call graph
+  /// queries without walking the adjacency lists. It is built once the
+  /// construction has finished and rebuilt whenever the call graph is
+  /// modified afterwards.
+  struct FrozenCallGraph {
+    /// Maps call-sites to their callees.
+    CSRMap<const llvm::Instruction *, const llvm::Function *> Callees;
+    /// Maps functions to the call-sites that may call them.
+    CSRMap<const llvm::Function *, const llvm::Instruction *> Callers;
+    /// Maps functions to their call-sites that have at least one callee.
+    CSRMap<const llvm::Function *, const llvm::Instruction *> CallSites;
+  };
+
+  FrozenCallGraph Frozen;
+  bool IsFrozen = false;
+
+  /// The strongly connected components (SCCs) of the call graph and their
+  /// condensation. The SCCs are numbered in callee-first order.
+  struct CallGraphSCCs {
+    /// Maps functions to the SCC they belong to.
+    llvm::DenseMap<const llvm::Function *, unsigned> Ids;
+    /// Maps SCCs to their functions.
+    CSRMap<unsigned, const llvm::Function *> Functions;
+    /// Maps SCCs to the other SCCs their functions call.
+    CSRMap<unsigned, unsigned> Callees;
+    /// Marks the SCCs that contain a call cycle.
+    llvm::BitVector Recursive;
+  };
+
+  CallGraphSCCs SCCs;
+
+  /// The functions that sliceTowards() has kept only because a kept function
+  /// calls them, see isSliceBoundary().
+  llvm::DenseSet<const llvm::Function *> SliceBoundary;
+
+  /// The possible targets of the call-sites that have been resolved
+  /// concurrently before the call graph is constructed; only used during the
+  /// construction.
+  std::unordered_map<const llvm::Instruction *,
+                     std::set<const llvm::Function *>>
+      PreResolvedTargets;
+
+  /// Constructs the call graph of the functions reachable from the given
+  /// entry points.
+  void constructCallGraph(const std::set<std::string> &EntryPoints,
+                          unsigned NumThreads);
+
+  /// Replaces the call graph with the one stored in the snapshot at Path if
+  /// the snapshot has been written for the same IR and configuration.
+  /// \return true if the call graph has been loaded.
+  bool loadSnapshot(const std::string &Path, uint64_t ModuleHash,
+                    uint64_t ConfigHash);
+
+  /// Hands the callees of each call-site of a loaded call graph to the OTF
+  /// resolver, which introduces the same aliases into the points-to
+  /// information as the construction of the call graph does.
+  void replayPossibleTargets();
+
+  /// Writes the call graph to a snapshot at Path.
+  bool storeSnapshot(const std::string &Path, uint64_t ModuleHash,
+                     uint64_t ConfigHash) const;
+
+  /// Walks the functions reachable from F in depth-first order and adds them
+  /// and their call-sites to the call graph. The walk uses an explicit stack
+  /// instead of recursion, but visits the call-sites in the same order.
   void constructionWalker(const llvm::Function *F, Resolver &Resolver);
 
+  /// Resolves the possible targets of the call-site CS.
+  std::set<const llvm::Function *> resolveCallSite(llvm::ImmutableCallSite CS,
+                                                   Resolver &Resolver) const;
+
+  /// Adds the edges from the call-site CS within the function of vertex
+  /// Caller to the given targets, adding vertices for the targets if needed.
+  void addCallEdges(vertex_t Caller, const llvm::Instruction *CS,
+                    const std::set<const llvm::Function *> &Targets);
+
+  /// Resolves the call-sites the resolver reports as outdated again and
+  /// walks the newly found targets, until no call-site is outdated anymore.
+  void resolveToFixpoint(Resolver &Resolver);
+
+  /// Resolves the call-sites of all functions reachable from the given entry
+  /// points using NumThreads threads and stores the results in
+  /// PreResolvedTargets. Requires an order-independent resolver.
+  void resolveConcurrently(const std::vector<const llvm::Function *> &Entries,
+                           Resolver &Resolver, unsigned NumThreads);
+
+  /// Builds the frozen representation of the call graph.
+  void freeze();
+
+  /// Computes the SCCs of the call graph.
+  void computeSCCs();
+
   std::unique_ptr<Resolver> makeResolver(ProjectIRDB &IRDB,
                                          CallGraphAnalysisType CGT,
                                          LLVMTypeHierarchy &TH,
@@ -125,10 +225,39 @@ public:
   using OutEdgesAndTargets = std::unordered_multimap<const llvm::Instruction *,
                                                      const llvm::Function *>;
 
+  /// Describes how much of the call graph has been removed by sliceTowards().
+  struct SliceReport {
+    size_t NumFunctions = 0;
+    size_t NumRemovedFunctions = 0;
+    size_t NumCallEdges = 0;
+    size_t NumRemovedCallEdges = 0;
+    size_t NumBoundaryFunctions = 0;
+  };
+
+  /**
+   * Constructs the call graph of the functions reachable from the given entry
+   * points. If NumThreads is greater than one and the call-graph analysis
+   * resolves call-sites independently of each other (NORESOLVE, CHA, RTA,
+   * SIG), the call-sites are resolved concurrently; the resulting call graph
+   * is the same in either case.
+   *
+   * With SoundnessFlag::SOUND, call-sites whose resolution depends on
+   * information that grows during the construction (the points-to sets for
+   * OTF) are resolved again until a fixpoint is reached.
+   *
+   * If SnapshotPath is given, the call graph is loaded from the snapshot file
+   * at this path instead, provided the snapshot has been written for the
+   * same IR, call-graph analysis, soundness and entry points, and for OTF the
+   * same pointer analysis. Otherwise, the call graph is constructed and the
+   * snapshot is (re)written. For OTF, the targets of the loaded call-sites
+   * are replayed on the points-to information, which thus receives the same
+   * aliases as during a construction.
+   */
   LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
                 const std::set<std::string> &EntryPoints = {},
                 LLVMTypeHierarchy *TH = nullptr, LLVMPointsToInfo *PT = nullptr,
-                SoundnessFlag SF = SoundnessFlag::SOUNDY);
+                SoundnessFlag SF = SoundnessFlag::SOUNDY,
+                unsigned NumThreads = 1, const std::string &SnapshotPath = "");
 
   LLVMBasedICFG(const LLVMBasedICFG &);
 
@@ -187,6 +316,33 @@ public:
    */
   bool removeVertex(const llvm::Function *Fun);
 
+  /**
+   * Restricts the call graph to the functions that are reachable from the
+   * given entry points and that may directly or transitively call one of the
+   * given target functions, e.g. the source and sink functions of a taint
+   * analysis. The entry points themselves are always kept.
+   *
+   * The call-sites of the kept functions keep all of their callees: a callee
+   * that cannot reach a target is kept as a boundary function without any
+   * outgoing call edges, see isSliceBoundary(). Data may still flow through
+   * such a function, e.g. through a wrapper or a setter, so an analysis that
+   * uses the slice has to treat calls of boundary functions conservatively,
+   * typically by a summary flow function instead of descending into them.
+   *
+   * \return the number of functions and call edges before and removed by the
+   * slicing as well as the number of boundary functions.
+   */
+  SliceReport sliceTowards(const std::set<const llvm::Function *> &EntryPoints,
+                           const std::set<const llvm::Function *> &Targets);
+
+  /**
+   * \return true if the last call of sliceTowards() has kept the given
+   * function definition only because a kept function calls it. The function
+   * cannot reach a target and its own call-sites have no callees in the
+   * slice.
+   */
+  [[nodiscard]] bool isSliceBoundary(const llvm::Function *Fun) const;
+
   /**
    * \return the total number of in edges to the vertex representing this
    * Function.
@@ -205,6 +361,32 @@ public:
   [[nodiscard]] std::set<const llvm::Instruction *>
   getCallersOf(const llvm::Function *Fun) const override;
 
+  /**
+   * Same as getCalleesOfCallAt(), but returns a sorted view into the call
+   * graph instead of a freshly allocated set. The view remains valid until
+   * the call graph is modified. Aborts if called while the call graph is still
+   * under construction.
+   */
+  [[nodiscard]] llvm::ArrayRef<const llvm::Function *>
+  getCalleesOfCallAtAsRange(const llvm::Instruction *N) const;
+
+  /**
+   * Same as getCallersOf(), but returns a sorted view into the call graph
+   * instead of a freshly allocated set. The view remains valid until the call
+   * graph is modified. Aborts if called while the call graph is still under
+   * construction.
+   */
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getCallersOfAsRange(const llvm::Function *Fun) const;
+
+  /**
+   * \return a sorted view of the call-sites within a given method that have
+   * at least one callee in the call graph. Aborts if called while the call
+   * graph is still under construction.
+   */
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getResolvedCallSitesOfAsRange(const llvm::Function *Fun) const;
+
   /**
    * \return all call sites within a given method.
    */
@@ -240,6 +422,49 @@ public:
   [[nodiscard]] unsigned getNumOfEdges();
 
   std::vector<const llvm::Function *> getDependencyOrderedFunctions();
+
+  /**
+   * \return the number of rounds in which outdated call-sites have been
+   * resolved again until the call graph reached its fixpoint, which is zero
+   * unless the call graph has been constructed with SoundnessFlag::SOUND.
+   */
+  [[nodiscard]] size_t getNumFixpointRounds() const {
+    return NumFixpointRounds;
+  }
+
+  /**
+   * \return the number of strongly connected components (SCCs) of the call
+   * graph. The SCCs are numbered from 0 in callee-first order: the functions
+   * of an SCC only call functions of the same SCC or of SCCs with a smaller
+   * number. Visiting the SCCs in ascending order therefore visits callees
+   * before their callers and each recursive cluster at once.
+   */
+  [[nodiscard]] unsigned getNumSCCs() const;
+
+  /**
+   * \return the SCC of the given function, which must be part of the call
+   * graph.
+   */
+  [[nodiscard]] unsigned getSCCOf(const llvm::Function *Fun) const;
+
+  /**
+   * \return a sorted view of the functions of the given SCC.
+   */
+  [[nodiscard]] llvm::ArrayRef<const llvm::Function *>
+  getFunctionsOfSCC(unsigned SCC) const;
+
+  /**
+   * \return a sorted view of the SCCs, other than SCC itself, that the
+   * functions of the given SCC call. SCCs that neither directly nor
+   * indirectly depend on each other can be processed in parallel.
+   */
+  [[nodiscard]] llvm::ArrayRef<unsigned> getCalleeSCCsOf(unsigned SCC) const;
+
+  /**
+   * \return true if the given SCC contains a call cycle, i.e. a recursive
+   * function or a set of mutually recursive functions.
+   */
+  [[nodiscard]] bool isRecursiveSCC(unsigned SCC) const;
 };
 
 } // namespace psr
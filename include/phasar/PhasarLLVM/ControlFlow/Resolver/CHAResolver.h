@@ -17,24 +17,48 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_CHARESOLVER_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_CHARESOLVER_H_
 
+#include <memory>
 #include <set>
 
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/VirtualCallCache.h"
 
 namespace llvm {
 class ImmutableCallSite;
 class Function;
+class StructType;
 } // namespace llvm
 
 namespace psr {
 class CHAResolver : public Resolver {
+protected:
+  // the targets only depend on the type hierarchy, hence the cache may be
+  // shared by all resolvers that use the same one
+  std::shared_ptr<VirtualCallCache> CHACache;
+
+  /// Returns the targets of a virtual call on ReceiverTy at VFTIdx according
+  /// to the class hierarchy.
+  std::set<const llvm::Function *>
+  resolveVirtualCallCHA(const llvm::StructType *ReceiverTy, unsigned VFTIdx,
+                        llvm::ImmutableCallSite CS);
+
 public:
-  CHAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH);
+  CHAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH,
+              std::shared_ptr<VirtualCallCache> CHACache = nullptr);
 
   ~CHAResolver() override = default;
 
   std::set<const llvm::Function *>
   resolveVirtualCall(llvm::ImmutableCallSite CS) override;
+
+  [[nodiscard]] bool isOrderIndependent() const override;
+
+  [[nodiscard]] VirtualCallCache::Stats
+  getVirtualCallCacheStats() const override;
+
+  [[nodiscard]] std::shared_ptr<VirtualCallCache> getCHACache() const {
+    return CHACache;
+  }
 };
 } // namespace psr
 
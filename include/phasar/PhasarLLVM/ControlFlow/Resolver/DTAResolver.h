@@ -63,6 +63,9 @@ public:
   resolveVirtualCall(llvm::ImmutableCallSite CS) override;
 
   void otherInst(const llvm::Instruction *Inst) override;
+
+  // the type graph grows with the functions visited so far
+  [[nodiscard]] bool isOrderIndependent() const override;
 };
 } // namespace psr
 
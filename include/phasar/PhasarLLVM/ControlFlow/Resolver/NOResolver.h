@@ -49,6 +49,8 @@ public:
   resolveFunctionPointer(llvm::ImmutableCallSite CS) override;
 
   void otherInst(const llvm::Instruction *Inst) override;
+
+  [[nodiscard]] bool isOrderIndependent() const override;
 };
 } // namespace psr
 
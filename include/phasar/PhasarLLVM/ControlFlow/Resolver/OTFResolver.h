@@ -19,6 +19,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -46,6 +47,19 @@ protected:
   LLVMPointsToInfo &PT;
   std::vector<const llvm::Instruction *> CallStack;
 
+  // the value whose points-to set a dynamic call-site has been resolved with
+  // and the size of that set at the time
+  struct PointsToDependency {
+    const llvm::Value *V;
+    size_t PointsToSetSize;
+  };
+  std::unordered_map<const llvm::Instruction *, PointsToDependency>
+      Dependencies;
+  // the call-sites of Dependencies in the order of their first resolution
+  std::vector<const llvm::Instruction *> DependentCallSites;
+
+  void recordDependency(llvm::ImmutableCallSite CS, const llvm::Value *V);
+
 public:
   OTFResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH, LLVMBasedICFG &ICF,
               LLVMPointsToInfo &PT);
@@ -66,6 +80,13 @@ public:
   std::set<const llvm::Function *>
   resolveFunctionPointer(llvm::ImmutableCallSite CS) override;
 
+  // the points-to information grows with the call-sites visited so far
+  [[nodiscard]] bool isOrderIndependent() const override;
+
+  /// Returns the dynamic call-sites whose points-to set has grown since they
+  /// have been resolved.
+  std::vector<const llvm::Instruction *> getOutdatedCallSites() override;
+
   static std::set<const llvm::Type *>
   getReachableTypes(const std::unordered_set<const llvm::Value *> &Values);
 
@@ -17,9 +17,11 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_RTARESOLVER_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_RTARESOLVER_H_
 
+#include <memory>
 #include <set>
 
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/VirtualCallCache.h"
 
 namespace llvm {
 class ImmutableCallSite;
@@ -29,13 +31,21 @@ class Function;
 
 namespace psr {
 class RTAResolver : public CHAResolver {
+private:
+  // the targets that are restricted to the allocated types
+  VirtualCallCache RTACache;
+
 public:
-  RTAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH);
+  RTAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH,
+              std::shared_ptr<VirtualCallCache> CHACache = nullptr);
 
   ~RTAResolver() override = default;
 
   virtual std::set<const llvm::Function *>
   resolveVirtualCall(llvm::ImmutableCallSite CS) override;
+
+  [[nodiscard]] VirtualCallCache::Stats
+  getVirtualCallCacheStats() const override;
 };
 } // namespace psr
 
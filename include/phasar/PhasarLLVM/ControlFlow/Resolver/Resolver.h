@@ -19,6 +19,9 @@
 
 #include <set>
 #include <string>
+#include <vector>
+
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/VirtualCallCache.h"
 
 namespace llvm {
 class Instruction;
@@ -68,6 +71,30 @@ public:
   resolveFunctionPointer(llvm::ImmutableCallSite CS);
 
   virtual void otherInst(const llvm::Instruction *Inst);
+
+  /**
+   * Returns true if the call-sites can be resolved independently of each
+   * other and of the order in which the functions are visited. The resolution
+   * methods of such a resolver may be called concurrently, and its preCall(),
+   * handlePossibleTargets(), postCall() and otherInst() must not influence
+   * the resolution.
+   */
+  [[nodiscard]] virtual bool isOrderIndependent() const;
+
+  /**
+   * Returns the call-sites that have already been resolved, but may have
+   * additional targets if they were resolved again, e.g. because the
+   * points-to information they have been resolved with has grown since. The
+   * caller is expected to resolve them again.
+   */
+  virtual std::vector<const llvm::Instruction *> getOutdatedCallSites();
+
+  /**
+   * Returns how many virtual calls have been resolved using memoized targets
+   * and how many had to be resolved from scratch.
+   */
+  [[nodiscard]] virtual VirtualCallCache::Stats
+  getVirtualCallCacheStats() const;
 };
 } // namespace psr
 
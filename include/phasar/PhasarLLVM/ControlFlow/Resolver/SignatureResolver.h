@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_SIGNATURERESOLVER_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_SIGNATURERESOLVER_H_
+
+#include <set>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h"
+
+namespace llvm {
+class ImmutableCallSite;
+class Function;
+class FunctionType;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Resolves function pointers without points-to information: an indirect
+ * call may call every function whose address is taken somewhere in the
+ * program and whose type is the function type of the call-site. The
+ * functions are indexed by their type once, when the resolver is created, so
+ * that each call-site is resolved by a single lookup. Virtual calls are
+ * resolved like CHAResolver does.
+ *
+ * This is sound as long as function pointers are not cast to a different
+ * type before they are called and no function pointers are obtained from
+ * outside of the analyzed modules.
+ */
+class SignatureResolver : public CHAResolver {
+private:
+  llvm::DenseMap<const llvm::FunctionType *,
+                 std::vector<const llvm::Function *>>
+      AddressTakenFunctions;
+
+public:
+  SignatureResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH);
+
+  ~SignatureResolver() override = default;
+
+  std::set<const llvm::Function *>
+  resolveFunctionPointer(llvm::ImmutableCallSite CS) override;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_VIRTUALCALLCACHE_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_VIRTUALCALLCACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace llvm {
+class Function;
+class StructType;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Memoizes the targets of virtual calls by the static receiver type and the
+ * index into the virtual function table. Many call-sites share the same
+ * receiver type and index, but only the first of them needs to walk the type
+ * hierarchy and the virtual function tables. Resolvers whose targets only
+ * depend on these two values may share a cache. The cache may be queried
+ * concurrently.
+ */
+class VirtualCallCache {
+public:
+  using TargetSet = std::set<const llvm::Function *>;
+
+  struct Stats {
+    size_t Hits = 0;
+    size_t Misses = 0;
+
+    Stats &operator+=(const Stats &Other) {
+      Hits += Other.Hits;
+      Misses += Other.Misses;
+      return *this;
+    }
+  };
+
+private:
+  mutable std::shared_mutex Mtx;
+  llvm::DenseMap<std::pair<const llvm::StructType *, unsigned>, TargetSet>
+      Targets;
+  std::atomic<size_t> Hits{0};
+  std::atomic<size_t> Misses{0};
+
+public:
+  VirtualCallCache() = default;
+
+  VirtualCallCache(const VirtualCallCache &) = delete;
+  VirtualCallCache &operator=(const VirtualCallCache &) = delete;
+  ~VirtualCallCache() = default;
+
+  /// Returns the targets of a virtual call on ReceiverTy at VFTIdx. On the
+  /// first query of a pair the targets are computed by Compute(), which is
+  /// called without holding the lock.
+  template <typename ComputeFn>
+  TargetSet getOrCompute(const llvm::StructType *ReceiverTy, unsigned VFTIdx,
+                         ComputeFn Compute) {
+    auto Key = std::make_pair(ReceiverTy, VFTIdx);
+    {
+      std::shared_lock<std::shared_mutex> Lock(Mtx);
+      if (auto Search = Targets.find(Key); Search != Targets.end()) {
+        ++Hits;
+        return Search->second;
+      }
+    }
+    ++Misses;
+    TargetSet Result = Compute();
+    std::unique_lock<std::shared_mutex> Lock(Mtx);
+    // another thread may have computed the same targets in the meantime
+    Targets.try_emplace(Key, Result);
+    return Result;
+  }
+
+  [[nodiscard]] size_t size() const {
+    std::shared_lock<std::shared_mutex> Lock(Mtx);
+    return Targets.size();
+  }
+
+  [[nodiscard]] Stats getStats() const { return {Hits, Misses}; }
+};
+
+} // namespace psr
+
+#endif
@@ -10,9 +10,12 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONCOMPOSER_H
 #define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONCOMPOSER_H
 
+#include "llvm/ADT/Hashing.h"
+
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 
 #include <memory>
+#include <typeinfo>
 
 namespace psr {
 
@@ -89,6 +92,12 @@ public:
     return false;
   }
 
+  // equal_to() also holds for subclasses, hence, they must share the hash
+  size_t hash() const override {
+    return llvm::hash_combine(typeid(EdgeFunctionComposer<L>).hash_code(),
+                              F->hash(), G->hash());
+  }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "COMP[ " << F.get()->str() << " , " << G.get()->str()
        << " ] (EF:" << EFComposer_Id << ')';
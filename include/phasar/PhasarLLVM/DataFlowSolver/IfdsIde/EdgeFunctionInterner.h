@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONINTERNER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONINTERNER_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/ShardedCache.h"
+
+namespace psr {
+
+/**
+ * Hash-conses the edge functions of a solver run: for each class of
+ * structurally equal edge functions (w.r.t. EdgeFunction::hash() and
+ * EdgeFunction::equal_to()) a single canonical instance is kept. The
+ * canonical instances are owned by the interner and are released all at once
+ * when it is destroyed at the end of the solver run.
+ *
+ * As canonical instances are never released before, their addresses identify
+ * them uniquely. This allows to memoize compositions and joins by the
+ * addresses of their operands, and to compare canonical edge functions by
+ * pointer equality rather than by equal_to().
+ */
+template <typename L> class EdgeFunctionInterner {
+public:
+  using EdgeFunctionPtrType = typename EdgeFunction<L>::EdgeFunctionPtrType;
+
+private:
+  struct StructuralKey {
+    EdgeFunctionPtrType Function;
+    size_t Hash;
+
+    explicit StructuralKey(EdgeFunctionPtrType F)
+        : Function(std::move(F)), Hash(Function->hash()) {}
+
+    bool operator==(const StructuralKey &Other) const {
+      return Function == Other.Function ||
+             (Hash == Other.Hash && Function->equal_to(Other.Function));
+    }
+
+    struct Hasher {
+      size_t operator()(const StructuralKey &Key) const { return Key.Hash; }
+    };
+  };
+
+  using MemoKey = HashedKey<const EdgeFunction<L> *, const EdgeFunction<L> *>;
+
+  ShardedCache<StructuralKey, EdgeFunctionPtrType,
+               typename StructuralKey::Hasher>
+      CanonicalFunctions;
+  ShardedCache<MemoKey, EdgeFunctionPtrType, typename MemoKey::Hasher>
+      Compositions;
+  ShardedCache<MemoKey, EdgeFunctionPtrType, typename MemoKey::Hasher> Joins;
+
+public:
+  // If more than one shard is requested, the interner may be used by
+  // multiple threads concurrently.
+  explicit EdgeFunctionInterner(size_t NumShards = 1)
+      : CanonicalFunctions(NumShards), Compositions(NumShards),
+        Joins(NumShards) {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("EF Compose Memo Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Join Memo Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  EdgeFunctionInterner(const EdgeFunctionInterner &) = delete;
+  EdgeFunctionInterner &operator=(const EdgeFunctionInterner &) = delete;
+  EdgeFunctionInterner(EdgeFunctionInterner &&) = delete;
+  EdgeFunctionInterner &operator=(EdgeFunctionInterner &&) = delete;
+  ~EdgeFunctionInterner() = default;
+
+  /// Returns the canonical instance of the given edge function.
+  EdgeFunctionPtrType intern(EdgeFunctionPtrType F) {
+    StructuralKey Key(std::move(F));
+    if (auto Canonical = CanonicalFunctions.lookup(Key)) {
+      return *Canonical;
+    }
+    size_t NumEvicted;
+    return CanonicalFunctions.insert(Key, Key.Function, NumEvicted);
+  }
+
+  /// Returns the canonical instance of F->composeWith(G). The composition is
+  /// only computed once for each pair of canonical operands.
+  EdgeFunctionPtrType compose(EdgeFunctionPtrType F, EdgeFunctionPtrType G) {
+    PAMM_GET_INSTANCE;
+    F = intern(std::move(F));
+    G = intern(std::move(G));
+    MemoKey Key(F.get(), G.get());
+    if (auto Result = Compositions.lookup(Key)) {
+      INC_COUNTER("EF Compose Memo Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+      return *Result;
+    }
+    size_t NumEvicted;
+    return Compositions.insert(Key, intern(F->composeWith(G)), NumEvicted);
+  }
+
+  /// Returns the canonical instance of F->joinWith(G). The join is only
+  /// computed once for each pair of canonical operands.
+  EdgeFunctionPtrType join(EdgeFunctionPtrType F, EdgeFunctionPtrType G) {
+    PAMM_GET_INSTANCE;
+    F = intern(std::move(F));
+    G = intern(std::move(G));
+    MemoKey Key(F.get(), G.get());
+    if (auto Result = Joins.lookup(Key)) {
+      INC_COUNTER("EF Join Memo Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+      return *Result;
+    }
+    size_t NumEvicted;
+    return Joins.insert(Key, intern(F->joinWith(G)), NumEvicted);
+  }
+
+  /// Returns the number of canonical edge functions. Must not be called
+  /// concurrently to the other member functions.
+  [[nodiscard]] size_t size() const { return CanonicalFunctions.size(); }
+};
+
+} // namespace psr
+
+#endif
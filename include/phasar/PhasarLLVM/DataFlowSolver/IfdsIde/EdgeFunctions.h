@@ -20,6 +20,7 @@
 #include "llvm/Support/Compiler.h"
 
 #include <atomic>
+#include <cstddef>
 #include <iosfwd>
 #include <iostream>
 #include <map>
@@ -30,6 +31,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <typeinfo>
 #include <utility>
 
 namespace psr {
@@ -80,6 +82,16 @@ public:
 
   virtual bool equal_to(EdgeFunctionPtrType OtherFunction) const = 0;
 
+  //
+  // Returns a hash value that is consistent with equal_to(), i.e. edge
+  // functions that are equal must have equal hash values. It is used to
+  // hash-cons edge functions (see EdgeFunctionInterner). The default
+  // implementation only hashes the dynamic type, which is consistent as long as
+  // equal_to() does not hold for edge functions of different types. Edge
+  // functions that carry data should override it to hash that data, too.
+  //
+  virtual size_t hash() const { return typeid(*this).hash_code(); }
+
   virtual void print(std::ostream &OS, bool IsForDebug = false) const {
     OS << "EdgeFunction";
   }
@@ -135,6 +147,9 @@ public:
     return false;
   }
 
+  // equal_to() also holds for subclasses, hence, they must share the hash
+  size_t hash() const override { return typeid(AllTop<L>).hash_code(); }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "AllTop";
   }
@@ -189,6 +204,9 @@ public:
     return false;
   }
 
+  // equal_to() also holds for subclasses, hence, they must share the hash
+  size_t hash() const override { return typeid(AllBottom<L>).hash_code(); }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "AllBottom";
   }
@@ -10,15 +10,18 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <set>
-#include <tuple>
+#include <shared_mutex>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/Utils/Interner.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/ShardedCache.h"
 
 namespace psr {
 
@@ -41,81 +44,116 @@ class FlowEdgeFunctionCache {
   using t_t = typename AnalysisDomainTy::t_t;
 
 private:
-  using EdgeFuncInstKey = std::pair<n_t, n_t>;
-  using EdgeFuncNodeKey = std::pair<d_t, d_t>;
-  using InnerEdgeFunctionMapType =
-      std::map<EdgeFuncNodeKey, EdgeFunctionPtrType>;
+  using CalleeSetIdTy = uint32_t;
+
+  template <typename... Ts>
+  using CacheTy = ShardedCache<HashedKey<Ts...>, FlowFunctionPtrType,
+                               typename HashedKey<Ts...>::Hasher>;
+  template <typename... Ts>
+  using EdgeCacheTy = ShardedCache<HashedKey<Ts...>, EdgeFunctionPtrType,
+                                   typename HashedKey<Ts...>::Hasher>;
+
+  struct CalleeSetHash {
+    size_t operator()(const std::set<f_t> &Callees) const {
+      llvm::hash_code Hash = llvm::hash_value(Callees.size());
+      for (const auto &Callee : Callees) {
+        Hash = llvm::hash_combine(Hash, std::hash<f_t>{}(Callee));
+      }
+      return Hash;
+    }
+  };
 
   IDETabulationProblem<AnalysisDomainTy, Container> &problem;
   // Auto add zero
   bool autoAddZero;
   d_t zeroValue;
   // Caches for the flow functions
-  std::map<std::tuple<n_t, n_t>, FlowFunctionPtrType> NormalFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
-      ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t, std::set<f_t>>, FlowFunctionPtrType>
-      CallToRetFlowFunctionCache;
+  CacheTy<n_t, n_t> NormalFlowFunctionCache;
+  CacheTy<n_t, f_t> CallFlowFunctionCache;
+  CacheTy<n_t, f_t, n_t, n_t> ReturnFlowFunctionCache;
+  // the set of callees is part of the key, but is interned to an ID so that
+  // lookups do not copy and compare whole sets
+  CacheTy<n_t, n_t, CalleeSetIdTy> CallToRetFlowFunctionCache;
   // Caches for the edge functions
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType> NormalEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunctionPtrType>
-      CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      ReturnEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      SummaryEdgeFunctionCache;
+  EdgeCacheTy<n_t, d_t, n_t, d_t> NormalEdgeFunctionCache;
+  EdgeCacheTy<n_t, d_t, f_t, d_t> CallEdgeFunctionCache;
+  EdgeCacheTy<n_t, f_t, n_t, d_t, n_t, d_t> ReturnEdgeFunctionCache;
+  EdgeCacheTy<n_t, d_t, n_t, d_t> CallToRetEdgeFunctionCache;
+  EdgeCacheTy<n_t, d_t, n_t, d_t> SummaryEdgeFunctionCache;
+  Interner<std::set<f_t>, CalleeSetHash> CalleeSets;
+  // only used if the caches are shared by the worker threads of a parallel
+  // solver
+  std::shared_mutex CalleeSetsMtx;
 
 public:
   // Ctor allows access to the IDEProblem in order to get access to flow and
-  // edge function factory functions.
+  // edge function factory functions. If more than one shard is requested, the
+  // caches may be used by multiple threads concurrently. A capacity of zero
+  // means that the caches are unbounded, otherwise it limits the number of
+  // functions each of the caches holds.
   FlowEdgeFunctionCache(
-      IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
+      IDETabulationProblem<AnalysisDomainTy, Container> &Problem,
+      size_t NumShards = 1, size_t Capacity = 0)
       : problem(Problem),
         autoAddZero(problem.getIFDSIDESolverConfig().autoAddZero()),
-        zeroValue(problem.getZeroValue()) {
+        zeroValue(problem.getZeroValue()),
+        NormalFlowFunctionCache(NumShards, Capacity),
+        CallFlowFunctionCache(NumShards, Capacity),
+        ReturnFlowFunctionCache(NumShards, Capacity),
+        CallToRetFlowFunctionCache(NumShards, Capacity),
+        NormalEdgeFunctionCache(NumShards, Capacity),
+        CallEdgeFunctionCache(NumShards, Capacity),
+        ReturnEdgeFunctionCache(NumShards, Capacity),
+        CallToRetEdgeFunctionCache(NumShards, Capacity),
+        SummaryEdgeFunctionCache(NumShards, Capacity) {
     PAMM_GET_INSTANCE;
     REG_COUNTER("Normal-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Normal-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Normal-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call flow functions
     REG_COUNTER("Call-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Call-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Call-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for return flow functions
     REG_COUNTER("Return-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Return-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Return-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call to return flow functions
     REG_COUNTER("CallToRet-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("CallToRet-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("CallToRet-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the summary flow functions
     // REG_COUNTER("Summary-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     // REG_COUNTER("Summary-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the normal edge functions
     REG_COUNTER("Normal-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Normal-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Normal-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call edge functions
     REG_COUNTER("Call-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Call-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Call-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the return edge functions
     REG_COUNTER("Return-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Return-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Return-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call to return edge functions
     REG_COUNTER("CallToRet-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("CallToRet-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("CallToRet-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the summary edge functions
     REG_COUNTER("Summary-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Summary-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Summary-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
   }
 
   ~FlowEdgeFunctionCache() = default;
 
-  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = default;
-  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = default;
+  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = delete;
 
-  FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) noexcept = default;
-  FlowEdgeFunctionCache &
-  operator=(FlowEdgeFunctionCache &&FEFC) noexcept = default;
+  FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(FlowEdgeFunctionCache &&FEFC) = delete;
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) {
     PAMM_GET_INSTANCE;
@@ -125,20 +163,23 @@ public:
                   << "(N) Curr Inst : " << problem.NtoString(curr);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Succ Inst : " << problem.NtoString(succ));
-    auto key = std::tie(curr, succ);
-    if (NormalFlowFunctionCache.count(key)) {
+    HashedKey<n_t, n_t> Key(curr, succ);
+    if (auto Search = NormalFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return NormalFlowFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff = (autoAddZero)
                     ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                           problem.getNormalFlowFunction(curr, succ), zeroValue)
                     : problem.getNormalFlowFunction(curr, succ);
-      NormalFlowFunctionCache.insert(make_pair(key, ff));
+      size_t NumEvicted;
+      ff = NormalFlowFunctionCache.insert(Key, std::move(ff), NumEvicted);
+      INC_COUNTER("Normal-FF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -154,13 +195,13 @@ public:
                   << "(N) Call Stmt : " << problem.NtoString(callStmt);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(F) Dest Fun : " << problem.FtoString(destFun));
-    auto key = std::tie(callStmt, destFun);
-    if (CallFlowFunctionCache.count(key)) {
+    HashedKey<n_t, f_t> Key(callStmt, destFun);
+    if (auto Search = CallFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallFlowFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff =
@@ -168,7 +209,10 @@ public:
               ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                     problem.getCallFlowFunction(callStmt, destFun), zeroValue)
               : problem.getCallFlowFunction(callStmt, destFun);
-      CallFlowFunctionCache.insert(std::make_pair(key, ff));
+      size_t NumEvicted;
+      ff = CallFlowFunctionCache.insert(Key, std::move(ff), NumEvicted);
+      INC_COUNTER("Call-FF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -189,13 +233,13 @@ public:
                   << "(N) Exit Stmt : " << problem.NtoString(exitStmt);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Ret Site  : " << problem.NtoString(retSite));
-    auto key = std::tie(callSite, calleeFun, exitStmt, retSite);
-    if (ReturnFlowFunctionCache.count(key)) {
+    HashedKey<n_t, f_t, n_t, n_t> Key(callSite, calleeFun, exitStmt, retSite);
+    if (auto Search = ReturnFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return ReturnFlowFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff = (autoAddZero)
@@ -205,7 +249,10 @@ public:
                           zeroValue)
                     : problem.getRetFlowFunction(callSite, calleeFun, exitStmt,
                                                  retSite);
-      ReturnFlowFunctionCache.insert(std::make_pair(key, ff));
+      size_t NumEvicted;
+      ff = ReturnFlowFunctionCache.insert(Key, std::move(ff), NumEvicted);
+      INC_COUNTER("Return-FF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -214,7 +261,7 @@ public:
   }
 
   FlowFunctionPtrType getCallToRetFlowFunction(n_t callSite, n_t retSite,
-                                               std::set<f_t> callees) {
+                                               const std::set<f_t> &callees) {
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -227,13 +274,14 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-    auto key = std::tie(callSite, retSite, callees);
-    if (CallToRetFlowFunctionCache.count(key)) {
+    HashedKey<n_t, n_t, CalleeSetIdTy> Key(callSite, retSite,
+                                           getCalleeSetId(callees));
+    if (auto Search = CallToRetFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallToRetFlowFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff =
@@ -243,7 +291,10 @@ public:
                                                      callees),
                     zeroValue)
               : problem.getCallToRetFlowFunction(callSite, retSite, callees);
-      CallToRetFlowFunctionCache.insert(std::make_pair(key, ff));
+      size_t NumEvicted;
+      ff = CallToRetFlowFunctionCache.insert(Key, std::move(ff), NumEvicted);
+      INC_COUNTER("CallToRet-FF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -278,42 +329,20 @@ public:
                   << "(N) Succ Inst : " << problem.NtoString(succ);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Succ Node : " << problem.DtoString(succNode));
-    if (hasNormalEdgeFunction(curr, currNode, succ, succNode)) {
+    HashedKey<n_t, d_t, n_t, d_t> Key(curr, currNode, succ, succNode);
+    if (auto Search = NormalEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-
-      EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(curr, succ);
-      auto SearchInnerMap = NormalEdgeFunctionCache.find(OuterMapKey);
-      assert(
-          SearchInnerMap != NormalEdgeFunctionCache.end() &&
-          "Outer map did not contain map node, which should be guaranteed by "
-          "hasNormalEdgeFunction.");
-
-      auto SearchEdgeFunc = SearchInnerMap->second.find(
-          createEdgeFunctionNodeKey(currNode, succNode));
-      assert(SearchEdgeFunc != SearchInnerMap->second.end() &&
-             "Inner map did not contain EdgeFunction, which should be "
-             "guaranteed by hasNormalEdgeFunction");
-
-      return SearchEdgeFunc->second;
+      return *Search;
     } else {
       INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
-
-      EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(curr, succ);
-      auto SearchInnerMap = NormalEdgeFunctionCache.find(OuterMapKey);
-      if (SearchInnerMap != NormalEdgeFunctionCache.end()) {
-        SearchInnerMap->second.emplace(
-            createEdgeFunctionNodeKey(currNode, succNode), ef);
-      } else {
-        NormalEdgeFunctionCache.emplace(
-            OuterMapKey,
-            InnerEdgeFunctionMapType{
-                {typename InnerEdgeFunctionMapType::value_type{
-                    createEdgeFunctionNodeKey(currNode, succNode), ef}}});
-      }
+      size_t NumEvicted;
+      ef = NormalEdgeFunctionCache.insert(Key, std::move(ef), NumEvicted);
+      INC_COUNTER("Normal-EF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -335,18 +364,22 @@ public:
         << "(F) Dest Fun : " << problem.FtoString(destinationFunction);
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "(D) Dest Node : " << problem.DtoString(destNode));
-    auto key = std::tie(callStmt, srcNode, destinationFunction, destNode);
-    if (CallEdgeFunctionCache.count(key)) {
+    HashedKey<n_t, d_t, f_t, d_t> Key(callStmt, srcNode, destinationFunction,
+                                      destNode);
+    if (auto Search = CallEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return CallEdgeFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getCallEdgeFunction(callStmt, srcNode,
                                             destinationFunction, destNode);
-      CallEdgeFunctionCache.insert(std::make_pair(key, ef));
+      size_t NumEvicted;
+      ef = CallEdgeFunctionCache.insert(Key, std::move(ef), NumEvicted);
+      INC_COUNTER("Call-EF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -372,19 +405,22 @@ public:
                   << "(N) Ret Site  : " << problem.NtoString(reSite);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retNode));
-    auto key =
-        std::tie(callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
-    if (ReturnEdgeFunctionCache.count(key)) {
+    HashedKey<n_t, f_t, n_t, d_t, n_t, d_t> Key(
+        callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
+    if (auto Search = ReturnEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ReturnEdgeFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getReturnEdgeFunction(
           callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
-      ReturnEdgeFunctionCache.insert(std::make_pair(key, ef));
+      size_t NumEvicted;
+      ef = ReturnEdgeFunctionCache.insert(Key, std::move(ef), NumEvicted);
+      INC_COUNTER("Return-EF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -394,7 +430,7 @@ public:
 
   EdgeFunctionPtrType getCallToRetEdgeFunction(n_t callSite, d_t callNode,
                                                n_t retSite, d_t retSiteNode,
-                                               std::set<f_t> callees) {
+                                               const std::set<f_t> &callees) {
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -411,18 +447,21 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (CallToRetEdgeFunctionCache.count(key)) {
+    HashedKey<n_t, d_t, n_t, d_t> Key(callSite, callNode, retSite, retSiteNode);
+    if (auto Search = CallToRetEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("CallToRet-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return CallToRetEdgeFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("CallToRet-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
                                                  retSiteNode, callees);
-      CallToRetEdgeFunctionCache.insert(std::make_pair(key, ef));
+      size_t NumEvicted;
+      ef = CallToRetEdgeFunctionCache.insert(Key, std::move(ef), NumEvicted);
+      INC_COUNTER("CallToRet-EF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -444,18 +483,21 @@ public:
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retSiteNode);
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (SummaryEdgeFunctionCache.count(key)) {
+    HashedKey<n_t, d_t, n_t, d_t> Key(callSite, callNode, retSite, retSiteNode);
+    if (auto Search = SummaryEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return SummaryEdgeFunctionCache.at(key);
+      return *Search;
     } else {
       INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
                                                retSiteNode);
-      SummaryEdgeFunctionCache.insert(std::make_pair(key, ef));
+      size_t NumEvicted;
+      ef = SummaryEdgeFunctionCache.insert(Key, std::move(ef), NumEvicted);
+      INC_COUNTER("Summary-EF Cache Eviction", NumEvicted,
+                  PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -474,24 +516,36 @@ public:
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Normal-flow function constructions: "
                     << GET_COUNTER("Normal-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Normal-flow function cache evictions: "
+                    << GET_COUNTER("Normal-FF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-flow function cache hits: "
                     << GET_COUNTER("Call-FF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-flow function constructions: "
                     << GET_COUNTER("Call-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call-flow function cache evictions: "
+                    << GET_COUNTER("Call-FF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return-flow function cache hits: "
                     << GET_COUNTER("Return-FF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return-flow function constructions: "
                     << GET_COUNTER("Return-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Return-flow function cache evictions: "
+                    << GET_COUNTER("Return-FF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return-flow function cache hits: "
                     << GET_COUNTER("CallToRet-FF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return-flow function constructions: "
                     << GET_COUNTER("CallToRet-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call-to-Return-flow function cache evictions: "
+                    << GET_COUNTER("CallToRet-FF Cache Eviction"));
       // LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Summary-flow function
       // cache hits: "
       //                        << GET_COUNTER("Summary-FF Cache Hit"));
@@ -511,6 +565,12 @@ public:
                             "Return-FF Construction",
                             "CallToRet-FF Construction" /*,
                 "Summary-FF Construction"*/}));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Total flow function cache evictions: "
+                    << GET_SUM_COUNT({"Normal-FF Cache Eviction",
+                                      "Call-FF Cache Eviction",
+                                      "Return-FF Cache Eviction",
+                                      "CallToRet-FF Cache Eviction"}));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << ' ');
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Normal edge function cache hits: "
@@ -518,30 +578,45 @@ public:
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Normal edge function constructions: "
                     << GET_COUNTER("Normal-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Normal edge function cache evictions: "
+                    << GET_COUNTER("Normal-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call edge function cache hits: "
                     << GET_COUNTER("Call-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call edge function constructions: "
                     << GET_COUNTER("Call-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call edge function cache evictions: "
+                    << GET_COUNTER("Call-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return edge function cache hits: "
                     << GET_COUNTER("Return-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return edge function constructions: "
                     << GET_COUNTER("Return-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Return edge function cache evictions: "
+                    << GET_COUNTER("Return-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return edge function cache hits: "
                     << GET_COUNTER("CallToRet-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return edge function constructions: "
                     << GET_COUNTER("CallToRet-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call-to-Return edge function cache evictions: "
+                    << GET_COUNTER("CallToRet-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Summary edge function cache hits: "
                     << GET_COUNTER("Summary-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Summary edge function constructions: "
                     << GET_COUNTER("Summary-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Summary edge function cache evictions: "
+                    << GET_COUNTER("Summary-EF Cache Eviction"));
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Total edge function cache hits: "
@@ -555,6 +630,13 @@ public:
                             "Return-EF Construction",
                             "CallToRet-EF Construction",
                             "Summary-EF Construction"}));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Total edge function cache evictions: "
+                    << GET_SUM_COUNT({"Normal-EF Cache Eviction",
+                                      "Call-EF Cache Eviction",
+                                      "Return-EF Cache Eviction",
+                                      "CallToRet-EF Cache Eviction",
+                                      "Summary-EF Cache Eviction"}));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "----------------------------------------------");
     } else {
@@ -565,27 +647,27 @@ public:
   }
 
 private:
-  /// Checks if an EdgeFunction corresponding to the passed n_t/d_t values is
-  /// cached.
-  ///
-  /// \returns true, if a cache entry is present
-  inline bool hasNormalEdgeFunction(n_t curr, d_t currNode, n_t succ,
-                                    d_t succNode) {
-    auto Search =
-        NormalEdgeFunctionCache.find(createEdgeFunctionInstKey(curr, succ));
-    if (Search != NormalEdgeFunctionCache.end()) {
-      return Search->second.count(
-          createEdgeFunctionNodeKey(currNode, succNode));
+  /// Returns the ID of the given set of callees; the set is interned if
+  /// necessary.
+  CalleeSetIdTy getCalleeSetId(const std::set<f_t> &Callees) {
+    bool Concurrent = NormalFlowFunctionCache.getNumShards() > 1;
+    std::shared_lock<std::shared_mutex> ReadLock(CalleeSetsMtx,
+                                                 std::defer_lock);
+    if (Concurrent) {
+      ReadLock.lock();
     }
-    return false;
-  }
-
-  static inline EdgeFuncInstKey createEdgeFunctionInstKey(n_t n1, n_t n2) {
-    return std::make_pair(n1, n2);
-  }
-
-  static inline EdgeFuncNodeKey createEdgeFunctionNodeKey(d_t d1, d_t d2) {
-    return std::make_pair(d1, d2);
+    if (auto Id = CalleeSets.getId(Callees)) {
+      return *Id;
+    }
+    if (Concurrent) {
+      ReadLock.unlock();
+    }
+    std::unique_lock<std::shared_mutex> WriteLock(CalleeSetsMtx,
+                                                  std::defer_lock);
+    if (Concurrent) {
+      WriteLock.lock();
+    }
+    return CalleeSets.getOrCreateId(Callees);
   }
 };
 
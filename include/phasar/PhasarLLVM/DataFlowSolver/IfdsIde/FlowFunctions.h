@@ -57,6 +57,19 @@ public:
   // details.
   //
   virtual container_type computeTargets(D Source) = 0;
+
+  //
+  // Same as computeTargets(), but adds the target facts to Targets instead of
+  // returning them in a new container, which allows the solvers to reuse the
+  // same output buffer for all flow function applications. Targets is not
+  // cleared beforehand. The default implementation delegates to
+  // computeTargets(); flow functions that produce their targets cheaply
+  // should override it to avoid the temporary container.
+  //
+  virtual void computeTargetsInto(D Source, container_type &Targets) {
+    container_type Result = computeTargets(Source);
+    Targets.insert(Result.begin(), Result.end());
+  }
 };
 
 template <typename D, typename Container = std::set<D>>
@@ -72,6 +85,9 @@ public:
   Identity &operator=(const Identity &i) = delete;
   // simply return what the user provides
   container_type computeTargets(D source) override { return {source}; }
+  void computeTargetsInto(D source, container_type &Targets) override {
+    Targets.insert(source);
+  }
   static std::shared_ptr<Identity> getInstance() {
     static std::shared_ptr<Identity> instance =
         std::shared_ptr<Identity>(new Identity);
@@ -162,6 +178,17 @@ public:
       return {source};
     }
   }
+
+  void computeTargetsInto(D source, container_type &Targets) override {
+    Targets.insert(source);
+    if (source == zeroValue) {
+      Targets.insert(genValue);
+    }
+  }
+
+  [[nodiscard]] D getGenValue() const { return genValue; }
+
+  [[nodiscard]] D getZeroValue() const { return zeroValue; }
 };
 
 /**
@@ -192,6 +219,13 @@ public:
     }
   }
 
+  void computeTargetsInto(D Source, container_type &Targets) override {
+    Targets.insert(Source);
+    if (Predicate(Source)) {
+      Targets.insert(GenValues.begin(), GenValues.end());
+    }
+  }
+
 protected:
   container_type GenValues;
   std::function<bool(D)> Predicate;
@@ -237,6 +271,14 @@ public:
     }
   }
 
+  void computeTargetsInto(D source, container_type &Targets) override {
+    if (source != killValue) {
+      Targets.insert(source);
+    }
+  }
+
+  [[nodiscard]] D getKillValue() const { return killValue; }
+
 protected:
   D killValue;
 };
@@ -260,6 +302,12 @@ public:
     }
   }
 
+  void computeTargetsInto(D source, container_type &Targets) override {
+    if (!Predicate(source)) {
+      Targets.insert(source);
+    }
+  }
+
 protected:
   std::function<bool(D)> Predicate;
 };
@@ -292,7 +340,8 @@ public:
   KillAll(const KillAll &k) = delete;
   KillAll &operator=(const KillAll &k) = delete;
   container_type computeTargets(D source) override { return container_type(); }
-  static std::shared_ptr<KillAll<D>> getInstance() {
+  void computeTargetsInto(D source, container_type &Targets) override {}
+  static std::shared_ptr<KillAll> getInstance() {
     static std::shared_ptr<KillAll> instance =
         std::shared_ptr<KillAll>(new KillAll);
     return instance;
@@ -379,6 +428,13 @@ public:
     }
   }
 
+  void computeTargetsInto(D source, container_type &Targets) override {
+    delegate->computeTargetsInto(source, Targets);
+    if (source == zerovalue) {
+      Targets.insert(zerovalue);
+    }
+  }
+
 private:
   FlowFunctionPtrType delegate;
   D zerovalue;
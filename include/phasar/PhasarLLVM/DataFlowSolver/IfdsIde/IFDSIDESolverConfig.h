@@ -17,7 +17,9 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 
+#include <cstddef>
 #include <iosfwd>
+#include <string>
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/Utils/EnumFlags.h"
@@ -34,10 +36,38 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  InternEdgeFunctions = 64,
+  CollectJumpFunctions = 128,
 
   All = ~0u
 };
 
+/// Determines the order in which the IDESolver processes path edges.
+enum class WorklistKind {
+#define WORKLIST_KIND(NAME, CMDFLAG, TYPE) TYPE,
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistKind.def"
+  Invalid
+};
+
+std::string toString(const WorklistKind &WK);
+
+WorklistKind toWorklistKind(const std::string &S);
+
+std::ostream &operator<<(std::ostream &OS, const WorklistKind &WK);
+
+/// Determines how the IDESolver stores its jump functions.
+enum class JumpFunctionsKind {
+#define JUMP_FUNCTIONS_KIND(NAME, CMDFLAG, TYPE) TYPE,
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JumpFunctionsKind.def"
+  Invalid
+};
+
+std::string toString(const JumpFunctionsKind &JFK);
+
+JumpFunctionsKind toJumpFunctionsKind(const std::string &S);
+
+std::ostream &operator<<(std::ostream &OS, const JumpFunctionsKind &JFK);
+
 struct IFDSIDESolverConfig {
   IFDSIDESolverConfig();
   IFDSIDESolverConfig(SolverConfigOptions Options);
@@ -53,6 +83,13 @@ struct IFDSIDESolverConfig {
   bool recordEdges() const;
   bool emitESG() const;
   bool computePersistedSummaries() const;
+  bool internEdgeFunctions() const;
+  bool collectJumpFunctions() const;
+  WorklistKind worklistKind() const;
+  unsigned numThreads() const;
+  JumpFunctionsKind jumpFunctionsKind() const;
+  size_t cacheCapacity() const;
+  const std::string &esgRecordFile() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
@@ -60,6 +97,13 @@ struct IFDSIDESolverConfig {
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
   void setComputePersistedSummaries(bool Set = true);
+  void setInternEdgeFunctions(bool Set = true);
+  void setCollectJumpFunctions(bool Set = true);
+  void setWorklistKind(WorklistKind WK);
+  void setNumThreads(unsigned N);
+  void setJumpFunctionsKind(JumpFunctionsKind JFK);
+  void setCacheCapacity(size_t Capacity);
+  void setESGRecordFile(std::string Path);
 
   friend std::ostream &operator<<(std::ostream &OS,
                                   const IFDSIDESolverConfig &SC);
@@ -68,6 +112,21 @@ private:
   SolverConfigOptions Options = SolverConfigOptions::AutoAddZero |
                                 SolverConfigOptions::ComputeValues |
                                 SolverConfigOptions::RecordEdges;
+  // LIFO resembles the depth-first order of the former recursive
+  // implementation most closely
+  WorklistKind WLKind = WorklistKind::LIFO;
+  // number of threads used for the tabulation; a single thread disables the
+  // parallel solver
+  unsigned NumThreads = 1;
+  // Nested uses hash tables keyed by the nodes and facts themselves, Flat
+  // interns them to dense IDs first
+  JumpFunctionsKind JFKind = JumpFunctionsKind::Nested;
+  // maximum number of functions in each of the flow and edge function caches,
+  // zero means unbounded
+  size_t CacheCapacity = 0;
+  // if set, the recorded path edges and edge functions are streamed to this
+  // file instead of being kept in memory
+  std::string ESGRecordFile;
 };
 
 } // namespace psr
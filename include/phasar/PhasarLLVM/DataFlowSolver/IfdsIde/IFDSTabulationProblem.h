@@ -120,6 +120,15 @@ public:
   }
 
   virtual bool setSoundnessFlag(SoundnessFlag SF) { return false; }
+
+  /**
+   * Returns true if the flow and edge function factories of this problem as
+   * well as the functions they return may be used by multiple threads at
+   * once. The solvers only tabulate problems in parallel that are thread-safe
+   * (see IFDSIDESolverConfig::numThreads()), all other problems are solved
+   * sequentially.
+   */
+  [[nodiscard]] virtual bool isThreadSafe() const { return false; }
 };
 } // namespace psr
 
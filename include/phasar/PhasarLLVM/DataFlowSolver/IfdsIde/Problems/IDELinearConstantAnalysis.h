@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -38,13 +39,16 @@ class LLVMBasedICFG;
 class LLVMTypeHierarchy;
 class LLVMPointsToInfo;
 
+// Unlike the IFDS variant, this problem keeps the default std::set fact
+// container: WPDSLinearConstantAnalysis shares its flow functions with
+// WPDSProblem, whose WPDSSolver only supports std::set.
 class IDELinearConstantAnalysis
     : public IDETabulationProblem<IDELinearConstantAnalysisDomain> {
 private:
   // For debug purpose only
-  static unsigned CurrGenConstantId;
-  static unsigned CurrLCAIDId;
-  static unsigned CurrBinaryId;
+  static std::atomic<unsigned> CurrGenConstantId;
+  static std::atomic<unsigned> CurrLCAIDId;
+  static std::atomic<unsigned> CurrBinaryId;
 
 public:
   using IDETabProblemType =
@@ -165,6 +169,8 @@ public:
 
     bool equal_to(std::shared_ptr<EdgeFunction<l_t>> other) const override;
 
+    size_t hash() const override;
+
     void print(std::ostream &OS, bool isForDebug = false) const override;
   };
 
@@ -208,6 +214,8 @@ public:
 
     bool equal_to(std::shared_ptr<EdgeFunction<l_t>> other) const override;
 
+    size_t hash() const override;
+
     void print(std::ostream &OS, bool isForDebug = false) const override;
   };
 
@@ -245,6 +253,8 @@ public:
 
   void emitTextReport(const SolverResults<n_t, d_t, l_t> &SR,
                       std::ostream &OS = std::cout) override;
+
+  [[nodiscard]] bool isThreadSafe() const override { return true; }
 };
 
 } // namespace psr
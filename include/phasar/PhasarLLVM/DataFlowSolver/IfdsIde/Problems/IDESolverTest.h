@@ -18,6 +18,7 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/Utils/SmallFactSet.h"
 
 namespace llvm {
 class Instruction;
@@ -36,12 +37,17 @@ struct IDESolverTestAnalysisDomain : public LLVMAnalysisDomainDefault {
   using l_t = const llvm::Value *;
 };
 
-class IDESolverTest : public IDETabulationProblem<IDESolverTestAnalysisDomain> {
+class IDESolverTest
+    : public IDETabulationProblem<
+          IDESolverTestAnalysisDomain,
+          SmallFactSet<IDESolverTestAnalysisDomain::d_t>> {
 private:
   std::vector<std::string> EntryPoints;
 
 public:
-  using IDETabProblemType = IDETabulationProblem<IDESolverTestAnalysisDomain>;
+  using IDETabProblemType =
+      IDETabulationProblem<IDESolverTestAnalysisDomain,
+                           SmallFactSet<IDESolverTestAnalysisDomain::d_t>>;
   using typename IDETabProblemType::d_t;
   using typename IDETabProblemType::f_t;
   using typename IDETabProblemType::i_t;
@@ -18,6 +18,7 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/Utils/SmallFactSet.h"
 
 // Forward declaration of types for which we only use its pointer or ref type
 namespace llvm {
@@ -60,7 +61,8 @@ struct IFDSLinearConstantAnalysisDomain : public LLVMAnalysisDomainDefault {
 };
 
 class IFDSLinearConstantAnalysis
-    : public IFDSTabulationProblem<IFDSLinearConstantAnalysisDomain> {
+    : public IFDSTabulationProblem<IFDSLinearConstantAnalysisDomain,
+                                   SmallFactSet<LCAPair>> {
 public:
   IFDSLinearConstantAnalysis(const ProjectIRDB *IRDB,
                              const LLVMTypeHierarchy *TH,
@@ -13,10 +13,12 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/TaintConfiguration.h"
+#include "phasar/Utils/SmallFactSet.h"
 
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -45,9 +47,13 @@ struct HasNoConfigurationType;
  * taint-sensitive source and sink functions.
  */
 class IFDSTaintAnalysis
-    : public IFDSTabulationProblem<LLVMAnalysisDomainDefault> {
+    : public IFDSTabulationProblem<
+          LLVMAnalysisDomainDefault,
+          SmallFactSet<LLVMAnalysisDomainDefault::d_t>> {
 private:
   const TaintConfiguration<const llvm::Value *> &SourceSinkFunctions;
+  // guards the leaks during a parallel tabulation
+  std::mutex LeaksMtx;
 
 public:
   // Setup the configuration type
@@ -96,6 +102,12 @@ public:
 
   void emitTextReport(const SolverResults<n_t, d_t, BinaryDomain> &SR,
                       std::ostream &OS = std::cout) override;
+
+  /// The flow functions query the points-to information, hence the problem
+  /// may only be tabulated in parallel if that is thread-safe.
+  [[nodiscard]] bool isThreadSafe() const override {
+    return PT && PT->isThreadSafe();
+  }
 };
 } // namespace psr
 
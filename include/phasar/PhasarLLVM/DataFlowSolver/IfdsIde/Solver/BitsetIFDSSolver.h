@@ -0,0 +1,439 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BITSETIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BITSETIFDSSOLVER_H_
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/ShardedCache.h"
+
+namespace psr {
+
+/**
+ * Solves an IFDS problem without going through IFDSToIDETabulationProblem.
+ * Since an IFDS problem has no edge functions to compose, the solver only
+ * keeps track of which facts are reachable: for each node and fact at the
+ * start point of the node's function (the context), the facts holding at the
+ * node are stored as a BitVectorSet, i.e. as a dense bit-set over the interned
+ * facts. Facts are propagated as sets, so that the path edges of a context are
+ * merged with word-wide operations, and the flow functions Identity, KillAll,
+ * Gen and Kill are applied to a whole set at once without calling
+ * computeTargets() for each fact.
+ *
+ * As no values are computed, the results are available right after the
+ * tabulation. Unlike IFDSSolver, the solver does not record the exploded
+ * super-graph and always tabulates sequentially.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class BitsetIFDSSolver {
+public:
+  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy, Container>;
+  using container_type = typename ProblemTy::container_type;
+  using FlowFunctionPtrType = typename ProblemTy::FlowFunctionPtrType;
+
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+
+  using FactSet = BitVectorSet<d_t>;
+
+private:
+  struct PathEdgeCell {
+    // all facts reached so far
+    FactSet Reached;
+    // the reached facts that have not been processed yet
+    FactSet Pending;
+    bool Queued = false;
+  };
+
+  using NodeFactKey = HashedKey<n_t, d_t>;
+
+  ProblemTy &Problem;
+  d_t ZeroValue;
+  const i_t *ICF;
+  IFDSIDESolverConfig &SolverConfig;
+  std::map<n_t, std::set<d_t>> InitialSeeds;
+
+  // node --> context --> facts
+  std::unordered_map<n_t, std::unordered_map<d_t, PathEdgeCell>> PathEdges;
+  std::vector<std::pair<n_t, d_t>> Worklist;
+  // <start point, context> --> exit node --> facts
+  std::unordered_map<NodeFactKey, std::unordered_map<n_t, FactSet>,
+                     typename NodeFactKey::Hasher>
+      EndSummaries;
+  // <start point, context> --> call site --> contexts of the caller
+  std::unordered_map<NodeFactKey, std::unordered_map<n_t, FactSet>,
+                     typename NodeFactKey::Hasher>
+      Incoming;
+
+  std::unordered_map<HashedKey<n_t, n_t>, FlowFunctionPtrType,
+                     typename HashedKey<n_t, n_t>::Hasher>
+      NormalFlowFunctions;
+  std::unordered_map<HashedKey<n_t, f_t>, FlowFunctionPtrType,
+                     typename HashedKey<n_t, f_t>::Hasher>
+      CallFlowFunctions;
+  std::unordered_map<HashedKey<n_t, f_t, n_t, n_t>, FlowFunctionPtrType,
+                     typename HashedKey<n_t, f_t, n_t, n_t>::Hasher>
+      ReturnFlowFunctions;
+  std::unordered_map<HashedKey<n_t, n_t>, FlowFunctionPtrType,
+                     typename HashedKey<n_t, n_t>::Hasher>
+      CallToRetFlowFunctions;
+
+  template <typename CacheTy, typename FactoryTy, typename... Ts>
+  static FlowFunctionPtrType getFlowFunction(CacheTy &Cache,
+                                             FactoryTy Factory, Ts... Args) {
+    auto [It, Inserted] = Cache.try_emplace(
+        typename CacheTy::key_type(Args...), nullptr);
+    if (Inserted) {
+      It->second = Factory(Args...);
+    }
+    return It->second;
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) {
+    return getFlowFunction(
+        NormalFlowFunctions,
+        [this](n_t Curr, n_t Succ) {
+          return Problem.getNormalFlowFunction(Curr, Succ);
+        },
+        Curr, Succ);
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t Callee) {
+    return getFlowFunction(
+        CallFlowFunctions,
+        [this](n_t CallSite, f_t Callee) {
+          return Problem.getCallFlowFunction(CallSite, Callee);
+        },
+        CallSite, Callee);
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t Callee,
+                                         n_t ExitStmt, n_t RetSite) {
+    return getFlowFunction(
+        ReturnFlowFunctions,
+        [this](n_t CallSite, f_t Callee, n_t ExitStmt, n_t RetSite) {
+          return Problem.getRetFlowFunction(CallSite, Callee, ExitStmt,
+                                            RetSite);
+        },
+        CallSite, Callee, ExitStmt, RetSite);
+  }
+
+  // the callees are determined by the call site, they are not part of the key
+  // and only copied into a set if the flow function has to be constructed
+  template <typename CalleesTy>
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                                               const CalleesTy &Callees) {
+    return getFlowFunction(
+        CallToRetFlowFunctions,
+        [this, &Callees](n_t CallSite, n_t RetSite) {
+          return Problem.getCallToRetFlowFunction(
+              CallSite, RetSite,
+              std::set<f_t>(std::begin(Callees), std::end(Callees)));
+        },
+        CallSite, RetSite);
+  }
+
+  /// Applies the flow function to all facts of Sources. If AddZero is set,
+  /// the zero value is kept alive, which corresponds to the ZeroedFlowFunction
+  /// the IDESolver wraps its flow functions in if autoAddZero() is set.
+  FactSet applyFlowFunction(const FlowFunctionPtrType &Function,
+                            const FactSet &Sources, bool AddZero) {
+    PAMM_GET_INSTANCE;
+    FactSet Targets;
+    auto *F = Function.get();
+    if (dynamic_cast<Identity<d_t, Container> *>(F)) {
+      Targets = Sources;
+    } else if (dynamic_cast<KillAll<d_t, Container> *>(F)) {
+      // nothing survives
+    } else if (auto *G = dynamic_cast<Gen<d_t, Container> *>(F)) {
+      Targets = Sources;
+      if (Sources.count(G->getZeroValue())) {
+        Targets.insert(G->getGenValue());
+      }
+    } else if (auto *K = dynamic_cast<Kill<d_t, Container> *>(F)) {
+      Targets = Sources;
+      Targets.erase(K->getKillValue());
+    } else {
+      // interning a new fact may invalidate the iterators of Sources
+      container_type AllTargets;
+      for (d_t Source : Sources) {
+        container_type SourceTargets = Function->computeTargets(Source);
+        AllTargets.insert(SourceTargets.begin(), SourceTargets.end());
+      }
+      Targets.insert(AllTargets.begin(), AllTargets.end());
+      INC_COUNTER("Bitset-IFDS Per-Fact FF Application", 1,
+                  PAMM_SEVERITY_LEVEL::Full);
+    }
+    if (AddZero && Sources.count(ZeroValue)) {
+      Targets.insert(ZeroValue);
+    }
+    INC_COUNTER("Bitset-IFDS FF Application", 1, PAMM_SEVERITY_LEVEL::Full);
+    return Targets;
+  }
+
+  FactSet applyFlowFunction(const FlowFunctionPtrType &Function,
+                            const FactSet &Sources) {
+    return applyFlowFunction(Function, Sources, SolverConfig.autoAddZero());
+  }
+
+  /// Adds the path edges <start point, Context> --> <N, d> for all d in Facts
+  /// and schedules the facts that have not been reached before.
+  void propagate(d_t Context, n_t N, const FactSet &Facts) {
+    PAMM_GET_INSTANCE;
+    PathEdgeCell &Cell = PathEdges[N][Context];
+    FactSet New = Facts.setDifference(Cell.Reached);
+    if (New.empty()) {
+      return;
+    }
+    INC_COUNTER("Bitset-IFDS Path Edges", New.size(),
+                PAMM_SEVERITY_LEVEL::Full);
+    Cell.Reached.insert(New);
+    Cell.Pending.insert(New);
+    if (!Cell.Queued) {
+      Cell.Queued = true;
+      Worklist.emplace_back(N, Context);
+    }
+  }
+
+  void processWorklist() {
+    while (!Worklist.empty()) {
+      auto [N, Context] = Worklist.back();
+      Worklist.pop_back();
+      PathEdgeCell &Cell = PathEdges[N][Context];
+      FactSet Facts;
+      std::swap(Facts, Cell.Pending);
+      Cell.Queued = false;
+      if (!ICF->isCallStmt(N)) {
+        if (ICF->isExitStmt(N)) {
+          processExit(Context, N, Facts);
+        }
+        if (!succsOf(*ICF, N).empty()) {
+          processNormalFlow(Context, N, Facts);
+        }
+      } else {
+        processCall(Context, N, Facts);
+      }
+    }
+  }
+
+  void processCall(d_t Context, n_t N, const FactSet &Facts) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process call at target: " << Problem.NtoString(N));
+    const std::set<n_t> ReturnSites = ICF->getReturnSitesOfCallAt(N);
+    const auto Callees = calleesOfCallAt(*ICF, N);
+    for (f_t Callee : Callees) {
+      if (FlowFunctionPtrType SpecialSum =
+              Problem.getSummaryFlowFunction(N, Callee)) {
+        FactSet Targets = applyFlowFunction(SpecialSum, Facts, false);
+        for (n_t RetSite : ReturnSites) {
+          propagate(Context, RetSite, Targets);
+        }
+        continue;
+      }
+      // the return flow functions may intern new facts, which invalidates
+      // the iterators of a FactSet, so the contexts are copied beforehand
+      std::vector<d_t> CalleeContexts;
+      for (d_t CalleeContext :
+           applyFlowFunction(getCallFlowFunction(N, Callee), Facts)) {
+        CalleeContexts.push_back(CalleeContext);
+      }
+      for (n_t SP : startPointsOf(*ICF, Callee)) {
+        for (d_t CalleeContext : CalleeContexts) {
+          propagate(CalleeContext, SP, FactSet({CalleeContext}));
+          NodeFactKey Key(SP, CalleeContext);
+          FactSet &Callers = Incoming[Key][N];
+          if (Callers.count(Context)) {
+            // the end summaries have been applied to this context before
+            continue;
+          }
+          Callers.insert(Context);
+          auto Search = EndSummaries.find(Key);
+          if (Search == EndSummaries.end()) {
+            continue;
+          }
+          for (const auto &[EP, ExitFacts] : Search->second) {
+            for (n_t RetSite : ReturnSites) {
+              propagate(Context, RetSite,
+                        applyFlowFunction(
+                            getRetFlowFunction(N, Callee, EP, RetSite),
+                            ExitFacts));
+            }
+          }
+        }
+      }
+    }
+    if (Callees.empty()) {
+      return;
+    }
+    for (n_t RetSite : ReturnSites) {
+      propagate(Context, RetSite,
+                applyFlowFunction(
+                    getCallToRetFlowFunction(N, RetSite, Callees), Facts));
+    }
+  }
+
+  void processNormalFlow(d_t Context, n_t N, const FactSet &Facts) {
+    for (n_t Succ : succsOf(*ICF, N)) {
+      propagate(Context, Succ,
+                applyFlowFunction(getNormalFlowFunction(N, Succ), Facts));
+    }
+  }
+
+  void processExit(d_t Context, n_t N, const FactSet &Facts) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process exit at target: " << Problem.NtoString(N));
+    f_t Callee = ICF->getFunctionOf(N);
+    bool HasIncoming = false;
+    for (n_t SP : startPointsOf(*ICF, Callee)) {
+      NodeFactKey Key(SP, Context);
+      EndSummaries[Key][N].insert(Facts);
+      auto Search = Incoming.find(Key);
+      if (Search == Incoming.end()) {
+        continue;
+      }
+      for (const auto &[CallSite, Callers] : Search->second) {
+        HasIncoming = true;
+        for (n_t RetSite : ICF->getReturnSitesOfCallAt(CallSite)) {
+          FactSet Targets = applyFlowFunction(
+              getRetFlowFunction(CallSite, Callee, N, RetSite), Facts);
+          for (d_t CallerContext : Callers) {
+            propagate(CallerContext, RetSite, Targets);
+          }
+        }
+      }
+    }
+    // unbalanced returns, see IDESolver::processExit()
+    if (!SolverConfig.followReturnsPastSeeds() || HasIncoming ||
+        !Problem.isZeroValue(Context)) {
+      return;
+    }
+    const auto CallSites = callersOf(*ICF, Callee);
+    for (n_t CallSite : CallSites) {
+      for (n_t RetSite : ICF->getReturnSitesOfCallAt(CallSite)) {
+        propagate(ZeroValue, RetSite,
+                  applyFlowFunction(
+                      getRetFlowFunction(CallSite, Callee, N, RetSite),
+                      Facts));
+      }
+    }
+    if (CallSites.empty()) {
+      applyFlowFunction(getRetFlowFunction(nullptr, Callee, N, nullptr),
+                        Facts);
+    }
+  }
+
+public:
+  BitsetIFDSSolver(ProblemTy &Problem)
+      : Problem(Problem), ZeroValue(Problem.getZeroValue()),
+        ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
+        InitialSeeds(Problem.initialSeeds()) {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Bitset-IFDS Path Edges", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Bitset-IFDS FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Bitset-IFDS Per-Fact FF Application", 0,
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  BitsetIFDSSolver(const BitsetIFDSSolver &) = delete;
+  BitsetIFDSSolver &operator=(const BitsetIFDSSolver &) = delete;
+  BitsetIFDSSolver(BitsetIFDSSolver &&) = delete;
+  BitsetIFDSSolver &operator=(BitsetIFDSSolver &&) = delete;
+  virtual ~BitsetIFDSSolver() = default;
+
+  /**
+   * @brief Runs the solver on the configured problem. This can take some time.
+   */
+  virtual void solve() {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Bitset IFDS solver is solving the specified problem");
+    for (const auto &[StartPoint, Facts] : InitialSeeds) {
+      FactSet Seeds(Facts.begin(), Facts.end());
+      Seeds.insert(ZeroValue);
+      propagate(ZeroValue, StartPoint, Seeds);
+    }
+    processWorklist();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Problem solved");
+  }
+
+  /// Returns the facts that hold at the given statement in any context,
+  /// including the zero value, as IFDSSolver::ifdsResultsAt() does.
+  [[nodiscard]] std::set<d_t> ifdsResultsAt(n_t Stmt) const {
+    std::set<d_t> Results;
+    auto Search = PathEdges.find(Stmt);
+    if (Search == PathEdges.end()) {
+      return Results;
+    }
+    for (const auto &[Context, Cell] : Search->second) {
+      Results.insert(Cell.Reached.begin(), Cell.Reached.end());
+    }
+    return Results;
+  }
+
+  /// Returns the facts that hold at the given statement in the given context.
+  [[nodiscard]] FactSet ifdsResultsAt(n_t Stmt, d_t Context) const {
+    auto Search = PathEdges.find(Stmt);
+    if (Search == PathEdges.end()) {
+      return {};
+    }
+    auto CellSearch = Search->second.find(Context);
+    if (CellSearch == Search->second.end()) {
+      return {};
+    }
+    return CellSearch->second.Reached;
+  }
+
+  virtual void dumpResults(std::ostream &OS = std::cout) {
+    OS << "\n***************************************************************\n"
+       << "*                  Raw BitsetIFDSSolver results                 *\n"
+       << "***************************************************************\n";
+    std::map<n_t, std::set<d_t>> Results;
+    for (const auto &[N, Cells] : PathEdges) {
+      Results[N] = ifdsResultsAt(N);
+    }
+    for (const auto &[N, Facts] : Results) {
+      OS << "N: " << Problem.NtoString(N) << '\n';
+      for (d_t D : Facts) {
+        OS << "\tD: " << Problem.DtoString(D) << '\n';
+      }
+    }
+  }
+};
+
+template <typename Problem>
+BitsetIFDSSolver(Problem &)
+    -> BitsetIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                        typename Problem::container_type>;
+
+template <typename Problem>
+using BitsetIFDSSolver_P =
+    BitsetIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                     typename Problem::container_type>;
+
+} // namespace psr
+
+#endif
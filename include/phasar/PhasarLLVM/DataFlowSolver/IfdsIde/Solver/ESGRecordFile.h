@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_ESGRECORDFILE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_ESGRECORDFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "phasar/Utils/Interner.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * An append-only file to which the IDESolver streams the path edges and
+ * intermediate edge functions it records for the exploded super-graph (ESG),
+ * so that they do not have to be kept in memory while the problem is solved.
+ * Only the nodes and facts themselves are kept in memory; they are interned
+ * to 32-bit IDs which the records refer to.
+ *
+ * The file consists of records of the following form, all integers are
+ * stored in native byte order:
+ *
+ *   Kind:u8 Source:u32 Sink:u32 SourceVal:u32 NumDestVals:u32 DestVal:u32*
+ *     for the path edges of a single saveEdges() call (Kind is
+ *     IntraPathEdges or InterPathEdges), and
+ *   Kind:u8 N1:u32 D1:u32 N2:u32 D2:u32 LabelSize:u32 Label:char*
+ *     for the edge function of the ESG edge <N1, D1> --> <N2, D2>.
+ *
+ * As the IDs are only meaningful to the ESGRecordFile that has written them,
+ * a file can only be read back by the same instance.
+ */
+template <typename n_t, typename d_t> class ESGRecordFile {
+public:
+  template <typename ContainerTy>
+  using PathEdgeTable = Table<n_t, n_t, std::map<d_t, ContainerTy>>;
+
+private:
+  using IdTy = uint32_t;
+
+  enum class RecordKind : uint8_t {
+    IntraPathEdges,
+    InterPathEdges,
+    EdgeFunction
+  };
+
+  std::string Path;
+  std::ofstream OFS;
+  Interner<n_t> Nodes;
+  Interner<d_t> Facts;
+  size_t NumRecords = 0;
+
+  void write(IdTy Val) {
+    OFS.write(reinterpret_cast<const char *>(&Val), sizeof(Val));
+  }
+
+  void write(RecordKind Kind) {
+    OFS.write(reinterpret_cast<const char *>(&Kind), sizeof(Kind));
+  }
+
+  void checkRecord(const std::ifstream &IFS) const {
+    if (!IFS) {
+      throw std::ios_base::failure("truncated ESG record in file: " + Path);
+    }
+  }
+
+  template <typename T> static bool read(std::ifstream &IFS, T &Val) {
+    return static_cast<bool>(
+        IFS.read(reinterpret_cast<char *>(&Val), sizeof(Val)));
+  }
+
+public:
+  explicit ESGRecordFile(std::string Path)
+      : Path(std::move(Path)),
+        OFS(this->Path, std::ios::binary | std::ios::trunc) {
+    if (!OFS.is_open()) {
+      throw std::ios_base::failure("could not write file: " + this->Path);
+    }
+  }
+
+  ESGRecordFile(const ESGRecordFile &) = delete;
+  ESGRecordFile &operator=(const ESGRecordFile &) = delete;
+  ESGRecordFile(ESGRecordFile &&) = delete;
+  ESGRecordFile &operator=(ESGRecordFile &&) = delete;
+  ~ESGRecordFile() = default;
+
+  /// Appends the path edges <Source, SourceVal> --> <Sink, d> for all d in
+  /// DestVals.
+  template <typename ContainerTy>
+  void recordPathEdges(n_t Source, n_t Sink, d_t SourceVal,
+                       const ContainerTy &DestVals, bool InterP) {
+    write(InterP ? RecordKind::InterPathEdges : RecordKind::IntraPathEdges);
+    write(Nodes.getOrCreateId(Source));
+    write(Nodes.getOrCreateId(Sink));
+    write(Facts.getOrCreateId(SourceVal));
+    write(static_cast<IdTy>(DestVals.size()));
+    for (const auto &DestVal : DestVals) {
+      write(Facts.getOrCreateId(DestVal));
+    }
+    ++NumRecords;
+  }
+
+  /// Appends the label of an edge function of the ESG edge
+  /// <N1, D1> --> <N2, D2>.
+  void recordEdgeFunction(n_t N1, d_t D1, n_t N2, d_t D2,
+                          llvm::StringRef Label) {
+    write(RecordKind::EdgeFunction);
+    write(Nodes.getOrCreateId(N1));
+    write(Facts.getOrCreateId(D1));
+    write(Nodes.getOrCreateId(N2));
+    write(Facts.getOrCreateId(D2));
+    write(static_cast<IdTy>(Label.size()));
+    OFS.write(Label.data(), Label.size());
+    ++NumRecords;
+  }
+
+  /// Reads the recorded path edges back into tables of the same shape as the
+  /// ones the IDESolver keeps if the edges are recorded in memory.
+  template <typename ContainerTy>
+  void readPathEdges(PathEdgeTable<ContainerTy> &IntraPathEdges,
+                     PathEdgeTable<ContainerTy> &InterPathEdges) {
+    forEachRecord(
+        [&](bool InterP, n_t Source, n_t Sink, d_t SourceVal,
+            const auto &DestVals) {
+          auto &DestSet = (InterP ? InterPathEdges : IntraPathEdges)
+                              .get(Source, Sink)[SourceVal];
+          for (d_t DestVal : DestVals) {
+            DestSet.insert(DestVal);
+          }
+        },
+        [](n_t, d_t, n_t, d_t, llvm::StringRef) {});
+  }
+
+  /// Returns all facts that occur in the recorded path edges and edge
+  /// functions.
+  [[nodiscard]] std::set<d_t> getRecordedFacts() const {
+    std::set<d_t> RecordedFacts;
+    for (IdTy Id = 0; Id < Facts.size(); ++Id) {
+      RecordedFacts.insert(Facts.getValue(Id));
+    }
+    return RecordedFacts;
+  }
+
+  /**
+   * Reads all records of the file in a single pass, in the order in which
+   * they have been written, and hands them to the given handlers:
+   *
+   *   OnPathEdges(InterP, Source, Sink, SourceVal, DestVals)
+   *     for the path edges of a single recordPathEdges() call, DestVals is a
+   *     range of facts that is only valid during the call, and
+   *   OnEdgeFunction(N1, D1, N2, D2, Label)
+   *     for the label of a recorded edge function.
+   *
+   * The same path edges may be recorded several times.
+   */
+  template <typename PathEdgesHandlerTy, typename EdgeFunctionHandlerTy>
+  void forEachRecord(PathEdgesHandlerTy OnPathEdges,
+                     EdgeFunctionHandlerTy OnEdgeFunction) {
+    OFS.flush();
+    std::ifstream IFS(Path, std::ios::binary);
+    if (!IFS.is_open()) {
+      throw std::ios_base::failure("could not read file: " + Path);
+    }
+    std::vector<IdTy> DestVals;
+    std::string Label;
+    RecordKind Kind;
+    while (read(IFS, Kind)) {
+      IdTy N1;
+      IdTy N2;
+      IdTy D1;
+      if (Kind == RecordKind::EdgeFunction) {
+        IdTy D2;
+        IdTy LabelSize;
+        read(IFS, N1);
+        read(IFS, D1);
+        read(IFS, N2);
+        read(IFS, D2);
+        read(IFS, LabelSize);
+        Label.resize(LabelSize);
+        IFS.read(Label.data(), LabelSize);
+        checkRecord(IFS);
+        OnEdgeFunction(Nodes.getValue(N1), Facts.getValue(D1),
+                       Nodes.getValue(N2), Facts.getValue(D2),
+                       llvm::StringRef(Label));
+      } else {
+        IdTy NumDestVals;
+        read(IFS, N1);
+        read(IFS, N2);
+        read(IFS, D1);
+        read(IFS, NumDestVals);
+        DestVals.resize(NumDestVals);
+        IFS.read(reinterpret_cast<char *>(DestVals.data()),
+                 NumDestVals * sizeof(IdTy));
+        checkRecord(IFS);
+        OnPathEdges(Kind == RecordKind::InterPathEdges, Nodes.getValue(N1),
+                    Nodes.getValue(N2), Facts.getValue(D1),
+                    llvm::map_range(llvm::ArrayRef<IdTy>(DestVals),
+                                    [this](IdTy DestVal) {
+                                      return Facts.getValue(DestVal);
+                                    }));
+      }
+    }
+  }
+
+  void flush() { OFS.flush(); }
+
+  [[nodiscard]] const std::string &getPath() const { return Path; }
+
+  [[nodiscard]] size_t getNumRecords() const { return NumRecords; }
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FLATJUMPFUNCTIONSSTORAGE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FLATJUMPFUNCTIONSSTORAGE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctionsStorage.h"
+#include "phasar/Utils/Interner.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * Stores the jump functions in flat tables. Nodes and facts are interned to
+ * dense 32-bit IDs, so that the reverse and forward indexes become single
+ * open-addressing hash maps keyed by a pair of IDs. The lists of facts and
+ * edge functions they refer to are stored contiguously. In contrast to
+ * NestedJumpFunctionsStorage, the records for a target node are not stored
+ * a third time, but are reconstructed from the reverse index on demand.
+ */
+template <typename AnalysisDomainTy>
+class FlatJumpFunctionsStorage : public JumpFunctionsStorage<AnalysisDomainTy> {
+public:
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::d_t;
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::n_t;
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::EdgeFunctionPtrType;
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::EntryList;
+
+private:
+  using IdTy = uint32_t;
+
+  // The default hash of 64-bit integers ignores the upper half of the key,
+  // which holds the first ID, so the keys are hashed as pairs of IDs.
+  struct KeyInfo : llvm::DenseMapInfo<uint64_t> {
+    static unsigned getHashValue(uint64_t Key) {
+      return llvm::DenseMapInfo<std::pair<IdTy, IdTy>>::getHashValue(
+          {getHi(Key), getLo(Key)});
+    }
+  };
+  using IndexTy = llvm::DenseMap<uint64_t, IdTy, KeyInfo>;
+
+  Interner<n_t> Nodes;
+  Interner<d_t> Facts;
+  // map (target node, target value) to the index of the list of source values
+  // and edge functions in Entries
+  IndexTy ReverseIndex;
+  // map (source value, target node) to the index of the list of target values
+  // and edge functions in Entries
+  IndexTy ForwardIndex;
+  // a deque does not move its elements when it grows, references to the
+  // lists thus remain valid
+  std::deque<EntryList> Entries;
+  // the target values that have jump functions, indexed by target node
+  std::vector<llvm::SmallVector<IdTy, 2>> TargetValsOfNode;
+
+  static uint64_t makeKey(IdTy Hi, IdTy Lo) {
+    // the two largest keys are reserved by llvm::DenseMap
+    assert(Hi < std::numeric_limits<IdTy>::max() - 1 &&
+           Lo < std::numeric_limits<IdTy>::max() - 1 && "Too many IDs!");
+    return (uint64_t(Hi) << 32U) | Lo;
+  }
+
+  static IdTy getHi(uint64_t Key) { return IdTy(Key >> 32U); }
+
+  static IdTy getLo(uint64_t Key) { return IdTy(Key); }
+
+  // Returns the list that the given key refers to and creates it if required.
+  EntryList &getOrCreateEntries(IndexTy &Index, uint64_t Key) {
+    auto [It, Inserted] = Index.try_emplace(Key, IdTy(Entries.size()));
+    if (Inserted) {
+      Entries.emplace_back();
+    }
+    return Entries[It->second];
+  }
+
+  EntryList *lookup(const IndexTy &Index, uint64_t Key) {
+    if (auto Search = Index.find(Key); Search != Index.end()) {
+      auto &List = Entries[Search->second];
+      return List.empty() ? nullptr : &List;
+    }
+    return nullptr;
+  }
+
+public:
+  void addFunction(d_t sourceVal, n_t target, d_t targetVal,
+                   EdgeFunctionPtrType function) override {
+    IdTy N = Nodes.getOrCreateId(target);
+    IdTy S = Facts.getOrCreateId(sourceVal);
+    IdTy T = Facts.getOrCreateId(targetVal);
+    auto &SourceValToFunc = getOrCreateEntries(ReverseIndex, makeKey(N, T));
+    if (SourceValToFunc.empty()) {
+      if (N >= TargetValsOfNode.size()) {
+        TargetValsOfNode.resize(N + 1);
+      }
+      TargetValsOfNode[N].push_back(T);
+    }
+    this->setEntry(SourceValToFunc, sourceVal, function);
+    auto &TargetValToFunc = getOrCreateEntries(ForwardIndex, makeKey(S, N));
+    this->setEntry(TargetValToFunc, targetVal, std::move(function));
+  }
+
+  EntryList *reverseLookup(n_t target, d_t targetVal) override {
+    auto N = Nodes.getId(target);
+    auto T = Facts.getId(targetVal);
+    if (!N || !T) {
+      return nullptr;
+    }
+    return lookup(ReverseIndex, makeKey(*N, *T));
+  }
+
+  EntryList *forwardLookup(d_t sourceVal, n_t target) override {
+    auto S = Facts.getId(sourceVal);
+    auto N = Nodes.getId(target);
+    if (!S || !N) {
+      return nullptr;
+    }
+    return lookup(ForwardIndex, makeKey(*S, *N));
+  }
+
+  [[nodiscard]] Table<d_t, d_t, EdgeFunctionPtrType>
+  lookupByTarget(n_t target) const override {
+    Table<d_t, d_t, EdgeFunctionPtrType> Result;
+    auto N = Nodes.getId(target);
+    if (!N || *N >= TargetValsOfNode.size()) {
+      return Result;
+    }
+    for (IdTy T : TargetValsOfNode[*N]) {
+      const auto &SourceValToFunc =
+          Entries[ReverseIndex.find(makeKey(*N, T))->second];
+      for (const auto &[SourceVal, Function] : SourceValToFunc) {
+        Result.insert(SourceVal, Facts.getValue(T), Function);
+      }
+    }
+    return Result;
+  }
+
+  bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) override {
+    auto N = Nodes.getId(target);
+    auto S = Facts.getId(sourceVal);
+    auto T = Facts.getId(targetVal);
+    if (!N || !S || !T) {
+      return false;
+    }
+    bool Removed = false;
+    if (auto *SourceValToFunc = lookup(ReverseIndex, makeKey(*N, *T))) {
+      Removed = this->eraseEntry(*SourceValToFunc, sourceVal);
+      if (SourceValToFunc->empty()) {
+        auto &TargetVals = TargetValsOfNode[*N];
+        TargetVals.erase(std::find(TargetVals.begin(), TargetVals.end(), *T));
+      }
+    }
+    if (auto *TargetValToFunc = lookup(ForwardIndex, makeKey(*S, *N))) {
+      this->eraseEntry(*TargetValToFunc, targetVal);
+    }
+    return Removed;
+  }
+
+  size_t removeFunctionsAt(n_t target) override {
+    auto N = Nodes.getId(target);
+    if (!N || *N >= TargetValsOfNode.size()) {
+      return 0;
+    }
+    size_t NumRemoved = 0;
+    for (IdTy T : TargetValsOfNode[*N]) {
+      auto &SourceValToFunc =
+          Entries[ReverseIndex.find(makeKey(*N, T))->second];
+      for (const auto &Entry : SourceValToFunc) {
+        // all target values of this source value at target are removed; the
+        // index entries are kept, so that the lists can be reused
+        IdTy S = *Facts.getId(Entry.first);
+        Entries[ForwardIndex.find(makeKey(S, *N))->second] = EntryList();
+      }
+      NumRemoved += SourceValToFunc.size();
+      SourceValToFunc = EntryList();
+    }
+    TargetValsOfNode[*N] = {};
+    return NumRemoved;
+  }
+
+  void clear() override {
+    Nodes.clear();
+    Facts.clear();
+    ReverseIndex.clear();
+    ForwardIndex.clear();
+    Entries.clear();
+    TargetValsOfNode.clear();
+  }
+
+  void visitReverseLookup(llvm::function_ref<void(n_t, d_t, const EntryList &)>
+                              Visitor) const override {
+    for (const auto &[Key, Idx] : ReverseIndex) {
+      if (!Entries[Idx].empty()) {
+        Visitor(Nodes.getValue(getHi(Key)), Facts.getValue(getLo(Key)),
+                Entries[Idx]);
+      }
+    }
+  }
+
+  void visitForwardLookup(llvm::function_ref<void(d_t, n_t, const EntryList &)>
+                              Visitor) const override {
+    for (const auto &[Key, Idx] : ForwardIndex) {
+      if (!Entries[Idx].empty()) {
+        Visitor(Facts.getValue(getHi(Key)), Nodes.getValue(getLo(Key)),
+                Entries[Idx]);
+      }
+    }
+  }
+
+  void visitTargets(llvm::function_ref<void(n_t)> Visitor) const override {
+    for (IdTy N = 0; N < TargetValsOfNode.size(); ++N) {
+      if (!TargetValsOfNode[N].empty()) {
+        Visitor(Nodes.getValue(N));
+      }
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -17,24 +17,33 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionInterner.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
@@ -42,17 +51,20 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGRecordFile.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JoinHandlingNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LinkedNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/DOTGraph.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Table.h"
+#include "phasar/Utils/WorkStealingPool.h"
 
 namespace psr {
 
@@ -104,9 +116,17 @@ public:
   IDESolver(IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()),
         ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
-        cachedFlowEdgeFunctions(Problem), allTop(Problem.allTopFunction()),
+        NumThreads(getNumSolverThreads(Problem, SolverConfig)),
+        EFInterner(makeEdgeFunctionInterner()),
+        cachedFlowEdgeFunctions(Problem, getNumShards(),
+                                SolverConfig.cacheCapacity()),
+        allTop(internEdgeFunction(Problem.allTopFunction())),
         jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            allTop, IDEProblem)),
+            allTop, IDEProblem, getNumShards(),
+            SolverConfig.jumpFunctionsKind())),
+        JumpFnMutexes(getNumShards()), ESGRecords(makeESGRecordFile()),
+        endsummarytab(getNumShards()), incomingtab(getNumShards()),
+        SummaryMutexes(getNumShards()),
         initialSeeds(Problem.initialSeeds()) {}
 
   IDESolver(const IDESolver &) = delete;
@@ -163,6 +183,10 @@ public:
     REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Worklist Pushes", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Worklist Peak Size", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Collected JumpFn", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Retabulated Procedures", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
@@ -282,7 +306,11 @@ public:
 
   void dumpAllInterPathEdges() {
     std::cout << "COMPUTED INTER PATH EDGES" << std::endl;
-    auto interpe = this->computedInterPathEdges.cellSet();
+    // only filled if the path edges have been streamed to disk
+    std::pair<PathEdgeTable, PathEdgeTable> StreamedPathEdges;
+    auto [IntraPathEdges, InterPathEdges] =
+        getRecordedPathEdges(StreamedPathEdges);
+    auto interpe = InterPathEdges.cellSet();
     for (const auto &cell : interpe) {
       std::cout << "FROM" << std::endl;
       IDEProblem.printNode(std::cout, cell.getRowKey());
@@ -302,7 +330,11 @@ public:
 
   void dumpAllIntraPathEdges() {
     std::cout << "COMPUTED INTRA PATH EDGES" << std::endl;
-    auto intrape = this->computedIntraPathEdges.cellSet();
+    // only filled if the path edges have been streamed to disk
+    std::pair<PathEdgeTable, PathEdgeTable> StreamedPathEdges;
+    auto [IntraPathEdges, InterPathEdges] =
+        getRecordedPathEdges(StreamedPathEdges);
+    auto intrape = IntraPathEdges.cellSet();
     for (auto &cell : intrape) {
       std::cout << "FROM" << std::endl;
       IDEProblem.printNode(std::cout, cell.getRowKey());
@@ -331,28 +363,73 @@ protected:
   d_t ZeroValue;
   const i_t *ICF;
   IFDSIDESolverConfig &SolverConfig;
-  unsigned PathEdgeCount = 0;
+  // number of threads that solve the problem in phase I and II
+  unsigned NumThreads;
+  // the shared tables are split into this many shards per thread to keep
+  // lock contention low
+  static constexpr unsigned ShardsPerThread = 16;
+  std::atomic<unsigned> PathEdgeCount{0};
+  // hash-conses the edge functions of this solver run if enabled, nullptr
+  // otherwise
+  std::unique_ptr<EdgeFunctionInterner<l_t>> EFInterner;
 
   FlowEdgeFunctionCache<AnalysisDomainTy, Container> cachedFlowEdgeFunctions;
 
-  Table<n_t, n_t, std::map<d_t, Container>> computedIntraPathEdges;
+  using PathEdgeTable = Table<n_t, n_t, std::map<d_t, Container>>;
 
-  Table<n_t, n_t, std::map<d_t, Container>> computedInterPathEdges;
+  PathEdgeTable computedIntraPathEdges;
+
+  PathEdgeTable computedInterPathEdges;
 
   EdgeFunctionPtrType allTop;
 
   std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> jumpFn;
 
+  // one mutex per shard of the jump functions
+  std::vector<std::mutex> JumpFnMutexes;
+
+  // path edges that still have to be processed in phase I
+  std::unique_ptr<PathEdgeWorklist<n_t, d_t>> Worklist;
+  // used instead of Worklist if the problem is tabulated in parallel
+  std::unique_ptr<WorkStealingPool<PathEdge<n_t, d_t>>> ParallelWorklist;
+  size_t WorklistPeakSize = 0;
+
+  // the jump functions of procedures that are done are only collected by the
+  // sequential solver in phase I, see collectJumpFunctions()
+  bool CollectJumpFunctions =
+      SolverConfig.collectJumpFunctions() && NumThreads == 1;
+  // number of path edges per procedure that are scheduled but not processed
+  std::unordered_map<f_t, size_t> PendingEdgesOf;
+  // procedures that have no pending path edges and have not been collected
+  // since
+  std::unordered_set<f_t> CollectionCandidates;
+  // procedures whose jump functions have been collected at least once
+  std::unordered_set<f_t> CollectedProcedures;
+  size_t EdgesSinceCollection = 0;
+  static constexpr size_t CollectionInterval = 1024;
+
   std::map<std::tuple<n_t, d_t, n_t, d_t>, std::vector<EdgeFunctionPtrType>>
       intermediateEdgeFunctions;
 
-  // stores summaries that were queried before they were computed
+  // if set, the recorded path edges and intermediate edge functions are
+  // streamed to this file rather than being stored in the tables above
+  std::unique_ptr<ESGRecordFile<n_t, d_t>> ESGRecords;
+
+  // stores summaries that were queried before they were computed; the table
+  // is sharded by <sP, d> (see summaryShardIndex())
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<n_t, d_t, Table<n_t, d_t, EdgeFunctionPtrType>> endsummarytab;
+  std::vector<Table<n_t, d_t, Table<n_t, d_t, EdgeFunctionPtrType>>>
+      endsummarytab;
 
-  // edges going along calls
+  // edges going along calls; sharded in the same way as endsummarytab
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<n_t, d_t, std::map<n_t, Container>> incomingtab;
+  std::vector<Table<n_t, d_t, std::map<n_t, Container>>> incomingtab;
+
+  // one mutex per shard of endsummarytab and incomingtab
+  std::vector<std::mutex> SummaryMutexes;
+
+  // guards the remaining bookkeeping tables during a parallel tabulation
+  std::mutex BookkeepingMutex;
 
   // stores the return sites (inside callers) to which we have unbalanced
   // returns if SolverConfig.followReturnPastSeeds is enabled
@@ -379,12 +456,201 @@ protected:
         IDEProblem(*this->TransformedProblem),
         ZeroValue(IDEProblem.getZeroValue()), ICF(IDEProblem.getICFG()),
         SolverConfig(IDEProblem.getIFDSIDESolverConfig()),
-        cachedFlowEdgeFunctions(IDEProblem),
-        allTop(IDEProblem.allTopFunction()),
+        NumThreads(getNumSolverThreads(IDEProblem, SolverConfig)),
+        EFInterner(makeEdgeFunctionInterner()),
+        cachedFlowEdgeFunctions(IDEProblem, getNumShards(),
+                                SolverConfig.cacheCapacity()),
+        allTop(internEdgeFunction(IDEProblem.allTopFunction())),
         jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            allTop, IDEProblem)),
+            allTop, IDEProblem, getNumShards(),
+            SolverConfig.jumpFunctionsKind())),
+        JumpFnMutexes(getNumShards()), ESGRecords(makeESGRecordFile()),
+        endsummarytab(getNumShards()), incomingtab(getNumShards()),
+        SummaryMutexes(getNumShards()),
         initialSeeds(IDEProblem.initialSeeds()) {}
 
+  /**
+   * Returns the number of threads that solve the problem in phase I and II.
+   * The problem is only solved in parallel if it declares itself thread-safe.
+   * As the logger is not thread-safe, we also fall back to the sequential
+   * solver whenever logging is enabled.
+   */
+  static unsigned getNumSolverThreads(const ProblemTy &Problem,
+                                      const IFDSIDESolverConfig &Config) {
+    if (Config.numThreads() <= 1 || !Problem.isThreadSafe()) {
+      return 1;
+    }
+#ifdef DYNAMIC_LOG
+    if (boost::log::core::get()->get_logging_enabled()) {
+      return 1;
+    }
+#endif
+    return Config.numThreads();
+  }
+
+  [[nodiscard]] size_t getNumShards() const {
+    return NumThreads == 1 ? 1 : size_t(NumThreads) * ShardsPerThread;
+  }
+
+  [[nodiscard]] std::unique_ptr<EdgeFunctionInterner<l_t>>
+  makeEdgeFunctionInterner() const {
+    if (!SolverConfig.internEdgeFunctions()) {
+      return nullptr;
+    }
+    return std::make_unique<EdgeFunctionInterner<l_t>>(getNumShards());
+  }
+
+  [[nodiscard]] std::unique_ptr<ESGRecordFile<n_t, d_t>>
+  makeESGRecordFile() const {
+    if (SolverConfig.esgRecordFile().empty()) {
+      return nullptr;
+    }
+    return std::make_unique<ESGRecordFile<n_t, d_t>>(
+        SolverConfig.esgRecordFile());
+  }
+
+  /// Records the edge function of the ESG edge <n1, d1> --> <n2, d2> for the
+  /// emission of the ESG. Callers must hold the BookkeepingMutex.
+  void recordEdgeFunction(n_t n1, d_t d1, n_t n2, d_t d2,
+                          EdgeFunctionPtrType EF) {
+    if (ESGRecords) {
+      ESGRecords->recordEdgeFunction(n1, d1, n2, d2, EF->str());
+      return;
+    }
+    intermediateEdgeFunctions[std::make_tuple(n1, d1, n2, d2)].push_back(
+        std::move(EF));
+  }
+
+  /// Returns the recorded intra- and inter-procedural path edges. If they
+  /// have been streamed to disk, they are read back into Storage first.
+  std::pair<const PathEdgeTable &, const PathEdgeTable &>
+  getRecordedPathEdges(std::pair<PathEdgeTable, PathEdgeTable> &Storage) {
+    if (!ESGRecords) {
+      return {computedIntraPathEdges, computedInterPathEdges};
+    }
+    ESGRecords->readPathEdges(Storage.first, Storage.second);
+    return {Storage.first, Storage.second};
+  }
+
+  /// Hands the recorded path edges and edge function labels to the given
+  /// handlers, see ESGRecordFile::forEachRecord(). Records that have been
+  /// streamed to disk are read in a single pass; the same path edges may then
+  /// be passed several times. Otherwise, the path edges are passed before the
+  /// edge function labels.
+  template <typename PathEdgesHandlerTy, typename EdgeFunctionHandlerTy>
+  void forEachRecord(PathEdgesHandlerTy OnPathEdges,
+                     EdgeFunctionHandlerTy OnEdgeFunction) {
+    if (ESGRecords) {
+      ESGRecords->forEachRecord(OnPathEdges, OnEdgeFunction);
+      return;
+    }
+    for (bool InterP : {false, true}) {
+      const auto &PathEdges =
+          InterP ? computedInterPathEdges : computedIntraPathEdges;
+      for (const auto &cell : PathEdges.cellVec()) {
+        for (const auto &[D1, D2Set] : cell.getValue()) {
+          OnPathEdges(InterP, cell.getRowKey(), cell.getColumnKey(), D1,
+                      D2Set);
+        }
+      }
+    }
+    for (const auto &[Edge, EFs] : intermediateEdgeFunctions) {
+      for (const auto &EF : EFs) {
+        OnEdgeFunction(std::get<0>(Edge), std::get<1>(Edge), std::get<2>(Edge),
+                       std::get<3>(Edge), llvm::StringRef(EF->str()));
+      }
+    }
+  }
+
+  /// Returns all facts that occur in the recorded path edges and edge
+  /// functions.
+  std::set<d_t> getRecordedFacts() const {
+    if (ESGRecords) {
+      return ESGRecords->getRecordedFacts();
+    }
+    std::set<d_t> Facts;
+    for (const auto *PathEdges :
+         {&computedIntraPathEdges, &computedInterPathEdges}) {
+      for (const auto &cell : PathEdges->cellVec()) {
+        for (const auto &[D1, D2Set] : cell.getValue()) {
+          Facts.insert(D1);
+          Facts.insert(D2Set.begin(), D2Set.end());
+        }
+      }
+    }
+    for (const auto &Entry : intermediateEdgeFunctions) {
+      Facts.insert(std::get<1>(Entry.first));
+      Facts.insert(std::get<3>(Entry.first));
+    }
+    return Facts;
+  }
+
+  /// Returns the canonical instance of the given edge function if edge
+  /// functions are interned, and the function itself otherwise.
+  EdgeFunctionPtrType internEdgeFunction(EdgeFunctionPtrType F) {
+    if (EFInterner) {
+      return EFInterner->intern(std::move(F));
+    }
+    return F;
+  }
+
+  /// Computes F->composeWith(G); the result is memoized if edge functions are
+  /// interned.
+  EdgeFunctionPtrType composeEdgeFunctions(EdgeFunctionPtrType F,
+                                           EdgeFunctionPtrType G) {
+    if (EFInterner) {
+      return EFInterner->compose(std::move(F), std::move(G));
+    }
+    return F->composeWith(std::move(G));
+  }
+
+  /// Computes F->joinWith(G); the result is memoized if edge functions are
+  /// interned.
+  EdgeFunctionPtrType joinEdgeFunctions(EdgeFunctionPtrType F,
+                                        EdgeFunctionPtrType G) {
+    if (EFInterner) {
+      return EFInterner->join(std::move(F), std::move(G));
+    }
+    return F->joinWith(std::move(G));
+  }
+
+  /// Compares two edge functions. If edge functions are interned, all edge
+  /// functions that are compared by the solver are canonical and pointer
+  /// equality suffices.
+  bool equalEdgeFunctions(const EdgeFunctionPtrType &F,
+                          const EdgeFunctionPtrType &G) const {
+    if (EFInterner) {
+      return F == G;
+    }
+    return F->equal_to(G);
+  }
+
+  /// Only locks the given mutex if the problem is tabulated in parallel.
+  std::unique_lock<std::mutex> lockIfConcurrent(std::mutex &Mtx) {
+    if (NumThreads == 1) {
+      return std::unique_lock<std::mutex>(Mtx, std::defer_lock);
+    }
+    return std::unique_lock<std::mutex>(Mtx);
+  }
+
+  /// Locks the shard of the jump functions that end in the given node.
+  std::unique_lock<std::mutex> lockJumpFunctions(n_t Target) {
+    return lockIfConcurrent(JumpFnMutexes[jumpFn->getShardIndex(Target)]);
+  }
+
+  [[nodiscard]] size_t summaryShardIndex(n_t sP, d_t d) const {
+    if (SummaryMutexes.size() == 1) {
+      return 0;
+    }
+    return llvm::hash_combine(std::hash<n_t>{}(sP), std::hash<d_t>{}(d)) %
+           SummaryMutexes.size();
+  }
+
+  /// Locks the shard of the end summaries and incoming edges of <sP, d>.
+  std::unique_lock<std::mutex> lockSummaries(n_t sP, d_t d) {
+    return lockIfConcurrent(SummaryMutexes[summaryShardIndex(sP, d)]);
+  }
+
   /**
    * Lines 13-20 of the algorithm; processing a call site in the caller's
    * context.
@@ -406,6 +672,7 @@ protected:
   virtual void processCall(const PathEdge<n_t, d_t> edge) {
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Call", 1, PAMM_SEVERITY_LEVEL::Full);
+    FlowFunctionBuffers &Buffers = getFlowFunctionBuffers();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Process call at target: "
                   << IDEProblem.NtoString(edge.getTarget()));
@@ -440,7 +707,8 @@ protected:
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Found and process special summary");
         for (n_t returnSiteN : returnSiteNs) {
-          container_type res = computeSummaryFlowFunction(specialSum, d1, d2);
+          container_type &res = Buffers.Call;
+          computeSummaryFlowFunction(specialSum, d1, d2, res);
           INC_COUNTER("SpecialSummary-FF Application", 1,
                       PAMM_SEVERITY_LEVEL::Full);
           ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
@@ -458,7 +726,8 @@ protected:
                 BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Compose: " << sumEdgFnE->str() << " * " << f->str();
                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-            propagate(d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
+            propagate(d1, returnSiteN, d3, composeEdgeFunctions(f, sumEdgFnE),
+                      n, false);
           }
         }
       } else {
@@ -466,20 +735,21 @@ protected:
         FlowFunctionPtrType function =
             cachedFlowEdgeFunctions.getCallFlowFunction(n, sCalledProcN);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        container_type res = computeCallFlowFunction(function, d1, d2);
+        container_type &res = Buffers.Call;
+        computeCallFlowFunction(function, d1, d2, res);
         ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
         // for each callee's start point(s)
-        std::set<n_t> startPointsOf = ICF->getStartPointsOf(sCalledProcN);
-        if (startPointsOf.empty()) {
+        auto startPoints = startPointsOf(*ICF, sCalledProcN);
+        if (startPoints.empty()) {
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                             << "Start points of '" +
                                    ICF->getFunctionName(sCalledProcN) +
                                    "' currently not available!";
                         BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
         }
-        // if startPointsOf is empty, the called function is a declaration
-        for (n_t sP : startPointsOf) {
+        // if startPoints is empty, the called function is a declaration
+        for (n_t sP : startPoints) {
           saveEdges(n, sP, d2, res, true);
           // for each result node of the call-flow function
           for (d_t d3 : res) {
@@ -491,24 +761,23 @@ protected:
                           << IDEProblem.DtoString(d3));
             propagate(d3, sP, d3, EdgeIdentity<l_t>::getInstance(), n,
                       false); // line 15
-            // register the fact that <sp,d3> has an incoming edge from <n,d2>
-            // line 15.1 of Naeem/Lhotak/Rodriguez
-            addIncoming(sP, d3, n, d2);
-            // line 15.2, copy to avoid concurrent modification exceptions by
-            // other threads
-            // const std::set<TableCell> endSumm(endSummary(sP, d3));
-            // std::cout << "ENDSUMM" << std::endl;
-            // std::cout << "Size: " << endSumm.size() << std::endl;
-            // std::cout << "sP: " << IDEProblem.NtoString(sP)
-            //           << "\nd3: " << IDEProblem.DtoString(d3)
-            //           << std::endl;
-            // printEndSummaryTab();
+            std::set<TableCell> endSumm;
+            {
+              auto Lock = lockSummaries(sP, d3);
+              // register the fact that <sp,d3> has an incoming edge from
+              // <n,d2>
+              // line 15.1 of Naeem/Lhotak/Rodriguez
+              addIncoming(sP, d3, n, d2);
+              // line 15.2, copy to avoid concurrent modification by other
+              // threads
+              endSumm = endSummary(sP, d3);
+            }
             // still line 15.2 of Naeem/Lhotak/Rodriguez
             // for each already-queried exit value <eP,d4> reachable from
             // <sP,d3>, create new caller-side jump functions to the return
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
-            for (const TableCell entry : endSummary(sP, d3)) {
+            for (const TableCell entry : endSumm) {
               n_t eP = entry.getRowKey();
               d_t d4 = entry.getColumnKey();
               EdgeFunctionPtrType fCalleeSummary = entry.getValue();
@@ -519,8 +788,9 @@ protected:
                     cachedFlowEdgeFunctions.getRetFlowFunction(n, sCalledProcN,
                                                                eP, retSiteN);
                 INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-                const container_type returnedFacts = computeReturnFlowFunction(
-                    retFunction, d3, d4, n, Container{d2});
+                const container_type &returnedFacts = Buffers.Return;
+                computeReturnFlowFunction(retFunction, d3, d4, n,
+                                          Container{d2}, Buffers.Return);
                 ADD_TO_HISTOGRAM("Data-flow facts", returnedFacts.size(), 1,
                                  PAMM_SEVERITY_LEVEL::Full);
                 saveEdges(eP, retSiteN, d4, returnedFacts, true);
@@ -541,13 +811,11 @@ protected:
                                 << "Queried Return Edge Function: "
                                 << f5->str());
                   if (SolverConfig.emitESG()) {
-                    for (auto sP : ICF->getStartPointsOf(sCalledProcN)) {
-                      intermediateEdgeFunctions[std::make_tuple(n, d2, sP, d3)]
-                          .push_back(f4);
+                    auto Lock = lockIfConcurrent(BookkeepingMutex);
+                    for (auto sP : startPointsOf(*ICF, sCalledProcN)) {
+                      recordEdgeFunction(n, d2, sP, d3, f4);
                     }
-                    intermediateEdgeFunctions[std::make_tuple(eP, d4, retSiteN,
-                                                              d5)]
-                        .push_back(f5);
+                    recordEdgeFunction(eP, d4, retSiteN, d5, f5);
                   }
                   INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
                   // compose call * calleeSummary * return edge functions
@@ -557,8 +825,8 @@ protected:
                                     << f4->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG)
                                 << "         (return * calleeSummary * call)");
-                  EdgeFunctionPtrType fPrime =
-                      f4->composeWith(fCalleeSummary)->composeWith(f5);
+                  EdgeFunctionPtrType fPrime = composeEdgeFunctions(
+                      composeEdgeFunctions(f4, fCalleeSummary), f5);
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                                     << "       = " << fPrime->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -569,7 +837,7 @@ protected:
                                     << f->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
                   propagate(d1, retSiteN, d5_restoredCtx,
-                            f->composeWith(fPrime), n, false);
+                            composeEdgeFunctions(f, fPrime), n, false);
                 }
               }
             }
@@ -583,8 +851,9 @@ protected:
             cachedFlowEdgeFunctions.getCallToRetFlowFunction(n, returnSiteN,
                                                              callees);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        container_type returnFacts =
-            computeCallToReturnFlowFunction(callToReturnFlowFunction, d1, d2);
+        container_type &returnFacts = Buffers.CallToReturn;
+        computeCallToReturnFlowFunction(callToReturnFlowFunction, d1, d2,
+                                        returnFacts);
         ADD_TO_HISTOGRAM("Data-flow facts", returnFacts.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
         saveEdges(n, returnSiteN, d2, returnFacts, false);
@@ -596,11 +865,11 @@ protected:
                         << "Queried Call-to-Return Edge Function: "
                         << edgeFnE->str());
           if (SolverConfig.emitESG()) {
-            intermediateEdgeFunctions[std::make_tuple(n, d2, returnSiteN, d3)]
-                .push_back(edgeFnE);
+            auto Lock = lockIfConcurrent(BookkeepingMutex);
+            recordEdgeFunction(n, d2, returnSiteN, d3, edgeFnE);
           }
           INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          auto fPrime = f->composeWith(edgeFnE);
+          auto fPrime = composeEdgeFunctions(f, edgeFnE);
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                             << "Compose: " << edgeFnE->str() << " * "
                             << f->str() << " = " << fPrime->str();
@@ -619,6 +888,7 @@ protected:
   virtual void processNormalFlow(const PathEdge<n_t, d_t> edge) {
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Normal", 1, PAMM_SEVERITY_LEVEL::Full);
+    FlowFunctionBuffers &Buffers = getFlowFunctionBuffers();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Process normal at target: "
                   << IDEProblem.NtoString(edge.getTarget()));
@@ -626,12 +896,12 @@ protected:
     n_t n = edge.getTarget();
     d_t d2 = edge.factAtTarget();
     EdgeFunctionPtrType f = jumpFunction(edge);
-    for (const auto fn : ICF->getSuccsOf(n)) {
+    for (const auto fn : succsOf(*ICF, n)) {
       FlowFunctionPtrType flowFunction =
           cachedFlowEdgeFunctions.getNormalFlowFunction(n, fn);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-      const container_type res =
-          computeNormalFlowFunction(flowFunction, d1, d2);
+      const container_type &res = Buffers.Normal;
+      computeNormalFlowFunction(flowFunction, d1, d2, Buffers.Normal);
       ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                        PAMM_SEVERITY_LEVEL::Full);
       saveEdges(n, fn, d2, res, false);
@@ -640,10 +910,10 @@ protected:
             cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, fn, d3);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Queried Normal Edge Function: " << g->str());
-        EdgeFunctionPtrType fprime = f->composeWith(g);
+        EdgeFunctionPtrType fprime = composeEdgeFunctions(f, g);
         if (SolverConfig.emitESG()) {
-          intermediateEdgeFunctions[std::make_tuple(n, d2, fn, d3)].push_back(
-              g);
+          auto Lock = lockIfConcurrent(BookkeepingMutex);
+          recordEdgeFunction(n, d2, fn, d3, g);
         }
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Compose: " << g->str() << " * " << f->str()
@@ -678,7 +948,7 @@ protected:
   void propagateValueAtCall(const std::pair<n_t, d_t> nAndD, n_t n) {
     PAMM_GET_INSTANCE;
     d_t d = nAndD.second;
-    for (const f_t q : ICF->getCalleesOfCallAt(n)) {
+    for (const f_t q : calleesOfCallAt(*ICF, n)) {
       FlowFunctionPtrType callFlowFunction =
           cachedFlowEdgeFunctions.getCallFlowFunction(n, q);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -688,13 +958,13 @@ protected:
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Queried Call Edge Function: " << edgeFn->str());
         if (SolverConfig.emitESG()) {
-          for (const auto sP : ICF->getStartPointsOf(q)) {
-            intermediateEdgeFunctions[std::make_tuple(n, d, sP, dPrime)]
-                .push_back(edgeFn);
+          auto Lock = lockIfConcurrent(BookkeepingMutex);
+          for (const auto sP : startPointsOf(*ICF, q)) {
+            recordEdgeFunction(n, d, sP, dPrime, edgeFn);
           }
         }
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        for (const n_t startPoint : ICF->getStartPointsOf(q)) {
+        for (const n_t startPoint : startPointsOf(*ICF, q)) {
           INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
           propagateValue(startPoint, dPrime, edgeFn->computeTarget(val(n, d)));
         }
@@ -713,7 +983,8 @@ protected:
 
   l_t val(n_t nHashN, d_t nHashD) {
     if (valtab.contains(nHashN, nHashD)) {
-      return valtab.get(nHashN, nHashD);
+      // only read valtab, as it is read concurrently in parallel phase II
+      return std::as_const(valtab).get(nHashN, nHashD);
     } else {
       // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
       return IDEProblem.topElement();
@@ -752,6 +1023,7 @@ protected:
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "   Target D: " << IDEProblem.DtoString(edge.factAtTarget()));
 
+    auto Lock = lockJumpFunctions(edge.getTarget());
     auto fwdLookupRes =
         jumpFn->forwardLookup(edge.factAtSource(), edge.getTarget());
     if (fwdLookupRes) {
@@ -777,8 +1049,239 @@ protected:
   void addEndSummary(n_t sP, d_t d1, n_t eP, d_t d2, EdgeFunctionPtrType f) {
     // note: at this point we don't need to join with a potential previous f
     // because f is a jump function, which is already properly joined
-    // within propagate(..)
-    endsummarytab.get(sP, d1).insert(eP, d2, std::move(f));
+    // within propagate(..); the caller must hold the summary lock of <sP, d1>
+    // while reading f, as jump functions only grow
+    endsummarytab[summaryShardIndex(sP, d1)].get(sP, d1).insert(eP, d2,
+                                                                std::move(f));
+  }
+
+  /**
+   * Schedules the given path edge for processing. The edge is processed once
+   * the worklist is drained by processWorklist(). If the problem is tabulated
+   * in parallel, the edge is handed to a work-stealing pool and the
+   * configured worklist kind is ignored.
+   */
+  void scheduleEdgeProcessing(const PathEdge<n_t, d_t> edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Worklist Pushes", 1, PAMM_SEVERITY_LEVEL::Full);
+    if (NumThreads > 1) {
+      if (!ParallelWorklist) {
+        ParallelWorklist =
+            std::make_unique<WorkStealingPool<PathEdge<n_t, d_t>>>(NumThreads);
+      }
+      ParallelWorklist->push(edge);
+      return;
+    }
+    if (!Worklist) {
+      Worklist = makePathEdgeWorklist<n_t, d_t, f_t, i_t>(
+          SolverConfig.worklistKind(), *ICF, initialSeeds);
+    }
+    Worklist->push(edge);
+    WorklistPeakSize = std::max(WorklistPeakSize, Worklist->size());
+    if (CollectJumpFunctions) {
+      ++PendingEdgesOf[ICF->getFunctionOf(edge.getTarget())];
+    }
+  }
+
+  /**
+   * Processes path edges until the worklist is empty, i.e. until the jump
+   * functions have reached their fixed point.
+   */
+  void processWorklist() {
+    if (ParallelWorklist) {
+      PAMM_GET_INSTANCE;
+      PAMM_PARALLEL_SECTION(ParallelTabulation);
+      ParallelWorklist->run([this](PathEdge<n_t, d_t> Edge) {
+        PathEdgeCount++;
+        pathEdgeProcessingTask(std::move(Edge));
+      });
+      WorklistPeakSize =
+          std::max(WorklistPeakSize, ParallelWorklist->getPeakSize());
+      return;
+    }
+    if (!Worklist) {
+      return;
+    }
+    while (!Worklist->empty()) {
+      PathEdgeCount++;
+      const PathEdge<n_t, d_t> Edge = Worklist->pop();
+      pathEdgeProcessingTask(Edge);
+      if (CollectJumpFunctions) {
+        notePathEdgeProcessed(Edge.getTarget());
+      }
+    }
+    if (CollectJumpFunctions) {
+      // all procedures are done now
+      collectJumpFunctions();
+    }
+  }
+
+  void notePathEdgeProcessed(n_t Target) {
+    f_t F = ICF->getFunctionOf(Target);
+    if (--PendingEdgesOf[F] == 0) {
+      CollectionCandidates.insert(F);
+    }
+    if (++EdgesSinceCollection >= CollectionInterval) {
+      collectJumpFunctions();
+    }
+  }
+
+  /**
+   * Jump functions into these nodes are never collected. They are the ones
+   * that the tabulation of a procedure can be resumed from and the ones that
+   * are used in phase II(i).
+   */
+  bool isRetainedNode(n_t n) const {
+    return ICF->isStartPoint(n) || ICF->isCallStmt(n) || ICF->isExitStmt(n) ||
+           initialSeeds.count(n) || unbalancedRetSites.count(n);
+  }
+
+  /**
+   * Collects the jump functions of all candidate procedures that are done,
+   * i.e. that neither have pending path edges themselves nor call a procedure
+   * that has. The latter would likely produce new summaries that have to be
+   * applied in the candidate. If the ICFG provides the SCCs of its call graph,
+   * a procedure is only done once all procedures of its SCC and of all SCCs
+   * it transitively calls are done, as a pending edge in any of them may
+   * still produce a new summary. Otherwise only the direct callees are
+   * checked.
+   *
+   * Collecting the jump functions of a procedure is always sound, as long as
+   * the retained ones are kept: if a new path edge reaches a node whose jump
+   * functions have been collected, the edge is considered new and is
+   * propagated further until it reaches a retained node, where it is joined
+   * with the complete jump function as usual. Collecting too early only costs
+   * time.
+   */
+  void collectJumpFunctions() {
+    EdgesSinceCollection = 0;
+    auto isDone = [this](f_t F) {
+      auto Search = PendingEdgesOf.find(F);
+      return Search == PendingEdgesOf.end() || Search->second == 0;
+    };
+    // whether an SCC and all SCCs it transitively calls are done, only valid
+    // for this round
+    llvm::DenseMap<unsigned, bool> DoneSCCs;
+    for (auto It = CollectionCandidates.begin();
+         It != CollectionCandidates.end();) {
+      f_t F = *It;
+      if (!isDone(F)) {
+        // F becomes a candidate again once it is done
+        It = CollectionCandidates.erase(It);
+        continue;
+      }
+      bool CalleesDone = true;
+      if constexpr (detail::HasCallGraphSCCs<i_t, f_t>::value) {
+        CalleesDone = isSCCDone(ICF->getSCCOf(F), DoneSCCs, isDone);
+      } else {
+        for (n_t c : ICF->getCallsFromWithin(F)) {
+          for (f_t q : calleesOfCallAt(*ICF, c)) {
+            CalleesDone &= isDone(q);
+          }
+        }
+      }
+      if (!CalleesDone) {
+        ++It;
+        continue;
+      }
+      releaseJumpFunctions(F);
+      CollectedProcedures.insert(F);
+      It = CollectionCandidates.erase(It);
+    }
+  }
+
+  /**
+   * Returns whether all procedures of the given SCC of the call graph and of
+   * all SCCs it transitively calls are done. As the SCCs form a DAG, the
+   * callee SCCs are visited depth-first without a visited set, the results
+   * are memoized in Done.
+   */
+  template <typename IsDoneFn>
+  bool isSCCDone(unsigned Root, llvm::DenseMap<unsigned, bool> &Done,
+                 IsDoneFn isDone) const {
+    if (auto Search = Done.find(Root); Search != Done.end()) {
+      return Search->second;
+    }
+    // pairs of an SCC and the index of its next callee SCC to visit
+    std::vector<std::pair<unsigned, size_t>> Stack;
+    auto Enter = [this, &Stack, &isDone](unsigned SCC) {
+      for (f_t F : ICF->getFunctionsOfSCC(SCC)) {
+        if (!isDone(F)) {
+          return false;
+        }
+      }
+      Stack.emplace_back(SCC, 0);
+      return true;
+    };
+    bool RootDone = Enter(Root);
+    while (RootDone && !Stack.empty()) {
+      unsigned SCC = Stack.back().first;
+      auto Callees = ICF->getCalleeSCCsOf(SCC);
+      if (Stack.back().second == Callees.size()) {
+        Done[SCC] = true;
+        Stack.pop_back();
+        continue;
+      }
+      unsigned Callee = Callees[Stack.back().second++];
+      if (auto Search = Done.find(Callee); Search != Done.end()) {
+        RootDone = Search->second;
+      } else if (!Enter(Callee)) {
+        Done[Callee] = false;
+        RootDone = false;
+      }
+    }
+    // all SCCs on the stack transitively call the pending one
+    for (const auto &Entry : Stack) {
+      Done[Entry.first] = false;
+    }
+    if (!RootDone) {
+      Done[Root] = false;
+    }
+    return RootDone;
+  }
+
+  /// Removes the jump functions into all nodes of the given procedure that are
+  /// not retained.
+  void releaseJumpFunctions(f_t F) {
+    PAMM_GET_INSTANCE;
+    size_t NumRemoved = 0;
+    for (n_t n : ICF->getAllInstructionsOf(F)) {
+      if (!isRetainedNode(n)) {
+        NumRemoved += jumpFn->removeFunctionsAt(n);
+      }
+    }
+    INC_COUNTER("Collected JumpFn", NumRemoved, PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /**
+   * Recomputes the collected jump functions of the given procedure from the
+   * retained ones by processing the path edges into its start points and call
+   * sites once more. As the summaries of all callees are known and the jump
+   * functions into the exit points are retained, nothing is propagated
+   * beyond the procedure. Must only be called after phase I.
+   */
+  void retabulateProcedure(f_t F) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Retabulated Procedures", 1, PAMM_SEVERITY_LEVEL::Full);
+    // start from scratch in case the procedure has been resumed after it has
+    // been collected
+    releaseJumpFunctions(F);
+    for (n_t n : ICF->getAllInstructionsOf(F)) {
+      if (!isRetainedNode(n)) {
+        continue;
+      }
+      using TableCell = typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
+      for (const TableCell &Cell : jumpFn->lookupByTarget(n).cellSet()) {
+        const PathEdge<n_t, d_t> Edge(Cell.getRowKey(), n,
+                                      Cell.getColumnKey());
+        if (ICF->isCallStmt(n)) {
+          processCall(Edge);
+        } else if (!succsOf(*ICF, n).empty()) {
+          processNormalFlow(Edge);
+        }
+      }
+    }
+    processWorklist();
   }
 
   // should be made a callable at some point
@@ -804,7 +1307,7 @@ protected:
       if (ICF->isExitStmt(edge.getTarget())) {
         processExit(edge);
       }
-      if (!ICF->getSuccsOf(edge.getTarget()).empty()) {
+      if (!succsOf(*ICF, edge.getTarget()).empty()) {
         processNormalFlow(edge);
       }
     } else {
@@ -831,7 +1334,7 @@ protected:
   void valueComputationTask(const std::vector<n_t> &values) {
     PAMM_GET_INSTANCE;
     for (n_t n : values) {
-      for (n_t sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
+      for (n_t sP : startPointsOf(*ICF, ICF->getFunctionOf(n))) {
         using TableCell = typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
         Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget;
         lookupByTarget = jumpFn->lookupByTarget(n);
@@ -850,11 +1353,95 @@ protected:
     }
   }
 
+  /**
+   * Computes the values of the facts at the given node like
+   * valueComputationTask(), but only reads valtab and records the results in
+   * the given buffer instead. The values of different nodes can thus be
+   * computed concurrently. Returns the number of evaluated jump functions.
+   */
+  size_t bufferedValueComputationTask(
+      n_t n, std::vector<std::tuple<n_t, d_t, l_t>> &Buffer) {
+    std::unordered_map<d_t, l_t> Values;
+    size_t NumComputations = 0;
+    for (n_t sP : startPointsOf(*ICF, ICF->getFunctionOf(n))) {
+      using TableCell = typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
+      for (const TableCell &sourceValTargetValAndFunction :
+           jumpFn->lookupByTarget(n).cellSet()) {
+        d_t dPrime = sourceValTargetValAndFunction.getRowKey();
+        d_t d = sourceValTargetValAndFunction.getColumnKey();
+        EdgeFunctionPtrType fPrime = sourceValTargetValAndFunction.getValue();
+        auto Search = Values.find(d);
+        if (Search == Values.end()) {
+          Search = Values.emplace(d, val(n, d)).first;
+        }
+        Search->second =
+            IDEProblem.join(std::move(Search->second),
+                            fPrime->computeTarget(val(sP, dPrime)));
+        ++NumComputations;
+      }
+    }
+    for (auto &[d, l] : Values) {
+      Buffer.emplace_back(n, d, std::move(l));
+    }
+    return NumComputations;
+  }
+
+  /**
+   * Phase II(ii) using NumThreads threads. The threads repeatedly claim the
+   * next chunk of nodes and record the computed values in a buffer of their
+   * own. The buffers are merged into valtab once all threads have finished.
+   */
+  void parallelValueComputation(const std::vector<n_t> &values) {
+    PAMM_GET_INSTANCE;
+    static constexpr size_t ChunkSize = 64;
+    std::atomic<size_t> NextChunk{0};
+    std::atomic<size_t> NumComputations{0};
+    std::vector<std::vector<std::tuple<n_t, d_t, l_t>>> Buffers(NumThreads);
+    auto Worker = [&](unsigned Thread) {
+      auto &Buffer = Buffers[Thread];
+      size_t LocalComputations = 0;
+      for (size_t Begin = NextChunk.fetch_add(ChunkSize); Begin < values.size();
+           Begin = NextChunk.fetch_add(ChunkSize)) {
+        size_t End = std::min(Begin + ChunkSize, values.size());
+        for (size_t Idx = Begin; Idx < End; ++Idx) {
+          LocalComputations +=
+              bufferedValueComputationTask(values[Idx], Buffer);
+        }
+      }
+      NumComputations += LocalComputations;
+    };
+    PAMM_PARALLEL_SECTION(ParallelValueComputation);
+    std::vector<std::thread> Threads;
+    Threads.reserve(NumThreads - 1);
+    for (unsigned Thread = 1; Thread < NumThreads; ++Thread) {
+      Threads.emplace_back(Worker, Thread);
+    }
+    Worker(0);
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+    // every node is handled by exactly one thread, the buffers are thus
+    // disjoint
+    for (auto &Buffer : Buffers) {
+      for (auto &[n, d, l] : Buffer) {
+        setVal(n, d, std::move(l));
+      }
+    }
+    INC_COUNTER("Value Computation", NumComputations.load(),
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+
   virtual void saveEdges(n_t sourceNode, n_t sinkStmt, d_t sourceVal,
                          const container_type &destVals, bool interP) {
     if (!SolverConfig.recordEdges()) {
       return;
     }
+    auto Lock = lockIfConcurrent(BookkeepingMutex);
+    if (ESGRecords) {
+      ESGRecords->recordPathEdges(sourceNode, sinkStmt, sourceVal, destVals,
+                                  interP);
+      return;
+    }
     Table<n_t, n_t, std::map<d_t, container_type>> &tgtMap =
         (interP) ? computedInterPathEdges : computedIntraPathEdges;
     tgtMap.get(sourceNode, sinkStmt)[sourceVal].insert(destVals.begin(),
@@ -866,6 +1453,9 @@ protected:
    */
   void computeValues() {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "Start computing values");
+    // phase I is over, retabulateProcedure() must not be interrupted by
+    // further collections
+    CollectJumpFunctions = false;
     // Phase II(i)
     std::map<n_t, std::set<d_t>> allSeeds(initialSeeds);
     for (n_t unbalancedRetSite : unbalancedRetSites) {
@@ -888,8 +1478,27 @@ protected:
     // we create an array of all nodes and then dispatch fractions of this
     // array to multiple threads
     const std::set<n_t> allNonCallStartNodes = ICF->allNonCallStartNodes();
-    valueComputationTask(
-        {allNonCallStartNodes.begin(), allNonCallStartNodes.end()});
+    std::vector<n_t> values;
+    // the collected jump functions are recomputed one procedure at a time
+    // and are collected again right after they have been used
+    std::unordered_map<f_t, std::vector<n_t>> valuesOfCollectedProcedures;
+    for (n_t n : allNonCallStartNodes) {
+      if (f_t F = ICF->getFunctionOf(n); CollectedProcedures.count(F)) {
+        valuesOfCollectedProcedures[F].push_back(n);
+      } else {
+        values.push_back(n);
+      }
+    }
+    for (const auto &[F, FValues] : valuesOfCollectedProcedures) {
+      retabulateProcedure(F);
+      valueComputationTask(FValues);
+      releaseJumpFunctions(F);
+    }
+    if (NumThreads > 1) {
+      parallelValueComputation(values);
+    } else {
+      valueComputationTask(values);
+    }
   }
 
   /**
@@ -912,9 +1521,11 @@ protected:
         propagate(ZeroValue, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
                   nullptr, false);
       }
-      jumpFn->addFunction(ZeroValue, StartPoint, ZeroValue,
-                          EdgeIdentity<l_t>::getInstance());
+      jumpFn->addFunction(
+          ZeroValue, StartPoint, ZeroValue,
+          internEdgeFunction(EdgeIdentity<l_t>::getInstance()));
     }
+    processWorklist();
   }
 
   /**
@@ -929,6 +1540,7 @@ protected:
   virtual void processExit(const PathEdge<n_t, d_t> edge) {
     PAMM_GET_INSTANCE;
     INC_COUNTER("Process Exit", 1, PAMM_SEVERITY_LEVEL::Full);
+    FlowFunctionBuffers &Buffers = getFlowFunctionBuffers();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Process exit at target: "
                   << IDEProblem.NtoString(edge.getTarget()));
@@ -942,6 +1554,11 @@ protected:
         ICF->getStartPointsOf(functionThatNeedsSummary);
     std::map<n_t, container_type> inc;
     for (n_t sP : startPointsOf) {
+      auto Lock = lockSummaries(sP, d1);
+      // re-read the jump function under the lock, so that a thread that
+      // processes an older version of this edge cannot overwrite the end
+      // summary with a stale function
+      f = jumpFunction(edge);
       // line 21.1 of Naeem/Lhotak/Rodriguez
       // register end-summary
       addEndSummary(sP, d1, n, d2, f);
@@ -965,8 +1582,9 @@ protected:
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
         // for each incoming-call value
         for (d_t d4 : entry.second) {
-          const container_type targets =
-              computeReturnFlowFunction(retFunction, d1, d2, c, entry.second);
+          const container_type &targets = Buffers.Return;
+          computeReturnFlowFunction(retFunction, d1, d2, c, entry.second,
+                                    Buffers.Return);
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
           saveEdges(n, retSiteC, d2, targets, true);
@@ -987,12 +1605,11 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Queried Return Edge Function: " << f5->str());
             if (SolverConfig.emitESG()) {
+              auto Lock = lockIfConcurrent(BookkeepingMutex);
               for (auto sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-                intermediateEdgeFunctions[std::make_tuple(c, d4, sP, d1)]
-                    .push_back(f4);
+                recordEdgeFunction(c, d4, sP, d1, f4);
               }
-              intermediateEdgeFunctions[std::make_tuple(n, d2, retSiteC, d5)]
-                  .push_back(f5);
+              recordEdgeFunction(n, d2, retSiteC, d5, f5);
             }
             INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
             // compose call function * function * return function
@@ -1001,26 +1618,33 @@ protected:
                               << " * " << f4->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "         (return * function * call)");
-            EdgeFunctionPtrType fPrime = f4->composeWith(f)->composeWith(f5);
+            EdgeFunctionPtrType fPrime =
+                composeEdgeFunctions(composeEdgeFunctions(f4, f), f5);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "       = " << fPrime->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
             // for each jump function coming into the call, propagate to
             // return site using the composed function
-            auto revLookupResult = jumpFn->reverseLookup(c, d4);
-            if (revLookupResult) {
-              for (auto valAndFunc : revLookupResult->get()) {
-                EdgeFunctionPtrType f3 = valAndFunc.second;
-                if (!f3->equal_to(allTop)) {
-                  d_t d3 = valAndFunc.first;
-                  d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                                    << "Compose: " << fPrime->str() << " * "
-                                    << f3->str();
-                                BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-                  propagate(d3, retSiteC, d5_restoredCtx,
-                            f3->composeWith(fPrime), c, false);
-                }
+            // copy to avoid concurrent modification by other threads
+            llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>
+                revLookupResult;
+            {
+              auto Lock = lockJumpFunctions(c);
+              if (auto Result = jumpFn->reverseLookup(c, d4)) {
+                revLookupResult = Result->get();
+              }
+            }
+            for (auto valAndFunc : revLookupResult) {
+              EdgeFunctionPtrType f3 = valAndFunc.second;
+              if (!equalEdgeFunctions(f3, allTop)) {
+                d_t d3 = valAndFunc.first;
+                d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
+                LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                                  << "Compose: " << fPrime->str() << " * "
+                                  << f3->str();
+                              BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+                propagate(d3, retSiteC, d5_restoredCtx,
+                          composeEdgeFunctions(f3, fPrime), c, false);
               }
             }
           }
@@ -1035,15 +1659,16 @@ protected:
     // condition
     if (SolverConfig.followReturnsPastSeeds() && inc.empty() &&
         IDEProblem.isZeroValue(d1)) {
-      const std::set<n_t> callers = ICF->getCallersOf(functionThatNeedsSummary);
+      const auto callers = callersOf(*ICF, functionThatNeedsSummary);
       for (n_t c : callers) {
         for (n_t retSiteC : ICF->getReturnSitesOfCallAt(c)) {
           FlowFunctionPtrType retFunction =
               cachedFlowEdgeFunctions.getRetFlowFunction(
                   c, functionThatNeedsSummary, n, retSiteC);
           INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          const container_type targets = computeReturnFlowFunction(
-              retFunction, d1, d2, c, Container{ZeroValue});
+          const container_type &targets = Buffers.Return;
+          computeReturnFlowFunction(retFunction, d1, d2, c,
+                                    Container{ZeroValue}, Buffers.Return);
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
           saveEdges(n, retSiteC, d2, targets, true);
@@ -1054,15 +1679,17 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Queried Return Edge Function: " << f5->str());
             if (SolverConfig.emitESG()) {
-              intermediateEdgeFunctions[std::make_tuple(n, d2, retSiteC, d5)]
-                  .push_back(f5);
+              auto Lock = lockIfConcurrent(BookkeepingMutex);
+              recordEdgeFunction(n, d2, retSiteC, d5, f5);
             }
             INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "Compose: " << f5->str() << " * " << f->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-            propagteUnbalancedReturnFlow(retSiteC, d5, f->composeWith(f5), c);
+            propagteUnbalancedReturnFlow(retSiteC, d5,
+                                         composeEdgeFunctions(f, f5), c);
             // register for value processing (2nd IDE phase)
+            auto Lock = lockIfConcurrent(BookkeepingMutex);
             unbalancedRetSites.insert(retSiteC);
           }
         }
@@ -1113,27 +1740,55 @@ protected:
     return d5;
   }
 
+  /**
+   * Output buffers for the flow function applications of a worker. They are
+   * cleared rather than reallocated before each application, so that a
+   * container that keeps its memory on clear() does not allocate per path
+   * edge. The buffers of a kind must not be in use by an enclosing
+   * application, hence processCall() uses a separate buffer for each kind of
+   * flow function it applies.
+   */
+  struct FlowFunctionBuffers {
+    container_type Normal;
+    container_type Call;
+    container_type Return;
+    container_type CallToReturn;
+  };
+
+  // one set of buffers per worker of the parallel tabulation, the sequential
+  // solver only uses the first one
+  std::vector<FlowFunctionBuffers> WorkerBuffers =
+      std::vector<FlowFunctionBuffers>(NumThreads);
+
+  FlowFunctionBuffers &getFlowFunctionBuffers() {
+    if (ParallelWorklist) {
+      return WorkerBuffers[ParallelWorklist->getCurrentWorker()];
+    }
+    return WorkerBuffers.front();
+  }
+
   /**
    * Computes the normal flow function for the given set of start and end
    * abstractions-
    * @param flowFunction The normal flow function to compute
    * @param d1 The abstraction at the method's start node
    * @param d2 The abstraction at the current node
-   * @return The set of abstractions at the successor node
+   * @param targets Receives the set of abstractions at the successor node
    */
-  container_type
-  computeNormalFlowFunction(const FlowFunctionPtrType &flowFunction, d_t d1,
-                            d_t d2) {
-    return flowFunction->computeTargets(d2);
+  void computeNormalFlowFunction(const FlowFunctionPtrType &flowFunction,
+                                 d_t d1, d_t d2, container_type &targets) {
+    targets.clear();
+    flowFunction->computeTargetsInto(d2, targets);
   }
 
   /**
    * TODO: comment
    */
-  container_type
+  void
   computeSummaryFlowFunction(const FlowFunctionPtrType &SummaryFlowFunction,
-                             d_t d1, d_t d2) {
-    return SummaryFlowFunction->computeTargets(d2);
+                             d_t d1, d_t d2, container_type &targets) {
+    targets.clear();
+    SummaryFlowFunction->computeTargetsInto(d2, targets);
   }
 
   /**
@@ -1141,12 +1796,13 @@ protected:
    * @param callFlowFunction The call flow function to compute
    * @param d1 The abstraction at the current method's start node.
    * @param d2 The abstraction at the call site
-   * @return The set of caller-side abstractions at the callee's start node
+   * @param targets Receives the set of caller-side abstractions at the
+   * callee's start node
    */
-  container_type
-  computeCallFlowFunction(const FlowFunctionPtrType &callFlowFunction, d_t d1,
-                          d_t d2) {
-    return callFlowFunction->computeTargets(d2);
+  void computeCallFlowFunction(const FlowFunctionPtrType &callFlowFunction,
+                               d_t d1, d_t d2, container_type &targets) {
+    targets.clear();
+    callFlowFunction->computeTargetsInto(d2, targets);
   }
 
   /**
@@ -1156,11 +1812,14 @@ protected:
    * compute
    * @param d1 The abstraction at the current method's start node.
    * @param d2 The abstraction at the call site
-   * @return The set of caller-side abstractions at the return site
+   * @param targets Receives the set of caller-side abstractions at the return
+   * site
    */
-  container_type computeCallToReturnFlowFunction(
-      const FlowFunctionPtrType &callToReturnFlowFunction, d_t d1, d_t d2) {
-    return callToReturnFlowFunction->computeTargets(d2);
+  void computeCallToReturnFlowFunction(
+      const FlowFunctionPtrType &callToReturnFlowFunction, d_t d1, d_t d2,
+      container_type &targets) {
+    targets.clear();
+    callToReturnFlowFunction->computeTargetsInto(d2, targets);
   }
 
   /**
@@ -1171,13 +1830,15 @@ protected:
    * @param d2 The abstraction at the exit node in the callee
    * @param callSite The call site
    * @param callerSideDs The abstractions at the call site
-   * @return The set of caller-side abstractions at the return site
+   * @param targets Receives the set of caller-side abstractions at the return
+   * site
    */
-  container_type
-  computeReturnFlowFunction(const FlowFunctionPtrType &retFunction, d_t d1,
-                            d_t d2, n_t callSite,
-                            const Container &callerSideDs) {
-    return retFunction->computeTargets(d2);
+  void computeReturnFlowFunction(const FlowFunctionPtrType &retFunction,
+                                 d_t d1, d_t d2, n_t callSite,
+                                 const Container &callerSideDs,
+                                 container_type &targets) {
+    targets.clear();
+    retFunction->computeTargetsInto(d2, targets);
   }
 
   /**
@@ -1214,6 +1875,7 @@ protected:
                   << " (result of previous compose)";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
 
+    auto Lock = lockJumpFunctions(target);
     EdgeFunctionPtrType jumpFnE = [&]() {
       const auto revLookupResult = jumpFn->reverseLookup(target, targetVal);
       if (revLookupResult) {
@@ -1228,8 +1890,8 @@ protected:
       // jump function is initialized to all-top if no entry was found
       return allTop;
     }();
-    EdgeFunctionPtrType fPrime = jumpFnE->joinWith(f);
-    bool newFunction = !(fPrime->equal_to(jumpFnE));
+    EdgeFunctionPtrType fPrime = joinEdgeFunctions(jumpFnE, f);
+    bool newFunction = !equalEdgeFunctions(fPrime, jumpFnE);
 
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Join: " << jumpFnE->str() << " & " << f.get()->str()
@@ -1240,9 +1902,9 @@ protected:
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
     if (newFunction) {
       jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
+      Lock.unlock();
       const PathEdge<n_t, d_t> edge(sourceVal, target, targetVal);
-      PathEdgeCount++;
-      pathEdgeProcessingTask(edge);
+      scheduleEdgeProcessing(edge);
 
       LOG_IF_ENABLE(if (!IDEProblem.isZeroValue(targetVal)) {
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -1269,6 +1931,7 @@ protected:
   endSummary(n_t sP, d_t d3) {
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       auto key = std::make_pair(sP, d3);
+      auto Lock = lockIfConcurrent(BookkeepingMutex);
       auto findND = fSummaryReuse.find(key);
       if (findND == fSummaryReuse.end()) {
         fSummaryReuse.emplace(key, 0);
@@ -1276,35 +1939,37 @@ protected:
         fSummaryReuse[key] += 1;
       }
     }
-    return endsummarytab.get(sP, d3).cellSet();
+    return endsummarytab[summaryShardIndex(sP, d3)].get(sP, d3).cellSet();
   }
 
   std::map<n_t, container_type> incoming(d_t d1, n_t sP) {
-    return incomingtab.get(sP, d1);
+    return incomingtab[summaryShardIndex(sP, d1)].get(sP, d1);
   }
 
   void addIncoming(n_t sP, d_t d3, n_t n, d_t d2) {
-    incomingtab.get(sP, d3)[n].insert(d2);
+    incomingtab[summaryShardIndex(sP, d3)].get(sP, d3)[n].insert(d2);
   }
 
   void printIncomingTab() const {
 #ifdef DYNAMIC_LOG
     if (boost::log::core::get()->get_logging_enabled()) {
       BOOST_LOG_SEV(lg::get(), DEBUG) << "Start of incomingtab entry";
-      for (auto cell : incomingtab.cellSet()) {
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "sP: " << IDEProblem.NtoString(cell.getRowKey());
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "d3: " << IDEProblem.DtoString(cell.getColumnKey());
-        for (auto entry : cell.getValue()) {
+      for (const auto &Shard : incomingtab) {
+        for (auto cell : Shard.cellSet()) {
           BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  n: " << IDEProblem.NtoString(entry.first);
-          for (auto fact : entry.second) {
+              << "sP: " << IDEProblem.NtoString(cell.getRowKey());
+          BOOST_LOG_SEV(lg::get(), DEBUG)
+              << "d3: " << IDEProblem.DtoString(cell.getColumnKey());
+          for (auto entry : cell.getValue()) {
             BOOST_LOG_SEV(lg::get(), DEBUG)
-                << "  d2: " << IDEProblem.DtoString(fact);
+                << "  n: " << IDEProblem.NtoString(entry.first);
+            for (auto fact : entry.second) {
+              BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "  d2: " << IDEProblem.DtoString(fact);
+            }
           }
+          BOOST_LOG_SEV(lg::get(), DEBUG) << "---------------";
         }
-        BOOST_LOG_SEV(lg::get(), DEBUG) << "---------------";
       }
       BOOST_LOG_SEV(lg::get(), DEBUG) << "End of incomingtab entry";
       BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
@@ -1316,22 +1981,24 @@ protected:
 #ifdef DYNAMIC_LOG
     if (boost::log::core::get()->get_logging_enabled()) {
       BOOST_LOG_SEV(lg::get(), DEBUG) << "Start of endsummarytab entry";
-      for (auto cell : endsummarytab.cellVec()) {
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "sP: " << IDEProblem.NtoString(cell.getRowKey());
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "d1: " << IDEProblem.DtoString(cell.getColumnKey());
-        for (auto inner_cell : cell.getValue().cellVec()) {
-          BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  eP: " << IDEProblem.NtoString(inner_cell.getRowKey());
+      for (const auto &Shard : endsummarytab) {
+        for (auto cell : Shard.cellVec()) {
           BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  d2: " << IDEProblem.DtoString(inner_cell.getColumnKey());
+              << "sP: " << IDEProblem.NtoString(cell.getRowKey());
           BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  EF: " << inner_cell.getValue()->str();
+              << "d1: " << IDEProblem.DtoString(cell.getColumnKey());
+          for (auto inner_cell : cell.getValue().cellVec()) {
+            BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "  eP: " << IDEProblem.NtoString(inner_cell.getRowKey());
+            BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "  d2: " << IDEProblem.DtoString(inner_cell.getColumnKey());
+            BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "  EF: " << inner_cell.getValue()->str();
+            BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
+          }
+          BOOST_LOG_SEV(lg::get(), DEBUG) << "---------------";
           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
         }
-        BOOST_LOG_SEV(lg::get(), DEBUG) << "---------------";
-        BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
       }
       BOOST_LOG_SEV(lg::get(), DEBUG) << "End of endsummarytab entry";
       BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
@@ -1345,8 +2012,13 @@ protected:
     std::cout
         << "\n**********************************************************\n";
 
+    // only filled if the path edges have been streamed to disk
+    std::pair<PathEdgeTable, PathEdgeTable> StreamedPathEdges;
+    auto [IntraPathEdges, InterPathEdges] =
+        getRecordedPathEdges(StreamedPathEdges);
+
     // Sort intra-procedural path edges
-    auto cells = computedIntraPathEdges.cellVec();
+    auto cells = IntraPathEdges.cellVec();
     StmtLess stmtless(ICF);
     sort(cells.begin(), cells.end(), [&stmtless](auto a, auto b) {
       return stmtless(a.getRowKey(), b.getRowKey());
@@ -1373,7 +2045,7 @@ protected:
         << "\n**********************************************************\n";
 
     // Sort intra-procedural path edges
-    cells = computedInterPathEdges.cellVec();
+    cells = InterPathEdges.cellVec();
     sort(cells.begin(), cells.end(), [&stmtless](auto a, auto b) {
       return stmtless(a.getRowKey(), b.getRowKey());
     });
@@ -1414,148 +2086,141 @@ protected:
     // Stores all valid facts at return site in caller context; return-site is
     // key
     std::unordered_map<n_t, std::set<d_t>> ValidInCallerContext;
+    // Facts that are propagated to a return-site, with the number of
+    // return-flow path edges they are propagated by. As the path edges are
+    // not visited in any particular order, they are only compared to the
+    // valid facts in the caller context once all edges have been visited.
+    std::unordered_map<n_t, std::map<d_t, std::size_t>> ReturnedFacts;
+    // Stores all pairs of (Startpoint, Fact) for which a summary was applied
+    std::set<std::pair<n_t, d_t>> ProcessSummaryFacts;
+    // The same path edges may have been streamed to disk several times. As
+    // flow functions are pure, they are all recorded with the same targets.
+    std::set<std::tuple<n_t, n_t, d_t>> VisitedStreamedEdges;
     std::size_t genFacts = 0, killFacts = 0, intraPathEdges = 0,
                 interPathEdges = 0;
-    /* --- Intra-procedural Path Edges ---
-     * d1 --> d2-Set
-     * Case 1: d1 in d2-Set
-     * Case 2: d1 not in d2-Set, i.e. d1 was killed. d2-Set could be empty.
-     */
-    for (auto cell : computedIntraPathEdges.cellSet()) {
-      auto Edge = std::make_pair(cell.getRowKey(), cell.getColumnKey());
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "N1: " << IDEProblem.NtoString(Edge.first);
-                    BOOST_LOG_SEV(lg::get(), DEBUG)
-                    << "N2: " << IDEProblem.NtoString(Edge.second));
-      for (auto D1ToD2Set : cell.getValue()) {
-        auto D1 = D1ToD2Set.first;
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "d1: " << IDEProblem.DtoString(D1));
-        auto D2Set = D1ToD2Set.second;
-        intraPathEdges += D2Set.size();
-        // Case 1
-        if (D2Set.find(D1) != D2Set.end()) {
-          genFacts += D2Set.size() - 1;
-        }
-        // Case 2
-        else {
-          genFacts += D2Set.size();
-          // We ignore the zero value
-          if (!IDEProblem.isZeroValue(D1)) {
-            killFacts++;
-          }
-        }
-        // Store all valid facts after call-to-return flow
-        if (ICF->isCallStmt(Edge.first)) {
-          ValidInCallerContext[Edge.second].insert(D2Set.begin(), D2Set.end());
-        }
-        LOG_IF_ENABLE([&]() {
-          for (auto D2 : D2Set) {
-            BOOST_LOG_SEV(lg::get(), DEBUG)
-                << "d2: " << IDEProblem.DtoString(D2);
+    forEachRecord(
+        [&](bool InterP, n_t N1, n_t N2, d_t D1, const auto &D2Set) {
+          if (ESGRecords && !VisitedStreamedEdges.emplace(N1, N2, D1).second) {
+            return;
           }
-          BOOST_LOG_SEV(lg::get(), DEBUG) << "----";
-        }());
-      }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-    }
-
-    // Stores all pairs of (Startpoint, Fact) for which a summary was applied
-    std::set<std::pair<n_t, d_t>> ProcessSummaryFacts;
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "==============================================";
-                  BOOST_LOG_SEV(lg::get(), DEBUG) << "INTER PATH EDGES");
-    for (auto cell : computedInterPathEdges.cellSet()) {
-      auto Edge = std::make_pair(cell.getRowKey(), cell.getColumnKey());
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "N1: " << IDEProblem.NtoString(Edge.first);
-                    BOOST_LOG_SEV(lg::get(), DEBUG)
-                    << "N2: " << IDEProblem.NtoString(Edge.second));
-      /* --- Call-flow Path Edges ---
-       * Case 1: d1 --> empty set
-       *   Can be ignored, since killing a fact in the caller context will
-       *   actually happen during  call-to-return.
-       *
-       * Case 2: d1 --> d2-Set
-       *   Every fact d_i != ZeroValue in d2-set will be generated in the
-       * callee context, thus counts as a new fact. Even if d1 is passed as it
-       * is, it will count as a new fact. The reason for this is, that d1 can
-       * be killed in the callee context, but still be valid in the caller
-       * context.
-       *
-       * Special Case: Summary was applied for a particular call
-       *   Process the summary's #gen and #kill.
-       */
-      if (ICF->isCallStmt(Edge.first)) {
-        for (auto D1ToD2Set : cell.getValue()) {
-          auto D1 = D1ToD2Set.first;
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                            << "N1: " << IDEProblem.NtoString(N1);
+                        BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "N2: " << IDEProblem.NtoString(N2);
+                        BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "d1: " << IDEProblem.DtoString(D1));
-          auto DSet = D1ToD2Set.second;
-          interPathEdges += DSet.size();
-          for (auto D2 : DSet) {
-            if (!IDEProblem.isZeroValue(D2)) {
-              genFacts++;
+          std::size_t NumD2 = 0;
+          bool ContainsD1 = false;
+          for (d_t D2 : D2Set) {
+            ++NumD2;
+            ContainsD1 |= D2 == D1;
+            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                          << "d2: " << IDEProblem.DtoString(D2));
+          }
+          if (!InterP) {
+            /* --- Intra-procedural Path Edges ---
+             * d1 --> d2-Set
+             * Case 1: d1 in d2-Set
+             * Case 2: d1 not in d2-Set, i.e. d1 was killed. d2-Set could be
+             * empty.
+             */
+            intraPathEdges += NumD2;
+            // Case 1
+            if (ContainsD1) {
+              genFacts += NumD2 - 1;
             }
-            // Special case
-            if (ProcessSummaryFacts.find(std::make_pair(Edge.second, D2)) !=
-                ProcessSummaryFacts.end()) {
-              std::multiset<d_t> SummaryDMultiSet =
-                  endsummarytab.get(Edge.second, D2).columnKeySet();
-              // remove duplicates from multiset
-              std::set<d_t> SummaryDSet(SummaryDMultiSet.begin(),
-                                        SummaryDMultiSet.end());
-              // Process summary just as an intra-procedural edge
-              if (SummaryDSet.find(D2) != SummaryDSet.end()) {
-                genFacts += SummaryDSet.size() - 1;
-              } else {
-                genFacts += SummaryDSet.size();
-                // We ignore the zero value
-                if (!IDEProblem.isZeroValue(D1)) {
-                  killFacts++;
-                }
+            // Case 2
+            else {
+              genFacts += NumD2;
+              // We ignore the zero value
+              if (!IDEProblem.isZeroValue(D1)) {
+                killFacts++;
               }
-            } else {
-              ProcessSummaryFacts.emplace(Edge.second, D2);
             }
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "d2: " << IDEProblem.DtoString(D2));
+            // Store all valid facts after call-to-return flow
+            if (ICF->isCallStmt(N1)) {
+              for (d_t D2 : D2Set) {
+                ValidInCallerContext[N2].insert(D2);
+              }
+            }
+            return;
           }
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "----");
-        }
-      }
-      /* --- Return-flow Path Edges ---
-       * Since every fact passed to the callee was counted as a new fact, we
-       * have to count every fact propagated to the caller as a kill to
-       * satisfy our invariant. Obviously, every fact not propagated to the
-       * caller will count as a kill. If an actual new fact is propagated to
-       * the caller, we have to increase the number of generated facts by one.
-       * Zero value does not count towards generated/killed facts.
-       */
-      if (ICF->isExitStmt(cell.getRowKey())) {
-        for (auto D1ToD2Set : cell.getValue()) {
-          auto D1 = D1ToD2Set.first;
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "d1: " << IDEProblem.DtoString(D1));
-          auto DSet = D1ToD2Set.second;
-          interPathEdges += DSet.size();
-          auto CallerFacts = ValidInCallerContext[Edge.second];
-          for (auto D2 : DSet) {
-            // d2 not valid in caller context
-            if (CallerFacts.find(D2) == CallerFacts.end()) {
-              genFacts++;
+          /* --- Call-flow Path Edges ---
+           * Case 1: d1 --> empty set
+           *   Can be ignored, since killing a fact in the caller context will
+           *   actually happen during  call-to-return.
+           *
+           * Case 2: d1 --> d2-Set
+           *   Every fact d_i != ZeroValue in d2-set will be generated in the
+           * callee context, thus counts as a new fact. Even if d1 is passed as
+           * it is, it will count as a new fact. The reason for this is, that
+           * d1 can be killed in the callee context, but still be valid in the
+           * caller context.
+           *
+           * Special Case: Summary was applied for a particular call
+           *   Process the summary's #gen and #kill.
+           */
+          if (ICF->isCallStmt(N1)) {
+            interPathEdges += NumD2;
+            for (d_t D2 : D2Set) {
+              if (!IDEProblem.isZeroValue(D2)) {
+                genFacts++;
+              }
+              // Special case
+              if (ProcessSummaryFacts.find(std::make_pair(N2, D2)) !=
+                  ProcessSummaryFacts.end()) {
+                std::multiset<d_t> SummaryDMultiSet =
+                    endsummarytab[summaryShardIndex(N2, D2)]
+                        .get(N2, D2)
+                        .columnKeySet();
+                // remove duplicates from multiset
+                std::set<d_t> SummaryDSet(SummaryDMultiSet.begin(),
+                                          SummaryDMultiSet.end());
+                // Process summary just as an intra-procedural edge
+                if (SummaryDSet.find(D2) != SummaryDSet.end()) {
+                  genFacts += SummaryDSet.size() - 1;
+                } else {
+                  genFacts += SummaryDSet.size();
+                  // We ignore the zero value
+                  if (!IDEProblem.isZeroValue(D1)) {
+                    killFacts++;
+                  }
+                }
+              } else {
+                ProcessSummaryFacts.emplace(N2, D2);
+              }
             }
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "d2: " << IDEProblem.DtoString(D2));
           }
-          if (!IDEProblem.isZeroValue(D1)) {
-            killFacts++;
+          /* --- Return-flow Path Edges ---
+           * Since every fact passed to the callee was counted as a new fact,
+           * we have to count every fact propagated to the caller as a kill to
+           * satisfy our invariant. Obviously, every fact not propagated to
+           * the caller will count as a kill. If an actual new fact is
+           * propagated to the caller, we have to increase the number of
+           * generated facts by one. Zero value does not count towards
+           * generated/killed facts.
+           */
+          if (ICF->isExitStmt(N1)) {
+            interPathEdges += NumD2;
+            for (d_t D2 : D2Set) {
+              ++ReturnedFacts[N2][D2];
+            }
+            if (!IDEProblem.isZeroValue(D1)) {
+              killFacts++;
+            }
           }
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "----");
+        },
+        [](n_t, d_t, n_t, d_t, llvm::StringRef) {});
+    for (const auto &[RetSite, Facts] : ReturnedFacts) {
+      const auto &CallerFacts = ValidInCallerContext[RetSite];
+      for (const auto &[D2, NumReturned] : Facts) {
+        // d2 not valid in caller context
+        if (CallerFacts.find(D2) == CallerFacts.end()) {
+          genFacts += NumReturned;
         }
       }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
     }
+
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "SUMMARY REUSE");
     std::size_t TotalSummaryReuse = 0;
     for (auto entry : fSummaryReuse) {
@@ -1573,6 +2238,8 @@ protected:
     INC_COUNTER("Summary-reuse", TotalSummaryReuse, PAMM_SEVERITY_LEVEL::Core);
     INC_COUNTER("Intra Path Edges", intraPathEdges, PAMM_SEVERITY_LEVEL::Core);
     INC_COUNTER("Inter Path Edges", interPathEdges, PAMM_SEVERITY_LEVEL::Core);
+    INC_COUNTER("Worklist Peak Size", WorklistPeakSize,
+                PAMM_SEVERITY_LEVEL::Full);
 
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                       << "----------------------------------------------";
@@ -1605,6 +2272,19 @@ protected:
           BOOST_LOG_SEV(lg::get(), INFO) << "Jump function construciton count: "
                                          << GET_COUNTER("JumpFn Construction");
           BOOST_LOG_SEV(lg::get(), INFO)
+          << "Memoized edge function compositions/joins reused: "
+          << GET_COUNTER("EF Compose Memo Hit") << '/'
+          << GET_COUNTER("EF Join Memo Hit");
+          BOOST_LOG_SEV(lg::get(), INFO)
+          << "Worklist (" << SolverConfig.worklistKind()
+          << ") push count: " << GET_COUNTER("Worklist Pushes");
+          BOOST_LOG_SEV(lg::get(), INFO)
+          << "Worklist peak size: " << GET_COUNTER("Worklist Peak Size");
+          BOOST_LOG_SEV(lg::get(), INFO)
+          << "Collected jump functions: " << GET_COUNTER("Collected JumpFn")
+          << " (retabulated procedures: "
+          << GET_COUNTER("Retabulated Procedures") << ')';
+          BOOST_LOG_SEV(lg::get(), INFO)
           << "Phase I duration: " << PRINT_TIMER("DFA Phase I");
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Phase II duration: " << PRINT_TIMER("DFA Phase II");
@@ -1621,226 +2301,185 @@ public:
   emitESGAsDot(std::ostream &OS = std::cout,
                std::string DotConfigDir = PhasarConfig::PhasarDirectory()) {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "Emit Exploded super-graph (ESG) as DOT graph";
-                  BOOST_LOG_SEV(lg::get(), DEBUG)
-                  << "Process intra-procedural path egdes";
-                  BOOST_LOG_SEV(lg::get(), DEBUG)
-                  << "=============================================");
+                  << "Emit Exploded super-graph (ESG) as DOT graph");
     DOTGraph<d_t> G;
     DOTConfig::importDOTConfig(std::move(DotConfigDir));
-    DOTFunctionSubGraph *FG = nullptr;
-
-    // Sort intra-procedural path edges
-    auto cells = computedIntraPathEdges.cellVec();
-    StmtLess stmtless(ICF);
-    sort(cells.begin(), cells.end(), [&stmtless](auto a, auto b) {
-      return stmtless(a.getRowKey(), b.getRowKey());
-    });
-    for (auto cell : cells) {
-      auto Edge = std::make_pair(cell.getRowKey(), cell.getColumnKey());
-      std::string n1_label = IDEProblem.NtoString(Edge.first);
-      std::string n2_label = IDEProblem.NtoString(Edge.second);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "N1: " << n1_label;
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << "N2: " << n2_label);
-      std::string n1_stmtId = ICF->getStatementId(Edge.first);
-      std::string n2_stmtId = ICF->getStatementId(Edge.second);
-      std::string fnName = ICF->getFunctionOf(Edge.first)->getName().str();
-      // Get or create function subgraph
-      if (!FG || FG->id != fnName) {
-        FG = &G.functions[fnName];
-        FG->id = fnName;
+    // The records are visited in a single pass and in no particular order.
+    // Fact-IDs are thus assigned up front, in the order of the facts, such
+    // that the graph does not depend on the order of the records.
+    for (d_t Fact : getRecordedFacts()) {
+      if (!IDEProblem.isZeroValue(Fact)) {
+        G.getFactID(Fact);
       }
-
+    }
+    // labels of edge functions that have been read before their path edge
+    std::map<std::tuple<n_t, d_t, n_t, d_t>, std::string> PendingEFLabels;
+
+    auto getFunctionName = [this](n_t n) {
+      return ICF->getFunctionOf(n)->getName().str();
+    };
+    auto getFunctionSG = [&G](const std::string &fnName) {
+      DOTFunctionSubGraph *FG = &G.functions[fnName];
+      FG->id = fnName;
+      return FG;
+    };
+    auto makeFactNode = [&](const std::string &fnName, n_t n, d_t d) {
+      if (IDEProblem.isZeroValue(d)) {
+        return DOTNode(fnName, "Λ", ICF->getStatementId(n), 0, false, true);
+      }
+      return DOTNode(fnName, IDEProblem.DtoString(d), ICF->getStatementId(n),
+                     G.getFactID(d), false, true);
+    };
+    auto takePendingEFLabel = [&](n_t n1, d_t d1, n_t n2, d_t d2) {
+      std::string EFLabel;
+      if (auto Search = PendingEFLabels.find(std::make_tuple(n1, d1, n2, d2));
+          Search != PendingEFLabels.end()) {
+        EFLabel = std::move(Search->second);
+        PendingEFLabels.erase(Search);
+      }
+      return EFLabel;
+    };
+
+    auto addIntraPathEdges = [&](n_t n1, n_t n2, d_t d1, const auto &D2Set) {
+      std::string fnName = getFunctionName(n1);
+      std::string n1_stmtId = ICF->getStatementId(n1);
+      std::string n2_stmtId = ICF->getStatementId(n2);
+      DOTFunctionSubGraph *FG = getFunctionSG(fnName);
       // Create control flow nodes
-      DOTNode N1(fnName, n1_label, n1_stmtId);
-      DOTNode N2(fnName, n2_label, n2_stmtId);
+      DOTNode N1(fnName, IDEProblem.NtoString(n1), n1_stmtId);
+      DOTNode N2(fnName, IDEProblem.NtoString(n2), n2_stmtId);
       // Add control flow node(s) to function subgraph
       FG->stmts.insert(N1);
-      if (ICF->isExitStmt(Edge.second)) {
+      if (ICF->isExitStmt(n2)) {
         FG->stmts.insert(N2);
       }
-
       // Set control flow edge
       FG->intraCFEdges.emplace(N1, N2);
 
+      DOTNode D1 = makeFactNode(fnName, n1, d1);
       DOTFactSubGraph *D1_FSG = nullptr;
-      unsigned D1FactId = 0;
-      unsigned D2FactId = 0;
-      for (auto D1ToD2Set : cell.getValue()) {
-        auto D1Fact = D1ToD2Set.first;
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "d1: " << IDEProblem.DtoString(D1Fact));
-
-        DOTNode D1;
-        if (IDEProblem.isZeroValue(D1Fact)) {
-          D1 = {fnName, "Λ", n1_stmtId, 0, false, true};
-          D1FactId = 0;
+      if (!IDEProblem.isZeroValue(d1)) {
+        // Get or create the fact subgraph and insert D1
+        D1_FSG = FG->getOrCreateFactSG(D1.factId, D1.label);
+        D1_FSG->nodes.insert(std::make_pair(n1_stmtId, D1));
+      }
+      for (d_t d2 : D2Set) {
+        // We do not need to generate any intra-procedural nodes and edges
+        // for the zero value since they will be auto-generated
+        if (IDEProblem.isZeroValue(d2)) {
+          continue;
+        }
+        DOTNode D2 = makeFactNode(fnName, n2, d2);
+        std::string EFLabel = takePendingEFLabel(n1, d1, n2, d2);
+        if (D1_FSG && D1.factId == D2.factId) {
+          D1_FSG->nodes.insert(std::make_pair(n2_stmtId, D2));
+          D1_FSG->edges.emplace(D1, D2, true, std::move(EFLabel));
         } else {
-          // Get the fact-ID
-          D1FactId = G.getFactID(D1Fact);
-          std::string d1_label = IDEProblem.DtoString(D1Fact);
-
           // Get or create the fact subgraph
-          D1_FSG = FG->getOrCreateFactSG(D1FactId, d1_label);
-
-          // Insert D1 to fact subgraph
-          D1 = {fnName, d1_label, n1_stmtId, D1FactId, false, true};
-          D1_FSG->nodes.insert(std::make_pair(n1_stmtId, D1));
+          DOTFactSubGraph *D2_FSG = FG->getOrCreateFactSG(D2.factId, D2.label);
+          D2_FSG->nodes.insert(std::make_pair(n2_stmtId, D2));
+          FG->crossFactEdges.emplace(D1, D2, true, std::move(EFLabel));
         }
-
-        DOTFactSubGraph *D2_FSG = nullptr;
-        for (auto D2Fact : D1ToD2Set.second) {
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "d2: " << IDEProblem.DtoString(D2Fact));
-          // We do not need to generate any intra-procedural nodes and edges
-          // for the zero value since they will be auto-generated
-          if (!IDEProblem.isZeroValue(D2Fact)) {
-            // Get the fact-ID
-            D2FactId = G.getFactID(D2Fact);
-            std::string d2_label = IDEProblem.DtoString(D2Fact);
-            DOTNode D2 = {fnName, d2_label, n2_stmtId, D2FactId, false, true};
-            std::string EFLabel;
-            auto EFVec = intermediateEdgeFunctions[std::make_tuple(
-                Edge.first, D1Fact, Edge.second, D2Fact)];
-            for (auto EF : EFVec) {
-              EFLabel += EF->str() + ", ";
-            }
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "EF LABEL: " << EFLabel);
-            if (D1FactId == D2FactId && !IDEProblem.isZeroValue(D1Fact)) {
-              D1_FSG->nodes.insert(std::make_pair(n2_stmtId, D2));
-              D1_FSG->edges.emplace(D1, D2, true, EFLabel);
-            } else {
-              // Get or create the fact subgraph
-              D2_FSG = FG->getOrCreateFactSG(D2FactId, d2_label);
-
-              D2_FSG->nodes.insert(std::make_pair(n2_stmtId, D2));
-              FG->crossFactEdges.emplace(D1, D2, true, EFLabel);
-            }
-          }
-        }
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "----------");
       }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-    }
-
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "=============================================";
-                  BOOST_LOG_SEV(lg::get(), DEBUG)
-                  << "Process inter-procedural path edges";
-                  BOOST_LOG_SEV(lg::get(), DEBUG)
-                  << "=============================================");
-    cells = computedInterPathEdges.cellVec();
-    sort(cells.begin(), cells.end(), [&stmtless](auto a, auto b) {
-      return stmtless(a.getRowKey(), b.getRowKey());
-    });
-    for (auto cell : cells) {
-      auto Edge = std::make_pair(cell.getRowKey(), cell.getColumnKey());
-      std::string n1_label = IDEProblem.NtoString(Edge.first);
-      std::string n2_label = IDEProblem.NtoString(Edge.second);
-      std::string fNameOfN1 = ICF->getFunctionOf(Edge.first)->getName().str();
-      std::string fNameOfN2 = ICF->getFunctionOf(Edge.second)->getName().str();
-      std::string n1_stmtId = ICF->getStatementId(Edge.first);
-      std::string n2_stmtId = ICF->getStatementId(Edge.second);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "N1: " << n1_label;
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << "N2: " << n2_label);
+    };
 
+    auto addInterPathEdges = [&](n_t n1, n_t n2, d_t d1, const auto &D2Set) {
+      std::string fNameOfN1 = getFunctionName(n1);
+      std::string fNameOfN2 = getFunctionName(n2);
+      std::string n1_stmtId = ICF->getStatementId(n1);
+      std::string n2_stmtId = ICF->getStatementId(n2);
       // Add inter-procedural control flow edge
-      DOTNode N1(fNameOfN1, n1_label, n1_stmtId);
-      DOTNode N2(fNameOfN2, n2_label, n2_stmtId);
-
+      DOTNode N1(fNameOfN1, IDEProblem.NtoString(n1), n1_stmtId);
+      DOTNode N2(fNameOfN2, IDEProblem.NtoString(n2), n2_stmtId);
       // Handle recursion control flow as intra-procedural control flow
       // since those eges never leave the function subgraph
-      FG = nullptr;
       if (fNameOfN1 == fNameOfN2) {
-        // This function subgraph is guaranteed to exist
-        FG = &G.functions[fNameOfN1];
-        FG->intraCFEdges.emplace(N1, N2);
+        getFunctionSG(fNameOfN1)->intraCFEdges.emplace(N1, N2);
       } else {
-        // Check the case where the callee is a single statement function,
-        // thus does not contain intra-procedural path edges. We have to
-        // generate the function sub graph here!
-        if (!G.functions.count(fNameOfN1)) {
-          FG = &G.functions[fNameOfN1];
-          FG->id = fNameOfN1;
-          FG->stmts.insert(N1);
-        } else if (!G.functions.count(fNameOfN2)) {
-          FG = &G.functions[fNameOfN2];
-          FG->id = fNameOfN2;
-          FG->stmts.insert(N2);
-        }
+        // The callee may be a single statement function, thus does not
+        // contain intra-procedural path edges. We have to add its statement
+        // to its function sub graph here!
+        getFunctionSG(fNameOfN1)->stmts.insert(N1);
+        getFunctionSG(fNameOfN2)->stmts.insert(N2);
         G.interCFEdges.emplace(N1, N2);
       }
 
       // Create D1 and D2, if D1 == D2 == lambda then add Edge(D1, D2) to
       // interLambdaEges otherwise add Edge(D1, D2) to interFactEdges
-      unsigned D1FactId = 0;
-      unsigned D2FactId = 0;
-      for (auto D1ToD2Set : cell.getValue()) {
-        auto D1Fact = D1ToD2Set.first;
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "d1: " << IDEProblem.DtoString(D1Fact));
-        DOTNode D1;
-        if (IDEProblem.isZeroValue(D1Fact)) {
-          D1 = {fNameOfN1, "Λ", n1_stmtId, 0, false, true};
-        } else {
-          // Get the fact-ID
-          D1FactId = G.getFactID(D1Fact);
-          std::string d1_label = IDEProblem.DtoString(D1Fact);
-          D1 = {fNameOfN1, d1_label, n1_stmtId, D1FactId, false, true};
-          // FG should already exist even for single statement functions
-          if (!G.containsFactSG(fNameOfN1, D1FactId)) {
-            FG = &G.functions[fNameOfN1];
-            auto *D1_FSG = FG->getOrCreateFactSG(D1FactId, d1_label);
-            D1_FSG->nodes.insert(std::make_pair(n1_stmtId, D1));
+      DOTNode D1 = makeFactNode(fNameOfN1, n1, d1);
+      if (!IDEProblem.isZeroValue(d1)) {
+        getFunctionSG(fNameOfN1)
+            ->getOrCreateFactSG(D1.factId, D1.label)
+            ->nodes.insert(std::make_pair(n1_stmtId, D1));
+      }
+      for (d_t d2 : D2Set) {
+        DOTNode D2 = makeFactNode(fNameOfN2, n2, d2);
+        if (!IDEProblem.isZeroValue(d2)) {
+          getFunctionSG(fNameOfN2)
+              ->getOrCreateFactSG(D2.factId, D2.label)
+              ->nodes.insert(std::make_pair(n2_stmtId, D2));
+        }
+        if (IDEProblem.isZeroValue(d1) && IDEProblem.isZeroValue(d2)) {
+          // Do not add lambda recursion edges as inter-procedural edges
+          if (D1.funcName != D2.funcName) {
+            G.interLambdaEdges.emplace(D1, D2, true, "AllBottom", "BOT");
           }
+        } else {
+          G.interFactEdges.emplace(D1, D2, true,
+                                   takePendingEFLabel(n1, d1, n2, d2));
         }
+      }
+    };
 
-        auto D2Set = D1ToD2Set.second;
-        for (auto D2Fact : D2Set) {
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "d2: " << IDEProblem.DtoString(D2Fact));
-          DOTNode D2;
-          if (IDEProblem.isZeroValue(D2Fact)) {
-            D2 = {fNameOfN2, "Λ", n2_stmtId, 0, false, true};
-          } else {
-            // Get the fact-ID
-            D2FactId = G.getFactID(D2Fact);
-            std::string d2_label = IDEProblem.DtoString(D2Fact);
-            D2 = {fNameOfN2, d2_label, n2_stmtId, D2FactId, false, true};
-            // FG should already exist even for single statement functions
-            if (!G.containsFactSG(fNameOfN2, D2FactId)) {
-              FG = &G.functions[fNameOfN2];
-              auto *D2_FSG = FG->getOrCreateFactSG(D2FactId, d2_label);
-              D2_FSG->nodes.insert(std::make_pair(n2_stmtId, D2));
-            }
+    // Appends the label to the fact edge <n1, d1> --> <n2, d2>, which may be
+    // an intra- or an inter-procedural edge
+    auto addEdgeFunctionLabel = [&](n_t n1, d_t d1, n_t n2, d_t d2,
+                                    llvm::StringRef Label) {
+      std::string EFLabel = Label.str() + ", ";
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "Partial EF Label: " << EFLabel);
+      std::string fNameOfN1 = getFunctionName(n1);
+      DOTNode D1 = makeFactNode(fNameOfN1, n1, d1);
+      DOTNode D2 = makeFactNode(getFunctionName(n2), n2, d2);
+      auto appendTo = [&](std::set<DOTEdge> &Edges) {
+        auto Search = Edges.find(DOTEdge(D1, D2));
+        if (Search == Edges.end()) {
+          return false;
+        }
+        // the label is not part of an edge's key
+        auto Node = Edges.extract(Search);
+        Node.value().edgeFnLabel += EFLabel;
+        Edges.insert(std::move(Node));
+        return true;
+      };
+      if (!IDEProblem.isZeroValue(d2)) {
+        if (auto FG = G.functions.find(fNameOfN1); FG != G.functions.end()) {
+          if (auto FSG = FG->second.facts.find(D1.factId);
+              !IDEProblem.isZeroValue(d1) && D1.factId == D2.factId &&
+              FSG != FG->second.facts.end() && appendTo(FSG->second.edges)) {
+            return;
           }
-
-          if (IDEProblem.isZeroValue(D1Fact) &&
-              IDEProblem.isZeroValue(D2Fact)) {
-            // Do not add lambda recursion edges as inter-procedural edges
-            if (D1.funcName != D2.funcName) {
-              G.interLambdaEdges.emplace(D1, D2, true, "AllBottom", "BOT");
-            }
-          } else {
-            // std::string EFLabel = EF ? EF->str() : " ";
-            std::string EFLabel;
-            auto EFVec = intermediateEdgeFunctions[std::make_tuple(
-                Edge.first, D1Fact, Edge.second, D2Fact)];
-            for (auto EF : EFVec) {
-              LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                            << "Partial EF Label: " << EF->str());
-              EFLabel.append(EF->str() + ", ");
-            }
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "EF LABEL: " << EFLabel);
-            G.interFactEdges.emplace(D1, D2, true, EFLabel);
+          if (appendTo(FG->second.crossFactEdges)) {
+            return;
           }
         }
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "----------");
       }
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-    }
+      if (!(IDEProblem.isZeroValue(d1) && IDEProblem.isZeroValue(d2)) &&
+          appendTo(G.interFactEdges)) {
+        return;
+      }
+      PendingEFLabels[std::make_tuple(n1, d1, n2, d2)] += EFLabel;
+    };
+
+    forEachRecord(
+        [&](bool InterP, n_t n1, n_t n2, d_t d1, const auto &D2Set) {
+          if (InterP) {
+            addInterPathEdges(n1, n2, d1, D2Set);
+          } else {
+            addIntraPathEdges(n1, n2, d1, D2Set);
+          }
+        },
+        addEdgeFunctionLabel);
     OS << G;
   }
 
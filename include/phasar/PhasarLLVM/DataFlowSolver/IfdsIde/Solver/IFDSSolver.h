@@ -30,15 +30,18 @@ namespace psr {
 
 template <typename OriginalAnalysisDomain> struct AnalysisDomainExtender;
 
-template <typename AnalysisDomainTy>
-class IFDSSolver : public IDESolver<AnalysisDomainExtender<AnalysisDomainTy>> {
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class IFDSSolver
+    : public IDESolver<AnalysisDomainExtender<AnalysisDomainTy>, Container> {
 public:
-  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy>;
+  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy, Container>;
   using D = typename AnalysisDomainTy::d_t;
   using N = typename AnalysisDomainTy::n_t;
 
-  IFDSSolver(IFDSTabulationProblem<AnalysisDomainTy> &ifdsProblem)
-      : IDESolver<AnalysisDomainExtender<AnalysisDomainTy>>(ifdsProblem) {}
+  IFDSSolver(IFDSTabulationProblem<AnalysisDomainTy, Container> &ifdsProblem)
+      : IDESolver<AnalysisDomainExtender<AnalysisDomainTy>, Container>(
+            ifdsProblem) {}
 
   ~IFDSSolver() override = default;
 
@@ -53,10 +56,12 @@ public:
 };
 
 template <typename Problem>
-IFDSSolver(Problem &) -> IFDSSolver<typename Problem::ProblemAnalysisDomain>;
+IFDSSolver(Problem &) -> IFDSSolver<typename Problem::ProblemAnalysisDomain,
+                                    typename Problem::container_type>;
 
 template <typename Problem>
-using IFDSSolver_P = IFDSSolver<typename Problem::ProblemAnalysisDomain>;
+using IFDSSolver_P = IFDSSolver<typename Problem::ProblemAnalysisDomain,
+                                typename Problem::container_type>;
 
 } // namespace psr
 
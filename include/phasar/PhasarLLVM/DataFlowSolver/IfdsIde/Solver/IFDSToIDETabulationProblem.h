@@ -65,13 +65,16 @@ public:
   IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem;
 
   IFDSToIDETabulationProblem(
-      IFDSTabulationProblem<AnalysisDomainTy> &IFDSProblem)
-      : IDETabulationProblem<AnalysisDomainExtender<AnalysisDomainTy>>(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem)
+      : IDETabulationProblem<AnalysisDomainExtender<AnalysisDomainTy>,
+                             Container>(
             IFDSProblem.getProjectIRDB(), IFDSProblem.getTypeHierarchy(),
             IFDSProblem.getICFG(), IFDSProblem.getPointstoInfo(),
             IFDSProblem.getEntryPoints()),
         Problem(IFDSProblem) {
     this->ZeroValue = Problem.createZeroValue();
+    // the solver is configured through the transformed problem
+    this->SolverConfig = IFDSProblem.getIFDSIDESolverConfig();
   }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) override {
@@ -177,6 +180,10 @@ public:
   void printEdgeFact(std::ostream &os, BinaryDomain v) const override {
     os << v;
   }
+
+  [[nodiscard]] bool isThreadSafe() const override {
+    return Problem.isThreadSafe();
+  }
 };
 
 } // namespace psr
@@ -17,16 +17,24 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <ostream>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/ErrorHandling.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FlatJumpFunctionsStorage.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctionsStorage.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/Table.h"
@@ -52,34 +60,62 @@ private:
   const IDETabulationProblem<AnalysisDomainTy, Container> &problem;
 
 protected:
-  // mapping from target node and value to a list of all source values and
-  // associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<n_t, d_t, llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>
-      nonEmptyReverseLookup;
-  // mapping from source value and target node to a list of all target values
-  // and associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<d_t, n_t, llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>
-      nonEmptyForwardLookup;
-  // a mapping from target node to a list of triples consisting of source value,
-  // target value and associated function; the triple is implemented by a table
-  // we exclude empty default functions
-  std::unordered_map<n_t, Table<d_t, d_t, EdgeFunctionPtrType>>
-      nonEmptyLookupByTargetNode;
+  // All jump functions that share the same target node are stored in the
+  // same shard. Different shards may be accessed concurrently.
+  std::vector<std::unique_ptr<JumpFunctionsStorage<AnalysisDomainTy>>> Shards;
+
+  JumpFunctionsStorage<AnalysisDomainTy> &getShard(n_t target) {
+    return *Shards[getShardIndex(target)];
+  }
+
+  static std::unique_ptr<JumpFunctionsStorage<AnalysisDomainTy>>
+  makeStorage(JumpFunctionsKind Kind) {
+    switch (Kind) {
+    case JumpFunctionsKind::Nested:
+      return std::make_unique<NestedJumpFunctionsStorage<AnalysisDomainTy>>();
+      break;
+    case JumpFunctionsKind::Flat:
+      return std::make_unique<FlatJumpFunctionsStorage<AnalysisDomainTy>>();
+      break;
+    default:
+      llvm::report_fatal_error("Jump functions kind not properly instantiated");
+      break;
+    }
+  }
 
 public:
   JumpFunctions(EdgeFunctionPtrType allTop,
-                const IDETabulationProblem<AnalysisDomainTy, Container> &p)
-      : allTop(std::move(allTop)), problem(p) {}
+                const IDETabulationProblem<AnalysisDomainTy, Container> &p,
+                size_t NumShards = 1,
+                JumpFunctionsKind Kind = JumpFunctionsKind::Nested)
+      : allTop(std::move(allTop)), problem(p) {
+    Shards.reserve(std::max(NumShards, size_t(1)));
+    for (size_t Idx = 0; Idx < std::max(NumShards, size_t(1)); ++Idx) {
+      Shards.push_back(makeStorage(Kind));
+    }
+  }
 
   ~JumpFunctions() = default;
 
-  JumpFunctions(const JumpFunctions &JFs) = default;
-  JumpFunctions &operator=(const JumpFunctions &JFs) = default;
+  JumpFunctions(const JumpFunctions &JFs) = delete;
+  JumpFunctions &operator=(const JumpFunctions &JFs) = delete;
   JumpFunctions(JumpFunctions &&JFs) noexcept = default;
   JumpFunctions &operator=(JumpFunctions &&JFs) noexcept = default;
 
+  [[nodiscard]] size_t getNumShards() const { return Shards.size(); }
+
+  /**
+   * Returns the index of the shard that holds all jump functions with the
+   * given target node. Clients that access the jump functions concurrently
+   * have to synchronize all accesses to the same shard.
+   */
+  [[nodiscard]] size_t getShardIndex(n_t target) const {
+    if (Shards.size() == 1) {
+      return 0;
+    }
+    return llvm::hash_combine(std::hash<n_t>{}(target)) % Shards.size();
+  }
+
   /**
    * Records a jump function. The source statement is implicit.
    * @see PathEdge
@@ -100,35 +136,8 @@ public:
     if (function->equal_to(allTop)) {
       return;
     }
-
-    auto &SourceValToFunc = nonEmptyReverseLookup.get(target, targetVal);
-    if (auto Find = std::find_if(
-            SourceValToFunc.begin(), SourceValToFunc.end(),
-            [sourceVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return sourceVal == Entry.first;
-            });
-        Find != SourceValToFunc.end()) {
-      // it is important that existing values in JumpFunctions are overwritten
-      Find->second = function;
-    } else {
-      SourceValToFunc.emplace_back(sourceVal, function);
-    }
-
-    auto &TargetValToFunc = nonEmptyForwardLookup.get(sourceVal, target);
-    if (auto Find = std::find_if(
-            TargetValToFunc.begin(), TargetValToFunc.end(),
-            [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return targetVal == Entry.first;
-            });
-        Find != TargetValToFunc.end()) {
-      // it is important that existing values in JumpFunctions are overwritten
-      Find->second = function;
-    } else {
-      TargetValToFunc.emplace_back(targetVal, function);
-    }
-
-    // V Table::insert(R r, C c, V v) always overrides (see comments above)
-    nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal, function);
+    getShard(target).addFunction(sourceVal, target, targetVal,
+                                 std::move(function));
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "End adding new jump function";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -142,11 +151,10 @@ public:
   std::optional<std::reference_wrapper<
       llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>>
   reverseLookup(n_t target, d_t targetVal) {
-    if (!nonEmptyReverseLookup.contains(target, targetVal)) {
-      return std::nullopt;
-    } else {
-      return {nonEmptyReverseLookup.get(target, targetVal)};
+    if (auto *Entries = getShard(target).reverseLookup(target, targetVal)) {
+      return {*Entries};
     }
+    return std::nullopt;
   }
 
   /**
@@ -157,11 +165,10 @@ public:
   std::optional<std::reference_wrapper<
       llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>>
   forwardLookup(d_t sourceVal, n_t target) {
-    if (!nonEmptyForwardLookup.contains(sourceVal, target)) {
-      return std::nullopt;
-    } else {
-      return {nonEmptyForwardLookup.get(sourceVal, target)};
+    if (auto *Entries = getShard(target).forwardLookup(sourceVal, target)) {
+      return {*Entries};
     }
+    return std::nullopt;
   }
 
   /**
@@ -170,8 +177,8 @@ public:
    * The return value is a set of records of the form
    * (sourceVal,targetVal,edgeFunction).
    */
-  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) {
-    return nonEmptyLookupByTargetNode[target];
+  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) const {
+    return Shards[getShardIndex(target)]->lookupByTarget(target);
   }
 
   /**
@@ -181,95 +188,90 @@ public:
    * there anyway.
    */
   bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) {
-    auto &SourceValToFunc = nonEmptyReverseLookup.get(target, targetVal);
-    if (auto Find = std::find_if(
-            SourceValToFunc.begin(), SourceValToFunc.end(),
-            [sourceVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return sourceVal == Entry.first;
-            });
-        Find != SourceValToFunc.end()) {
-      SourceValToFunc.erase(Find);
-    }
-    auto &TargetValToFunc = nonEmptyForwardLookup.get(sourceVal, target);
-    if (auto Find = std::find_if(
-            TargetValToFunc.begin(), TargetValToFunc.end(),
-            [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return targetVal == Entry.first;
-            });
-        Find != TargetValToFunc.end()) {
-      TargetValToFunc.erase(Find);
-    }
-    return nonEmptyLookupByTargetNode.erase(target);
+    return getShard(target).removeFunction(sourceVal, target, targetVal);
+  }
+
+  /**
+   * Removes all jump functions with the given target statement.
+   * @return The number of removed functions.
+   */
+  size_t removeFunctionsAt(n_t target) {
+    return getShard(target).removeFunctionsAt(target);
   }
 
   /**
    * Removes all jump functions
    */
   void clear() {
-    nonEmptyReverseLookup.clear();
-    nonEmptyForwardLookup.clear();
-    nonEmptyLookupByTargetNode.clear();
+    for (auto &S : Shards) {
+      S->clear();
+    }
   }
 
   void printJumpFunctions(std::ostream &os) {
     os << "\n******************************************************";
     os << "\n*              Print all Jump Functions              *";
     os << "\n******************************************************\n";
-    for (auto &entry : nonEmptyLookupByTargetNode) {
-      std::string nLabel = problem.NtoString(entry.first);
-      os << "\nN: " << nLabel << "\n---" << std::string(nLabel.size(), '-')
-         << '\n';
-      for (auto cell : entry.second.cellSet()) {
-        os << "D1: " << problem.DtoString(cell.r) << '\n'
-           << "\tD2: " << problem.DtoString(cell.c) << '\n'
-           << "\tEF: " << cell.v->str() << "\n\n";
-      }
+    for (auto &S : Shards) {
+      S->visitTargets([&](n_t Target) {
+        std::string nLabel = problem.NtoString(Target);
+        os << "\nN: " << nLabel << "\n---" << std::string(nLabel.size(), '-')
+           << '\n';
+        for (auto cell : S->lookupByTarget(Target).cellSet()) {
+          os << "D1: " << problem.DtoString(cell.getRowKey()) << '\n'
+             << "\tD2: " << problem.DtoString(cell.getColumnKey()) << '\n'
+             << "\tEF: " << cell.getValue()->str() << "\n\n";
+        }
+      });
     }
   }
 
   void printNonEmptyReverseLookup(std::ostream &os) {
     os << "DUMP nonEmptyReverseLookup\nTable<N, D, std::unordered_map<D, "
           "EdgeFunctionPtrType>>\n";
-    auto cellvec = nonEmptyReverseLookup.cellVec();
-    for (auto cell : cellvec) {
-      os << "N : " << problem.NtoString(cell.r)
-         << "\nD1: " << problem.DtoString(cell.c) << '\n';
-      for (auto D2ToEF : cell.v) {
-        os << "D2: " << problem.DtoString(D2ToEF.first)
-           << "\nEF: " << D2ToEF.second->str() << '\n';
-      }
-      os << '\n';
+    for (auto &S : Shards) {
+      S->visitReverseLookup([&](n_t N, d_t D1, const auto &D2ToEFs) {
+        os << "N : " << problem.NtoString(N)
+           << "\nD1: " << problem.DtoString(D1) << '\n';
+        for (auto D2ToEF : D2ToEFs) {
+          os << "D2: " << problem.DtoString(D2ToEF.first)
+             << "\nEF: " << D2ToEF.second->str() << '\n';
+        }
+        os << '\n';
+      });
     }
   }
 
   void printNonEmptyForwardLookup(std::ostream &os) {
     os << "DUMP nonEmptyForwardLookup\nTable<D, N, std::unordered_map<D, "
           "EdgeFunctionPtrType>>\n";
-    auto cellvec = nonEmptyForwardLookup.cellVec();
-    for (auto cell : cellvec) {
-      os << "D1: " << problem.DtoString(cell.r)
-         << "\nN : " << problem.NtoString(cell.c) << '\n';
-      for (auto D2ToEF : cell.v) {
-        os << "D2: " << problem.DtoString(D2ToEF.first)
-           << "\nEF: " << D2ToEF.second->str() << '\n';
-      }
-      os << '\n';
+    for (auto &S : Shards) {
+      S->visitForwardLookup([&](d_t D1, n_t N, const auto &D2ToEFs) {
+        os << "D1: " << problem.DtoString(D1)
+           << "\nN : " << problem.NtoString(N) << '\n';
+        for (auto D2ToEF : D2ToEFs) {
+          os << "D2: " << problem.DtoString(D2ToEF.first)
+             << "\nEF: " << D2ToEF.second->str() << '\n';
+        }
+        os << '\n';
+      });
     }
   }
 
   void printNonEmptyLookupByTargetNode(std::ostream &os) {
     os << "DUMP nonEmptyLookupByTargetNode\nstd::unordered_map<N, Table<D, D, "
           "EdgeFunctionPtrType>>\n";
-    for (auto node : nonEmptyLookupByTargetNode) {
-      os << "\nN : " << problem.NtoString(node.first) << '\n';
-      auto table = nonEmptyLookupByTargetNode[node.first];
-      auto cellvec = table.cellVec();
-      for (auto cell : cellvec) {
-        os << "D1: " << problem.DtoString(cell.r)
-           << "\nD2: " << problem.DtoString(cell.c) << "\nEF: " << cell.v->str()
-           << '\n';
-      }
-      os << '\n';
+    for (auto &S : Shards) {
+      S->visitTargets([&](n_t Target) {
+        os << "\nN : " << problem.NtoString(Target) << '\n';
+        auto cellvec = S->lookupByTarget(Target).cellVec();
+        for (auto cell : cellvec) {
+          os << "D1: " << problem.DtoString(cell.getRowKey())
+             << "\nD2: " << problem.DtoString(cell.getColumnKey())
+             << "\nEF: " << cell.getValue()->str() << '\n';
+        }
+        os << '\n';
+      });
     }
   }
 };
@@ -0,0 +1,227 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONSSTORAGE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONSSTORAGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * Stores the jump functions of (a shard of) JumpFunctions. Implementations
+ * never store the all-top function; this is handled by JumpFunctions.
+ */
+template <typename AnalysisDomainTy> class JumpFunctionsStorage {
+public:
+  using l_t = typename AnalysisDomainTy::l_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+  using EdgeFunctionPtrType = std::shared_ptr<EdgeFunction<l_t>>;
+  // list of facts and the associated edge functions
+  using EntryList = llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>;
+
+  virtual ~JumpFunctionsStorage() = default;
+
+  /// Adds the jump function or overwrites an existing one.
+  virtual void addFunction(d_t sourceVal, n_t target, d_t targetVal,
+                           EdgeFunctionPtrType function) = 0;
+
+  /// Returns the source values and edge functions for the given target
+  /// statement and value, or nullptr if there are none.
+  virtual EntryList *reverseLookup(n_t target, d_t targetVal) = 0;
+
+  /// Returns the target values and edge functions for the given source value
+  /// and target statement, or nullptr if there are none.
+  virtual EntryList *forwardLookup(d_t sourceVal, n_t target) = 0;
+
+  /// Returns all (sourceVal, targetVal, edgeFunction) records with the given
+  /// target statement.
+  [[nodiscard]] virtual Table<d_t, d_t, EdgeFunctionPtrType>
+  lookupByTarget(n_t target) const = 0;
+
+  /// Returns true if the jump function has actually been removed.
+  virtual bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) = 0;
+
+  /// Removes all jump functions with the given target statement and returns
+  /// the number of removed functions.
+  virtual size_t removeFunctionsAt(n_t target) = 0;
+
+  virtual void clear() = 0;
+
+  /// Calls the visitor for each target statement and value for which jump
+  /// functions are stored.
+  virtual void visitReverseLookup(
+      llvm::function_ref<void(n_t, d_t, const EntryList &)> Visitor) const = 0;
+
+  /// Calls the visitor for each source value and target statement for which
+  /// jump functions are stored.
+  virtual void visitForwardLookup(
+      llvm::function_ref<void(d_t, n_t, const EntryList &)> Visitor) const = 0;
+
+  /// Calls the visitor for each target statement for which jump functions
+  /// are stored.
+  virtual void visitTargets(llvm::function_ref<void(n_t)> Visitor) const = 0;
+
+protected:
+  // Inserts or overwrites the edge function that is associated with the given
+  // fact.
+  static void setEntry(EntryList &Entries, d_t Fact,
+                       EdgeFunctionPtrType Function) {
+    if (auto Find = std::find_if(Entries.begin(), Entries.end(),
+                                 [Fact](const auto &Entry) {
+                                   return Fact == Entry.first;
+                                 });
+        Find != Entries.end()) {
+      // it is important that existing values in JumpFunctions are overwritten
+      Find->second = std::move(Function);
+    } else {
+      Entries.emplace_back(Fact, std::move(Function));
+    }
+  }
+
+  static bool eraseEntry(EntryList &Entries, d_t Fact) {
+    if (auto Find = std::find_if(Entries.begin(), Entries.end(),
+                                 [Fact](const auto &Entry) {
+                                   return Fact == Entry.first;
+                                 });
+        Find != Entries.end()) {
+      Entries.erase(Find);
+      return true;
+    }
+    return false;
+  }
+};
+
+/**
+ * The original storage of the jump functions: three redundant indexes built
+ * from nested hash tables that are keyed by the nodes and facts themselves.
+ */
+template <typename AnalysisDomainTy>
+class NestedJumpFunctionsStorage
+    : public JumpFunctionsStorage<AnalysisDomainTy> {
+public:
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::d_t;
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::n_t;
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::EdgeFunctionPtrType;
+  using typename JumpFunctionsStorage<AnalysisDomainTy>::EntryList;
+
+private:
+  // mapping from target node and value to a list of all source values and
+  // associated functions where the list is implemented as a mapping from
+  // the source value to the function we exclude empty default functions
+  Table<n_t, d_t, EntryList> nonEmptyReverseLookup;
+  // mapping from source value and target node to a list of all target
+  // values and associated functions where the list is implemented as a
+  // mapping from the source value to the function we exclude empty default
+  // functions
+  Table<d_t, n_t, EntryList> nonEmptyForwardLookup;
+  // a mapping from target node to a list of triples consisting of source
+  // value, target value and associated function; the triple is implemented
+  // by a table we exclude empty default functions
+  std::unordered_map<n_t, Table<d_t, d_t, EdgeFunctionPtrType>>
+      nonEmptyLookupByTargetNode;
+
+public:
+  void addFunction(d_t sourceVal, n_t target, d_t targetVal,
+                   EdgeFunctionPtrType function) override {
+    this->setEntry(nonEmptyReverseLookup.get(target, targetVal), sourceVal,
+                   function);
+    this->setEntry(nonEmptyForwardLookup.get(sourceVal, target), targetVal,
+                   function);
+    // V Table::insert(R r, C c, V v) always overrides (see comments above)
+    nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal,
+                                              std::move(function));
+  }
+
+  EntryList *reverseLookup(n_t target, d_t targetVal) override {
+    if (!nonEmptyReverseLookup.contains(target, targetVal)) {
+      return nullptr;
+    }
+    return &nonEmptyReverseLookup.get(target, targetVal);
+  }
+
+  EntryList *forwardLookup(d_t sourceVal, n_t target) override {
+    if (!nonEmptyForwardLookup.contains(sourceVal, target)) {
+      return nullptr;
+    }
+    return &nonEmptyForwardLookup.get(sourceVal, target);
+  }
+
+  [[nodiscard]] Table<d_t, d_t, EdgeFunctionPtrType>
+  lookupByTarget(n_t target) const override {
+    if (auto Search = nonEmptyLookupByTargetNode.find(target);
+        Search != nonEmptyLookupByTargetNode.end()) {
+      return Search->second;
+    }
+    return {};
+  }
+
+  bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) override {
+    this->eraseEntry(nonEmptyReverseLookup.get(target, targetVal), sourceVal);
+    this->eraseEntry(nonEmptyForwardLookup.get(sourceVal, target), targetVal);
+    return nonEmptyLookupByTargetNode.erase(target);
+  }
+
+  size_t removeFunctionsAt(n_t target) override {
+    auto Search = nonEmptyLookupByTargetNode.find(target);
+    if (Search == nonEmptyLookupByTargetNode.end()) {
+      return 0;
+    }
+    auto Cells = Search->second.cellVec();
+    for (const auto &Cell : Cells) {
+      // all target values of this source value at target are removed
+      nonEmptyForwardLookup.remove(Cell.getRowKey(), target);
+    }
+    nonEmptyReverseLookup.remove(target);
+    nonEmptyLookupByTargetNode.erase(Search);
+    return Cells.size();
+  }
+
+  void clear() override {
+    nonEmptyReverseLookup.clear();
+    nonEmptyForwardLookup.clear();
+    nonEmptyLookupByTargetNode.clear();
+  }
+
+  void visitReverseLookup(llvm::function_ref<void(n_t, d_t, const EntryList &)>
+                              Visitor) const override {
+    for (const auto &Cell : nonEmptyReverseLookup.cellVec()) {
+      Visitor(Cell.getRowKey(), Cell.getColumnKey(), Cell.getValue());
+    }
+  }
+
+  void visitForwardLookup(llvm::function_ref<void(d_t, n_t, const EntryList &)>
+                              Visitor) const override {
+    for (const auto &Cell : nonEmptyForwardLookup.cellVec()) {
+      Visitor(Cell.getRowKey(), Cell.getColumnKey(), Cell.getValue());
+    }
+  }
+
+  void visitTargets(llvm::function_ref<void(n_t)> Visitor) const override {
+    for (const auto &Entry : nonEmptyLookupByTargetNode) {
+      Visitor(Entry.first);
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
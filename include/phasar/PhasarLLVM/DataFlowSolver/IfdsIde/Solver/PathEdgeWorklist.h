@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/Support/ErrorHandling.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/CFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/**
+ * Holds the path edges that the IDESolver still has to process during phase I.
+ * Using an explicit worklist rather than processing path edges recursively
+ * bounds the solver's stack depth and allows to tune the processing order.
+ */
+template <typename N, typename D> class PathEdgeWorklist {
+public:
+  virtual ~PathEdgeWorklist() = default;
+
+  virtual void push(PathEdge<N, D> Edge) = 0;
+
+  virtual PathEdge<N, D> pop() = 0;
+
+  [[nodiscard]] virtual bool empty() const = 0;
+
+  [[nodiscard]] virtual size_t size() const = 0;
+};
+
+/// Processes path edges in the order they have been discovered.
+template <typename N, typename D>
+class FIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::deque<PathEdge<N, D>> Edges;
+
+public:
+  void push(PathEdge<N, D> Edge) override { Edges.push_back(std::move(Edge)); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> Edge = Edges.front();
+    Edges.pop_front();
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+};
+
+/// Processes the most recently discovered path edge first (depth-first).
+template <typename N, typename D>
+class LIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::vector<PathEdge<N, D>> Edges;
+
+public:
+  void push(PathEdge<N, D> Edge) override { Edges.push_back(std::move(Edge)); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> Edge = Edges.back();
+    Edges.pop_back();
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+};
+
+/**
+ * Processes path edges by the reverse-postorder index of their target node in
+ * the interprocedural control-flow graph. Information is thus pushed forward
+ * along the program before loops are revisited, which usually reduces the
+ * number of times a jump function has to be re-joined. Path edges with the
+ * same priority are processed in FIFO order. Nodes that are not reachable
+ * from the initial seeds (e.g. return sites of unbalanced returns) are
+ * processed last.
+ */
+template <typename N, typename D, typename F, typename I>
+class ReversePostOrderPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  struct Entry {
+    unsigned Priority;
+    size_t Sequence;
+    D Source;
+    N Target;
+    D TargetFact;
+  };
+
+  struct EntryGreater {
+    bool operator()(const Entry &Lhs, const Entry &Rhs) const {
+      if (Lhs.Priority != Rhs.Priority) {
+        return Lhs.Priority > Rhs.Priority;
+      }
+      return Lhs.Sequence > Rhs.Sequence;
+    }
+  };
+
+  std::priority_queue<Entry, std::vector<Entry>, EntryGreater> Edges;
+  std::unordered_map<N, unsigned> RPOIndex;
+  size_t NextSequence = 0;
+
+  std::vector<N> getSuccessors(const I &ICF, N Node) {
+    if (!ICF.isCallStmt(Node)) {
+      return ICF.getSuccsOf(Node);
+    }
+    std::vector<N> Succs;
+    for (F Callee : ICF.getCalleesOfCallAt(Node)) {
+      for (N StartPoint : startPointsOf(ICF, Callee)) {
+        Succs.push_back(StartPoint);
+      }
+    }
+    for (N RetSite : ICF.getReturnSitesOfCallAt(Node)) {
+      Succs.push_back(RetSite);
+    }
+    return Succs;
+  }
+
+  // Computes a post-order of the interprocedural control-flow graph using an
+  // explicit stack, because the graph may be arbitrarily deep.
+  void computeReversePostOrder(const I &ICF, const std::set<N> &Roots) {
+    std::vector<N> PostOrder;
+    std::unordered_set<N> Visited;
+    std::vector<std::pair<N, std::vector<N>>> Stack;
+    for (N Root : Roots) {
+      if (!Visited.insert(Root).second) {
+        continue;
+      }
+      Stack.emplace_back(Root, getSuccessors(ICF, Root));
+      while (!Stack.empty()) {
+        auto &[Node, Succs] = Stack.back();
+        if (Succs.empty()) {
+          PostOrder.push_back(Node);
+          Stack.pop_back();
+          continue;
+        }
+        N Succ = Succs.back();
+        Succs.pop_back();
+        if (Visited.insert(Succ).second) {
+          auto SuccSuccs = getSuccessors(ICF, Succ);
+          Stack.emplace_back(Succ, std::move(SuccSuccs));
+        }
+      }
+    }
+    RPOIndex.reserve(PostOrder.size());
+    unsigned Idx = 0;
+    for (auto It = PostOrder.rbegin(); It != PostOrder.rend(); ++It) {
+      RPOIndex[*It] = Idx++;
+    }
+  }
+
+public:
+  ReversePostOrderPathEdgeWorklist(const I &ICF,
+                                   const std::map<N, std::set<D>> &Seeds) {
+    std::set<N> Roots;
+    for (const auto &Seed : Seeds) {
+      Roots.insert(Seed.first);
+    }
+    computeReversePostOrder(ICF, Roots);
+  }
+
+  void push(PathEdge<N, D> Edge) override {
+    unsigned Priority = std::numeric_limits<unsigned>::max();
+    if (auto Search = RPOIndex.find(Edge.getTarget());
+        Search != RPOIndex.end()) {
+      Priority = Search->second;
+    }
+    Edges.push(Entry{Priority, NextSequence++, Edge.factAtSource(),
+                     Edge.getTarget(), Edge.factAtTarget()});
+  }
+
+  PathEdge<N, D> pop() override {
+    const Entry &Top = Edges.top();
+    PathEdge<N, D> Edge(Top.Source, Top.Target, Top.TargetFact);
+    Edges.pop();
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+};
+
+/**
+ * Creates the path edge worklist that corresponds to the given kind. The
+ * ICFG and initial seeds are only required to compute the node priorities of
+ * the ordered worklists.
+ */
+template <typename N, typename D, typename F, typename I>
+std::unique_ptr<PathEdgeWorklist<N, D>>
+makePathEdgeWorklist(WorklistKind WK, const I &ICF,
+                     const std::map<N, std::set<D>> &Seeds) {
+  switch (WK) {
+  case WorklistKind::FIFO:
+    return std::make_unique<FIFOPathEdgeWorklist<N, D>>();
+    break;
+  case WorklistKind::LIFO:
+    return std::make_unique<LIFOPathEdgeWorklist<N, D>>();
+    break;
+  case WorklistKind::ReversePostOrder:
+    return std::make_unique<ReversePostOrderPathEdgeWorklist<N, D, F, I>>(
+        ICF, Seeds);
+    break;
+  default:
+    llvm::report_fatal_error("Worklist kind not properly instantiated");
+    break;
+  }
+}
+
+} // namespace psr
+
+#endif
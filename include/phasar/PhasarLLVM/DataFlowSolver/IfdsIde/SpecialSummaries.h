@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -33,9 +34,11 @@
 
 namespace psr {
 
-template <typename D, typename V = BinaryDomain> class SpecialSummaries {
-  using FlowFunctionType = FlowFunction<D>;
-  using FlowFunctionPtrType = std::shared_ptr<FlowFunction<D>>;
+template <typename D, typename V = BinaryDomain,
+          typename Container = std::set<D>>
+class SpecialSummaries {
+  using FlowFunctionType = FlowFunction<D, Container>;
+  using FlowFunctionPtrType = std::shared_ptr<FlowFunctionType>;
 
 private:
   std::map<std::string, FlowFunctionPtrType> SpecialFlowFunctions;
@@ -49,8 +52,8 @@ private:
     // insert default flow and edge functions
     for (auto function_name :
          PhasarConfig::getPhasarConfig().specialFunctionNames()) {
-      SpecialFlowFunctions.insert(
-          std::make_pair(function_name, Identity<D>::getInstance()));
+      SpecialFlowFunctions.insert(std::make_pair(
+          function_name, Identity<D, Container>::getInstance()));
       SpecialEdgeFunctions.insert(
           std::make_pair(function_name, EdgeIdentity<V>::getInstance()));
     }
@@ -63,8 +66,8 @@ public:
   SpecialSummaries &operator=(SpecialSummaries &&) = delete;
   ~SpecialSummaries() = default;
 
-  static SpecialSummaries<D, V> &getInstance() {
-    static SpecialSummaries<D, V> instance;
+  static SpecialSummaries &getInstance() {
+    static SpecialSummaries instance;
     return instance;
   }
 
@@ -114,10 +117,10 @@ public:
   }
 
   friend std::ostream &operator<<(std::ostream &os,
-                                  const SpecialSummaries<D> &ss) {
+                                  const SpecialSummaries &ss) {
     os << "SpecialSummaries:\n";
     for (auto &entry : ss.SpecialFunctionNames) {
-      os << entry.first << " ";
+      os << entry << " ";
     }
     return os;
   }
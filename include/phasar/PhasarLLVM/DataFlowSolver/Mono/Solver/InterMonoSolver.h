@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringCTX.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/InterMonoProblem.h"
 #include "phasar/Utils/BitVectorSet.h"
@@ -109,7 +110,7 @@ protected:
       }
       AddedFunctions.insert(callee);
       // Add call edge(s)
-      for (auto startPoint : ICF->getStartPointsOf(callee)) {
+      for (auto startPoint : startPointsOf(*ICF, callee)) {
         Worklist.push_back({src, startPoint});
       }
       // Add intra edges of callee
@@ -126,7 +127,7 @@ protected:
         Analysis[edges.back().second][CallStringCTX<n_t, K>()];
       }
       // Add return edge(s)
-      for (auto ret : ICF->getExitPointsOf(callee)) {
+      for (auto ret : exitPointsOf(*ICF, callee)) {
         for (auto retSite : ICF->getReturnSitesOfCallAt(src)) {
           Worklist.push_back({ret, retSite});
         }
@@ -141,21 +142,21 @@ protected:
     auto dst = edge.second;
     Worklist.push_back({src, dst});
     // add intra-procedural edges again
-    for (auto nprimeprime : ICF->getSuccsOf(dst)) {
+    for (auto nprimeprime : succsOf(*ICF, dst)) {
       Worklist.push_back({dst, nprimeprime});
     }
     // add inter-procedural call edges again
     if (ICF->isCallStmt(dst)) {
-      for (auto callee : ICF->getCalleesOfCallAt(dst)) {
-        for (auto startPoint : ICF->getStartPointsOf(callee)) {
+      for (auto callee : calleesOfCallAt(*ICF, dst)) {
+        for (auto startPoint : startPointsOf(*ICF, callee)) {
           Worklist.push_back({dst, startPoint});
         }
       }
     }
     // add inter-procedural return edges again
     if (ICF->isExitStmt(dst)) {
-      for (auto caller : ICF->getCallersOf(ICF->getFunctionOf(dst))) {
-        for (auto nprimeprime : ICF->getSuccsOf(caller)) {
+      for (auto caller : callersOf(*ICF, ICF->getFunctionOf(dst))) {
+        for (auto nprimeprime : succsOf(*ICF, caller)) {
           Worklist.push_back({dst, nprimeprime});
         }
       }
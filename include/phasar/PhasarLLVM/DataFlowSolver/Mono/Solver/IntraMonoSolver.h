@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "phasar/PhasarLLVM/ControlFlow/CFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/IntraMonoProblem.h"
 #include "phasar/Utils/BitVectorSet.h"
 
@@ -81,7 +82,7 @@ public:
       BitVectorSet<d_t> Out = IMProblem.normalFlow(src, Analysis[src]);
       if (!IMProblem.sqSubSetEqual(Out, Analysis[dst])) {
         Analysis[dst] = IMProblem.join(Analysis[dst], Out);
-        for (auto nprimeprime : CFG->getSuccsOf(dst)) {
+        for (auto nprimeprime : succsOf(*CFG, dst)) {
           Worklist.push_back({dst, nprimeprime});
         }
       }
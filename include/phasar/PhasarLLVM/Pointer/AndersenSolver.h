@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_ANDERSENSOLVER_H_
+#define PHASAR_PHASARLLVM_POINTER_ANDERSENSOLVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/SparseBitVector.h"
+
+#include "phasar/Utils/UnionFind.h"
+
+namespace psr {
+
+/**
+ * An inclusion-based (Andersen-style) points-to solver over a sparse
+ * constraint graph, independent of the IR the constraints are generated
+ * from.
+ *
+ * The nodes of the graph are either pointers or the fields of abstract
+ * memory objects, the latter are called locations and are the elements of
+ * the points-to sets. Each object occupies one consecutive node per field,
+ * the field of a location is found by the byte offset of the field within
+ * the object. A location node holds the points-to set of the memory at that
+ * location.
+ *
+ * The solver propagates only the difference of a points-to set since the
+ * node has been processed last. Cycles of copy edges are detected lazily,
+ * once a copy edge connects two nodes with equal points-to sets, and are
+ * collapsed into a single node. Points-to sets are sparse bit vectors.
+ *
+ * Constraints may be added between calls to solve(), e.g. to resolve
+ * indirect calls on the fly.
+ */
+class AndersenSolver {
+public:
+  using IdTy = UnionFind::IdTy;
+  /// The offset of an access to an unknown field of an object.
+  static constexpr int64_t AnyField = std::numeric_limits<int64_t>::min();
+
+  /// Called with the call id and a new location the callee pointer of an
+  /// indirect call may point to.
+  using IndirectCallHandlerTy = std::function<void(uint32_t, IdTy)>;
+
+private:
+  struct Node {
+    llvm::SparseBitVector<> Pts;
+    // the part of Pts that has been propagated already
+    llvm::SparseBitVector<> PrevPts;
+    // the copy successors, which may have been merged into other nodes
+    llvm::SparseBitVector<> Succs;
+    // Dst = *this
+    llvm::SmallVector<IdTy, 2> Loads;
+    // *this = Src
+    llvm::SmallVector<IdTy, 2> Stores;
+    // Dst = this + Offset
+    llvm::SmallVector<std::pair<IdTy, int64_t>, 2> Offsets;
+    // call ids of the indirect calls through this
+    llvm::SmallVector<uint32_t, 1> IndirectCalls;
+  };
+
+  struct Object {
+    IdTy Base;
+    // the size of an array element if the object is an array, offsets are
+    // taken modulo this size
+    uint64_t Stride;
+    std::vector<uint64_t> FieldOffsets;
+  };
+
+  static constexpr uint32_t NoObject = std::numeric_limits<uint32_t>::max();
+
+  // references to nodes remain valid when nodes are added
+  std::deque<Node> Nodes;
+  // the index of the object of each location, NoObject for pointers
+  std::vector<uint32_t> ObjectIndices;
+  std::vector<Object> Objects;
+  UnionFind Reps;
+  std::deque<IdTy> WorkList;
+  std::vector<bool> InWorkList;
+  // the copy edges that have triggered a cycle detection already
+  llvm::DenseSet<std::pair<IdTy, IdTy>> CheckedEdges;
+  IndirectCallHandlerTy IndirectCallHandler;
+  size_t NumCollapsedNodes = 0;
+  size_t NumPropagations = 0;
+
+  IdTy makeNode();
+
+  void push(IdTy N);
+
+  // adds the edge Src -> Dst and propagates the points-to set of Src along it
+  void addCopyEdge(IdTy Src, IdTy Dst);
+
+  // adds the locations of Location + Offset to Result
+  void applyOffset(IdTy Location, int64_t Offset,
+                   llvm::SparseBitVector<> &Result) const;
+
+  // processes the locations of N that have not been propagated, yet, and
+  // returns the copy edges whose nodes have equal points-to sets afterwards
+  std::vector<std::pair<IdTy, IdTy>> process(IdTy N);
+
+  // collapses the cycles of copy edges that are reachable from Start
+  void collapseCycles(IdTy Start);
+
+  IdTy merge(IdTy N1, IdTy N2);
+
+public:
+  AndersenSolver() = default;
+
+  AndersenSolver(const AndersenSolver &) = delete;
+  AndersenSolver &operator=(const AndersenSolver &) = delete;
+  ~AndersenSolver() = default;
+
+  /// Adds a pointer node.
+  IdTy addNode();
+
+  /// Adds an object with the given byte offsets of its fields, which must be
+  /// sorted, unique and contain 0. \return the location of its first field.
+  IdTy addObject(llvm::ArrayRef<uint64_t> FieldOffsets, uint64_t Stride = 0);
+
+  /// Dst points to Location.
+  void addAddressOf(IdTy Dst, IdTy Location);
+
+  /// Dst points to everything Src points to.
+  void addCopy(IdTy Dst, IdTy Src);
+
+  /// Dst points to everything the locations that SrcPtr points to point to.
+  void addLoad(IdTy Dst, IdTy SrcPtr);
+
+  /// The locations that DstPtr points to point to everything Src points to.
+  void addStore(IdTy DstPtr, IdTy Src);
+
+  /// Dst points to the fields at Offset bytes from the locations SrcPtr
+  /// points to, or to all fields of their objects if Offset is AnyField.
+  void addOffset(IdTy Dst, IdTy SrcPtr, int64_t Offset);
+
+  /// The indirect call with the given id calls through CalleePtr.
+  void addIndirectCall(IdTy CalleePtr, uint32_t CallId);
+
+  void setIndirectCallHandler(IndirectCallHandlerTy Handler) {
+    IndirectCallHandler = std::move(Handler);
+  }
+
+  /// Propagates the points-to sets until a fixpoint is reached.
+  void solve();
+
+  [[nodiscard]] bool isSolved() const { return WorkList.empty(); }
+
+  /// \return the representative of the node N has been merged into.
+  [[nodiscard]] IdTy find(IdTy N) { return Reps.find(N); }
+
+  [[nodiscard]] const llvm::SparseBitVector<> &getPointsToSet(IdTy N) const {
+    return Nodes[Reps.findRoot(N)].Pts;
+  }
+
+  [[nodiscard]] bool isLocation(IdTy N) const {
+    return ObjectIndices[N] != NoObject;
+  }
+
+  /// \return the location of the first field of Location's object.
+  [[nodiscard]] IdTy getObjectBase(IdTy Location) const {
+    return Objects[ObjectIndices[Location]].Base;
+  }
+
+  [[nodiscard]] size_t size() const { return Nodes.size(); }
+
+  [[nodiscard]] size_t getNumCollapsedNodes() const {
+    return NumCollapsedNodes;
+  }
+
+  [[nodiscard]] size_t getNumPropagations() const { return NumPropagations; }
+};
+
+} // namespace psr
+
+#endif
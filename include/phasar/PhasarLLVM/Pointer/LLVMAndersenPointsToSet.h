@@ -0,0 +1,172 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_LLVMANDERSENPOINTSTOSET_H_
+#define PHASAR_PHASARLLVM_POINTER_LLVMANDERSENPOINTSTOSET_H_
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SparseBitVector.h"
+#include "llvm/IR/CallSite.h"
+
+#include "nlohmann/json.hpp"
+
+#include "phasar/PhasarLLVM/Pointer/AndersenSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+
+namespace llvm {
+class Constant;
+class DataLayout;
+class Function;
+class GEPOperator;
+class Instruction;
+class Type;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/**
+ * A whole-program, inclusion-based points-to analysis that is
+ * inter-procedural and field-sensitive. Indirect calls are resolved while the
+ * points-to sets are computed.
+ *
+ * Fields are distinguished by their byte offset within an object, all
+ * elements of an array share the fields of the first element. Heap
+ * allocations and the pointers returned by other external functions are
+ * modelled by one object per call site.
+ *
+ * As for the other points-to infos, the points-to set of a pointer is the set
+ * of pointers it may alias with.
+ */
+class LLVMAndersenPointsToSet : public LLVMPointsToInfo {
+private:
+  using IdTy = AndersenSolver::IdTy;
+
+  ProjectIRDB &IRDB;
+  // the data layout of the modules, which are expected to agree on it
+  const llvm::DataLayout *DL = nullptr;
+  AndersenSolver Solver;
+  // the nodes of the pointers of the program
+  llvm::DenseMap<const llvm::Value *, IdTy> ValueNodes;
+  // the objects by their allocation site, e.g. an alloca or a global
+  llvm::DenseMap<const llvm::Value *, IdTy> Objects;
+  // the allocation sites by the first location of their objects
+  llvm::DenseMap<IdTy, const llvm::Value *> AllocationSites;
+  llvm::DenseMap<const llvm::Function *, IdTy> ReturnNodes;
+  // the flattened field offsets of the types of objects
+  std::unordered_map<const llvm::Type *, std::vector<uint64_t>> FieldOffsets;
+  // the indirect calls by their call id
+  std::vector<llvm::ImmutableCallSite> IndirectCalls;
+  // the callees that have been connected to the indirect calls already
+  llvm::DenseSet<std::pair<uint32_t, const llvm::Function *>> ResolvedCalls;
+  // the pointer nodes that point to each location, along with their values,
+  // built on demand and dropped once constraints are added
+  std::vector<llvm::SparseBitVector<>> PointedToBy;
+  std::vector<const llvm::Value *> NodeValues;
+  // the points-to sets that have been handed out, by the representative of
+  // their node
+  llvm::DenseMap<IdTy, std::shared_ptr<std::unordered_set<const llvm::Value *>>>
+      AliasSets;
+
+  IdTy getValueNode(const llvm::Value *V);
+
+  std::optional<IdTy> lookupValueNode(const llvm::Value *V) const;
+
+  IdTy getReturnNode(const llvm::Function *F);
+
+  const std::vector<uint64_t> &getFieldOffsets(llvm::Type *Ty);
+
+  // Returns the first location of the object of AllocationSite, whose memory
+  // holds values of type Ty, IsArray is set if it holds more than one of
+  // them.
+  IdTy getObject(const llvm::Value *AllocationSite, llvm::Type *Ty,
+                 bool IsArray = false);
+
+  // Adds the pointers of the initializer Init of the field at Offset within
+  // Object, which has the given field offsets.
+  void addInitializer(IdTy Object, const std::vector<uint64_t> &Offsets,
+                      const llvm::Constant *Init, uint64_t Offset);
+
+  static int64_t getGEPOffset(const llvm::GEPOperator &GEP,
+                              const llvm::DataLayout &DL);
+
+  void addConstraints(const llvm::Function &F);
+
+  void addCallConstraints(llvm::ImmutableCallSite CS,
+                          const llvm::Function &Callee);
+
+  void handleIndirectCallTarget(uint32_t CallId, IdTy Location);
+
+  void invalidate();
+
+  void solve();
+
+  std::shared_ptr<std::unordered_set<const llvm::Value *>>
+  computeAliasSet(IdTy Node);
+
+  [[nodiscard]] std::string getLocationAsString(IdTy Location) const;
+
+public:
+  /**
+   * Generates the constraints of all functions of the IRDB and solves them.
+   */
+  LLVMAndersenPointsToSet(ProjectIRDB &IRDB);
+
+  ~LLVMAndersenPointsToSet() override = default;
+
+  [[nodiscard]] inline bool isInterProcedural() const override {
+    return true;
+  };
+
+  [[nodiscard]] inline PointerAnalysisType
+  getPointerAnalysistype() const override {
+    return PointerAnalysisType::Andersen;
+  };
+
+  [[nodiscard]] AliasResult
+  alias(const llvm::Value *V1, const llvm::Value *V2,
+        const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] std::shared_ptr<std::unordered_set<const llvm::Value *>>
+  getPointsToSet(const llvm::Value *V,
+                 const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] std::unordered_set<const llvm::Value *>
+  getReachableAllocationSites(const llvm::Value *V,
+                              const llvm::Instruction *I = nullptr) override;
+
+  void mergeWith(const PointsToInfo &PTI) override;
+
+  void introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
+                      const llvm::Instruction *I = nullptr,
+                      AliasResult Kind = AliasResult::MustAlias) override;
+
+  void print(std::ostream &OS = std::cout) const override;
+
+  [[nodiscard]] nlohmann::json getAsJson() const override;
+
+  void printAsJson(std::ostream &OS = std::cout) const override;
+};
+
+} // namespace psr
+
+#endif
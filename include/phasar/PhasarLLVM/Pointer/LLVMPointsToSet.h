@@ -10,21 +10,33 @@
 #ifndef PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOSET_H_
 #define PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOSET_H_
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 
 #include "nlohmann/json.hpp"
 
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+#include "phasar/PhasarLLVM/Pointer/PointsToCache.h"
+#include "phasar/Utils/Interner.h"
+#include "phasar/Utils/UnionFind.h"
 
 namespace llvm {
 class Value;
 class Module;
 class Instruction;
 class AAResults;
+class DataLayout;
 class GlobalVariable;
 class Function;
 class Type;
@@ -34,16 +46,72 @@ namespace psr {
 
 class LLVMPointsToSet : public LLVMPointsToInfo {
 private:
+  // serializes the queries, which may compute points-to sets lazily and
+  // compress the paths of the union-find structure
+  mutable std::mutex Mtx;
   LLVMBasedPointsToAnalysis PTA;
   std::unordered_set<const llvm::Function *> AnalyzedFunctions;
-  std::unordered_map<const llvm::Value *,
-                     std::shared_ptr<std::unordered_set<const llvm::Value *>>>
-      PointsToSets;
+  // the pointers, each of which is in exactly one equivalence class of the
+  // union-find structure
+  Interner<const llvm::Value *> PointerIds;
+  UnionFind PointsToSets;
+  // the points-to sets that have been handed out, by the representative of
+  // their class; they are built on demand and dropped once the class changes
+  llvm::DenseMap<UnionFind::IdTy,
+                 std::shared_ptr<std::unordered_set<const llvm::Value *>>>
+      MaterializedSets;
+  // the persistent cache of the aliasing pairs of functions, if any
+  std::string CachePath;
+  std::unique_ptr<PointsToCache> Cache;
+  FunctionIRHasher Hasher;
+  // the results to be written to the cache, including the reused ones
+  std::vector<PointsToCache::FunctionResult> CacheResults;
+  size_t NumCacheHits = 0;
+  // the number of results in CacheResults that have already been written
+  size_t NumWrittenResults = 0;
+
+  // Opens the cache at CachePath unless it has been written for a different
+  // analysis.
+  void openCache();
+
+  // Writes the cache, the caller must hold Mtx. \return false if it could not
+  // be written.
+  bool writeCache();
+
+  std::shared_ptr<std::unordered_set<const llvm::Value *>>
+  materializePointsToSet(UnionFind::IdTy Id);
 
   void computeValuesPointsToSet(const llvm::Value *V);
 
   void computeFunctionsPointsToSet(llvm::Function *F);
 
+  // Computes the points-to sets of all functions, each thread analyzes a copy
+  // of a module that only contains the definitions of its functions.
+  void computeFunctionsPointsToSetsConcurrently(ProjectIRDB &IRDB,
+                                                unsigned NumThreads);
+
+  // Returns the pointers of F whose aliasing is analyzed. The order only
+  // depends on the IR, so that the pointers of a copy of F are in the same
+  // order.
+  static std::vector<const llvm::Value *>
+  collectPointers(const llvm::Function &F);
+
+  // Returns pairs of indices into Pointers that alias, the remaining aliases
+  // follow by transitivity.
+  static std::vector<std::pair<uint32_t, uint32_t>>
+  computeAliasingPairs(llvm::ArrayRef<const llvm::Value *> Pointers,
+                       llvm::AAResults &AA, const llvm::DataLayout &DL);
+
+  // Adds the points-to sets of F from the cache and returns true if the
+  // cache contains F.
+  bool addCachedPointsToSets(const llvm::Function &F,
+                             llvm::ArrayRef<const llvm::Value *> Pointers,
+                             uint64_t FunctionHash);
+
+  void
+  addPointsToSets(llvm::ArrayRef<const llvm::Value *> Pointers,
+                  llvm::ArrayRef<std::pair<uint32_t, uint32_t>> AliasingPairs);
+
   void addSingletonPointsToSet(const llvm::Value *V);
 
   void mergePointsToSets(const llvm::Value *V1, const llvm::Value *V2);
@@ -57,11 +125,18 @@ public:
    * @param F Points-to set is created for this particular function.
    * @param onlyConsiderMustAlias True, if only Must Aliases should be
    * considered. False, if May and Must Aliases should be considered.
+   * @param NumThreads Number of threads that compute the points-to sets of
+   * the functions if UseLazyEvaluation is false.
+   * @param CachePath If given, the aliasing pairs of functions that did not
+   * change are read from the points-to cache at this path, which is updated
+   * with the functions analyzed by flushCache() or, at the latest, once the
+   * points-to set is destroyed.
    */
   LLVMPointsToSet(ProjectIRDB &IRDB, bool UseLazyEvaluation = true,
-                  PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
+                  PointerAnalysisType PATy = PointerAnalysisType::CFLAnders,
+                  unsigned NumThreads = 1, const std::string &CachePath = "");
 
-  ~LLVMPointsToSet() override = default;
+  ~LLVMPointsToSet() override;
 
   [[nodiscard]] inline bool isInterProcedural() const override {
     return false;
@@ -90,7 +165,25 @@ public:
                       const llvm::Instruction *I = nullptr,
                       AliasResult Kind = AliasResult::MustAlias) override;
 
-  [[nodiscard]] inline bool empty() const { return AnalyzedFunctions.empty(); }
+  [[nodiscard]] inline bool isThreadSafe() const override { return true; }
+
+  [[nodiscard]] inline bool empty() const {
+    std::lock_guard<std::mutex> Lock(Mtx);
+    return AnalyzedFunctions.empty();
+  }
+
+  /// \return the number of functions whose points-to sets have been read
+  /// from the points-to cache.
+  [[nodiscard]] inline size_t getNumCacheHits() const {
+    std::lock_guard<std::mutex> Lock(Mtx);
+    return NumCacheHits;
+  }
+
+  /// Writes the points-to sets computed so far to the points-to cache, if
+  /// any. Unlike the destructor, it lets the caller react to a cache that
+  /// could not be written.
+  /// \return false if the cache could not be written.
+  bool flushCache();
 
   void print(std::ostream &OS = std::cout) const override;
 
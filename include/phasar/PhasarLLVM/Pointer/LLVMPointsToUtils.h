@@ -10,14 +10,18 @@
 #ifndef PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOUTILS_H_
 #define PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOUTILS_H_
 
+#include <cstddef>
 #include <set>
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 
 namespace llvm {
+class DataLayout;
 class Value;
 } // namespace llvm
 
@@ -34,6 +38,19 @@ inline bool isInterestingPointer(const llvm::Value *V) {
 
 extern const std::set<llvm::StringRef> HeapAllocatingFunctions;
 
+/**
+ * Calls Query(Idx1, Idx2), with Idx2 < Idx1, for each pair of Pointers whose
+ * aliasing cannot be decided without an alias analysis. Pairs of pointers
+ * that are based on two distinct identified objects, e.g. two different
+ * allocas or globals, are skipped, as basic alias analysis, which is always
+ * part of the alias analysis pipeline, reports them as NoAlias. The pointers
+ * are bucketed by their underlying object, so that the skipped pairs are
+ * never enumerated.
+ */
+void forEachPossiblyAliasingPair(
+    llvm::ArrayRef<const llvm::Value *> Pointers, const llvm::DataLayout &DL,
+    llvm::function_ref<void(size_t, size_t)> Query);
+
 } // namespace psr
 
 #endif
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_POINTSTOCACHE_H_
+#define PHASAR_PHASARLLVM_POINTER_POINTSTOCACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "phasar/PhasarLLVM/Pointer/PointsToInfo.h"
+
+namespace llvm {
+class Function;
+namespace sys {
+namespace fs {
+class mapped_file_region;
+} // namespace fs
+} // namespace sys
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Computes hashes of functions that only change if the result of an
+ * intra-procedural alias analysis of the function may change.
+ *
+ * The hash covers the instructions of the function, the types and the data
+ * layout they use as well as all functions that it references, directly or
+ * transitively, as the alias analyses use summaries of the callees. Names
+ * of local values and debug information are not part of the hash, so that a
+ * function keeps its hash when unrelated parts of the module change.
+ */
+class FunctionIRHasher {
+private:
+  // the hashes of the functions themselves, without the referenced functions
+  llvm::DenseMap<const llvm::Function *, uint64_t> LocalHashes;
+  llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Function *>>
+      ReferencedFunctions;
+  // the combined hashes of the strongly connected components of the
+  // reference graph, by their functions
+  llvm::DenseMap<const llvm::Function *, uint64_t> SCCHashes;
+
+  uint64_t getLocalHash(const llvm::Function &F);
+
+  // Computes the hashes of the SCCs that are reachable from F and not yet
+  // known, callees first, so that each SCC is hashed once.
+  void computeSCCHashes(const llvm::Function &F);
+
+public:
+  [[nodiscard]] uint64_t getHash(const llvm::Function &F);
+};
+
+/**
+ * The aliasing pairs of functions stored in a compact binary file that is
+ * memory-mapped when it is read, so that the points-to sets of functions
+ * which did not change since an earlier run need not be computed again.
+ *
+ * The functions are stored by the hash of a FunctionIRHasher and their
+ * aliasing pairs by the indices of the pointers in the order in which
+ * LLVMPointsToSet collects them. Each cache carries a configuration hash that
+ * the reader has to check before using it. The file uses the native byte
+ * order and is meant as a local cache rather than an exchange format.
+ */
+class PointsToCache {
+public:
+  struct AliasingPair {
+    uint32_t First;
+    uint32_t Second;
+  };
+
+  struct FunctionResult {
+    uint64_t FunctionHash;
+    uint32_t NumPointers;
+    std::vector<std::pair<uint32_t, uint32_t>> AliasingPairs;
+  };
+
+  struct Entry {
+    uint64_t FunctionHash;
+    uint32_t NumPointers;
+    uint32_t NumPairs;
+    uint64_t FirstPair;
+  };
+
+private:
+  std::unique_ptr<llvm::sys::fs::mapped_file_region> Region;
+  uint64_t ConfigHash = 0;
+  llvm::ArrayRef<Entry> Entries;
+  llvm::ArrayRef<AliasingPair> Pairs;
+
+  PointsToCache() = default;
+
+public:
+  PointsToCache(const PointsToCache &) = delete;
+  PointsToCache &operator=(const PointsToCache &) = delete;
+  ~PointsToCache();
+
+  /// \return the configuration hash of caches of the given analysis.
+  static uint64_t computeConfigHash(PointerAnalysisType PATy);
+
+  /// Writes the results of the functions to Path, a function whose hash
+  /// occurs multiple times is only written once. The file is replaced
+  /// atomically. \return false if it could not be written.
+  static bool write(const std::string &Path, uint64_t ConfigHash,
+                    std::vector<FunctionResult> Results);
+
+  /// Maps the cache at Path into memory. \return nullptr if the file does not
+  /// exist or is not a valid cache.
+  static std::unique_ptr<PointsToCache> open(const std::string &Path);
+
+  [[nodiscard]] uint64_t getConfigHash() const { return ConfigHash; }
+
+  [[nodiscard]] size_t size() const { return Entries.size(); }
+
+  /// \return the results of all functions of the cache, e.g. to carry them
+  /// over into a new cache.
+  [[nodiscard]] std::vector<FunctionResult> getResults() const;
+
+  /// \return the aliasing pairs of the function with the given hash and
+  /// number of pointers, or std::nullopt if the function is not cached. The
+  /// range points into the mapped file and remains valid as long as the
+  /// cache.
+  [[nodiscard]] std::optional<llvm::ArrayRef<AliasingPair>>
+  lookup(uint64_t FunctionHash, uint32_t NumPointers) const;
+};
+
+} // namespace psr
+
+#endif
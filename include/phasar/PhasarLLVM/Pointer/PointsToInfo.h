@@ -60,6 +60,10 @@ public:
 
   virtual void printAsJson(std::ostream &OS) const = 0;
 
+  /// \return true if the queries may be issued by several threads at once,
+  /// e.g. by the threads of a parallel data-flow solver.
+  [[nodiscard]] virtual bool isThreadSafe() const { return false; }
+
   // The following functions are relevent when combining points-to with other
   // pieces of information. For instance, during a call-graph construction (or
   // a data-flow analysis) points-to information may be altered to incorporate
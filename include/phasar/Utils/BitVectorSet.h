@@ -190,34 +190,16 @@ public:
     return Res;
   }
 
+  BitVectorSet<T> setDifference(const BitVectorSet<T> &Other) const {
+    BitVectorSet<T> Res;
+    Res.Bits = Bits;
+    Res.Bits.reset(Other.Bits);
+    return Res;
+  }
+
   bool includes(const BitVectorSet<T> &Other) const {
     // check if Other contains 1's at positions where this does not
-    // Other is longer
-    if (Bits.size() < Other.Bits.size()) {
-      size_t idx = 0;
-      for (; idx < Bits.size(); ++idx) {
-        if (Other.Bits[idx] && !Bits[idx]) {
-          return false;
-        }
-      }
-      // Check if Other's additional bits are non-zero
-      for (; idx < Other.Bits.size(); ++idx) {
-        if (Other.Bits[idx]) {
-          return false;
-        }
-      }
-      // additional zeros are fine
-      return true;
-    } else {
-      // this is longer or they have the same length
-      // check if Other contains 1's at positions where this does not
-      for (size_t idx = 0; idx < Other.Bits.size(); ++idx) {
-        if (Other.Bits[idx] && !Bits[idx]) {
-          return false;
-        }
-      }
-      return true;
-    }
+    return !Other.Bits.test(Bits);
   }
 
   void insert(const T &Data) {
@@ -239,14 +221,7 @@ public:
     }
   }
 
-  void insert(const BitVectorSet<T> &Other) {
-    if (Other.Bits.size() > Bits.size()) {
-      Bits.resize(Other.Bits.size());
-    }
-    for (size_t idx = 0; idx < Other.Bits.size(); ++idx) {
-      Bits[idx] = (Bits[idx] || Other.Bits[idx]);
-    }
-  }
+  void insert(const BitVectorSet<T> &Other) { Bits |= Other.Bits; }
 
   template <typename InputIt> void insert(InputIt First, InputIt Last) {
     while (First != Last) {
@@ -258,12 +233,14 @@ public:
   void erase(const T &Data) noexcept {
     auto Search = Position.left.find(Data);
     if (Search != Position.left.end()) {
-      if (!(Bits.size() < Search->second - 1)) {
+      if (Search->second < Bits.size()) {
         Bits[Search->second] = false;
       }
     }
   }
 
+  void erase(const BitVectorSet<T> &Other) noexcept { Bits.reset(Other.Bits); }
+
   void clear() noexcept { Bits.reset(); }
 
   [[nodiscard]] bool empty() const noexcept { return Bits.none(); }
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_CSRMAP_H_
+#define PHASAR_UTILS_CSRMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+namespace psr {
+
+/**
+ * An immutable multimap in compressed sparse row (CSR) format. All values are
+ * stored in a single array in which the values of each key form a contiguous,
+ * sorted and duplicate-free row, so that a lookup costs a single hash lookup
+ * and returns a non-owning range without allocating.
+ *
+ * The map is built at once from a list of (key, value) pairs; it cannot be
+ * modified afterwards other than by building it anew.
+ */
+template <typename KeyTy, typename ValueTy> class CSRMap {
+private:
+  llvm::DenseMap<KeyTy, unsigned> Rows;
+  // the values of row R are Values[Offsets[R]] to Values[Offsets[R + 1] - 1]
+  std::vector<unsigned> Offsets;
+  std::vector<ValueTy> Values;
+
+public:
+  CSRMap() = default;
+
+  explicit CSRMap(std::vector<std::pair<KeyTy, ValueTy>> Entries) {
+    build(std::move(Entries));
+  }
+
+  /// Replaces the contents of the map with the given (key, value) pairs.
+  /// Duplicate pairs are only stored once.
+  void build(std::vector<std::pair<KeyTy, ValueTy>> Entries) {
+    clear();
+    std::sort(Entries.begin(), Entries.end());
+    Entries.erase(std::unique(Entries.begin(), Entries.end()), Entries.end());
+    Values.reserve(Entries.size());
+    for (const auto &[Key, Value] : Entries) {
+      if (Values.empty() || Key != Entries[Values.size() - 1].first) {
+        Rows[Key] = Offsets.size();
+        Offsets.push_back(Values.size());
+      }
+      Values.push_back(Value);
+    }
+    Offsets.push_back(Values.size());
+  }
+
+  void clear() {
+    Rows.clear();
+    Offsets.clear();
+    Values.clear();
+  }
+
+  /// Returns the sorted values of Key, or an empty range if Key is unknown.
+  /// The range remains valid until the map is rebuilt.
+  [[nodiscard]] llvm::ArrayRef<ValueTy> lookup(const KeyTy &Key) const {
+    auto Search = Rows.find(Key);
+    if (Search == Rows.end()) {
+      return {};
+    }
+    unsigned Row = Search->second;
+    return llvm::ArrayRef<ValueTy>(Values).slice(
+        Offsets[Row], Offsets[Row + 1] - Offsets[Row]);
+  }
+
+  [[nodiscard]] bool contains(const KeyTy &Key) const {
+    return Rows.count(Key);
+  }
+
+  /// Returns the number of keys.
+  [[nodiscard]] size_t size() const { return Rows.size(); }
+
+  /// Returns the number of values of all keys.
+  [[nodiscard]] size_t getNumValues() const { return Values.size(); }
+
+  [[nodiscard]] bool empty() const { return Rows.empty(); }
+};
+
+} // namespace psr
+
+#endif
@@ -17,6 +17,9 @@
 #ifndef PHASAR_UTILS_GRAPHEXTENSIONS_H_
 #define PHASAR_UTILS_GRAPHEXTENSIONS_H_
 
+#include <algorithm>
+#include <ostream>
+#include <string>
 #include <utility> // std::pair
 #include <vector>
 
@@ -24,6 +27,8 @@
 #include "boost/graph/copy.hpp"
 #include "boost/graph/graph_utility.hpp"
 
+#include "nlohmann/json.hpp"
+
 namespace psr {
 
 template <typename GraphTy, typename VertexTy, typename EdgeProp>
@@ -137,6 +142,57 @@ void copy_graph(GraphTy &g1, const GraphTy &g2) {
   boost::copy_graph(g2, g1, boost::orig_to_copy(mapV)); // means g1 += g2
 }
 
+/**
+ * Writes the adjacency lists of the graph g as the JSON object
+ *
+ *   {"<GraphID>":{"<vertex name>":["<target name>",...],...}}
+ *
+ * directly to os, without building a nlohmann::json tree first. The output is
+ * the same as the one of the equivalent nlohmann::json: the vertices are
+ * sorted by name, vertices of the same name are merged, a vertex without
+ * out-edges is mapped to null, and an empty graph is written as null. Apart
+ * from the vertex names, which are needed for the sorting, the memory used
+ * does not depend on the size of the graph.
+ */
+template <typename GraphTy, typename VertexNameFn>
+void writeAdjacencyListsAsJson(std::ostream &os, const std::string &GraphID,
+                               const GraphTy &g, VertexNameFn getName) {
+  using vertex_t = typename boost::graph_traits<GraphTy>::vertex_descriptor;
+  std::vector<std::pair<std::string, vertex_t>> vertices;
+  vertices.reserve(boost::num_vertices(g));
+  for (auto v : boost::make_iterator_range(boost::vertices(g))) {
+    vertices.emplace_back(getName(v), v);
+  }
+  if (vertices.empty()) {
+    os << "null";
+    return;
+  }
+  std::stable_sort(
+      vertices.begin(), vertices.end(),
+      [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+  os << '{' << nlohmann::json(GraphID) << ":{";
+  for (auto it = vertices.begin(); it != vertices.end();) {
+    auto groupEnd = std::find_if(it, vertices.end(), [&it](const auto &entry) {
+      return entry.first != it->first;
+    });
+    if (it != vertices.begin()) {
+      os << ',';
+    }
+    os << nlohmann::json(it->first) << ':';
+    bool first = true;
+    for (; it != groupEnd; ++it) {
+      for (auto e :
+           boost::make_iterator_range(boost::out_edges(it->second, g))) {
+        os << (first ? '[' : ',')
+           << nlohmann::json(getName(boost::target(e, g)));
+        first = false;
+      }
+    }
+    os << (first ? "null" : "]");
+  }
+  os << "}}";
+}
+
 } // namespace psr
 
 #endif
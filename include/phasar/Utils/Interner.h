@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_INTERNER_H_
+#define PHASAR_UTILS_INTERNER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace psr {
+
+/**
+ * Maps values to dense 32-bit IDs. IDs are assigned in the order in which the
+ * values are interned, starting at zero, which allows to use them as indices
+ * into flat arrays.
+ */
+template <typename T, typename HashTy = std::hash<T>> class Interner {
+private:
+  std::unordered_map<T, uint32_t, HashTy> Ids;
+  std::vector<T> Values;
+
+public:
+  using IdTy = uint32_t;
+
+  /// Returns the ID of the given value; the value is interned if necessary.
+  IdTy getOrCreateId(const T &Value) {
+    auto [It, Inserted] = Ids.try_emplace(Value, Values.size());
+    if (Inserted) {
+      Values.push_back(Value);
+    }
+    return It->second;
+  }
+
+  /// Returns the ID of the given value if it has been interned already.
+  [[nodiscard]] std::optional<IdTy> getId(const T &Value) const {
+    if (auto Search = Ids.find(Value); Search != Ids.end()) {
+      return Search->second;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] const T &getValue(IdTy Id) const {
+    assert(Id < Values.size() && "Invalid ID!");
+    return Values[Id];
+  }
+
+  [[nodiscard]] size_t size() const { return Values.size(); }
+
+  [[nodiscard]] bool empty() const { return Values.empty(); }
+
+  void clear() {
+    Ids.clear();
+    Values.clear();
+  }
+};
+
+} // namespace psr
+
+#endif
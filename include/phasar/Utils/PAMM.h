@@ -17,8 +17,10 @@
 #ifndef PHASAR_UTILS_PAMM_H_
 #define PHASAR_UTILS_PAMM_H_
 
+#include <atomic>        // atomic
 #include <chrono>        // high_resolution_clock::time_point, milliseconds
 #include <iosfwd>        // ostream
+#include <mutex>         // mutex
 #include <set>           // set
 #include <string>        // string
 #include <unordered_map> // unordered_map
@@ -64,6 +66,11 @@ private:
   std::unordered_map<std::string,
                      std::unordered_map<std::string, unsigned long>>
       Histogram;
+  // counters and histograms may be updated by parallel solvers; updates are
+  // only synchronized while a ParallelSection is active
+  std::mutex DataMtx;
+  std::atomic<unsigned> NumParallelSections{0};
+  std::unique_lock<std::mutex> lockIfParallel();
 
 public:
   /// PAMM is used as singleton.
@@ -72,6 +79,23 @@ public:
   PAMM &operator=(const PAMM &pm) = delete;
   PAMM &operator=(PAMM &&pm) = delete;
 
+  /**
+   * Marks a scope in which counters and histograms may be updated by several
+   * threads - associated macro: PAMM_PARALLEL_SECTION(SECTION_ID). Outside of
+   * such scopes PAMM does not lock on updates. The section has to be entered
+   * before the threads are started and left after they have been joined.
+   */
+  class ParallelSection {
+  public:
+    explicit ParallelSection(PAMM &P) : P(P) { ++P.NumParallelSections; }
+    ~ParallelSection() { --P.NumParallelSections; }
+    ParallelSection(const ParallelSection &) = delete;
+    ParallelSection &operator=(const ParallelSection &) = delete;
+
+  private:
+    PAMM &P;
+  };
+
   /**
    * @brief Returns a reference to the PAMM object (singleton) - associated
    * macro: PAMM_GET_INSTANCE.
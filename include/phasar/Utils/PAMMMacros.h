@@ -82,6 +82,9 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0;
                         DATAPOINT_VALUE);                                      \
   }
 
+#define PAMM_PARALLEL_SECTION(SECTION_ID)                                      \
+  PAMM::ParallelSection SECTION_ID(pamm)
+
 #define PRINT_MEASURED_DATA(OUTPUT_STREAM) pamm.printMeasuredData(OUTPUT_STREAM)
 #define EXPORT_MEASURED_DATA(PATH) pamm.exportMeasuredData(PATH)
 
@@ -97,6 +100,7 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0;
 #define DEC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)
 #define REG_HISTOGRAM(HISTOGRAM_ID, SEV_LVL)
 #define ADD_TO_HISTOGRAM(HISTOGRAM_ID, DATAPOINT_ID, DATAPOINT_VALUE, SEV_LVL)
+#define PAMM_PARALLEL_SECTION(SECTION_ID)
 #define PRINT_MEASURED_DATA(OUTPUT_STREAM)
 #define EXPORT_MEASURED_DATA(PATH)
 // The following macros could be used in log messages, thus they have to
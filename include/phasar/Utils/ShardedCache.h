@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SHARDEDCACHE_H_
+#define PHASAR_UTILS_SHARDEDCACHE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/Hashing.h"
+
+namespace psr {
+
+/**
+ * A tuple of values whose hash is computed once on construction, so that
+ * neither rehashing nor probing the hash table of a cache has to hash the
+ * values again.
+ */
+template <typename... Ts> class HashedKey {
+private:
+  std::tuple<Ts...> Values;
+  size_t Hash;
+
+  static size_t computeHash(const std::tuple<Ts...> &Values) {
+    return std::apply(
+        [](const auto &...Vals) -> size_t {
+          return llvm::hash_combine(
+              std::hash<std::decay_t<decltype(Vals)>>{}(Vals)...);
+        },
+        Values);
+  }
+
+public:
+  explicit HashedKey(Ts... Vals)
+      : Values(std::move(Vals)...), Hash(computeHash(Values)) {}
+
+  [[nodiscard]] size_t hash() const { return Hash; }
+
+  [[nodiscard]] const std::tuple<Ts...> &values() const { return Values; }
+
+  bool operator==(const HashedKey &Other) const {
+    return Hash == Other.Hash && Values == Other.Values;
+  }
+
+  bool operator!=(const HashedKey &Other) const { return !(*this == Other); }
+
+  struct Hasher {
+    size_t operator()(const HashedKey &Key) const { return Key.hash(); }
+  };
+};
+
+/**
+ * A hash-based cache that is split into shards, each of which is guarded by
+ * its own reader-writer lock, so that threads that access different shards
+ * do not contend. A cache with a single shard is meant for sequential use
+ * and is not synchronized at all.
+ *
+ * If a capacity is given, a shard that would grow beyond its share of the
+ * capacity is emptied before the new entry is inserted. This is a crude
+ * eviction policy, but the cached values can always be recomputed and the
+ * policy does not need any bookkeeping on cache hits.
+ */
+template <typename KeyTy, typename ValueTy, typename HashTy = std::hash<KeyTy>>
+class ShardedCache {
+private:
+  struct Shard {
+    std::shared_mutex Mtx;
+    std::unordered_map<KeyTy, ValueTy, HashTy> Entries;
+  };
+
+  std::vector<Shard> Shards;
+  // maximum number of entries per shard, zero means unbounded
+  size_t ShardCapacity;
+
+  Shard &getShard(const KeyTy &Key) {
+    return Shards[Shards.size() == 1 ? 0 : HashTy{}(Key) % Shards.size()];
+  }
+
+  [[nodiscard]] bool isConcurrent() const { return Shards.size() > 1; }
+
+public:
+  explicit ShardedCache(size_t NumShards = 1, size_t Capacity = 0)
+      : Shards(std::max<size_t>(NumShards, 1)),
+        ShardCapacity(Capacity == 0
+                          ? 0
+                          : std::max<size_t>(
+                                1, (Capacity + Shards.size() - 1) /
+                                       Shards.size())) {}
+
+  ShardedCache(const ShardedCache &) = delete;
+  ShardedCache &operator=(const ShardedCache &) = delete;
+  ShardedCache(ShardedCache &&) = delete;
+  ShardedCache &operator=(ShardedCache &&) = delete;
+  ~ShardedCache() = default;
+
+  /// Returns the cached value for the given key, if any.
+  [[nodiscard]] std::optional<ValueTy> lookup(const KeyTy &Key) {
+    auto &S = getShard(Key);
+    std::shared_lock<std::shared_mutex> Lock(S.Mtx, std::defer_lock);
+    if (isConcurrent()) {
+      Lock.lock();
+    }
+    if (auto Search = S.Entries.find(Key); Search != S.Entries.end()) {
+      return Search->second;
+    }
+    return std::nullopt;
+  }
+
+  /// Caches the given value unless another value has been cached for the key
+  /// in the meantime, and returns the cached value. NumEvicted is set to the
+  /// number of entries that had to be evicted to make room for the value.
+  ValueTy insert(const KeyTy &Key, ValueTy Value, size_t &NumEvicted) {
+    NumEvicted = 0;
+    auto &S = getShard(Key);
+    std::unique_lock<std::shared_mutex> Lock(S.Mtx, std::defer_lock);
+    if (isConcurrent()) {
+      Lock.lock();
+    }
+    if (auto Search = S.Entries.find(Key); Search != S.Entries.end()) {
+      // another thread may have constructed the value in the meantime
+      return Search->second;
+    }
+    if (ShardCapacity != 0 && S.Entries.size() >= ShardCapacity) {
+      NumEvicted = S.Entries.size();
+      S.Entries.clear();
+    }
+    return S.Entries.emplace(Key, std::move(Value)).first->second;
+  }
+
+  /// Returns the number of cached values. Must not be called concurrently to
+  /// insert().
+  [[nodiscard]] size_t size() const {
+    size_t Size = 0;
+    for (const auto &S : Shards) {
+      Size += S.Entries.size();
+    }
+    return Size;
+  }
+
+  [[nodiscard]] size_t getNumShards() const { return Shards.size(); }
+
+  void clear() {
+    for (auto &S : Shards) {
+      std::unique_lock<std::shared_mutex> Lock(S.Mtx);
+      S.Entries.clear();
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
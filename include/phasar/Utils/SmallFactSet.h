@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SMALLFACTSET_H_
+#define PHASAR_UTILS_SMALLFACTSET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+
+namespace psr {
+
+/**
+ * A set of data-flow facts that is meant to be used as the Container of a
+ * data-flow problem instead of std::set. Most flow functions produce only one
+ * or two facts, so up to InlineCapacity facts are stored without any heap
+ * allocation, in a sorted vector. Once the set grows beyond HashThreshold
+ * facts, it switches to a hash set so that lookups and insertions remain
+ * cheap for large sets. clear() keeps the allocated memory, which allows to
+ * reuse a set as an output buffer.
+ *
+ * In contrast to std::set, the iteration order is unspecified once the set
+ * has switched to the hash set, and all iterators are constant.
+ */
+template <typename T, unsigned InlineCapacity = 4, unsigned HashThreshold = 32,
+          typename Hash = std::hash<T>>
+class SmallFactSet {
+private:
+  using SortedTy = llvm::SmallVector<T, InlineCapacity>;
+  using HashedTy = std::unordered_set<T, Hash>;
+
+  // at most one of them is non-empty
+  SortedTy Sorted;
+  HashedTy Hashed;
+
+  [[nodiscard]] bool isHashed() const { return !Hashed.empty(); }
+
+  void switchToHashed() {
+    Hashed.insert(Sorted.begin(), Sorted.end());
+    Sorted.clear();
+  }
+
+public:
+  class const_iterator {
+  private:
+    typename SortedTy::const_iterator SortedIt{};
+    typename HashedTy::const_iterator HashedIt{};
+    bool InSorted = true;
+
+    friend class SmallFactSet;
+
+    explicit const_iterator(typename SortedTy::const_iterator It)
+        : SortedIt(It) {}
+    explicit const_iterator(typename HashedTy::const_iterator It)
+        : HashedIt(It), InSorted(false) {}
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return InSorted ? *SortedIt : *HashedIt; }
+
+    pointer operator->() const { return &**this; }
+
+    const_iterator &operator++() {
+      if (InSorted) {
+        ++SortedIt;
+      } else {
+        ++HashedIt;
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto Temp(*this);
+      ++*this;
+      return Temp;
+    }
+
+    bool operator==(const const_iterator &Other) const {
+      return InSorted == Other.InSorted &&
+             (InSorted ? SortedIt == Other.SortedIt
+                       : HashedIt == Other.HashedIt);
+    }
+
+    bool operator!=(const const_iterator &Other) const {
+      return !(*this == Other);
+    }
+  };
+
+  using value_type = T;
+  using key_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = const T &;
+  using const_reference = const T &;
+  using iterator = const_iterator;
+
+  SmallFactSet() = default;
+
+  SmallFactSet(std::initializer_list<T> IList) {
+    insert(IList.begin(), IList.end());
+  }
+
+  template <typename InputIt> SmallFactSet(InputIt First, InputIt Last) {
+    insert(First, Last);
+  }
+
+  std::pair<const_iterator, bool> insert(const T &Fact) {
+    if (isHashed()) {
+      auto [It, Inserted] = Hashed.insert(Fact);
+      return {const_iterator(It), Inserted};
+    }
+    auto It = std::lower_bound(Sorted.begin(), Sorted.end(), Fact);
+    if (It != Sorted.end() && !(Fact < *It)) {
+      return {const_iterator(typename SortedTy::const_iterator(It)), false};
+    }
+    if (Sorted.size() < HashThreshold) {
+      It = Sorted.insert(It, Fact);
+      return {const_iterator(typename SortedTy::const_iterator(It)), true};
+    }
+    switchToHashed();
+    auto [HashedIt, Inserted] = Hashed.insert(Fact);
+    return {const_iterator(HashedIt), Inserted};
+  }
+
+  // for std::inserter()
+  const_iterator insert(const_iterator /* Hint */, const T &Fact) {
+    return insert(Fact).first;
+  }
+
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    for (; First != Last; ++First) {
+      insert(*First);
+    }
+  }
+
+  size_type erase(const T &Fact) {
+    if (isHashed()) {
+      return Hashed.erase(Fact);
+    }
+    auto It = std::lower_bound(Sorted.begin(), Sorted.end(), Fact);
+    if (It == Sorted.end() || Fact < *It) {
+      return 0;
+    }
+    Sorted.erase(It);
+    return 1;
+  }
+
+  /// Removes all facts, but keeps the allocated memory.
+  void clear() {
+    Sorted.clear();
+    Hashed.clear();
+  }
+
+  [[nodiscard]] const_iterator find(const T &Fact) const {
+    if (isHashed()) {
+      return const_iterator(Hashed.find(Fact));
+    }
+    auto It = std::lower_bound(Sorted.begin(), Sorted.end(), Fact);
+    if (It == Sorted.end() || Fact < *It) {
+      return end();
+    }
+    return const_iterator(It);
+  }
+
+  [[nodiscard]] size_type count(const T &Fact) const {
+    return find(Fact) != end();
+  }
+
+  [[nodiscard]] size_type size() const {
+    return isHashed() ? Hashed.size() : Sorted.size();
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  [[nodiscard]] const_iterator begin() const {
+    return isHashed() ? const_iterator(Hashed.begin())
+                      : const_iterator(Sorted.begin());
+  }
+
+  [[nodiscard]] const_iterator end() const {
+    return isHashed() ? const_iterator(Hashed.end())
+                      : const_iterator(Sorted.end());
+  }
+
+  friend bool operator==(const SmallFactSet &Lhs, const SmallFactSet &Rhs) {
+    if (Lhs.size() != Rhs.size()) {
+      return false;
+    }
+    if (!Lhs.isHashed() && !Rhs.isHashed()) {
+      return std::equal(Lhs.Sorted.begin(), Lhs.Sorted.end(),
+                        Rhs.Sorted.begin());
+    }
+    return std::all_of(Lhs.begin(), Lhs.end(),
+                       [&Rhs](const T &Fact) { return Rhs.count(Fact); });
+  }
+
+  friend bool operator!=(const SmallFactSet &Lhs, const SmallFactSet &Rhs) {
+    return !(Lhs == Rhs);
+  }
+
+  // lexicographical order of the sorted facts, as for std::set
+  friend bool operator<(const SmallFactSet &Lhs, const SmallFactSet &Rhs) {
+    if (!Lhs.isHashed() && !Rhs.isHashed()) {
+      return std::lexicographical_compare(Lhs.Sorted.begin(), Lhs.Sorted.end(),
+                                          Rhs.Sorted.begin(),
+                                          Rhs.Sorted.end());
+    }
+    std::vector<T> LhsFacts(Lhs.begin(), Lhs.end());
+    std::vector<T> RhsFacts(Rhs.begin(), Rhs.end());
+    std::sort(LhsFacts.begin(), LhsFacts.end());
+    std::sort(RhsFacts.begin(), RhsFacts.end());
+    return LhsFacts < RhsFacts;
+  }
+};
+
+} // namespace psr
+
+#endif
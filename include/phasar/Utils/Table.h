@@ -181,6 +181,12 @@ public:
     return table[rowKey][columnKey];
   }
 
+  [[nodiscard]] const V &get(R rowKey, C columnKey) const {
+    // Returns the value corresponding to the given row and column keys; the
+    // mapping must exist.
+    return table.at(rowKey).at(columnKey);
+  }
+
   V remove(R rowKey, C columnKey) {
     // Removes the mapping, if any, associated with the given keys.
     V v = table[rowKey][columnKey];
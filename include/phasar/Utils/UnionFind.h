@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_UNIONFIND_H_
+#define PHASAR_UTILS_UNIONFIND_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/**
+ * Disjoint sets over dense 32-bit IDs, e.g. the IDs handed out by an
+ * Interner. Sets are merged by size and find() compresses the paths it
+ * walks, so that both run in almost constant amortized time. The members of
+ * each set are additionally kept in a circular list, which allows to
+ * enumerate a set in time linear in its size without storing the members
+ * explicitly.
+ */
+class UnionFind {
+public:
+  using IdTy = uint32_t;
+
+private:
+  std::vector<IdTy> Parent;
+  // the number of members, only valid for representatives
+  std::vector<IdTy> Size;
+  // the next member of the same set
+  std::vector<IdTy> Next;
+
+public:
+  UnionFind() = default;
+
+  explicit UnionFind(size_t NumElements) { grow(NumElements); }
+
+  /// Adds singleton sets until there are NumElements elements.
+  void grow(size_t NumElements) {
+    Parent.reserve(NumElements);
+    Size.reserve(NumElements);
+    Next.reserve(NumElements);
+    while (Parent.size() < NumElements) {
+      makeSet();
+    }
+  }
+
+  /// Adds a new singleton set and returns its element.
+  IdTy makeSet() {
+    auto Id = static_cast<IdTy>(Parent.size());
+    Parent.push_back(Id);
+    Size.push_back(1);
+    Next.push_back(Id);
+    return Id;
+  }
+
+  /// Returns the representative of Id's set.
+  IdTy find(IdTy Id) {
+    assert(Id < Parent.size() && "Invalid ID!");
+    // path halving
+    while (Parent[Id] != Id) {
+      Parent[Id] = Parent[Parent[Id]];
+      Id = Parent[Id];
+    }
+    return Id;
+  }
+
+  /// Returns the representative of Id's set without compressing its path.
+  [[nodiscard]] IdTy findRoot(IdTy Id) const {
+    assert(Id < Parent.size() && "Invalid ID!");
+    while (Parent[Id] != Id) {
+      Id = Parent[Id];
+    }
+    return Id;
+  }
+
+  /// Merges the sets of Id1 and Id2 and returns the representative of the
+  /// merged set, which is one of the former representatives.
+  IdTy merge(IdTy Id1, IdTy Id2) {
+    Id1 = find(Id1);
+    Id2 = find(Id2);
+    if (Id1 == Id2) {
+      return Id1;
+    }
+    if (Size[Id1] < Size[Id2]) {
+      std::swap(Id1, Id2);
+    }
+    Parent[Id2] = Id1;
+    Size[Id1] += Size[Id2];
+    // splice the two circular member lists
+    std::swap(Next[Id1], Next[Id2]);
+    return Id1;
+  }
+
+  [[nodiscard]] bool connected(IdTy Id1, IdTy Id2) {
+    return find(Id1) == find(Id2);
+  }
+
+  /// Returns the number of members of Id's set.
+  [[nodiscard]] size_t getSetSize(IdTy Id) const { return Size[findRoot(Id)]; }
+
+  /// Calls Fn for each member of Id's set, starting with Id.
+  template <typename Fn> void forEachMember(IdTy Id, Fn F) const {
+    assert(Id < Parent.size() && "Invalid ID!");
+    IdTy Curr = Id;
+    do {
+      F(Curr);
+      Curr = Next[Curr];
+    } while (Curr != Id);
+  }
+
+  /// Returns the members of Id's set, starting with Id.
+  [[nodiscard]] std::vector<IdTy> getMembers(IdTy Id) const {
+    std::vector<IdTy> Members;
+    Members.reserve(getSetSize(Id));
+    forEachMember(Id, [&Members](IdTy Member) { Members.push_back(Member); });
+    return Members;
+  }
+
+  /// Returns the number of elements.
+  [[nodiscard]] size_t size() const { return Parent.size(); }
+
+  [[nodiscard]] bool empty() const { return Parent.empty(); }
+
+  void clear() {
+    Parent.clear();
+    Size.clear();
+    Next.clear();
+  }
+};
+
+} // namespace psr
+
+#endif
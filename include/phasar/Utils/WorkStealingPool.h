@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_WORKSTEALINGPOOL_H_
+#define PHASAR_UTILS_WORKSTEALINGPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/**
+ * A pool of worker threads that processes work items which may be discovered
+ * while other items are processed. Each worker owns a queue from which it
+ * takes the most recently added item (depth-first). Once its own queue runs
+ * dry, a worker steals the oldest item of another worker's queue. Items that
+ * are pushed by a worker are added to that worker's queue, all other items
+ * are distributed round-robin.
+ *
+ * run() returns as soon as all items, including those that have been pushed
+ * while processing other items, have been handled. The calling thread
+ * participates in the processing as the first worker.
+ */
+template <typename T> class WorkStealingPool {
+private:
+  struct WorkerQueue {
+    std::mutex Mtx;
+    std::deque<T> Items;
+  };
+
+  std::vector<WorkerQueue> Queues;
+  // number of items that are either queued or currently being processed
+  std::atomic<size_t> Pending{0};
+  std::atomic<size_t> PeakPending{0};
+  std::atomic<size_t> NextQueue{0};
+  std::atomic<bool> Aborted{false};
+  std::mutex ExceptionMtx;
+  std::exception_ptr FirstException;
+
+  // identifies the pool and queue of the calling worker thread
+  inline static thread_local const WorkStealingPool *CurrentPool = nullptr;
+  inline static thread_local size_t CurrentWorker = 0;
+
+  std::optional<T> take(size_t Worker) {
+    {
+      auto &Own = Queues[Worker];
+      std::lock_guard<std::mutex> Lock(Own.Mtx);
+      if (!Own.Items.empty()) {
+        std::optional<T> Item(std::move(Own.Items.back()));
+        Own.Items.pop_back();
+        return Item;
+      }
+    }
+    for (size_t Offset = 1; Offset < Queues.size(); ++Offset) {
+      auto &Victim = Queues[(Worker + Offset) % Queues.size()];
+      std::lock_guard<std::mutex> Lock(Victim.Mtx);
+      if (!Victim.Items.empty()) {
+        std::optional<T> Item(std::move(Victim.Items.front()));
+        Victim.Items.pop_front();
+        return Item;
+      }
+    }
+    return std::nullopt;
+  }
+
+  template <typename HandlerTy> void work(size_t Worker, HandlerTy &Handler) {
+    const WorkStealingPool *PrevPool = CurrentPool;
+    size_t PrevWorker = CurrentWorker;
+    CurrentPool = this;
+    CurrentWorker = Worker;
+    while (Pending.load() != 0 && !Aborted.load()) {
+      std::optional<T> Item = take(Worker);
+      if (!Item) {
+        // all remaining items are currently being processed by other workers,
+        // which may still discover new ones
+        std::this_thread::yield();
+        continue;
+      }
+      try {
+        Handler(std::move(*Item));
+      } catch (...) {
+        std::lock_guard<std::mutex> Lock(ExceptionMtx);
+        if (!FirstException) {
+          FirstException = std::current_exception();
+        }
+        Aborted = true;
+      }
+      --Pending;
+    }
+    CurrentPool = PrevPool;
+    CurrentWorker = PrevWorker;
+  }
+
+public:
+  explicit WorkStealingPool(unsigned NumThreads)
+      : Queues(std::max(NumThreads, 1U)) {}
+
+  ~WorkStealingPool() = default;
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+  WorkStealingPool(WorkStealingPool &&) = delete;
+  WorkStealingPool &operator=(WorkStealingPool &&) = delete;
+
+  [[nodiscard]] unsigned getNumThreads() const {
+    return static_cast<unsigned>(Queues.size());
+  }
+
+  /// Adds a work item; may be called concurrently from within run().
+  void push(T Item) {
+    size_t Now = ++Pending;
+    size_t Peak = PeakPending.load();
+    while (Now > Peak && !PeakPending.compare_exchange_weak(Peak, Now)) {
+    }
+    size_t Target =
+        (CurrentPool == this) ? CurrentWorker : NextQueue++ % Queues.size();
+    std::lock_guard<std::mutex> Lock(Queues[Target].Mtx);
+    Queues[Target].Items.push_back(std::move(Item));
+  }
+
+  /**
+   * Processes all work items using the given handler until no work is left.
+   * The handler is called concurrently and receives each item by value. If
+   * the handler throws, the remaining items are discarded and the first
+   * exception is rethrown after all workers have stopped.
+   */
+  template <typename HandlerTy> void run(HandlerTy Handler) {
+    std::vector<std::thread> Workers;
+    Workers.reserve(Queues.size() - 1);
+    for (size_t Worker = 1; Worker < Queues.size(); ++Worker) {
+      Workers.emplace_back([this, Worker, &Handler] { work(Worker, Handler); });
+    }
+    work(0, Handler);
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    if (Aborted) {
+      for (auto &Queue : Queues) {
+        Queue.Items.clear();
+      }
+      Pending = 0;
+      Aborted = false;
+      std::exception_ptr Exception = std::exchange(FirstException, nullptr);
+      std::rethrow_exception(Exception);
+    }
+  }
+
+  /// Returns the index of the calling worker, which is always less than
+  /// getNumThreads(). Threads that do not work for this pool get 0.
+  [[nodiscard]] size_t getCurrentWorker() const {
+    return CurrentPool == this ? CurrentWorker : 0;
+  }
+
+  /// Returns the maximal number of items that have been pending at once.
+  [[nodiscard]] size_t getPeakSize() const { return PeakPending.load(); }
+
+  [[nodiscard]] bool empty() const { return Pending.load() == 0; }
+};
+
+} // namespace psr
+
+#endif
@@ -7,15 +7,19 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <set>
+#include <string>
+#include <thread>
 #include <utility>
 
 #include "llvm/Support/ErrorHandling.h"
 
+#include "phasar/Config/Configuration.h"
 #include "phasar/Controller/AnalysisController.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
@@ -45,6 +49,8 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/InterMonoSolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
 #include "phasar/PhasarLLVM/Plugins/PluginFactories.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAndersenPointsToSet.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Utils/Utilities.h"
 
@@ -73,6 +79,57 @@ bool needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
          (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText);
 }
 
+bool computePointsToInfoEagerly(
+    AnalysisControllerEmitterOptions EmitterOptions) {
+  return needsToEmitPTA(EmitterOptions) ||
+         PhasarConfig::getPhasarConfig().VariablesMap().count(
+             "eager-pointer-analysis");
+}
+
+unsigned getNumThreads() {
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "right-to-ludicrous-speed")) {
+    return std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  return 1;
+}
+
+std::string getCallGraphSnapshotPath() {
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "call-graph-snapshot")) {
+    return PhasarConfig::getPhasarConfig()
+        .VariablesMap()["call-graph-snapshot"]
+        .as<std::string>();
+  }
+  return "";
+}
+
+std::string getPointsToCachePath() {
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "points-to-cache")) {
+    return PhasarConfig::getPhasarConfig()
+        .VariablesMap()["points-to-cache"]
+        .as<std::string>();
+  }
+  return "";
+}
+
+bool sliceCallGraphForTaint() {
+  return PhasarConfig::getPhasarConfig().VariablesMap().count(
+      "slice-call-graph");
+}
+
+std::unique_ptr<LLVMPointsToInfo>
+makePointsToInfo(ProjectIRDB &IRDB, PointerAnalysisType PTATy,
+                 AnalysisControllerEmitterOptions EmitterOptions) {
+  if (PTATy == PointerAnalysisType::Andersen) {
+    return std::make_unique<LLVMAndersenPointsToSet>(IRDB);
+  }
+  return std::make_unique<LLVMPointsToSet>(
+      IRDB, !computePointsToInfoEagerly(EmitterOptions), PTATy,
+      getNumThreads(), getPointsToCachePath());
+}
+
 AnalysisController::AnalysisController(
     ProjectIRDB &IRDB, std::vector<DataFlowAnalysisKind> DataFlowAnalyses,
     std::vector<std::string> AnalysisConfigs, PointerAnalysisType PTATy,
@@ -80,8 +137,10 @@ AnalysisController::AnalysisController(
     const std::set<std::string> &EntryPoints, AnalysisStrategy Strategy,
     AnalysisControllerEmitterOptions EmitterOptions,
     const std::string &ProjectID, const std::string &OutDirectory)
-    : IRDB(IRDB), TH(IRDB), PT(IRDB, !needsToEmitPTA(EmitterOptions), PTATy),
-      ICF(IRDB, CGTy, EntryPoints, &TH, &PT),
+    : IRDB(IRDB), TH(IRDB),
+      PT(makePointsToInfo(IRDB, PTATy, EmitterOptions)),
+      ICF(IRDB, CGTy, EntryPoints, &TH, PT.get(), SF, getNumThreads(),
+          getCallGraphSnapshotPath()),
       DataFlowAnalyses(std::move(DataFlowAnalyses)),
       AnalysisConfigs(std::move(AnalysisConfigs)), EntryPoints(EntryPoints),
       Strategy(Strategy), EmitterOptions(EmitterOptions), ProjectID(ProjectID),
@@ -93,6 +152,7 @@ AnalysisController::AnalysisController(
   }
   emitRequestedHelperAnalysisResults();
   executeAs(Strategy);
+  flushPointsToCache();
 }
 
 void AnalysisController::executeAs(AnalysisStrategy Strategy) {
@@ -117,6 +177,14 @@ void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   }
 }
 
+void AnalysisController::flushPointsToCache() {
+  auto *PTS = dynamic_cast<LLVMPointsToSet *>(PT.get());
+  if (PTS && !PTS->flushCache()) {
+    std::cerr << "Could not write the points-to cache '"
+              << getPointsToCachePath() << "'\n";
+  }
+}
+
 void AnalysisController::executeDemandDriven() {}
 
 void AnalysisController::executeIncremental() {}
@@ -136,25 +204,30 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::IFDSUninitializedVariables: {
         WholeProgramAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
                              IFDSUninitializedVariables>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IFDSConstAnalysis: {
         WholeProgramAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IFDSTaintAnalysis: {
+        auto TaintICF = makeTaintCallGraph(AnalysisConfigPath);
         WholeProgramAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(),
+                TaintICF ? TaintICF.get() : &ICF, &TH);
+        WPA.solve();
+        emitRequestedDataFlowResults(WPA);
+        WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IDETaintAnalysis: {
         WholeProgramAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -163,7 +236,7 @@ void AnalysisController::executeWholeProgram() {
         OpenSSLEVPKDFDescription TSDesc;
         WholeProgramAnalysis<IDESolver_P<IDETypeStateAnalysis>,
                              IDETypeStateAnalysis>
-            WPA(IRDB, &TSDesc, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, &TSDesc, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -171,14 +244,14 @@ void AnalysisController::executeWholeProgram() {
       } break;
       case DataFlowAnalysisType::IFDSTypeAnalysis: {
         WholeProgramAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IFDSSolverTest: {
         WholeProgramAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest> WPA(
-            IRDB, EntryPoints, &PT, &ICF, &TH);
+            IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -186,7 +259,7 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
         WholeProgramAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
                              IFDSLinearConstantAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -194,7 +267,7 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
         WholeProgramAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
                              IFDSFieldSensTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -202,14 +275,14 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::IDELinearConstantAnalysis: {
         WholeProgramAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
                              IDELinearConstantAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IDESolverTest: {
         WholeProgramAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> WPA(
-            IRDB, EntryPoints, &PT, &ICF, &TH);
+            IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -217,7 +290,7 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
         WholeProgramAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
                              IDEInstInteractionAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -226,7 +299,7 @@ void AnalysisController::executeWholeProgram() {
         WholeProgramAnalysis<
             IntraMonoSolver_P<IntraMonoFullConstantPropagation>,
             IntraMonoFullConstantPropagation>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -234,7 +307,7 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::IntraMonoSolverTest: {
         WholeProgramAnalysis<IntraMonoSolver_P<IntraMonoSolverTest>,
                              IntraMonoSolverTest>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -242,15 +315,17 @@ void AnalysisController::executeWholeProgram() {
       case DataFlowAnalysisType::InterMonoSolverTest: {
         WholeProgramAnalysis<InterMonoSolver_P<InterMonoSolverTest, 3>,
                              InterMonoSolverTest>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, EntryPoints, PT.get(), &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::InterMonoTaintAnalysis: {
+        auto TaintICF = makeTaintCallGraph(AnalysisConfigPath);
         WholeProgramAnalysis<InterMonoSolver_P<InterMonoTaintAnalysis, 3>,
                              InterMonoTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+            WPA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(),
+                TaintICF ? TaintICF.get() : &ICF, &TH);
         WPA.solve();
         emitRequestedDataFlowResults(WPA);
         WPA.releaseAllHelperAnalyses();
@@ -261,7 +336,7 @@ void AnalysisController::executeWholeProgram() {
     } else if (std::holds_alternative<IFDSPluginConstructor>(
                    _DataFlowAnalysis)) {
       auto Problem = std::get<IFDSPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
+          &IRDB, &TH, &ICF, PT.get(), EntryPoints);
       IFDSSolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
           *Problem);
       Solver.solve();
@@ -269,7 +344,7 @@ void AnalysisController::executeWholeProgram() {
     } else if (std::holds_alternative<IDEPluginConstructor>(
                    _DataFlowAnalysis)) {
       auto Problem = std::get<IDEPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
+          &IRDB, &TH, &ICF, PT.get(), EntryPoints);
       IDESolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
           *Problem);
       Solver.solve();
@@ -278,7 +353,7 @@ void AnalysisController::executeWholeProgram() {
                    _DataFlowAnalysis)) {
 
       auto Problem = std::get<IntraMonoPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
+          &IRDB, &TH, &ICF, PT.get(), EntryPoints);
       IntraMonoSolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
           *Problem);
       Solver.solve();
@@ -286,7 +361,7 @@ void AnalysisController::executeWholeProgram() {
     } else if (std::holds_alternative<InterMonoPluginConstructor>(
                    _DataFlowAnalysis)) {
       auto Problem = std::get<InterMonoPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
+          &IRDB, &TH, &ICF, PT.get(), EntryPoints);
       InterMonoSolver_P<std::remove_reference<decltype(*Problem)>::type, K>
           Solver(*Problem);
       Solver.solve();
@@ -295,6 +370,39 @@ void AnalysisController::executeWholeProgram() {
   }
 }
 
+std::unique_ptr<LLVMBasedICFG>
+AnalysisController::makeTaintCallGraph(const std::string &AnalysisConfigPath) {
+  if (!sliceCallGraphForTaint()) {
+    return nullptr;
+  }
+  TaintConfiguration<const llvm::Value *> TSF(AnalysisConfigPath);
+  std::set<const llvm::Function *> Entries;
+  for (const auto &EntryPoint : EntryPoints) {
+    if (const auto *F = IRDB.getFunctionDefinition(EntryPoint)) {
+      Entries.insert(F);
+    }
+  }
+  // the taint analyses look up callees by their mangled or demangled names
+  std::set<const llvm::Function *> SourcesAndSinks;
+  for (const auto *F : ICF.getAllVertexFunctions()) {
+    auto Name = F->getName().str();
+    auto DemangledName = cxxDemangle(Name);
+    if (TSF.isSource(Name) || TSF.isSink(Name) ||
+        TSF.isSource(DemangledName) || TSF.isSink(DemangledName)) {
+      SourcesAndSinks.insert(F);
+    }
+  }
+  auto TaintICF = std::make_unique<LLVMBasedICFG>(ICF);
+  auto Report = TaintICF->sliceTowards(Entries, SourcesAndSinks);
+  std::cout << "Sliced the call graph towards " << SourcesAndSinks.size()
+            << " source and sink functions: removed "
+            << Report.NumRemovedFunctions << " of " << Report.NumFunctions
+            << " functions and " << Report.NumRemovedCallEdges << " of "
+            << Report.NumCallEdges << " call edges, kept "
+            << Report.NumBoundaryFunctions << " boundary functions\n";
+  return TaintICF;
+}
+
 void AnalysisController::emitRequestedHelperAnalysisResults() {
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitIR) {
     if (!ResultDirectory.empty()) {
@@ -331,25 +439,25 @@ void AnalysisController::emitRequestedHelperAnalysisResults() {
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-pta.txt");
-      PT.print(OFS);
+      PT->print(OFS);
     } else {
-      PT.print();
+      PT->print();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsDot) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-pta.dot");
-      PT.print(OFS);
+      PT->print(OFS);
     } else {
-      PT.print();
+      PT->print();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsJson) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-pta.json");
-      PT.printAsJson(OFS);
+      PT->printAsJson(OFS);
     } else {
-      PT.printAsJson();
+      PT->printAsJson(std::cout);
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsText) {
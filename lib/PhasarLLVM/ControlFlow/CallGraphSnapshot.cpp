@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstring>
+#include <system_error>
+
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/CallGraphSnapshot.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+// bump the version whenever the layout changes
+constexpr char SnapshotMagic[8] = {'P', 'S', 'R', 'C', 'G', 'v', '0', '1'};
+
+// The file consists of the header, the offsets of the function names in the
+// name table (NumFunctions + 1 of them, padded to an even number to keep the
+// edges aligned), the edges and the name table.
+struct SnapshotHeader {
+  char Magic[8];
+  uint64_t ModuleHash;
+  uint64_t ConfigHash;
+  uint32_t NumFunctions;
+  uint32_t NumEdges;
+  uint64_t NamesSize;
+};
+
+size_t getNumPaddedOffsets(size_t NumFunctions) {
+  return (NumFunctions + 2) & ~size_t(1);
+}
+
+} // anonymous namespace
+
+CallGraphSnapshot::~CallGraphSnapshot() = default;
+
+bool CallGraphSnapshot::write(const std::string &Path, uint64_t ModuleHash,
+                              uint64_t ConfigHash,
+                              const std::vector<std::string> &FunctionNames,
+                              const std::vector<Edge> &Edges) {
+  SnapshotHeader Header;
+  std::memcpy(Header.Magic, SnapshotMagic, sizeof(SnapshotMagic));
+  Header.ModuleHash = ModuleHash;
+  Header.ConfigHash = ConfigHash;
+  Header.NumFunctions = FunctionNames.size();
+  Header.NumEdges = Edges.size();
+  std::vector<uint32_t> NameOffsets(
+      getNumPaddedOffsets(FunctionNames.size()));
+  uint64_t NamesSize = 0;
+  for (size_t Idx = 0; Idx < FunctionNames.size(); ++Idx) {
+    NameOffsets[Idx] = NamesSize;
+    NamesSize += FunctionNames[Idx].size();
+  }
+  NameOffsets[FunctionNames.size()] = NamesSize;
+  Header.NamesSize = NamesSize;
+  // write to a temporary file first, so that a concurrent or interrupted run
+  // never leaves a partially written snapshot behind
+  std::string TmpPath = Path + ".tmp";
+  {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(TmpPath, EC, llvm::sys::fs::OF_None);
+    if (EC) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Could not write call-graph snapshot '" << TmpPath
+                    << "': " << EC.message());
+      return false;
+    }
+    OS.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+    OS.write(reinterpret_cast<const char *>(NameOffsets.data()),
+             NameOffsets.size() * sizeof(uint32_t));
+    OS.write(reinterpret_cast<const char *>(Edges.data()),
+             Edges.size() * sizeof(Edge));
+    for (const auto &Name : FunctionNames) {
+      OS << Name;
+    }
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TmpPath);
+      return false;
+    }
+  }
+  if (auto EC = llvm::sys::fs::rename(TmpPath, Path)) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                  << "Could not write call-graph snapshot '" << Path
+                  << "': " << EC.message());
+    llvm::sys::fs::remove(TmpPath);
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<CallGraphSnapshot>
+CallGraphSnapshot::open(const std::string &Path) {
+  uint64_t FileSize;
+  if (llvm::sys::fs::file_size(Path, FileSize) ||
+      FileSize < sizeof(SnapshotHeader)) {
+    return nullptr;
+  }
+  auto FD = llvm::sys::fs::openNativeFileForRead(Path);
+  if (!FD) {
+    llvm::consumeError(FD.takeError());
+    return nullptr;
+  }
+  std::error_code EC;
+  auto Region = std::make_unique<llvm::sys::fs::mapped_file_region>(
+      *FD, llvm::sys::fs::mapped_file_region::readonly, FileSize, 0, EC);
+  llvm::sys::fs::closeFile(*FD);
+  if (EC) {
+    return nullptr;
+  }
+  const char *Data = Region->const_data();
+  SnapshotHeader Header;
+  std::memcpy(&Header, Data, sizeof(Header));
+  if (std::memcmp(Header.Magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0) {
+    return nullptr;
+  }
+  size_t NumOffsets = getNumPaddedOffsets(Header.NumFunctions);
+  size_t EdgesStart = sizeof(Header) + NumOffsets * sizeof(uint32_t);
+  size_t NamesStart = EdgesStart + size_t(Header.NumEdges) * sizeof(Edge);
+  if (NamesStart + Header.NamesSize != FileSize) {
+    return nullptr;
+  }
+  std::unique_ptr<CallGraphSnapshot> Snapshot(new CallGraphSnapshot());
+  Snapshot->ModuleHash = Header.ModuleHash;
+  Snapshot->ConfigHash = Header.ConfigHash;
+  Snapshot->NameOffsets = llvm::ArrayRef<uint32_t>(
+      reinterpret_cast<const uint32_t *>(Data + sizeof(Header)),
+      Header.NumFunctions + 1);
+  Snapshot->Edges = llvm::ArrayRef<Edge>(
+      reinterpret_cast<const Edge *>(Data + EdgesStart), Header.NumEdges);
+  Snapshot->Names = llvm::StringRef(Data + NamesStart, Header.NamesSize);
+  // reject snapshots whose offsets or indices point out of range
+  for (size_t Idx = 0; Idx < Header.NumFunctions; ++Idx) {
+    if (Snapshot->NameOffsets[Idx] > Snapshot->NameOffsets[Idx + 1] ||
+        Snapshot->NameOffsets[Idx + 1] > Header.NamesSize) {
+      return nullptr;
+    }
+  }
+  for (const auto &E : Snapshot->Edges) {
+    if (E.Caller >= Header.NumFunctions || E.Callee >= Header.NumFunctions) {
+      return nullptr;
+    }
+  }
+  Snapshot->Region = std::move(Region);
+  return Snapshot;
+}
+
+} // namespace psr
@@ -32,30 +32,14 @@ namespace psr {
 
 std::vector<const llvm::Instruction *>
 LLVMBasedBackwardCFG::getPredsOf(const llvm::Instruction *Stmt) const {
-  vector<const llvm::Instruction *> Preds;
-  if (Stmt->getNextNode()) {
-    Preds.push_back(Stmt->getNextNode());
-  }
-  if (Stmt->isTerminator()) {
-    for (unsigned I = 0; I < Stmt->getNumSuccessors(); ++I) {
-      Preds.push_back(&*Stmt->getSuccessor(I)->begin());
-    }
-  }
-  return Preds;
+  auto Preds = ForwardCache->getSuccsOf(Stmt);
+  return {Preds.begin(), Preds.end()};
 }
 
 std::vector<const llvm::Instruction *>
 LLVMBasedBackwardCFG::getSuccsOf(const llvm::Instruction *Stmt) const {
-  vector<const llvm::Instruction *> Preds;
-  if (Stmt->getPrevNode()) {
-    Preds.push_back(Stmt->getPrevNode());
-  }
-  if (Stmt == &Stmt->getParent()->front()) {
-    for (const auto *PredBlock : llvm::predecessors(Stmt->getParent())) {
-      Preds.push_back(&PredBlock->back());
-    }
-  }
-  return Preds;
+  auto Succs = ForwardCache->getPredsOf(Stmt);
+  return {Succs.begin(), Succs.end()};
 }
 
 std::set<const llvm::Instruction *>
@@ -68,6 +52,27 @@ LLVMBasedBackwardCFG::getExitPointsOf(const llvm::Function *Fun) const {
   return LLVMBasedCFG::getStartPointsOf(Fun);
 }
 
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedBackwardCFG::getPredsOfAsRange(const llvm::Instruction *Stmt) const {
+  return ForwardCache->getSuccsOf(Stmt);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedBackwardCFG::getSuccsOfAsRange(const llvm::Instruction *Stmt) const {
+  return ForwardCache->getPredsOf(Stmt);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedBackwardCFG::getStartPointsOfAsRange(
+    const llvm::Function *Fun) const {
+  return LLVMBasedCFG::getExitPointsOfAsRange(Fun);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedBackwardCFG::getExitPointsOfAsRange(const llvm::Function *Fun) const {
+  return LLVMBasedCFG::getStartPointsOfAsRange(Fun);
+}
+
 // LLVMBasedCFG::isStartPoint
 bool LLVMBasedBackwardCFG::isExitStmt(const llvm::Instruction *Stmt) const {
   return (Stmt == &Stmt->getFunction()->front().front());
@@ -42,49 +42,24 @@ LLVMBasedCFG::getFunctionOf(const llvm::Instruction *Stmt) const {
 
 vector<const llvm::Instruction *>
 LLVMBasedCFG::getPredsOf(const llvm::Instruction *I) const {
-  vector<const llvm::Instruction *> Preds;
-  if (!IgnoreDbgInstructions) {
-    if (I->getPrevNode()) {
-      Preds.push_back(I->getPrevNode());
-    }
-  } else {
-    if (I->getPrevNonDebugInstruction()) {
-      Preds.push_back(I->getPrevNonDebugInstruction());
-    }
-  }
-  // If we do not have a predecessor yet, look for basic blocks which
-  // lead to our instruction in question!
-  if (Preds.empty()) {
-    std::transform(llvm::pred_begin(I->getParent()),
-                   llvm::pred_end(I->getParent()), back_inserter(Preds),
-                   [](const llvm::BasicBlock *BB) {
-                     assert(BB && "BB under analysis was not well formed.");
-                     return BB->getTerminator();
-                   });
-  }
-  return Preds;
+  auto Preds = Cache->getPredsOf(I);
+  return {Preds.begin(), Preds.end()};
 }
 
 vector<const llvm::Instruction *>
 LLVMBasedCFG::getSuccsOf(const llvm::Instruction *I) const {
-  vector<const llvm::Instruction *> Successors;
-  // case we wish to consider LLVM's debug instructions
-  if (!IgnoreDbgInstructions) {
-    if (I->getNextNode()) {
-      Successors.push_back(I->getNextNode());
-    }
-  } else {
-    if (I->getNextNonDebugInstruction()) {
-      Successors.push_back(I->getNextNonDebugInstruction());
-    }
-  }
-  if (I->isTerminator()) {
-    Successors.reserve(I->getNumSuccessors() + Successors.size());
-    std::transform(llvm::succ_begin(I), llvm::succ_end(I),
-                   back_inserter(Successors),
-                   [](const llvm::BasicBlock *BB) { return &BB->front(); });
-  }
-  return Successors;
+  auto Successors = Cache->getSuccsOf(I);
+  return {Successors.begin(), Successors.end()};
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFG::getPredsOfAsRange(const llvm::Instruction *I) const {
+  return Cache->getPredsOf(I);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFG::getSuccsOfAsRange(const llvm::Instruction *I) const {
+  return Cache->getSuccsOf(I);
 }
 
 vector<pair<const llvm::Instruction *, const llvm::Instruction *>>
@@ -153,6 +128,22 @@ LLVMBasedCFG::getExitPointsOf(const llvm::Function *Fun) const {
   }
 }
 
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFG::getStartPointsOfAsRange(const llvm::Function *Fun) const {
+  if (!Fun) {
+    return {};
+  }
+  return Cache->getStartPointsOf(Fun);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedCFG::getExitPointsOfAsRange(const llvm::Function *Fun) const {
+  if (!Fun) {
+    return {};
+  }
+  return Cache->getExitPointsOf(Fun);
+}
+
 bool LLVMBasedCFG::isCallStmt(const llvm::Instruction *Stmt) const {
   return llvm::isa<llvm::CallInst>(Stmt) || llvm::isa<llvm::InvokeInst>(Stmt);
 }
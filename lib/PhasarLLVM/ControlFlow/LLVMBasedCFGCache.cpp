@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFGCache.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+LLVMBasedCFGCache::~LLVMBasedCFGCache() = default;
+
+vector<const llvm::Instruction *>
+LLVMBasedCFGCache::computeSuccsOf(const llvm::Instruction *I,
+                                  bool IgnoreDbgInstructions) {
+  vector<const llvm::Instruction *> Successors;
+  // case we wish to consider LLVM's debug instructions
+  if (!IgnoreDbgInstructions) {
+    if (I->getNextNode()) {
+      Successors.push_back(I->getNextNode());
+    }
+  } else {
+    if (I->getNextNonDebugInstruction()) {
+      Successors.push_back(I->getNextNonDebugInstruction());
+    }
+  }
+  if (I->isTerminator()) {
+    Successors.reserve(I->getNumSuccessors() + Successors.size());
+    std::transform(llvm::succ_begin(I), llvm::succ_end(I),
+                   back_inserter(Successors),
+                   [](const llvm::BasicBlock *BB) { return &BB->front(); });
+  }
+  return Successors;
+}
+
+vector<const llvm::Instruction *>
+LLVMBasedCFGCache::computePredsOf(const llvm::Instruction *I,
+                                  bool IgnoreDbgInstructions) {
+  vector<const llvm::Instruction *> Preds;
+  if (!IgnoreDbgInstructions) {
+    if (I->getPrevNode()) {
+      Preds.push_back(I->getPrevNode());
+    }
+  } else {
+    if (I->getPrevNonDebugInstruction()) {
+      Preds.push_back(I->getPrevNonDebugInstruction());
+    }
+  }
+  // If we do not have a predecessor yet, look for basic blocks which
+  // lead to our instruction in question!
+  if (Preds.empty()) {
+    std::transform(llvm::pred_begin(I->getParent()),
+                   llvm::pred_end(I->getParent()), back_inserter(Preds),
+                   [](const llvm::BasicBlock *BB) {
+                     assert(BB && "BB under analysis was not well formed.");
+                     return BB->getTerminator();
+                   });
+  }
+  return Preds;
+}
+
+// The node is returned by value, as the map of nodes may be rehashed as soon
+// as the lock is released.
+LLVMBasedCFGCache::Node
+LLVMBasedCFGCache::getNode(const llvm::Instruction *Inst) {
+  {
+    std::shared_lock<std::shared_mutex> Lock(Mtx);
+    if (auto Search = Nodes.find(Inst); Search != Nodes.end()) {
+      return Search->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> Lock(Mtx);
+  // another thread may have built the table in the meantime
+  if (!Tables.count(Inst->getFunction())) {
+    buildTable(Inst->getFunction());
+  }
+  auto Search = Nodes.find(Inst);
+  assert(Search != Nodes.end() && "Instruction is not part of its function");
+  return Search->second;
+}
+
+const LLVMBasedCFGCache::FunctionTable &
+LLVMBasedCFGCache::getTable(const llvm::Function *Fun) {
+  {
+    std::shared_lock<std::shared_mutex> Lock(Mtx);
+    if (auto Search = Tables.find(Fun); Search != Tables.end()) {
+      return *Search->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> Lock(Mtx);
+  if (auto Search = Tables.find(Fun); Search != Tables.end()) {
+    return *Search->second;
+  }
+  return buildTable(Fun);
+}
+
+LLVMBasedCFGCache::FunctionTable &
+LLVMBasedCFGCache::buildTable(const llvm::Function *Fun) {
+  auto Table = std::make_unique<FunctionTable>();
+  if (!Fun->isDeclaration()) {
+    Table->StartPoints.push_back(&Fun->front().front());
+    Table->ExitPoints.push_back(&Fun->back().back());
+  }
+  // the views into the tables are created once they are complete, as they
+  // may be reallocated while they are filled
+  vector<pair<size_t, size_t>> SuccOffsets;
+  vector<pair<size_t, size_t>> PredOffsets;
+  for (const auto &I : llvm::instructions(Fun)) {
+    auto Succs = computeSuccsOf(&I, IgnoreDbgInstructions);
+    SuccOffsets.emplace_back(Table->Succs.size(), Succs.size());
+    Table->Succs.insert(Table->Succs.end(), Succs.begin(), Succs.end());
+    auto Preds = computePredsOf(&I, IgnoreDbgInstructions);
+    PredOffsets.emplace_back(Table->Preds.size(), Preds.size());
+    Table->Preds.insert(Table->Preds.end(), Preds.begin(), Preds.end());
+  }
+  llvm::ArrayRef<const llvm::Instruction *> Succs(Table->Succs);
+  llvm::ArrayRef<const llvm::Instruction *> Preds(Table->Preds);
+  size_t Idx = 0;
+  for (const auto &I : llvm::instructions(Fun)) {
+    Nodes[&I] = {Succs.slice(SuccOffsets[Idx].first, SuccOffsets[Idx].second),
+                 Preds.slice(PredOffsets[Idx].first, PredOffsets[Idx].second)};
+    ++Idx;
+  }
+  auto &Result = *Table;
+  Tables[Fun] = std::move(Table);
+  return Result;
+}
+
+} // namespace psr
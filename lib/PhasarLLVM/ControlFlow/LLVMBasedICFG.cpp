@@ -14,8 +14,15 @@
  *      Author: pdschbrt
  */
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <utility>
 
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
@@ -29,7 +36,9 @@
 #include "boost/graph/depth_first_search.hpp"
 #include "boost/graph/graph_utility.hpp"
 #include "boost/graph/graphviz.hpp"
+#include "boost/graph/strong_components.hpp"
 
+#include "phasar/PhasarLLVM/ControlFlow/CallGraphSnapshot.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/DTAResolver.h"
@@ -37,11 +46,14 @@
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/OTFResolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/RTAResolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/SignatureResolver.h"
 
+#include "phasar/Utils/GraphExtensions.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Utilities.h"
+#include "phasar/Utils/WorkStealingPool.h"
 
 #include "phasar/DB/ProjectIRDB.h"
 
@@ -57,6 +69,51 @@ using namespace std;
 
 namespace psr {
 
+namespace {
+
+// The hash of all modules, independent of their identifiers so that a
+// snapshot remains valid when the IR files are moved.
+uint64_t computeIRDBHash(const ProjectIRDB &IRDB) {
+  std::vector<size_t> ModuleHashes;
+  for (auto *M : IRDB.getAllModules()) {
+    ModuleHashes.push_back(computeModuleHash(M, false));
+  }
+  std::sort(ModuleHashes.begin(), ModuleHashes.end());
+  std::ostringstream OSS;
+  for (auto Hash : ModuleHashes) {
+    OSS << Hash << ';';
+  }
+  return std::hash<std::string>{}(OSS.str());
+}
+
+uint64_t computeConfigHash(CallGraphAnalysisType CGType, SoundnessFlag SF,
+                           const std::set<std::string> &EntryPoints,
+                           const LLVMPointsToInfo *PT) {
+  std::ostringstream OSS;
+  OSS << CGType << ';' << SF;
+  // only OTF resolves call-sites using the points-to information
+  if (CGType == CallGraphAnalysisType::OTF && PT) {
+    OSS << ';' << toString(PT->getPointerAnalysistype());
+  }
+  for (const auto &EntryPoint : EntryPoints) {
+    OSS << ';' << EntryPoint;
+  }
+  return std::hash<std::string>{}(OSS.str());
+}
+
+// The range queries return views into the frozen call graph, which does not
+// exist while the call graph is still under construction. Fail loudly instead
+// of handing out empty ranges in builds without assertions.
+void requireFrozen(bool IsFrozen, const char *Query) {
+  if (!IsFrozen) {
+    llvm::report_fatal_error(llvm::Twine(Query) +
+                             "() called while the call graph is still under "
+                             "construction, use the set-based query instead");
+  }
+}
+
+} // anonymous namespace
+
 struct LLVMBasedICFG::dependency_visitor : boost::default_dfs_visitor {
   std::vector<vertex_t> &Vertices;
   dependency_visitor(std::vector<vertex_t> &V) : Vertices(V) {}
@@ -87,12 +144,16 @@ LLVMBasedICFG::LLVMBasedICFG(const LLVMBasedICFG &ICF)
     : IRDB(ICF.IRDB), CGType(ICF.CGType), SF(ICF.SF), TH(ICF.TH), PT(ICF.PT),
       // TODO copy resolver
       Res(nullptr), VisitedFunctions(ICF.VisitedFunctions),
-      CallGraph(ICF.CallGraph), FunctionVertexMap(ICF.FunctionVertexMap) {}
+      NumFixpointRounds(ICF.NumFixpointRounds), CallGraph(ICF.CallGraph),
+      FunctionVertexMap(ICF.FunctionVertexMap), Frozen(ICF.Frozen),
+      IsFrozen(ICF.IsFrozen), SCCs(ICF.SCCs),
+      SliceBoundary(ICF.SliceBoundary) {}
 
 LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
                              const std::set<std::string> &EntryPoints,
                              LLVMTypeHierarchy *TH, LLVMPointsToInfo *PT,
-                             SoundnessFlag SF)
+                             SoundnessFlag SF, unsigned NumThreads,
+                             const std::string &SnapshotPath)
     : IRDB(IRDB), CGType(CGType), SF(SF), TH(TH), PT(PT) {
   PAMM_GET_INSTANCE;
   // check for faults in the logic
@@ -108,24 +169,178 @@ LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
     this->PT = new LLVMPointsToSet(IRDB);
     UserPTInfos = false;
   }
+  if (SnapshotPath.empty()) {
+    constructCallGraph(EntryPoints, NumThreads);
+  } else {
+    auto ModuleHash = computeIRDBHash(IRDB);
+    auto ConfigHash = computeConfigHash(CGType, SF, EntryPoints, this->PT);
+    if (!loadSnapshot(SnapshotPath, ModuleHash, ConfigHash)) {
+      constructCallGraph(EntryPoints, NumThreads);
+      storeSnapshot(SnapshotPath, ModuleHash, ConfigHash);
+    } else if (CGType == CallGraphAnalysisType::OTF) {
+      replayPossibleTargets();
+    }
+  }
+  freeze();
+  START_TIMER("CG SCC Computation", PAMM_SEVERITY_LEVEL::Full);
+  computeSCCs();
+  STOP_TIMER("CG SCC Computation", PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("CG Vertices", getNumOfVertices(), PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("CG Edges", getNumOfEdges(), PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("CG SCCs", getNumSCCs(), PAMM_SEVERITY_LEVEL::Full);
+  REG_HISTOGRAM("CG SCC Sizes", PAMM_SEVERITY_LEVEL::Full);
+  for (unsigned SCC = 0; SCC < getNumSCCs(); ++SCC) {
+    ADD_TO_HISTOGRAM("CG SCC Sizes", getFunctionsOfSCC(SCC).size(), 1,
+                     PAMM_SEVERITY_LEVEL::Full);
+  }
+}
+
+void LLVMBasedICFG::constructCallGraph(const std::set<std::string> &EntryPoints,
+                                       unsigned NumThreads) {
   // instantiate the respective resolver type
   Res = makeResolver(IRDB, CGType, *this->TH, *this->PT);
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                 << "Starting CallGraphAnalysisType: " << CGType);
   VisitedFunctions.reserve(IRDB.getAllFunctions().size());
+  std::vector<const llvm::Function *> Entries;
   for (const auto &EntryPoint : EntryPoints) {
     const llvm::Function *F = IRDB.getFunctionDefinition(EntryPoint);
     if (F == nullptr) {
       llvm::report_fatal_error("Could not retrieve function for entry point");
     }
+    Entries.push_back(F);
+  }
+  if (NumThreads > 1 && Res->isOrderIndependent()) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Resolving call-sites using " << NumThreads
+                  << " threads");
+    resolveConcurrently(Entries, *Res, NumThreads);
+  }
+  // the call graph is always built in the same order to keep the vertex and
+  // edge ids independent of the number of threads
+  for (const auto *F : Entries) {
     constructionWalker(F, *Res);
   }
-  REG_COUNTER("CG Vertices", getNumOfVertices(), PAMM_SEVERITY_LEVEL::Full);
-  REG_COUNTER("CG Edges", getNumOfEdges(), PAMM_SEVERITY_LEVEL::Full);
+  PreResolvedTargets.clear();
+  if (SF == SoundnessFlag::SOUND) {
+    resolveToFixpoint(*Res);
+  }
+  [[maybe_unused]] auto VCallStats = Res->getVirtualCallCacheStats();
+  PAMM_GET_INSTANCE;
+  REG_COUNTER("CG Virtual Call Cache Hits", VCallStats.Hits,
+              PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("CG Virtual Call Cache Misses", VCallStats.Misses,
+              PAMM_SEVERITY_LEVEL::Full);
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Virtual call cache: " << VCallStats.Hits << " hit(s), "
+                << VCallStats.Misses << " miss(es)");
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                 << "Call graph has been constructed");
 }
 
+bool LLVMBasedICFG::loadSnapshot(const std::string &Path, uint64_t ModuleHash,
+                                 uint64_t ConfigHash) {
+  auto Snapshot = CallGraphSnapshot::open(Path);
+  if (!Snapshot) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "No valid call-graph snapshot at '" << Path << "'");
+    return false;
+  }
+  if (Snapshot->getModuleHash() != ModuleHash ||
+      Snapshot->getConfigHash() != ConfigHash) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Call-graph snapshot at '" << Path
+                  << "' has been written for different IR or settings");
+    return false;
+  }
+  // build the graph aside, a snapshot that does not fit the IR is discarded
+  bidigraph_t Graph;
+  std::unordered_map<const llvm::Function *, vertex_t> VertexMap;
+  std::vector<vertex_t> Vertices;
+  Vertices.reserve(Snapshot->getNumFunctions());
+  for (size_t Idx = 0; Idx < Snapshot->getNumFunctions(); ++Idx) {
+    auto Name = Snapshot->getFunctionName(Idx).str();
+    const llvm::Function *F = IRDB.getFunctionDefinition(Name);
+    if (!F) {
+      F = IRDB.getFunction(Name);
+    }
+    if (!F) {
+      return false;
+    }
+    Vertices.push_back(boost::add_vertex(VertexProperties(F), Graph));
+    VertexMap[F] = Vertices.back();
+  }
+  for (const auto &E : Snapshot->getEdges()) {
+    const llvm::Instruction *CS = IRDB.getInstruction(E.CallSiteID);
+    if (!CS) {
+      return false;
+    }
+    boost::add_edge(Vertices[E.Caller], Vertices[E.Callee], EdgeProperties(CS),
+                    Graph);
+  }
+  CallGraph = std::move(Graph);
+  FunctionVertexMap = std::move(VertexMap);
+  for (const auto &[F, Vertex] : FunctionVertexMap) {
+    if (!F->isDeclaration()) {
+      VisitedFunctions.insert(F);
+    }
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Call graph has been loaded from '" << Path << "'");
+  return true;
+}
+
+void LLVMBasedICFG::replayPossibleTargets() {
+  // the resolver is only used to update the points-to information
+  auto OTFRes = makeResolver(IRDB, CGType, *this->TH, *this->PT);
+  std::map<const llvm::Instruction *, std::set<const llvm::Function *>>
+      PossibleTargets;
+  vertex_iterator VIt;
+  vertex_iterator VEnd;
+  for (boost::tie(VIt, VEnd) = boost::vertices(CallGraph); VIt != VEnd;
+       ++VIt) {
+    out_edge_iterator EIt;
+    out_edge_iterator EEnd;
+    for (boost::tie(EIt, EEnd) = boost::out_edges(*VIt, CallGraph); EIt != EEnd;
+         ++EIt) {
+      PossibleTargets[CallGraph[*EIt].CS].insert(
+          CallGraph[boost::target(*EIt, CallGraph)].F);
+    }
+  }
+  for (auto &[CS, Targets] : PossibleTargets) {
+    OTFRes->handlePossibleTargets(llvm::ImmutableCallSite(CS), Targets);
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Replayed the targets of " << PossibleTargets.size()
+                << " call-sites on the points-to information");
+}
+
+bool LLVMBasedICFG::storeSnapshot(const std::string &Path, uint64_t ModuleHash,
+                                  uint64_t ConfigHash) const {
+  std::vector<std::string> FunctionNames;
+  FunctionNames.reserve(boost::num_vertices(CallGraph));
+  std::vector<CallGraphSnapshot::Edge> Edges;
+  Edges.reserve(boost::num_edges(CallGraph));
+  // the vertices are stored by their index and the edges vertex by vertex to
+  // reproduce the exact same graph when the snapshot is loaded
+  vertex_iterator VIt;
+  vertex_iterator VEnd;
+  for (boost::tie(VIt, VEnd) = boost::vertices(CallGraph); VIt != VEnd;
+       ++VIt) {
+    FunctionNames.push_back(CallGraph[*VIt].getFunctionName());
+    out_edge_iterator EIt;
+    out_edge_iterator EEnd;
+    for (boost::tie(EIt, EEnd) = boost::out_edges(*VIt, CallGraph); EIt != EEnd;
+         ++EIt) {
+      Edges.push_back({static_cast<uint32_t>(boost::source(*EIt, CallGraph)),
+                       static_cast<uint32_t>(boost::target(*EIt, CallGraph)),
+                       CallGraph[*EIt].ID});
+    }
+  }
+  return CallGraphSnapshot::write(Path, ModuleHash, ConfigHash, FunctionNames,
+                                  Edges);
+}
+
 LLVMBasedICFG::~LLVMBasedICFG() {
   // if we had to compute type hierarchy or points-to information ourselfs,
   // we need to clean up
@@ -139,99 +354,285 @@ LLVMBasedICFG::~LLVMBasedICFG() {
 
 void LLVMBasedICFG::constructionWalker(const llvm::Function *F,
                                        Resolver &Resolver) {
-  PAMM_GET_INSTANCE;
-  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                << "Walking in function: " << F->getName().str());
-  if (F->isDeclaration() || !VisitedFunctions.insert(F).second) {
+  // the state of a function whose instructions are being walked
+  struct Frame {
+    const llvm::Function *F;
+    vertex_t Vertex;
+    llvm::const_inst_iterator Curr;
+    llvm::const_inst_iterator End;
+    // the targets of the call-site Curr that remain to be walked
+    std::vector<const llvm::Function *> PendingTargets;
+    bool InCall = false;
+  };
+  std::vector<Frame> CallStack;
+
+  auto Enter = [this, &CallStack](const llvm::Function *F) {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                  << "Function already visited or only declaration: "
-                  << F->getName().str());
-    return;
+                  << "Walking in function: " << F->getName().str());
+    if (F->isDeclaration() || !VisitedFunctions.insert(F).second) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "Function already visited or only declaration: "
+                    << F->getName().str());
+      return;
+    }
+    // add a node for function F to the call graph (if not present already)
+    vertex_t ThisFunctionVertexDescriptor;
+    auto FvmItr = FunctionVertexMap.find(F);
+    if (FvmItr != FunctionVertexMap.end()) {
+      ThisFunctionVertexDescriptor = FvmItr->second;
+    } else {
+      ThisFunctionVertexDescriptor =
+          boost::add_vertex(VertexProperties(F), CallGraph);
+      FunctionVertexMap[F] = ThisFunctionVertexDescriptor;
+    }
+    CallStack.push_back({F, ThisFunctionVertexDescriptor, llvm::inst_begin(F),
+                         llvm::inst_end(F), {}, false});
+  };
+
+  Enter(F);
+  while (!CallStack.empty()) {
+    Frame &Top = CallStack.back();
+    if (Top.InCall) {
+      if (!Top.PendingTargets.empty()) {
+        // continue resolving
+        const llvm::Function *PossibleTarget = Top.PendingTargets.back();
+        Top.PendingTargets.pop_back();
+        Enter(PossibleTarget); // invalidates Top
+        continue;
+      }
+      Resolver.postCall(&*Top.Curr);
+      Top.InCall = false;
+      ++Top.Curr;
+      continue;
+    }
+    if (Top.Curr == Top.End) {
+      CallStack.pop_back();
+      continue;
+    }
+    const llvm::Instruction &I = *Top.Curr;
+    if (!llvm::isa<llvm::CallInst>(I) && !llvm::isa<llvm::InvokeInst>(I)) {
+      Resolver.otherInst(&I);
+      ++Top.Curr;
+      continue;
+    }
+    Resolver.preCall(&I);
+    llvm::ImmutableCallSite CS(&I);
+    set<const llvm::Function *> PossibleTargets;
+    auto Search = PreResolvedTargets.find(&I);
+    if (Search != PreResolvedTargets.end()) {
+      PossibleTargets = std::move(Search->second);
+      PreResolvedTargets.erase(Search);
+    } else {
+      PossibleTargets = resolveCallSite(CS, Resolver);
+    }
+
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Found " << PossibleTargets.size()
+                  << " possible target(s)");
+
+    Resolver.handlePossibleTargets(CS, PossibleTargets);
+    addCallEdges(Top.Vertex, CS.getInstruction(), PossibleTargets);
+    // the targets are walked in ascending order, hence push them reversed
+    Top.PendingTargets.assign(PossibleTargets.rbegin(),
+                              PossibleTargets.rend());
+    Top.InCall = true;
   }
+}
 
-  // add a node for function F to the call graph (if not present already)
-  vertex_t ThisFunctionVertexDescriptor;
-  auto FvmItr = FunctionVertexMap.find(F);
-  if (FvmItr != FunctionVertexMap.end()) {
-    ThisFunctionVertexDescriptor = FvmItr->second;
-  } else {
-    ThisFunctionVertexDescriptor =
-        boost::add_vertex(VertexProperties(F), CallGraph);
-    FunctionVertexMap[F] = ThisFunctionVertexDescriptor;
+set<const llvm::Function *>
+LLVMBasedICFG::resolveCallSite(llvm::ImmutableCallSite CS,
+                               Resolver &Resolver) const {
+  set<const llvm::Function *> PossibleTargets;
+  // check if function call can be resolved statically
+  if (CS.getCalledFunction() != nullptr) {
+    PossibleTargets.insert(CS.getCalledFunction());
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Found static call-site: ");
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "  " << llvmIRToString(CS.getInstruction()));
+    return PossibleTargets;
+  }
+  // still try to resolve the called function statically
+  const llvm::Value *SV = CS.getCalledValue()->stripPointerCasts();
+  const llvm::Function *ValueFunction =
+      !SV->hasName() ? nullptr : IRDB.getFunction(SV->getName());
+  if (ValueFunction) {
+    PossibleTargets.insert(ValueFunction);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Found static call-site: "
+                  << llvmIRToString(CS.getInstruction()));
+    return PossibleTargets;
   }
+  // the function call must be resolved dynamically
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "Found dynamic call-site: ");
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "  " << llvmIRToString(CS.getInstruction()));
+  // call the resolve routine
+  if (LLVMBasedICFG::isVirtualFunctionCall(CS.getInstruction())) {
+    return Resolver.resolveVirtualCall(CS);
+  }
+  return Resolver.resolveFunctionPointer(CS);
+}
 
-  // iterate all instructions of the current function
-  for (const auto &BB : *F) {
-    for (const auto &I : BB) {
-      if (llvm::isa<llvm::CallInst>(I) || llvm::isa<llvm::InvokeInst>(I)) {
-        Resolver.preCall(&I);
-
-        llvm::ImmutableCallSite CS(&I);
-        set<const llvm::Function *> PossibleTargets;
-        // check if function call can be resolved statically
-        if (CS.getCalledFunction() != nullptr) {
-          PossibleTargets.insert(CS.getCalledFunction());
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Found static call-site: ");
-          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "  " << llvmIRToString(CS.getInstruction()));
-        } else {
-          // still try to resolve the called function statically
-          const llvm::Value *SV = CS.getCalledValue()->stripPointerCasts();
-          const llvm::Function *ValueFunction =
-              !SV->hasName() ? nullptr : IRDB.getFunction(SV->getName());
-          if (ValueFunction) {
-            PossibleTargets.insert(ValueFunction);
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "Found static call-site: "
-                          << llvmIRToString(CS.getInstruction()));
-          } else {
-            // the function call must be resolved dynamically
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "Found dynamic call-site: ");
-            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "  " << llvmIRToString(CS.getInstruction()));
-            // call the resolve routine
-            if (LLVMBasedICFG::isVirtualFunctionCall(CS.getInstruction())) {
-              PossibleTargets = Resolver.resolveVirtualCall(CS);
-            } else {
-              PossibleTargets = Resolver.resolveFunctionPointer(CS);
-            }
-          }
-        }
+void LLVMBasedICFG::addCallEdges(
+    vertex_t Caller, const llvm::Instruction *CS,
+    const std::set<const llvm::Function *> &Targets) {
+  // Insert possible target inside the graph and add the link with
+  // the current function
+  for (const auto *PossibleTarget : Targets) {
+    vertex_t TargetVertex;
+    auto TargetFvmItr = FunctionVertexMap.find(PossibleTarget);
+    if (TargetFvmItr != FunctionVertexMap.end()) {
+      TargetVertex = TargetFvmItr->second;
+    } else {
+      TargetVertex =
+          boost::add_vertex(VertexProperties(PossibleTarget), CallGraph);
+      FunctionVertexMap[PossibleTarget] = TargetVertex;
+    }
+    boost::add_edge(Caller, TargetVertex, EdgeProperties(CS), CallGraph);
+  }
+}
 
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "Found " << PossibleTargets.size()
-                      << " possible target(s)");
-
-        Resolver.handlePossibleTargets(CS, PossibleTargets);
-        // Insert possible target inside the graph and add the link with
-        // the current function
-        for (const auto &PossibleTarget : PossibleTargets) {
-          vertex_t TargetVertex;
-          auto TargetFvmItr = FunctionVertexMap.find(PossibleTarget);
-          if (TargetFvmItr != FunctionVertexMap.end()) {
-            TargetVertex = TargetFvmItr->second;
-          } else {
-            TargetVertex =
-                boost::add_vertex(VertexProperties(PossibleTarget), CallGraph);
-            FunctionVertexMap[PossibleTarget] = TargetVertex;
-          }
-          boost::add_edge(ThisFunctionVertexDescriptor, TargetVertex,
-                          EdgeProperties(CS.getInstruction()), CallGraph);
+void LLVMBasedICFG::resolveToFixpoint(Resolver &Resolver) {
+  PAMM_GET_INSTANCE;
+  size_t NumRounds = 0;
+  size_t NumReResolved = 0;
+  for (auto Outdated = Resolver.getOutdatedCallSites(); !Outdated.empty();
+       Outdated = Resolver.getOutdatedCallSites()) {
+    ++NumRounds;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Call graph fixpoint round " << NumRounds << ": "
+                  << Outdated.size() << " outdated call-site(s)");
+    for (const auto *I : Outdated) {
+      ++NumReResolved;
+      Resolver.preCall(I);
+      llvm::ImmutableCallSite CS(I);
+      // only the targets that are new to the call graph need to be handled
+      set<const llvm::Function *> KnownTargets = getCalleesOfCallAt(I);
+      set<const llvm::Function *> NewTargets;
+      for (const auto *PossibleTarget : resolveCallSite(CS, Resolver)) {
+        if (!KnownTargets.count(PossibleTarget)) {
+          NewTargets.insert(PossibleTarget);
         }
+      }
+      Resolver.handlePossibleTargets(CS, NewTargets);
+      addCallEdges(FunctionVertexMap.at(I->getFunction()), I, NewTargets);
+      for (const auto *PossibleTarget : NewTargets) {
+        constructionWalker(PossibleTarget, Resolver);
+      }
+      Resolver.postCall(I);
+    }
+  }
+  NumFixpointRounds = NumRounds;
+  REG_COUNTER("CG Fixpoint Rounds", NumRounds, PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("CG Re-resolved Call-Sites", NumReResolved,
+              PAMM_SEVERITY_LEVEL::Full);
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Call graph reached its fixpoint after " << NumRounds
+                << " round(s), " << NumReResolved
+                << " call-site(s) have been resolved again");
+}
 
-        // continue resolving
+void LLVMBasedICFG::resolveConcurrently(
+    const std::vector<const llvm::Function *> &Entries, Resolver &Resolver,
+    unsigned NumThreads) {
+  std::mutex Mtx;
+  std::unordered_set<const llvm::Function *> Discovered;
+  WorkStealingPool<const llvm::Function *> Pool(NumThreads);
+  for (const auto *F : Entries) {
+    if (Discovered.insert(F).second) {
+      Pool.push(F);
+    }
+  }
+  Pool.run([&](const llvm::Function *F) {
+    if (F->isDeclaration()) {
+      return;
+    }
+    std::vector<std::pair<const llvm::Instruction *,
+                          std::set<const llvm::Function *>>>
+        Resolved;
+    for (const auto &I : llvm::instructions(F)) {
+      if (llvm::isa<llvm::CallInst>(I) || llvm::isa<llvm::InvokeInst>(I)) {
+        Resolved.emplace_back(&I,
+                              resolveCallSite(llvm::ImmutableCallSite(&I),
+                                              Resolver));
+      }
+    }
+    std::vector<const llvm::Function *> NewTargets;
+    {
+      std::lock_guard<std::mutex> Lock(Mtx);
+      for (auto &[CS, PossibleTargets] : Resolved) {
         for (const auto *PossibleTarget : PossibleTargets) {
-          constructionWalker(PossibleTarget, Resolver);
+          if (Discovered.insert(PossibleTarget).second) {
+            NewTargets.push_back(PossibleTarget);
+          }
         }
-
-        Resolver.postCall(&I);
-      } else {
-        Resolver.otherInst(&I);
+        PreResolvedTargets[CS] = std::move(PossibleTargets);
       }
     }
+    for (const auto *PossibleTarget : NewTargets) {
+      Pool.push(PossibleTarget);
+    }
+  });
+}
+
+void LLVMBasedICFG::freeze() {
+  std::vector<std::pair<const llvm::Instruction *, const llvm::Function *>>
+      Callees;
+  std::vector<std::pair<const llvm::Function *, const llvm::Instruction *>>
+      Callers;
+  std::vector<std::pair<const llvm::Function *, const llvm::Instruction *>>
+      CallSites;
+  Callees.reserve(boost::num_edges(CallGraph));
+  Callers.reserve(boost::num_edges(CallGraph));
+  CallSites.reserve(boost::num_edges(CallGraph));
+  for (const auto Edge :
+       boost::make_iterator_range(boost::edges(CallGraph))) {
+    const llvm::Instruction *CS = CallGraph[Edge].CS;
+    const llvm::Function *Caller = CallGraph[boost::source(Edge, CallGraph)].F;
+    const llvm::Function *Callee = CallGraph[boost::target(Edge, CallGraph)].F;
+    Callees.emplace_back(CS, Callee);
+    Callers.emplace_back(Callee, CS);
+    CallSites.emplace_back(Caller, CS);
+  }
+  Frozen.Callees.build(std::move(Callees));
+  Frozen.Callers.build(std::move(Callers));
+  Frozen.CallSites.build(std::move(CallSites));
+  IsFrozen = true;
+}
+
+void LLVMBasedICFG::computeSCCs() {
+  // Tarjan's algorithm numbers the SCCs in reverse topological order of the
+  // condensation, which is the callee-first order
+  std::vector<unsigned> Components(boost::num_vertices(CallGraph));
+  auto ComponentMap = boost::make_iterator_property_map(
+      Components.begin(), boost::get(boost::vertex_index, CallGraph));
+  unsigned NumSCCs = boost::strong_components(CallGraph, ComponentMap);
+  std::vector<std::pair<unsigned, const llvm::Function *>> Functions;
+  Functions.reserve(Components.size());
+  SCCs.Ids.clear();
+  SCCs.Ids.reserve(Components.size());
+  for (auto V : boost::make_iterator_range(boost::vertices(CallGraph))) {
+    SCCs.Ids[CallGraph[V].F] = Components[V];
+    Functions.emplace_back(Components[V], CallGraph[V].F);
+  }
+  std::vector<std::pair<unsigned, unsigned>> Callees;
+  SCCs.Recursive.clear();
+  SCCs.Recursive.resize(NumSCCs);
+  for (const auto Edge :
+       boost::make_iterator_range(boost::edges(CallGraph))) {
+    unsigned CallerSCC = Components[boost::source(Edge, CallGraph)];
+    unsigned CalleeSCC = Components[boost::target(Edge, CallGraph)];
+    // every SCC of more than one function contains an edge within the SCC
+    if (CallerSCC == CalleeSCC) {
+      SCCs.Recursive.set(CallerSCC);
+    } else {
+      Callees.emplace_back(CallerSCC, CalleeSCC);
+    }
   }
+  SCCs.Functions.build(std::move(Functions));
+  SCCs.Callees.build(std::move(Callees));
 }
 
 std::unique_ptr<Resolver> LLVMBasedICFG::makeResolver(ProjectIRDB &IRDB,
@@ -254,6 +655,9 @@ std::unique_ptr<Resolver> LLVMBasedICFG::makeResolver(ProjectIRDB &IRDB,
   case (CallGraphAnalysisType::OTF):
     return make_unique<OTFResolver>(IRDB, TH, *this, PT);
     break;
+  case (CallGraphAnalysisType::SIG):
+    return make_unique<SignatureResolver>(IRDB, TH);
+    break;
   default:
     llvm::report_fatal_error("Resolver strategy not properly instantiated");
     break;
@@ -341,13 +745,20 @@ size_t LLVMBasedICFG::removeEdges(const llvm::Function *F,
   }
 
   size_t EdgesRemoved = 0;
-  auto OutEdges = boost::out_edges(FunctionMapIt->second, CallGraph);
-  for (auto EdgeIt : boost::make_iterator_range(OutEdges)) {
-    auto Edge = CallGraph[EdgeIt];
-    if (Edge.CS == I) {
-      boost::remove_edge(EdgeIt, CallGraph);
-      ++EdgesRemoved;
-    }
+  // removing the edges one by one would invalidate the out-edge iterators
+  boost::remove_out_edge_if(
+      FunctionMapIt->second,
+      [this, I, &EdgesRemoved](edge_t Edge) {
+        if (CallGraph[Edge].CS == I) {
+          ++EdgesRemoved;
+          return true;
+        }
+        return false;
+      },
+      CallGraph);
+  if (EdgesRemoved) {
+    freeze();
+    computeSCCs();
   }
   return EdgesRemoved;
 }
@@ -360,9 +771,128 @@ bool LLVMBasedICFG::removeVertex(const llvm::Function *F) {
 
   boost::remove_vertex(FunctionMapIt->second, CallGraph);
   FunctionVertexMap.erase(FunctionMapIt);
+  freeze();
+  computeSCCs();
   return true;
 }
 
+LLVMBasedICFG::SliceReport
+LLVMBasedICFG::sliceTowards(const std::set<const llvm::Function *> &EntryPoints,
+                            const std::set<const llvm::Function *> &Targets) {
+  SliceReport Report;
+  Report.NumFunctions = boost::num_vertices(CallGraph);
+  Report.NumCallEdges = boost::num_edges(CallGraph);
+  // marks the vertices that can be reached from the given functions, either
+  // along the call edges or, if Backward is set, against them
+  auto Reach = [this](const std::set<const llvm::Function *> &Starts,
+                      bool Backward) {
+    std::vector<bool> Reached(boost::num_vertices(CallGraph), false);
+    std::vector<vertex_t> WorkList;
+    auto Visit = [&Reached, &WorkList](vertex_t V) {
+      if (!Reached[V]) {
+        Reached[V] = true;
+        WorkList.push_back(V);
+      }
+    };
+    for (const auto *F : Starts) {
+      if (auto Search = FunctionVertexMap.find(F);
+          Search != FunctionVertexMap.end()) {
+        Visit(Search->second);
+      }
+    }
+    while (!WorkList.empty()) {
+      vertex_t V = WorkList.back();
+      WorkList.pop_back();
+      if (Backward) {
+        for (const auto Edge :
+             boost::make_iterator_range(boost::in_edges(V, CallGraph))) {
+          Visit(boost::source(Edge, CallGraph));
+        }
+      } else {
+        for (const auto Edge :
+             boost::make_iterator_range(boost::out_edges(V, CallGraph))) {
+          Visit(boost::target(Edge, CallGraph));
+        }
+      }
+    }
+    return Reached;
+  };
+  auto Reachable = Reach(EntryPoints, false);
+  auto Relevant = Reach(Targets, true);
+  std::vector<bool> Keep(boost::num_vertices(CallGraph), false);
+  for (auto V : boost::make_iterator_range(boost::vertices(CallGraph))) {
+    Keep[V] = Reachable[V] &&
+              (Relevant[V] || EntryPoints.count(CallGraph[V].F));
+  }
+  // the callees of the kept functions that are not kept themselves become
+  // leaves of the slice
+  std::vector<bool> Boundary(boost::num_vertices(CallGraph), false);
+  for (auto V : boost::make_iterator_range(boost::vertices(CallGraph))) {
+    if (!Keep[V]) {
+      continue;
+    }
+    for (const auto Edge :
+         boost::make_iterator_range(boost::out_edges(V, CallGraph))) {
+      auto Target = boost::target(Edge, CallGraph);
+      Boundary[Target] = !Keep[Target];
+    }
+  }
+  // the vertices of a vecS graph cannot be removed without invalidating the
+  // other vertex descriptors, so the slice is built as a new graph that keeps
+  // the relative order of the vertices and edges
+  bidigraph_t Slice;
+  std::vector<vertex_t> SliceVertex(boost::num_vertices(CallGraph));
+  FunctionVertexMap.clear();
+  SliceBoundary.clear();
+  for (auto V : boost::make_iterator_range(boost::vertices(CallGraph))) {
+    const llvm::Function *F = CallGraph[V].F;
+    if (Keep[V] || Boundary[V]) {
+      SliceVertex[V] = boost::add_vertex(CallGraph[V], Slice);
+      FunctionVertexMap[F] = SliceVertex[V];
+      // declarations have no call-sites that could lose their callees
+      if (Boundary[V] && !F->isDeclaration()) {
+        SliceBoundary.insert(F);
+      }
+    } else {
+      VisitedFunctions.erase(F);
+    }
+  }
+  for (auto V : boost::make_iterator_range(boost::vertices(CallGraph))) {
+    // boundary functions have no outgoing call edges
+    if (!Keep[V]) {
+      continue;
+    }
+    for (const auto Edge :
+         boost::make_iterator_range(boost::out_edges(V, CallGraph))) {
+      auto Target = boost::target(Edge, CallGraph);
+      if (Keep[Target] || Boundary[Target]) {
+        boost::add_edge(SliceVertex[V], SliceVertex[Target], CallGraph[Edge],
+                        Slice);
+      }
+    }
+  }
+  CallGraph = std::move(Slice);
+  freeze();
+  computeSCCs();
+  Report.NumRemovedFunctions =
+      Report.NumFunctions - boost::num_vertices(CallGraph);
+  Report.NumRemovedCallEdges =
+      Report.NumCallEdges - boost::num_edges(CallGraph);
+  Report.NumBoundaryFunctions = SliceBoundary.size();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Sliced the call graph towards " << Targets.size()
+                << " target functions: removed "
+                << Report.NumRemovedFunctions << " of " << Report.NumFunctions
+                << " functions and " << Report.NumRemovedCallEdges << " of "
+                << Report.NumCallEdges << " call edges, kept "
+                << Report.NumBoundaryFunctions << " boundary functions");
+  return Report;
+}
+
+bool LLVMBasedICFG::isSliceBoundary(const llvm::Function *Fun) const {
+  return SliceBoundary.count(Fun);
+}
+
 size_t LLVMBasedICFG::getCallerCount(const llvm::Function *F) const {
   auto MapEntry = FunctionVertexMap.find(F);
   if (MapEntry == FunctionVertexMap.end()) {
@@ -375,31 +905,40 @@ size_t LLVMBasedICFG::getCallerCount(const llvm::Function *F) const {
 
 set<const llvm::Function *>
 LLVMBasedICFG::getCalleesOfCallAt(const llvm::Instruction *N) const {
-  if (llvm::isa<llvm::CallInst>(N) || llvm::isa<llvm::InvokeInst>(N)) {
-    set<const llvm::Function *> Callees;
-    auto MapEntry = FunctionVertexMap.find(N->getFunction());
-    if (MapEntry == FunctionVertexMap.end()) {
-      return Callees;
-    }
-    out_edge_iterator EI;
+  if (!llvm::isa<llvm::CallInst>(N) && !llvm::isa<llvm::InvokeInst>(N)) {
+    return {};
+  }
+  if (IsFrozen) {
+    auto Callees = Frozen.Callees.lookup(N);
+    return {Callees.begin(), Callees.end()};
+  }
+  // the call graph is still under construction
+  set<const llvm::Function *> Callees;
+  auto MapEntry = FunctionVertexMap.find(N->getFunction());
+  if (MapEntry == FunctionVertexMap.end()) {
+    return Callees;
+  }
+  out_edge_iterator EI;
 
-    out_edge_iterator EIEnd;
-    for (boost::tie(EI, EIEnd) = boost::out_edges(MapEntry->second, CallGraph);
-         EI != EIEnd; ++EI) {
-      auto Edge = CallGraph[*EI];
-      if (N == Edge.CS) {
-        auto Target = boost::target(*EI, CallGraph);
-        Callees.insert(CallGraph[Target].F);
-      }
+  out_edge_iterator EIEnd;
+  for (boost::tie(EI, EIEnd) = boost::out_edges(MapEntry->second, CallGraph);
+       EI != EIEnd; ++EI) {
+    auto Edge = CallGraph[*EI];
+    if (N == Edge.CS) {
+      auto Target = boost::target(*EI, CallGraph);
+      Callees.insert(CallGraph[Target].F);
     }
-    return Callees;
-  } else {
-    return {};
   }
+  return Callees;
 }
 
 set<const llvm::Instruction *>
 LLVMBasedICFG::getCallersOf(const llvm::Function *F) const {
+  if (IsFrozen) {
+    auto Callers = Frozen.Callers.lookup(F);
+    return {Callers.begin(), Callers.end()};
+  }
+  // the call graph is still under construction
   set<const llvm::Instruction *> CallersOf;
   auto MapEntry = FunctionVertexMap.find(F);
   if (MapEntry == FunctionVertexMap.end()) {
@@ -416,6 +955,24 @@ LLVMBasedICFG::getCallersOf(const llvm::Function *F) const {
   return CallersOf;
 }
 
+llvm::ArrayRef<const llvm::Function *>
+LLVMBasedICFG::getCalleesOfCallAtAsRange(const llvm::Instruction *N) const {
+  requireFrozen(IsFrozen, "getCalleesOfCallAtAsRange");
+  return Frozen.Callees.lookup(N);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedICFG::getCallersOfAsRange(const llvm::Function *F) const {
+  requireFrozen(IsFrozen, "getCallersOfAsRange");
+  return Frozen.Callers.lookup(F);
+}
+
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedICFG::getResolvedCallSitesOfAsRange(const llvm::Function *F) const {
+  requireFrozen(IsFrozen, "getResolvedCallSitesOfAsRange");
+  return Frozen.CallSites.lookup(F);
+}
+
 set<const llvm::Instruction *>
 LLVMBasedICFG::getCallsFromWithin(const llvm::Function *F) const {
   set<const llvm::Instruction *> CallSites;
@@ -529,6 +1086,8 @@ void LLVMBasedICFG::mergeWith(const LLVMBasedICFG &Other) {
   // Merge the already visited functions
   VisitedFunctions.insert(Other.VisitedFunctions.begin(),
                           Other.VisitedFunctions.end());
+  freeze();
+  computeSCCs();
   // Merge the points-to graphs
   // WholeModulePTG.mergeWith(Other.WholeModulePTG, Calls);
 }
@@ -612,7 +1171,12 @@ nlohmann::json LLVMBasedICFG::getAsJson() const {
   return J;
 }
 
-void LLVMBasedICFG::printAsJson(std::ostream &OS) const { OS << getAsJson(); }
+void LLVMBasedICFG::printAsJson(std::ostream &OS) const {
+  // stream the call graph, getAsJson() would first build it in memory
+  writeAdjacencyListsAsJson(
+      OS, PhasarConfig::JsonCallGraphID(), CallGraph,
+      [this](vertex_t V) { return CallGraph[V].getFunctionName(); });
+}
 
 vector<const llvm::Function *> LLVMBasedICFG::getDependencyOrderedFunctions() {
   vector<vertex_t> Vertices;
@@ -627,6 +1191,28 @@ vector<const llvm::Function *> LLVMBasedICFG::getDependencyOrderedFunctions() {
   return Functions;
 }
 
+unsigned LLVMBasedICFG::getNumSCCs() const { return SCCs.Recursive.size(); }
+
+unsigned LLVMBasedICFG::getSCCOf(const llvm::Function *Fun) const {
+  auto Search = SCCs.Ids.find(Fun);
+  assert(Search != SCCs.Ids.end() &&
+         "getSCCOf requires a function of the call graph");
+  return Search->second;
+}
+
+llvm::ArrayRef<const llvm::Function *>
+LLVMBasedICFG::getFunctionsOfSCC(unsigned SCC) const {
+  return SCCs.Functions.lookup(SCC);
+}
+
+llvm::ArrayRef<unsigned> LLVMBasedICFG::getCalleeSCCsOf(unsigned SCC) const {
+  return SCCs.Callees.lookup(SCC);
+}
+
+bool LLVMBasedICFG::isRecursiveSCC(unsigned SCC) const {
+  return SCCs.Recursive.test(SCC);
+}
+
 unsigned LLVMBasedICFG::getNumOfVertices() {
   return boost::num_vertices(CallGraph);
 }
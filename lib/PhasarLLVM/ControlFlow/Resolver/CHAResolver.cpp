@@ -14,6 +14,9 @@
  *      Author: nicolas bellec
  */
 
+#include <memory>
+#include <utility>
+
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -29,8 +32,13 @@
 using namespace std;
 using namespace psr;
 
-CHAResolver::CHAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH)
-    : Resolver(IRDB, TH) {}
+CHAResolver::CHAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH,
+                         std::shared_ptr<VirtualCallCache> CHACache)
+    : Resolver(IRDB, TH), CHACache(std::move(CHACache)) {
+  if (!this->CHACache) {
+    this->CHACache = std::make_shared<VirtualCallCache>();
+  }
+}
 
 set<const llvm::Function *>
 CHAResolver::resolveVirtualCall(llvm::ImmutableCallSite CS) {
@@ -51,18 +59,31 @@ CHAResolver::resolveVirtualCall(llvm::ImmutableCallSite CS) {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Virtual function table entry is: " << VFTIdx);
 
-  const auto *ReceiverTy = getReceiverType(CS);
+  return resolveVirtualCallCHA(getReceiverType(CS), VFTIdx, CS);
+}
 
-  // also insert all possible subtypes vtable entries
-  auto FallbackTys = Resolver::TH->getSubTypes(ReceiverTy);
+set<const llvm::Function *>
+CHAResolver::resolveVirtualCallCHA(const llvm::StructType *ReceiverTy,
+                                   unsigned VFTIdx,
+                                   llvm::ImmutableCallSite CS) {
+  return CHACache->getOrCompute(ReceiverTy, VFTIdx, [&] {
+    // also insert all possible subtypes vtable entries
+    auto FallbackTys = Resolver::TH->getSubTypes(ReceiverTy);
 
-  set<const llvm::Function *> PossibleCallees;
+    set<const llvm::Function *> PossibleCallees;
 
-  for (const auto &FallbackTy : FallbackTys) {
-    const auto *Target = getNonPureVirtualVFTEntry(FallbackTy, VFTIdx, CS);
-    if (Target) {
-      PossibleCallees.insert(Target);
+    for (const auto &FallbackTy : FallbackTys) {
+      const auto *Target = getNonPureVirtualVFTEntry(FallbackTy, VFTIdx, CS);
+      if (Target) {
+        PossibleCallees.insert(Target);
+      }
     }
-  }
-  return PossibleCallees;
+    return PossibleCallees;
+  });
+}
+
+bool CHAResolver::isOrderIndependent() const { return true; }
+
+VirtualCallCache::Stats CHAResolver::getVirtualCallCacheStats() const {
+  return CHACache->getStats();
 }
@@ -205,3 +205,5 @@ DTAResolver::resolveVirtualCall(llvm::ImmutableCallSite CS) {
 
   return PossibleCallTargets;
 }
+
+bool DTAResolver::isOrderIndependent() const { return false; }
@@ -46,4 +46,6 @@ NOResolver::resolveFunctionPointer(llvm::ImmutableCallSite CS) {
 
 void NOResolver::otherInst(const llvm::Instruction *Inst) {}
 
+bool NOResolver::isOrderIndependent() const { return true; }
+
 } // namespace psr
@@ -105,6 +105,7 @@ OTFResolver::resolveVirtualCall(llvm::ImmutableCallSite CS) {
   const llvm::Value *Receiver = CS.getArgOperand(0);
 
   // Use points-to information to resolve the indirect call
+  recordDependency(CS, Receiver);
   auto AllocSites = PT.getReachableAllocationSites(Receiver);
   auto PossibleAllocatedTypes = getReachableTypes(AllocSites);
 
@@ -139,6 +140,7 @@ OTFResolver::resolveFunctionPointer(llvm::ImmutableCallSite CS) {
   if (CS.getCalledValue() && CS.getCalledValue()->getType()->isPointerTy()) {
     if (const llvm::FunctionType *FTy = llvm::dyn_cast<llvm::FunctionType>(
             CS.getCalledValue()->getType()->getPointerElementType())) {
+      recordDependency(CS, CS.getCalledValue());
       const auto PTS = PT.getPointsToSet(CS.getCalledValue());
       for (const auto *P : *PTS) {
         if (P->getType()->isPointerTy() &&
@@ -159,6 +161,32 @@ OTFResolver::resolveFunctionPointer(llvm::ImmutableCallSite CS) {
   return Callees;
 }
 
+bool OTFResolver::isOrderIndependent() const { return false; }
+
+void OTFResolver::recordDependency(llvm::ImmutableCallSite CS,
+                                   const llvm::Value *V) {
+  auto [It, Inserted] = Dependencies.insert(
+      {CS.getInstruction(), {V, PT.getPointsToSet(V)->size()}});
+  if (Inserted) {
+    DependentCallSites.push_back(CS.getInstruction());
+  } else {
+    It->second = {V, PT.getPointsToSet(V)->size()};
+  }
+}
+
+std::vector<const llvm::Instruction *> OTFResolver::getOutdatedCallSites() {
+  // points-to sets only ever grow, hence a set of the same size still
+  // contains the same pointers
+  std::vector<const llvm::Instruction *> Outdated;
+  for (const auto *CS : DependentCallSites) {
+    const auto &Dep = Dependencies.at(CS);
+    if (PT.getPointsToSet(Dep.V)->size() != Dep.PointsToSetSize) {
+      Outdated.push_back(CS);
+    }
+  }
+  return Outdated;
+}
+
 std::set<const llvm::Type *> OTFResolver::getReachableTypes(
     const std::unordered_set<const llvm::Value *> &Values) {
   std::set<const llvm::Type *> Types;
@@ -14,6 +14,9 @@
  *      Author: nicolas bellec
  */
 
+#include <memory>
+#include <utility>
+
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -31,8 +34,9 @@
 using namespace std;
 using namespace psr;
 
-RTAResolver::RTAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH)
-    : CHAResolver(IRDB, TH) {}
+RTAResolver::RTAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH,
+                         std::shared_ptr<VirtualCallCache> CHACache)
+    : CHAResolver(IRDB, TH, std::move(CHACache)) {}
 
 // void RTAResolver::firstFunction(const llvm::Function *F) {
 //   auto func_type = F->getFunctionType();
@@ -52,8 +56,6 @@ RTAResolver::resolveVirtualCall(llvm::ImmutableCallSite CS) {
   // throw runtime_error("RTA is currently unabled to deal with already built "
   //                     "library, it has been disable until this is fixed");
 
-  set<const llvm::Function *> PossibleCallTargets;
-
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Call virtual function: "
                 << llvmIRToString(CS.getInstruction()));
@@ -73,29 +75,41 @@ RTAResolver::resolveVirtualCall(llvm::ImmutableCallSite CS) {
 
   const auto *ReceiverType = getReceiverType(CS);
 
-  // also insert all possible subtypes vtable entries
-  auto ReachableTypes = Resolver::TH->getSubTypes(ReceiverType);
-
-  // also insert all possible subtypes vtable entries
-  auto PossibleTypes = IRDB.getAllocatedStructTypes();
-
-  auto EndIt = ReachableTypes.end();
-  for (const auto *PossibleType : PossibleTypes) {
-    if (const auto *PossibleTypeStruct =
-            llvm::dyn_cast<llvm::StructType>(PossibleType)) {
-      if (ReachableTypes.find(PossibleTypeStruct) != EndIt) {
-        const auto *Target =
-            getNonPureVirtualVFTEntry(PossibleTypeStruct, VtableIndex, CS);
-        if (Target) {
-          PossibleCallTargets.insert(Target);
+  auto PossibleCallTargets =
+      RTACache.getOrCompute(ReceiverType, VtableIndex, [&] {
+        set<const llvm::Function *> Targets;
+
+        // also insert all possible subtypes vtable entries
+        auto ReachableTypes = Resolver::TH->getSubTypes(ReceiverType);
+
+        // also insert all possible subtypes vtable entries
+        auto PossibleTypes = IRDB.getAllocatedStructTypes();
+
+        auto EndIt = ReachableTypes.end();
+        for (const auto *PossibleType : PossibleTypes) {
+          if (const auto *PossibleTypeStruct =
+                  llvm::dyn_cast<llvm::StructType>(PossibleType)) {
+            if (ReachableTypes.find(PossibleTypeStruct) != EndIt) {
+              const auto *Target = getNonPureVirtualVFTEntry(
+                  PossibleTypeStruct, VtableIndex, CS);
+              if (Target) {
+                Targets.insert(Target);
+              }
+            }
+          }
         }
-      }
-    }
-  }
+        return Targets;
+      });
 
   if (PossibleCallTargets.empty()) {
-    return CHAResolver::resolveVirtualCall(CS);
+    return resolveVirtualCallCHA(ReceiverType, VtableIndex, CS);
   }
 
   return PossibleCallTargets;
 }
+
+VirtualCallCache::Stats RTAResolver::getVirtualCallCacheStats() const {
+  auto Stats = CHAResolver::getVirtualCallCacheStats();
+  Stats += RTACache.getStats();
+  return Stats;
+}
@@ -121,4 +121,14 @@ Resolver::resolveFunctionPointer(llvm::ImmutableCallSite CS) {
 
 void Resolver::otherInst(const llvm::Instruction *Inst) {}
 
+bool Resolver::isOrderIndependent() const { return false; }
+
+std::vector<const llvm::Instruction *> Resolver::getOutdatedCallSites() {
+  return {};
+}
+
+VirtualCallCache::Stats Resolver::getVirtualCallCacheStats() const {
+  return {};
+}
+
 } // namespace psr
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/SignatureResolver.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+
+SignatureResolver::SignatureResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH)
+    : CHAResolver(IRDB, TH) {
+  // the order of the functions of each type does not matter, they are
+  // returned as a set of callees
+  for (const auto *F : IRDB.getAllFunctions()) {
+    if (F->hasAddressTaken()) {
+      AddressTakenFunctions[F->getFunctionType()].push_back(F);
+    }
+  }
+}
+
+set<const llvm::Function *>
+SignatureResolver::resolveFunctionPointer(llvm::ImmutableCallSite CS) {
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "Call function pointer: "
+                << llvmIRToString(CS.getInstruction()));
+  if (CS.getCalledValue() == nullptr ||
+      !CS.getCalledValue()->getType()->isPointerTy()) {
+    return {};
+  }
+  const auto *FTy = llvm::dyn_cast<llvm::FunctionType>(
+      CS.getCalledValue()->getType()->getPointerElementType());
+  auto Search = AddressTakenFunctions.find(FTy);
+  if (Search == AddressTakenFunctions.end()) {
+    return {};
+  }
+  return {Search->second.begin(), Search->second.end()};
+}
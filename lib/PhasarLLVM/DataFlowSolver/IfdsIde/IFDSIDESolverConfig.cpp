@@ -7,7 +7,13 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "llvm/ADT/StringSwitch.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 
@@ -20,6 +26,46 @@ IFDSIDESolverConfig::IFDSIDESolverConfig() {
   setFlag(
       Options, SolverConfigOptions::EmitESG,
       PhasarConfig::getPhasarConfig().VariablesMap().count("emit-esg-as-dot"));
+  setFlag(Options, SolverConfigOptions::InternEdgeFunctions,
+          PhasarConfig::getPhasarConfig().VariablesMap().count(
+              "solver-intern-edge-functions"));
+  setFlag(Options, SolverConfigOptions::CollectJumpFunctions,
+          PhasarConfig::getPhasarConfig().VariablesMap().count(
+              "solver-collect-jump-functions"));
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count("solver-worklist")) {
+    WorklistKind WK = toWorklistKind(PhasarConfig::getPhasarConfig()
+                                         .VariablesMap()["solver-worklist"]
+                                         .as<std::string>());
+    if (WK != WorklistKind::Invalid) {
+      WLKind = WK;
+    }
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "solver-jump-functions")) {
+    JumpFunctionsKind JFK =
+        toJumpFunctionsKind(PhasarConfig::getPhasarConfig()
+                                .VariablesMap()["solver-jump-functions"]
+                                .as<std::string>());
+    if (JFK != JumpFunctionsKind::Invalid) {
+      JFKind = JFK;
+    }
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "solver-cache-capacity")) {
+    CacheCapacity = PhasarConfig::getPhasarConfig()
+                        .VariablesMap()["solver-cache-capacity"]
+                        .as<size_t>();
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "solver-esg-record-file")) {
+    ESGRecordFile = PhasarConfig::getPhasarConfig()
+                        .VariablesMap()["solver-esg-record-file"]
+                        .as<std::string>();
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "right-to-ludicrous-speed")) {
+    NumThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
 }
 IFDSIDESolverConfig::IFDSIDESolverConfig(SolverConfigOptions Options)
     : Options(Options) {}
@@ -42,6 +88,22 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+bool IFDSIDESolverConfig::internEdgeFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::InternEdgeFunctions);
+}
+bool IFDSIDESolverConfig::collectJumpFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::CollectJumpFunctions);
+}
+
+WorklistKind IFDSIDESolverConfig::worklistKind() const { return WLKind; }
+unsigned IFDSIDESolverConfig::numThreads() const { return NumThreads; }
+JumpFunctionsKind IFDSIDESolverConfig::jumpFunctionsKind() const {
+  return JFKind;
+}
+size_t IFDSIDESolverConfig::cacheCapacity() const { return CacheCapacity; }
+const std::string &IFDSIDESolverConfig::esgRecordFile() const {
+  return ESGRecordFile;
+}
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -61,6 +123,85 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setInternEdgeFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::InternEdgeFunctions, Set);
+}
+void IFDSIDESolverConfig::setCollectJumpFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::CollectJumpFunctions, Set);
+}
+void IFDSIDESolverConfig::setWorklistKind(WorklistKind WK) { WLKind = WK; }
+void IFDSIDESolverConfig::setNumThreads(unsigned N) {
+  NumThreads = std::max(N, 1U);
+}
+void IFDSIDESolverConfig::setJumpFunctionsKind(JumpFunctionsKind JFK) {
+  JFKind = JFK;
+}
+void IFDSIDESolverConfig::setCacheCapacity(size_t Capacity) {
+  CacheCapacity = Capacity;
+}
+void IFDSIDESolverConfig::setESGRecordFile(std::string Path) {
+  ESGRecordFile = std::move(Path);
+}
+
+std::string toString(const WorklistKind &WK) {
+  switch (WK) {
+  default:
+#define WORKLIST_KIND(NAME, CMDFLAG, TYPE)                                     \
+  case WorklistKind::TYPE:                                                     \
+    return NAME;                                                               \
+    break;
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistKind.def"
+  }
+}
+
+WorklistKind toWorklistKind(const std::string &S) {
+  WorklistKind Type = llvm::StringSwitch<WorklistKind>(S)
+#define WORKLIST_KIND(NAME, CMDFLAG, TYPE) .Case(NAME, WorklistKind::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistKind.def"
+                          .Default(WorklistKind::Invalid);
+  if (Type == WorklistKind::Invalid) {
+    Type = llvm::StringSwitch<WorklistKind>(S)
+#define WORKLIST_KIND(NAME, CMDFLAG, TYPE) .Case(CMDFLAG, WorklistKind::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistKind.def"
+               .Default(WorklistKind::Invalid);
+  }
+  return Type;
+}
+
+ostream &operator<<(ostream &OS, const WorklistKind &WK) {
+  return OS << toString(WK);
+}
+
+std::string toString(const JumpFunctionsKind &JFK) {
+  switch (JFK) {
+  default:
+#define JUMP_FUNCTIONS_KIND(NAME, CMDFLAG, TYPE)                               \
+  case JumpFunctionsKind::TYPE:                                                \
+    return NAME;                                                               \
+    break;
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JumpFunctionsKind.def"
+  }
+}
+
+JumpFunctionsKind toJumpFunctionsKind(const std::string &S) {
+  JumpFunctionsKind Type = llvm::StringSwitch<JumpFunctionsKind>(S)
+#define JUMP_FUNCTIONS_KIND(NAME, CMDFLAG, TYPE)                               \
+  .Case(NAME, JumpFunctionsKind::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JumpFunctionsKind.def"
+                               .Default(JumpFunctionsKind::Invalid);
+  if (Type == JumpFunctionsKind::Invalid) {
+    Type = llvm::StringSwitch<JumpFunctionsKind>(S)
+#define JUMP_FUNCTIONS_KIND(NAME, CMDFLAG, TYPE)                               \
+  .Case(CMDFLAG, JumpFunctionsKind::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JumpFunctionsKind.def"
+               .Default(JumpFunctionsKind::Invalid);
+  }
+  return Type;
+}
+
+ostream &operator<<(ostream &OS, const JumpFunctionsKind &JFK) {
+  return OS << toString(JFK);
+}
 
 ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
   return OS << "IFDSIDESolverConfig:\n"
@@ -71,7 +212,14 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tinternEdgeFunctions: " << SC.internEdgeFunctions() << "\n"
+            << "\tcollectJumpFunctions: " << SC.collectJumpFunctions() << "\n"
+            << "\tworklist: " << SC.worklistKind() << "\n"
+            << "\tthreads: " << SC.numThreads() << "\n"
+            << "\tjump functions: " << SC.jumpFunctionsKind() << "\n"
+            << "\tcache capacity: " << SC.cacheCapacity() << "\n"
+            << "\tESG record file: " << SC.esgRecordFile();
 }
 
 } // namespace psr
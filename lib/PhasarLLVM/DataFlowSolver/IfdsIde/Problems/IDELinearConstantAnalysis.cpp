@@ -8,9 +8,12 @@
  *****************************************************************************/
 
 // #include <functional>
+#include <atomic>
 #include <limits>
+#include <typeinfo>
 #include <utility>
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
@@ -38,9 +41,9 @@ using namespace psr;
 
 namespace psr {
 // Initialize debug counter for edge functions
-unsigned IDELinearConstantAnalysis::CurrGenConstantId = 0;
-unsigned IDELinearConstantAnalysis::CurrLCAIDId = 0;
-unsigned IDELinearConstantAnalysis::CurrBinaryId = 0;
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrGenConstantId = 0;
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrLCAIDId = 0;
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrBinaryId = 0;
 
 const IDELinearConstantAnalysis::l_t IDELinearConstantAnalysis::TOP =
     numeric_limits<IDELinearConstantAnalysis::l_t>::min();
@@ -577,6 +580,10 @@ bool IDELinearConstantAnalysis::GenConstant::equal_to(
   return this == Other.get();
 }
 
+size_t IDELinearConstantAnalysis::GenConstant::hash() const {
+  return llvm::hash_combine(typeid(GenConstant).hash_code(), IntConst);
+}
+
 void IDELinearConstantAnalysis::GenConstant::print(ostream &OS,
                                                    bool IsForDebug) const {
   OS << IntConst << " (EF:" << GenConstant_Id << ')';
@@ -703,6 +710,10 @@ bool IDELinearConstantAnalysis::BinOp::equal_to(
   return this == Other.get();
 }
 
+size_t IDELinearConstantAnalysis::BinOp::hash() const {
+  return llvm::hash_combine(typeid(BinOp).hash_code(), Op, lop, rop);
+}
+
 void IDELinearConstantAnalysis::BinOp::print(ostream &OS,
                                              bool IsForDebug) const {
   if (const auto *LIC = llvm::dyn_cast<llvm::ConstantInt>(lop)) {
@@ -45,26 +45,30 @@ IDESolverTest::IDESolverTest(const ProjectIRDB *IRDB,
 IDESolverTest::FlowFunctionPtrType
 IDESolverTest::getNormalFlowFunction(IDESolverTest::n_t Curr,
                                      IDESolverTest::n_t Succ) {
-  return Identity<IDESolverTest::d_t>::getInstance();
+  return Identity<IDESolverTest::d_t,
+                  IDESolverTest::container_type>::getInstance();
 }
 
 IDESolverTest::FlowFunctionPtrType
 IDESolverTest::getCallFlowFunction(IDESolverTest::n_t CallStmt,
                                    IDESolverTest::f_t DestFun) {
-  return Identity<IDESolverTest::d_t>::getInstance();
+  return Identity<IDESolverTest::d_t,
+                  IDESolverTest::container_type>::getInstance();
 }
 
 IDESolverTest::FlowFunctionPtrType IDESolverTest::getRetFlowFunction(
     IDESolverTest::n_t CallSite, IDESolverTest::f_t CalleeFun,
     IDESolverTest::n_t ExitStmt, IDESolverTest::n_t RetSite) {
-  return Identity<IDESolverTest::d_t>::getInstance();
+  return Identity<IDESolverTest::d_t,
+                  IDESolverTest::container_type>::getInstance();
 }
 
 IDESolverTest::FlowFunctionPtrType
 IDESolverTest::getCallToRetFlowFunction(IDESolverTest::n_t CallSite,
                                         IDESolverTest::n_t RetSite,
                                         set<IDESolverTest::f_t> Callees) {
-  return Identity<IDESolverTest::d_t>::getInstance();
+  return Identity<IDESolverTest::d_t,
+                  IDESolverTest::container_type>::getInstance();
 }
 
 IDESolverTest::FlowFunctionPtrType
@@ -60,14 +60,16 @@ IFDSLinearConstantAnalysis::FlowFunctionPtrType
 IFDSLinearConstantAnalysis::getNormalFlowFunction(
     IFDSLinearConstantAnalysis::n_t Curr,
     IFDSLinearConstantAnalysis::n_t Succ) {
-  return Identity<IFDSLinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IFDSLinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IFDSLinearConstantAnalysis::FlowFunctionPtrType
 IFDSLinearConstantAnalysis::getCallFlowFunction(
     IFDSLinearConstantAnalysis::n_t CallStmt,
     IFDSLinearConstantAnalysis::f_t DestFun) {
-  return Identity<IFDSLinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IFDSLinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IFDSLinearConstantAnalysis::FlowFunctionPtrType
@@ -76,7 +78,8 @@ IFDSLinearConstantAnalysis::getRetFlowFunction(
     IFDSLinearConstantAnalysis::f_t CalleeFun,
     IFDSLinearConstantAnalysis::n_t ExitStmt,
     IFDSLinearConstantAnalysis::n_t RetSite) {
-  return Identity<IFDSLinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IFDSLinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IFDSLinearConstantAnalysis::FlowFunctionPtrType
@@ -84,7 +87,8 @@ IFDSLinearConstantAnalysis::getCallToRetFlowFunction(
     IFDSLinearConstantAnalysis::n_t CallSite,
     IFDSLinearConstantAnalysis::n_t RetSite,
     set<IFDSLinearConstantAnalysis::f_t> Callees) {
-  return Identity<IFDSLinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IFDSLinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IFDSLinearConstantAnalysis::FlowFunctionPtrType
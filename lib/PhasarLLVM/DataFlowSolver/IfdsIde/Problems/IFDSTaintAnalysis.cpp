@@ -7,6 +7,8 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
+#include <mutex>
 #include <utility>
 
 #include "llvm/IR/CallSite.h"
@@ -47,14 +49,14 @@ IFDSTaintAnalysis::getNormalFlowFunction(IFDSTaintAnalysis::n_t Curr,
                                          IFDSTaintAnalysis::n_t Succ) {
   // If a tainted value is stored, the store location must be tainted too
   if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Curr)) {
-    struct TAFF : FlowFunction<IFDSTaintAnalysis::d_t> {
+    struct TAFF : FlowFunction<IFDSTaintAnalysis::d_t,
+                               IFDSTaintAnalysis::container_type> {
       const llvm::StoreInst *Store;
       TAFF(const llvm::StoreInst *S) : Store(S){};
-      set<IFDSTaintAnalysis::d_t>
+      IFDSTaintAnalysis::container_type
       computeTargets(IFDSTaintAnalysis::d_t Source) override {
         if (Store->getValueOperand() == Source) {
-          return set<IFDSTaintAnalysis::d_t>{Store->getPointerOperand(),
-                                             Source};
+          return {Store->getPointerOperand(), Source};
         } else if (Store->getValueOperand() != Source &&
                    Store->getPointerOperand() == Source) {
           return {};
@@ -67,7 +69,7 @@ IFDSTaintAnalysis::getNormalFlowFunction(IFDSTaintAnalysis::n_t Curr,
   }
   // If a tainted value is loaded, the loaded value is of course tainted
   if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
-    return make_shared<GenIf<IFDSTaintAnalysis::d_t>>(
+    return make_shared<GenIf<IFDSTaintAnalysis::d_t, container_type>>(
         Load, [Load](IFDSTaintAnalysis::d_t Source) {
           return Source == Load->getPointerOperand();
         });
@@ -75,13 +77,13 @@ IFDSTaintAnalysis::getNormalFlowFunction(IFDSTaintAnalysis::n_t Curr,
   // Check if an address is computed from a tainted base pointer of an
   // aggregated object
   if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(Curr)) {
-    return make_shared<GenIf<IFDSTaintAnalysis::d_t>>(
+    return make_shared<GenIf<IFDSTaintAnalysis::d_t, container_type>>(
         GEP, [GEP](IFDSTaintAnalysis::d_t Source) {
           return Source == GEP->getPointerOperand();
         });
   }
   // Otherwise we do not care and leave everything as it is
-  return Identity<IFDSTaintAnalysis::d_t>::getInstance();
+  return Identity<IFDSTaintAnalysis::d_t, container_type>::getInstance();
 }
 
 IFDSTaintAnalysis::FlowFunctionPtrType
@@ -94,16 +96,16 @@ IFDSTaintAnalysis::getCallFlowFunction(IFDSTaintAnalysis::n_t CallStmt,
   // call to return flow function.
   if (SourceSinkFunctions.isSource(FunctionName) ||
       (SourceSinkFunctions.isSink(FunctionName))) {
-    return KillAll<IFDSTaintAnalysis::d_t>::getInstance();
+    return KillAll<IFDSTaintAnalysis::d_t, container_type>::getInstance();
   }
   // Map the actual into the formal parameters
   if (llvm::isa<llvm::CallInst>(CallStmt) ||
       llvm::isa<llvm::InvokeInst>(CallStmt)) {
-    return make_shared<MapFactsToCallee<>>(llvm::ImmutableCallSite(CallStmt),
-                                           DestFun);
+    return make_shared<MapFactsToCallee<container_type>>(
+        llvm::ImmutableCallSite(CallStmt), DestFun);
   }
   // Pass everything else as identity
-  return Identity<IFDSTaintAnalysis::d_t>::getInstance();
+  return Identity<IFDSTaintAnalysis::d_t, container_type>::getInstance();
 }
 
 IFDSTaintAnalysis::FlowFunctionPtrType IFDSTaintAnalysis::getRetFlowFunction(
@@ -112,7 +114,7 @@ IFDSTaintAnalysis::FlowFunctionPtrType IFDSTaintAnalysis::getRetFlowFunction(
   // We must check if the return value and formal parameter are tainted, if so
   // we must taint all user's of the function call. We are only interested in
   // formal parameters of pointer/reference type.
-  return make_shared<MapFactsToCaller<>>(
+  return make_shared<MapFactsToCaller<container_type>>(
       llvm::ImmutableCallSite(CallSite), CalleeFun, ExitStmt,
       [](IFDSTaintAnalysis::d_t Formal) {
         return Formal->getType()->isPointerTy();
@@ -135,7 +137,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
       // process generated taints
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "Plugin SOURCE effects");
       auto Source = SourceSinkFunctions.getSource(FunctionName);
-      set<IFDSTaintAnalysis::d_t> ToGenerate;
+      container_type ToGenerate;
       llvm::ImmutableCallSite ICallSite(CallSite);
       if (auto *Pval =
               std::get_if<TaintConfiguration<IFDSTaintAnalysis::d_t>::All>(
@@ -173,25 +175,27 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
       if (Source.TaintsReturn) {
         ToGenerate.insert(CallSite);
       }
-      return make_shared<GenAll<IFDSTaintAnalysis::d_t>>(ToGenerate,
-                                                         getZeroValue());
+      return make_shared<GenAll<IFDSTaintAnalysis::d_t, container_type>>(
+          ToGenerate, getZeroValue());
     }
     if (SourceSinkFunctions.isSink(FunctionName)) {
       // process leaks
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "Plugin SINK effects");
-      struct TAFF : FlowFunction<IFDSTaintAnalysis::d_t> {
+      struct TAFF : FlowFunction<IFDSTaintAnalysis::d_t,
+                                 IFDSTaintAnalysis::container_type> {
         llvm::ImmutableCallSite CallSite;
         IFDSTaintAnalysis::f_t CalledMthd;
         TaintConfiguration<IFDSTaintAnalysis::d_t>::SinkFunction Sink;
         map<IFDSTaintAnalysis::n_t, set<IFDSTaintAnalysis::d_t>> &Leaks;
+        std::mutex &LeaksMtx;
         const IFDSTaintAnalysis *TaintAnalysis;
         TAFF(llvm::ImmutableCallSite CS, IFDSTaintAnalysis::f_t CalledMthd,
              TaintConfiguration<IFDSTaintAnalysis::d_t>::SinkFunction S,
              map<IFDSTaintAnalysis::n_t, set<IFDSTaintAnalysis::d_t>> &Leaks,
-             const IFDSTaintAnalysis *Ta)
+             std::mutex &LeaksMtx, const IFDSTaintAnalysis *Ta)
             : CallSite(CS), CalledMthd(CalledMthd), Sink(std::move(S)),
-              Leaks(Leaks), TaintAnalysis(Ta) {}
-        set<IFDSTaintAnalysis::d_t>
+              Leaks(Leaks), LeaksMtx(LeaksMtx), TaintAnalysis(Ta) {}
+        IFDSTaintAnalysis::container_type
         computeTargets(IFDSTaintAnalysis::d_t Source) override {
           // check if a tainted value flows into a sink
           // if so, add to Leaks and return id
@@ -199,6 +203,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
             for (unsigned Idx = 0; Idx < CallSite.getNumArgOperands(); ++Idx) {
               if (Source == CallSite.getArgOperand(Idx) &&
                   Sink.isLeakedArg(Idx)) {
+                std::lock_guard<std::mutex> Lock(LeaksMtx);
                 cout << "FOUND LEAK" << endl;
                 Leaks[CallSite.getInstruction()].insert(Source);
               }
@@ -209,18 +214,48 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
       };
       return make_shared<TAFF>(llvm::ImmutableCallSite(CallSite), Callee,
                                SourceSinkFunctions.getSink(FunctionName), Leaks,
-                               this);
+                               LeaksMtx, this);
     }
   }
   // Otherwise pass everything as it is
-  return Identity<IFDSTaintAnalysis::d_t>::getInstance();
+  return Identity<IFDSTaintAnalysis::d_t, container_type>::getInstance();
 }
 
 IFDSTaintAnalysis::FlowFunctionPtrType
 IFDSTaintAnalysis::getSummaryFlowFunction(IFDSTaintAnalysis::n_t CallStmt,
                                           IFDSTaintAnalysis::f_t DestFun) {
-  SpecialSummaries<IFDSTaintAnalysis::d_t> &SS =
-      SpecialSummaries<IFDSTaintAnalysis::d_t>::getInstance();
+  // Functions at the boundary of a sliced call graph cannot reach a source or
+  // sink, but data may flow through them. Their calls have no callees in the
+  // slice, so instead of analyzing them we conservatively assume that a
+  // tainted argument taints the return value and the memory behind all
+  // pointer arguments.
+  if (ICF->isSliceBoundary(DestFun)) {
+    struct TAFF : FlowFunction<IFDSTaintAnalysis::d_t,
+                               IFDSTaintAnalysis::container_type> {
+      llvm::ImmutableCallSite CallSite;
+      TAFF(llvm::ImmutableCallSite CS) : CallSite(CS) {}
+      IFDSTaintAnalysis::container_type
+      computeTargets(IFDSTaintAnalysis::d_t Source) override {
+        IFDSTaintAnalysis::container_type Res{Source};
+        if (std::find(CallSite.arg_begin(), CallSite.arg_end(), Source) ==
+            CallSite.arg_end()) {
+          return Res;
+        }
+        if (!CallSite.getType()->isVoidTy()) {
+          Res.insert(CallSite.getInstruction());
+        }
+        for (const auto &Arg : CallSite.args()) {
+          if (Arg->getType()->isPointerTy()) {
+            Res.insert(Arg.get());
+          }
+        }
+        return Res;
+      }
+    };
+    return make_shared<TAFF>(llvm::ImmutableCallSite(CallStmt));
+  }
+  auto &SS = SpecialSummaries<IFDSTaintAnalysis::d_t, BinaryDomain,
+                              container_type>::getInstance();
   string FunctionName = cxxDemangle(DestFun->getName().str());
   // If we have a special summary, which is neither a source function, nor
   // a sink function, then we provide it to the solver.
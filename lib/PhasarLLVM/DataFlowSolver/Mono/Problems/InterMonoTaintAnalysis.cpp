@@ -7,6 +7,7 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <unordered_map>
 #include <utility>
@@ -90,6 +91,11 @@ InterMonoTaintAnalysis::callFlow(const llvm::Instruction *CallSite,
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "InterMonoTaintAnalysis::callFlow()");
   BitVectorSet<const llvm::Value *> Out;
+  // boundary functions of a sliced call graph are summarized in
+  // callToRetFlow() instead
+  if (ICF->isSliceBoundary(Callee)) {
+    return Out;
+  }
   llvm::ImmutableCallSite CS(CallSite);
   vector<const llvm::Value *> Actuals;
   vector<const llvm::Value *> Formals;
@@ -145,6 +151,9 @@ BitVectorSet<const llvm::Value *> InterMonoTaintAnalysis::callToRetFlow(
                 << "InterMonoTaintAnalysis::callToRetFlow()");
   BitVectorSet<const llvm::Value *> Out(In);
   llvm::ImmutableCallSite CS(CallSite);
+  // the values that a call of a boundary function of a sliced call graph may
+  // taint, see IFDSTaintAnalysis::getSummaryFlowFunction()
+  BitVectorSet<const llvm::Value *> Summarized;
   //-----------------------------------------------------------------------------
   // Handle virtual calls in the loop
   //-----------------------------------------------------------------------------
@@ -175,6 +184,18 @@ BitVectorSet<const llvm::Value *> InterMonoTaintAnalysis::callToRetFlow(
         Out.insert(CallSite);
       }
     }
+    if (ICF->isSliceBoundary(Callee) &&
+        std::any_of(CS.arg_begin(), CS.arg_end(),
+                    [&In](const llvm::Value *Arg) { return In.count(Arg); })) {
+      if (!CS.getType()->isVoidTy()) {
+        Summarized.insert(CallSite);
+      }
+      for (unsigned Idx = 0; Idx < CS.getNumArgOperands(); ++Idx) {
+        if (CS.getArgOperand(Idx)->getType()->isPointerTy()) {
+          Summarized.insert(CS.getArgOperand(Idx));
+        }
+      }
+    }
   }
 
   // erase pointer arguments, since they are now propagated in the retFF
@@ -183,6 +204,7 @@ BitVectorSet<const llvm::Value *> InterMonoTaintAnalysis::callToRetFlow(
       Out.erase(CS.getArgOperand(Idx));
     }
   }
+  Out.insert(Summarized);
   return Out;
 }
 
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "phasar/PhasarLLVM/Pointer/AndersenSolver.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+AndersenSolver::IdTy AndersenSolver::makeNode() {
+  Nodes.emplace_back();
+  ObjectIndices.push_back(NoObject);
+  InWorkList.push_back(false);
+  return Reps.makeSet();
+}
+
+AndersenSolver::IdTy AndersenSolver::addNode() { return makeNode(); }
+
+AndersenSolver::IdTy
+AndersenSolver::addObject(llvm::ArrayRef<uint64_t> FieldOffsets,
+                          uint64_t Stride) {
+  assert(!FieldOffsets.empty() && FieldOffsets.front() == 0 &&
+         std::is_sorted(FieldOffsets.begin(), FieldOffsets.end()) &&
+         "Invalid field offsets!");
+  auto ObjectIdx = static_cast<uint32_t>(Objects.size());
+  Objects.push_back(
+      {static_cast<IdTy>(Nodes.size()), Stride, FieldOffsets.vec()});
+  for (size_t Idx = 0; Idx < FieldOffsets.size(); ++Idx) {
+    ObjectIndices[makeNode()] = ObjectIdx;
+  }
+  return Objects.back().Base;
+}
+
+void AndersenSolver::push(IdTy N) {
+  N = find(N);
+  if (!InWorkList[N]) {
+    InWorkList[N] = true;
+    WorkList.push_back(N);
+  }
+}
+
+void AndersenSolver::addAddressOf(IdTy Dst, IdTy Location) {
+  assert(isLocation(Location) && "Only locations can be pointed to!");
+  Dst = find(Dst);
+  if (Nodes[Dst].Pts.test_and_set(Location)) {
+    push(Dst);
+  }
+}
+
+void AndersenSolver::addCopy(IdTy Dst, IdTy Src) { addCopyEdge(Src, Dst); }
+
+void AndersenSolver::addCopyEdge(IdTy Src, IdTy Dst) {
+  Src = find(Src);
+  Dst = find(Dst);
+  if (Src == Dst || !Nodes[Src].Succs.test_and_set(Dst)) {
+    return;
+  }
+  // nothing has been propagated along a new edge, yet
+  if (Nodes[Dst].Pts |= Nodes[Src].Pts) {
+    ++NumPropagations;
+    push(Dst);
+  }
+}
+
+// The complex constraints are applied to the locations that have been
+// processed already right away, the remaining ones are handled once the
+// pointer is processed.
+
+void AndersenSolver::addLoad(IdTy Dst, IdTy SrcPtr) {
+  auto &N = Nodes[find(SrcPtr)];
+  N.Loads.push_back(Dst);
+  for (auto Location : N.PrevPts) {
+    addCopyEdge(Location, Dst);
+  }
+}
+
+void AndersenSolver::addStore(IdTy DstPtr, IdTy Src) {
+  auto &N = Nodes[find(DstPtr)];
+  N.Stores.push_back(Src);
+  for (auto Location : N.PrevPts) {
+    addCopyEdge(Src, Location);
+  }
+}
+
+void AndersenSolver::addOffset(IdTy Dst, IdTy SrcPtr, int64_t Offset) {
+  auto &N = Nodes[find(SrcPtr)];
+  N.Offsets.emplace_back(Dst, Offset);
+  llvm::SparseBitVector<> Result;
+  for (auto Location : N.PrevPts) {
+    applyOffset(Location, Offset, Result);
+  }
+  Dst = find(Dst);
+  if (Nodes[Dst].Pts |= Result) {
+    push(Dst);
+  }
+}
+
+void AndersenSolver::addIndirectCall(IdTy CalleePtr, uint32_t CallId) {
+  auto &N = Nodes[find(CalleePtr)];
+  N.IndirectCalls.push_back(CallId);
+  if (IndirectCallHandler) {
+    // the handler may add constraints
+    auto Processed = N.PrevPts;
+    for (auto Location : Processed) {
+      IndirectCallHandler(CallId, Location);
+    }
+  }
+}
+
+void AndersenSolver::applyOffset(IdTy Location, int64_t Offset,
+                                 llvm::SparseBitVector<> &Result) const {
+  const auto &Obj = Objects[ObjectIndices[Location]];
+  auto NumFields = static_cast<IdTy>(Obj.FieldOffsets.size());
+  if (NumFields == 1) {
+    Result.set(Obj.Base);
+    return;
+  }
+  auto AddAllFields = [&Obj, &Result, NumFields]() {
+    for (IdTy Field = 0; Field < NumFields; ++Field) {
+      Result.set(Obj.Base + Field);
+    }
+  };
+  if (Offset == AnyField) {
+    AddAllFields();
+    return;
+  }
+  auto FieldOffset =
+      static_cast<int64_t>(Obj.FieldOffsets[Location - Obj.Base]) + Offset;
+  if (Obj.Stride != 0) {
+    // all elements of an array share the fields of the first one
+    auto Stride = static_cast<int64_t>(Obj.Stride);
+    FieldOffset = ((FieldOffset % Stride) + Stride) % Stride;
+  }
+  auto Search =
+      std::lower_bound(Obj.FieldOffsets.begin(), Obj.FieldOffsets.end(),
+                       static_cast<uint64_t>(FieldOffset));
+  if (FieldOffset < 0 || Search == Obj.FieldOffsets.end() ||
+      *Search != static_cast<uint64_t>(FieldOffset)) {
+    // the offset does not match a field, e.g. due to type punning
+    AddAllFields();
+    return;
+  }
+  Result.set(Obj.Base + (Search - Obj.FieldOffsets.begin()));
+}
+
+std::vector<std::pair<AndersenSolver::IdTy, AndersenSolver::IdTy>>
+AndersenSolver::process(IdTy N) {
+  std::vector<std::pair<IdTy, IdTy>> EqualEdges;
+  auto &Nd = Nodes[N];
+  // difference propagation: only the new locations need to be handled
+  llvm::SparseBitVector<> Delta = Nd.Pts;
+  Delta.intersectWithComplement(Nd.PrevPts);
+  if (Delta.empty()) {
+    return EqualEdges;
+  }
+  Nd.PrevPts |= Delta;
+  // the constraints may be extended while they are handled, hence the
+  // indices
+  for (size_t Idx = 0; Idx < Nd.Loads.size(); ++Idx) {
+    for (auto Location : Delta) {
+      addCopyEdge(Location, Nd.Loads[Idx]);
+    }
+  }
+  for (size_t Idx = 0; Idx < Nd.Stores.size(); ++Idx) {
+    for (auto Location : Delta) {
+      addCopyEdge(Nd.Stores[Idx], Location);
+    }
+  }
+  for (size_t Idx = 0; Idx < Nd.Offsets.size(); ++Idx) {
+    llvm::SparseBitVector<> Result;
+    for (auto Location : Delta) {
+      applyOffset(Location, Nd.Offsets[Idx].second, Result);
+    }
+    auto Dst = find(Nd.Offsets[Idx].first);
+    if (Nodes[Dst].Pts |= Result) {
+      push(Dst);
+    }
+  }
+  if (IndirectCallHandler) {
+    for (size_t Idx = 0; Idx < Nd.IndirectCalls.size(); ++Idx) {
+      for (auto Location : Delta) {
+        IndirectCallHandler(Nd.IndirectCalls[Idx], Location);
+      }
+    }
+  }
+  // propagate along the copy edges and update the successors that have been
+  // merged in the meantime
+  llvm::SparseBitVector<> Succs;
+  for (auto Succ : Nd.Succs) {
+    auto Rep = find(Succ);
+    if (Rep == N || Succs.test(Rep)) {
+      continue;
+    }
+    Succs.set(Rep);
+    if (Nodes[Rep].Pts |= Delta) {
+      ++NumPropagations;
+      push(Rep);
+    }
+    if (Nodes[Rep].Pts == Nd.Pts) {
+      EqualEdges.emplace_back(N, Rep);
+    }
+  }
+  Nd.Succs = std::move(Succs);
+  return EqualEdges;
+}
+
+AndersenSolver::IdTy AndersenSolver::merge(IdTy N1, IdTy N2) {
+  N1 = find(N1);
+  N2 = find(N2);
+  if (N1 == N2) {
+    return N1;
+  }
+  auto Rep = Reps.merge(N1, N2);
+  auto Other = Rep == N1 ? N2 : N1;
+  auto &R = Nodes[Rep];
+  auto &O = Nodes[Other];
+  R.Pts |= O.Pts;
+  // the constraints of both nodes have only been applied to the locations
+  // both of them have processed
+  R.PrevPts &= O.PrevPts;
+  R.Succs |= O.Succs;
+  R.Loads.append(O.Loads.begin(), O.Loads.end());
+  R.Stores.append(O.Stores.begin(), O.Stores.end());
+  R.Offsets.append(O.Offsets.begin(), O.Offsets.end());
+  R.IndirectCalls.append(O.IndirectCalls.begin(), O.IndirectCalls.end());
+  O = Node();
+  ++NumCollapsedNodes;
+  push(Rep);
+  return Rep;
+}
+
+void AndersenSolver::collapseCycles(IdTy Start) {
+  // Tarjan's algorithm, iteratively to not run out of stack on long chains
+  struct Frame {
+    IdTy N;
+    std::vector<IdTy> Succs;
+    size_t Next = 0;
+  };
+  llvm::DenseMap<IdTy, unsigned> Index;
+  llvm::DenseMap<IdTy, unsigned> LowLink;
+  llvm::DenseSet<IdTy> OnStack;
+  std::vector<IdTy> Stack;
+  std::vector<Frame> CallStack;
+  auto Visit = [&](IdTy N) {
+    Index[N] = LowLink[N] = Index.size();
+    Stack.push_back(N);
+    OnStack.insert(N);
+    Frame F{N, {}};
+    for (auto Succ : Nodes[N].Succs) {
+      auto Rep = find(Succ);
+      if (Rep != N) {
+        F.Succs.push_back(Rep);
+      }
+    }
+    CallStack.push_back(std::move(F));
+  };
+  Visit(find(Start));
+  while (!CallStack.empty()) {
+    auto &F = CallStack.back();
+    if (F.Next < F.Succs.size()) {
+      auto Succ = F.Succs[F.Next++];
+      if (!Index.count(Succ)) {
+        Visit(Succ);
+      } else if (OnStack.count(Succ)) {
+        LowLink[F.N] = std::min(LowLink[F.N], Index[Succ]);
+      }
+      continue;
+    }
+    auto N = F.N;
+    CallStack.pop_back();
+    if (!CallStack.empty()) {
+      auto Parent = CallStack.back().N;
+      LowLink[Parent] = std::min(LowLink[Parent], LowLink[N]);
+    }
+    if (LowLink[N] != Index[N]) {
+      continue;
+    }
+    // N is the root of a strongly connected component
+    IdTy Member;
+    do {
+      Member = Stack.back();
+      Stack.pop_back();
+      OnStack.erase(Member);
+      if (Member != N) {
+        merge(N, Member);
+      }
+    } while (Member != N);
+  }
+}
+
+void AndersenSolver::solve() {
+  while (!WorkList.empty()) {
+    auto N = WorkList.front();
+    WorkList.pop_front();
+    InWorkList[N] = false;
+    if (find(N) != N) {
+      // N has been merged, its representative is in the work list
+      continue;
+    }
+    // lazy cycle detection: a copy edge between nodes with equal points-to
+    // sets is likely part of a cycle
+    for (auto [Src, Dst] : process(N)) {
+      Src = find(Src);
+      Dst = find(Dst);
+      if (Src != Dst && CheckedEdges.insert({Src, Dst}).second) {
+        collapseCycles(Dst);
+      }
+    }
+  }
+}
+
+} // namespace psr
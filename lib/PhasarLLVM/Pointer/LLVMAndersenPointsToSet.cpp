@@ -0,0 +1,574 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/IR/GlobalAlias.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
+#include "llvm/IR/Value.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAndersenPointsToSet.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+// Collects the byte offsets of the fields of Ty, nested structs are
+// flattened and arrays are represented by their first element.
+static void collectFieldOffsets(llvm::Type *Ty, uint64_t Base,
+                                const llvm::DataLayout &DL,
+                                std::vector<uint64_t> &Offsets) {
+  if (auto *STy = llvm::dyn_cast<llvm::StructType>(Ty)) {
+    if (STy->isOpaque() || !STy->isSized() || STy->getNumElements() == 0) {
+      Offsets.push_back(Base);
+      return;
+    }
+    const auto *SL = DL.getStructLayout(STy);
+    for (unsigned Idx = 0; Idx < STy->getNumElements(); ++Idx) {
+      collectFieldOffsets(STy->getElementType(Idx),
+                          Base + SL->getElementOffset(Idx), DL, Offsets);
+    }
+    return;
+  }
+  if (auto *ATy = llvm::dyn_cast<llvm::ArrayType>(Ty)) {
+    collectFieldOffsets(ATy->getElementType(), Base, DL, Offsets);
+    return;
+  }
+  Offsets.push_back(Base);
+}
+
+// functions are identified by their name rather than their whole body
+static std::string getValueAsString(const llvm::Value *V) {
+  return llvm::isa<llvm::Function>(V) ? V->getName().str()
+                                      : llvmIRToString(V);
+}
+
+static bool isHeapAllocatingCall(const llvm::Value *V) {
+  if (!llvm::isa<llvm::CallInst>(V) && !llvm::isa<llvm::InvokeInst>(V)) {
+    return false;
+  }
+  llvm::ImmutableCallSite CS(V);
+  return CS.getCalledFunction() != nullptr &&
+         CS.getCalledFunction()->hasName() &&
+         HeapAllocatingFunctions.count(CS.getCalledFunction()->getName());
+}
+
+LLVMAndersenPointsToSet::LLVMAndersenPointsToSet(ProjectIRDB &IRDB)
+    : IRDB(IRDB) {
+  Solver.setIndirectCallHandler([this](uint32_t CallId, IdTy Location) {
+    handleIndirectCallTarget(CallId, Location);
+  });
+  for (auto *M : IRDB.getAllModules()) {
+    DL = &M->getDataLayout();
+    for (const auto &G : M->globals()) {
+      getValueNode(&G);
+    }
+    for (const auto &F : *M) {
+      if (!F.isDeclaration()) {
+        addConstraints(F);
+      }
+    }
+  }
+  solve();
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Andersen points-to analysis: " << Solver.size()
+                << " node(s), " << Solver.getNumCollapsedNodes()
+                << " collapsed, " << Solver.getNumPropagations()
+                << " propagation(s), " << ResolvedCalls.size()
+                << " indirect call target(s)");
+}
+
+LLVMAndersenPointsToSet::IdTy
+LLVMAndersenPointsToSet::getValueNode(const llvm::Value *V) {
+  auto Search = ValueNodes.find(V);
+  if (Search != ValueNodes.end()) {
+    return Search->second;
+  }
+  // the node is registered first, as constants may refer to themselves
+  // through the initializers of globals
+  auto Node = Solver.addNode();
+  ValueNodes[V] = Node;
+  if (const auto *G = llvm::dyn_cast<llvm::GlobalVariable>(V)) {
+    auto Obj = getObject(G, G->getValueType());
+    Solver.addAddressOf(Node, Obj);
+    if (G->hasInitializer()) {
+      addInitializer(Obj, getFieldOffsets(G->getValueType()),
+                     G->getInitializer(), 0);
+    }
+  } else if (const auto *F = llvm::dyn_cast<llvm::Function>(V)) {
+    Solver.addAddressOf(Node, getObject(F, F->getFunctionType()));
+  } else if (const auto *GA = llvm::dyn_cast<llvm::GlobalAlias>(V)) {
+    Solver.addCopy(Node, getValueNode(GA->getAliasee()));
+  } else if (const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(V)) {
+    switch (CE->getOpcode()) {
+    case llvm::Instruction::GetElementPtr:
+      Solver.addOffset(Node, getValueNode(CE->getOperand(0)),
+                       getGEPOffset(*llvm::cast<llvm::GEPOperator>(CE), *DL));
+      break;
+    case llvm::Instruction::BitCast:
+    case llvm::Instruction::AddrSpaceCast:
+      if (CE->getOperand(0)->getType()->isPointerTy()) {
+        Solver.addCopy(Node, getValueNode(CE->getOperand(0)));
+      }
+      break;
+    case llvm::Instruction::Select:
+      Solver.addCopy(Node, getValueNode(CE->getOperand(1)));
+      Solver.addCopy(Node, getValueNode(CE->getOperand(2)));
+      break;
+    default:
+      // e.g. inttoptr, which may point anywhere and is not modelled
+      break;
+    }
+  }
+  return Node;
+}
+
+std::optional<LLVMAndersenPointsToSet::IdTy>
+LLVMAndersenPointsToSet::lookupValueNode(const llvm::Value *V) const {
+  auto Search = ValueNodes.find(V);
+  if (Search == ValueNodes.end()) {
+    return std::nullopt;
+  }
+  return Search->second;
+}
+
+LLVMAndersenPointsToSet::IdTy
+LLVMAndersenPointsToSet::getReturnNode(const llvm::Function *F) {
+  auto Search = ReturnNodes.find(F);
+  if (Search != ReturnNodes.end()) {
+    return Search->second;
+  }
+  auto Node = Solver.addNode();
+  ReturnNodes[F] = Node;
+  return Node;
+}
+
+const std::vector<uint64_t> &
+LLVMAndersenPointsToSet::getFieldOffsets(llvm::Type *Ty) {
+  auto Search = FieldOffsets.find(Ty);
+  if (Search != FieldOffsets.end()) {
+    return Search->second;
+  }
+  std::vector<uint64_t> Offsets;
+  collectFieldOffsets(Ty, 0, *DL, Offsets);
+  // zero-sized fields share their offset with the following field
+  std::sort(Offsets.begin(), Offsets.end());
+  Offsets.erase(std::unique(Offsets.begin(), Offsets.end()), Offsets.end());
+  return FieldOffsets[Ty] = std::move(Offsets);
+}
+
+LLVMAndersenPointsToSet::IdTy
+LLVMAndersenPointsToSet::getObject(const llvm::Value *AllocationSite,
+                                   llvm::Type *Ty, bool IsArray) {
+  auto Search = Objects.find(AllocationSite);
+  if (Search != Objects.end()) {
+    return Search->second;
+  }
+  while (auto *ATy = llvm::dyn_cast<llvm::ArrayType>(Ty)) {
+    Ty = ATy->getElementType();
+    IsArray = true;
+  }
+  uint64_t Stride = 0;
+  if (IsArray && Ty->isSized()) {
+    Stride = DL->getTypeAllocSize(Ty);
+  }
+  auto Obj = Solver.addObject(getFieldOffsets(Ty), Stride);
+  Objects[AllocationSite] = Obj;
+  AllocationSites[Obj] = AllocationSite;
+  return Obj;
+}
+
+void LLVMAndersenPointsToSet::addInitializer(
+    IdTy Object, const std::vector<uint64_t> &Offsets,
+    const llvm::Constant *Init, uint64_t Offset) {
+  if (Init->getType()->isPointerTy()) {
+    if (!isInterestingPointer(Init) || llvm::isa<llvm::UndefValue>(Init)) {
+      return;
+    }
+    auto Field = std::lower_bound(Offsets.begin(), Offsets.end(), Offset);
+    assert(Field != Offsets.end() && *Field == Offset &&
+           "Initializer does not match the fields of its object!");
+    Solver.addCopy(Object + std::distance(Offsets.begin(), Field),
+                   getValueNode(Init));
+    return;
+  }
+  // neither strings nor zero initializers contain pointers to objects
+  if (llvm::isa<llvm::ConstantDataSequential>(Init) ||
+      llvm::isa<llvm::ConstantAggregateZero>(Init)) {
+    return;
+  }
+  if (auto *STy = llvm::dyn_cast<llvm::StructType>(Init->getType())) {
+    const auto *SL = DL->getStructLayout(STy);
+    for (unsigned Idx = 0; Idx < STy->getNumElements(); ++Idx) {
+      if (const auto *Elem = Init->getAggregateElement(Idx)) {
+        addInitializer(Object, Offsets, Elem,
+                       Offset + SL->getElementOffset(Idx));
+      }
+    }
+  } else if (auto *ATy = llvm::dyn_cast<llvm::ArrayType>(Init->getType())) {
+    for (uint64_t Idx = 0; Idx < ATy->getNumElements(); ++Idx) {
+      if (const auto *Elem =
+              Init->getAggregateElement(static_cast<unsigned>(Idx))) {
+        addInitializer(Object, Offsets, Elem, Offset);
+      }
+    }
+  }
+}
+
+int64_t LLVMAndersenPointsToSet::getGEPOffset(const llvm::GEPOperator &GEP,
+                                              const llvm::DataLayout &DL) {
+  int64_t Offset = 0;
+  bool IsPointerIndex = true;
+  for (auto GTI = llvm::gep_type_begin(GEP), End = llvm::gep_type_end(GEP);
+       GTI != End; ++GTI, IsPointerIndex = false) {
+    const auto *Idx = GTI.getOperand();
+    if (auto *STy = GTI.getStructTypeOrNull()) {
+      auto Field = llvm::cast<llvm::ConstantInt>(Idx)->getZExtValue();
+      Offset += DL.getStructLayout(STy)->getElementOffset(Field);
+    } else if (IsPointerIndex) {
+      auto ElemSize =
+          static_cast<int64_t>(DL.getTypeAllocSize(GTI.getIndexedType()));
+      if (const auto *C = llvm::dyn_cast<llvm::ConstantInt>(Idx)) {
+        Offset += C->getSExtValue() * ElemSize;
+      } else if (ElemSize == 1) {
+        // byte-wise pointer arithmetic may end up in any field
+        return AndersenSolver::AnyField;
+      }
+    }
+    // indices into arrays are not taken into account, all elements of an
+    // array share the fields of the first one
+  }
+  return Offset;
+}
+
+void LLVMAndersenPointsToSet::addConstraints(const llvm::Function &F) {
+  for (const auto &I : llvm::instructions(F)) {
+    if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      const auto *Count =
+          llvm::dyn_cast<llvm::ConstantInt>(Alloca->getArraySize());
+      Solver.addAddressOf(getValueNode(Alloca),
+                          getObject(Alloca, Alloca->getAllocatedType(),
+                                    !Count || !Count->isOne()));
+    } else if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+      if (Load->getType()->isPointerTy()) {
+        Solver.addLoad(getValueNode(Load),
+                       getValueNode(Load->getPointerOperand()));
+      }
+    } else if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      if (isInterestingPointer(Store->getValueOperand())) {
+        Solver.addStore(getValueNode(Store->getPointerOperand()),
+                        getValueNode(Store->getValueOperand()));
+      }
+    } else if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+      if (GEP->getType()->isPointerTy()) {
+        Solver.addOffset(
+            getValueNode(GEP), getValueNode(GEP->getPointerOperand()),
+            getGEPOffset(*llvm::cast<llvm::GEPOperator>(GEP), *DL));
+      }
+    } else if (llvm::isa<llvm::BitCastInst>(&I) ||
+               llvm::isa<llvm::AddrSpaceCastInst>(&I)) {
+      if (I.getType()->isPointerTy() &&
+          I.getOperand(0)->getType()->isPointerTy()) {
+        Solver.addCopy(getValueNode(&I), getValueNode(I.getOperand(0)));
+      }
+    } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(&I)) {
+      if (Phi->getType()->isPointerTy()) {
+        for (const auto &Incoming : Phi->incoming_values()) {
+          if (isInterestingPointer(Incoming)) {
+            Solver.addCopy(getValueNode(Phi), getValueNode(Incoming));
+          }
+        }
+      }
+    } else if (const auto *Select = llvm::dyn_cast<llvm::SelectInst>(&I)) {
+      if (Select->getType()->isPointerTy()) {
+        Solver.addCopy(getValueNode(Select),
+                       getValueNode(Select->getTrueValue()));
+        Solver.addCopy(getValueNode(Select),
+                       getValueNode(Select->getFalseValue()));
+      }
+    } else if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(&I)) {
+      const auto *RetVal = Ret->getReturnValue();
+      if (RetVal && isInterestingPointer(RetVal)) {
+        Solver.addCopy(getReturnNode(&F), getValueNode(RetVal));
+      }
+    } else if (llvm::isa<llvm::CallInst>(&I) ||
+               llvm::isa<llvm::InvokeInst>(&I)) {
+      llvm::ImmutableCallSite CS(&I);
+      if (const auto *Callee = llvm::dyn_cast<llvm::Function>(
+              CS.getCalledValue()->stripPointerCasts())) {
+        addCallConstraints(CS, *Callee);
+      } else if (!CS.isInlineAsm()) {
+        // the callees are connected once they show up in the points-to set
+        // of the called value
+        auto CallId = static_cast<uint32_t>(IndirectCalls.size());
+        IndirectCalls.push_back(CS);
+        Solver.addIndirectCall(getValueNode(CS.getCalledValue()), CallId);
+      }
+    }
+  }
+}
+
+void LLVMAndersenPointsToSet::addCallConstraints(
+    llvm::ImmutableCallSite CS, const llvm::Function &Callee) {
+  const auto *Definition = &Callee;
+  if (Callee.isDeclaration()) {
+    // the definition may be part of another module
+    Definition = IRDB.getFunctionDefinition(Callee.getName().str());
+  }
+  if (!Definition) {
+    if (const auto *MT =
+            llvm::dyn_cast<llvm::MemTransferInst>(CS.getInstruction())) {
+      // *Dest = *Source for all fields, as the size is not taken into account
+      auto Source = Solver.addNode();
+      auto Dest = Solver.addNode();
+      auto Value = Solver.addNode();
+      Solver.addOffset(Source, getValueNode(MT->getRawSource()),
+                       AndersenSolver::AnyField);
+      Solver.addOffset(Dest, getValueNode(MT->getRawDest()),
+                       AndersenSolver::AnyField);
+      Solver.addLoad(Value, Source);
+      Solver.addStore(Dest, Value);
+      return;
+    }
+    if (!CS.getType()->isPointerTy()) {
+      return;
+    }
+    // heap allocations and pointers returned by other external functions
+    // point to an object of their call site
+    const auto *Call = CS.getInstruction();
+    llvm::Type *Ty = llvm::Type::getInt8Ty(Call->getContext());
+    bool IsArray = false;
+    if (isHeapAllocatingCall(Call)) {
+      // the type of the allocated memory is given by a cast of the result
+      for (const auto *User : Call->users()) {
+        if (const auto *Cast = llvm::dyn_cast<llvm::BitCastInst>(User)) {
+          Ty = Cast->getType()->getPointerElementType();
+          IsArray = true;
+          break;
+        }
+      }
+    }
+    Solver.addAddressOf(getValueNode(Call), getObject(Call, Ty, IsArray));
+    return;
+  }
+  // variadic arguments are not taken into account
+  auto NumArgs =
+      std::min<size_t>(CS.getNumArgOperands(), Definition->arg_size());
+  const auto *Formal = Definition->arg_begin();
+  for (size_t Idx = 0; Idx < NumArgs; ++Idx, ++Formal) {
+    const auto *Actual = CS.getArgOperand(Idx);
+    if (Formal->getType()->isPointerTy() && isInterestingPointer(Actual)) {
+      Solver.addCopy(getValueNode(Formal), getValueNode(Actual));
+    }
+  }
+  if (CS.getType()->isPointerTy() &&
+      Definition->getReturnType()->isPointerTy()) {
+    Solver.addCopy(getValueNode(CS.getInstruction()),
+                   getReturnNode(Definition));
+  }
+}
+
+void LLVMAndersenPointsToSet::handleIndirectCallTarget(uint32_t CallId,
+                                                       IdTy Location) {
+  const auto *Callee = llvm::dyn_cast_or_null<llvm::Function>(
+      AllocationSites.lookup(Solver.getObjectBase(Location)));
+  if (!Callee || !ResolvedCalls.insert({CallId, Callee}).second) {
+    return;
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "Resolved indirect call "
+                << llvmIRToString(IndirectCalls[CallId].getInstruction())
+                << " to " << Callee->getName().str());
+  addCallConstraints(IndirectCalls[CallId], *Callee);
+}
+
+void LLVMAndersenPointsToSet::invalidate() {
+  PointedToBy.clear();
+  NodeValues.clear();
+  AliasSets.clear();
+}
+
+void LLVMAndersenPointsToSet::solve() {
+  if (!Solver.isSolved()) {
+    Solver.solve();
+    invalidate();
+  }
+}
+
+std::shared_ptr<std::unordered_set<const llvm::Value *>>
+LLVMAndersenPointsToSet::computeAliasSet(IdTy Node) {
+  Node = Solver.find(Node);
+  auto Search = AliasSets.find(Node);
+  if (Search != AliasSets.end()) {
+    return Search->second;
+  }
+  if (PointedToBy.empty()) {
+    PointedToBy.resize(Solver.size());
+    NodeValues.resize(Solver.size());
+    for (const auto &[V, N] : ValueNodes) {
+      NodeValues[N] = V;
+      for (auto Location : Solver.getPointsToSet(N)) {
+        PointedToBy[Location].set(N);
+      }
+    }
+  }
+  // the pointers that point to any of the locations Node points to
+  llvm::SparseBitVector<> Aliases;
+  for (auto Location : Solver.getPointsToSet(Node)) {
+    Aliases |= PointedToBy[Location];
+  }
+  auto AliasSet = std::make_shared<std::unordered_set<const llvm::Value *>>();
+  for (auto N : Aliases) {
+    AliasSet->insert(NodeValues[N]);
+  }
+  AliasSets[Node] = AliasSet;
+  return AliasSet;
+}
+
+AliasResult LLVMAndersenPointsToSet::alias(const llvm::Value *V1,
+                                           const llvm::Value *V2,
+                                           const llvm::Instruction *I) {
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return AliasResult::NoAlias;
+  }
+  if (V1 == V2) {
+    return AliasResult::MustAlias;
+  }
+  solve();
+  auto N1 = lookupValueNode(V1);
+  auto N2 = lookupValueNode(V2);
+  if (!N1 || !N2) {
+    return AliasResult::NoAlias;
+  }
+  return Solver.getPointsToSet(*N1).intersects(Solver.getPointsToSet(*N2))
+             ? AliasResult::MayAlias
+             : AliasResult::NoAlias;
+}
+
+std::shared_ptr<std::unordered_set<const llvm::Value *>>
+LLVMAndersenPointsToSet::getPointsToSet(const llvm::Value *V,
+                                        const llvm::Instruction *I) {
+  // if V is not a (interesting) pointer we can return an empty set
+  if (!isInterestingPointer(V)) {
+    return std::make_shared<std::unordered_set<const llvm::Value *>>();
+  }
+  solve();
+  auto Node = lookupValueNode(V);
+  if (!Node || Solver.getPointsToSet(*Node).empty()) {
+    // V does not point anywhere and only aliases with itself
+    return std::make_shared<std::unordered_set<const llvm::Value *>>(
+        std::unordered_set<const llvm::Value *>{V});
+  }
+  return computeAliasSet(*Node);
+}
+
+std::unordered_set<const llvm::Value *>
+LLVMAndersenPointsToSet::getReachableAllocationSites(
+    const llvm::Value *V, const llvm::Instruction *I) {
+  std::unordered_set<const llvm::Value *> AllocSites;
+  // if V is not a (interesting) pointer we can return an empty set
+  if (!isInterestingPointer(V)) {
+    return AllocSites;
+  }
+  solve();
+  auto Node = lookupValueNode(V);
+  if (!Node) {
+    return AllocSites;
+  }
+  for (auto Location : Solver.getPointsToSet(*Node)) {
+    const auto *Site = AllocationSites.lookup(Solver.getObjectBase(Location));
+    if (llvm::isa<llvm::AllocaInst>(Site) || isHeapAllocatingCall(Site)) {
+      AllocSites.insert(Site);
+    }
+  }
+  return AllocSites;
+}
+
+void LLVMAndersenPointsToSet::mergeWith(const PointsToInfo &PTI) {
+  llvm::report_fatal_error("LLVMAndersenPointsToSet already covers the whole "
+                           "program and cannot be merged!");
+}
+
+void LLVMAndersenPointsToSet::introduceAlias(const llvm::Value *V1,
+                                             const llvm::Value *V2,
+                                             const llvm::Instruction *I,
+                                             AliasResult Kind) {
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return;
+  }
+  auto N1 = getValueNode(V1);
+  auto N2 = getValueNode(V2);
+  Solver.addCopy(N1, N2);
+  Solver.addCopy(N2, N1);
+}
+
+std::string LLVMAndersenPointsToSet::getLocationAsString(IdTy Location) const {
+  auto Base = Solver.getObjectBase(Location);
+  std::string Str = getValueAsString(AllocationSites.lookup(Base));
+  if (Location != Base) {
+    Str += " (field " + std::to_string(Location - Base) + ")";
+  }
+  return Str;
+}
+
+void LLVMAndersenPointsToSet::print(std::ostream &OS) const {
+  // print the pointers in the order they have been encountered
+  std::vector<std::pair<IdTy, const llvm::Value *>> Pointers;
+  Pointers.reserve(ValueNodes.size());
+  for (const auto &[V, N] : ValueNodes) {
+    Pointers.emplace_back(N, V);
+  }
+  std::sort(Pointers.begin(), Pointers.end());
+  for (const auto &[N, V] : Pointers) {
+    OS << "V: " << getValueAsString(V) << '\n';
+    for (auto Location : Solver.getPointsToSet(N)) {
+      OS << "\tpoints to -> " << getLocationAsString(Location) << '\n';
+    }
+  }
+}
+
+nlohmann::json LLVMAndersenPointsToSet::getAsJson() const {
+  nlohmann::json J;
+  for (const auto &[V, N] : ValueNodes) {
+    auto &Locations = J["PointsToSets"][getValueAsString(V)];
+    Locations = nlohmann::json::array();
+    for (auto Location : Solver.getPointsToSet(N)) {
+      Locations.push_back(getLocationAsString(Location));
+    }
+  }
+  return J;
+}
+
+void LLVMAndersenPointsToSet::printAsJson(std::ostream &OS) const {
+  OS << getAsJson() << '\n';
+}
+
+} // namespace psr
@@ -215,35 +215,34 @@ void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
   for (auto *P : Pointers) {
     ValueVertexMap[P] = boost::add_vertex(VertexProperties(P), PAG);
   }
-  // iterate over the worklist, and run the full (n^2)/2 disambiguations
-  const auto MapEnd = ValueVertexMap.end();
-  for (auto I1 = ValueVertexMap.begin(); I1 != MapEnd; ++I1) {
-    llvm::Type *I1ElTy =
-        llvm::cast<llvm::PointerType>(I1->first->getType())->getElementType();
-    const uint64_t I1Size = I1ElTy->isSized()
-                                ? DL.getTypeStoreSize(I1ElTy)
-                                : llvm::MemoryLocation::UnknownSize;
-    for (auto I2 = std::next(I1); I2 != MapEnd; ++I2) {
-      llvm::Type *I2ElTy =
-          llvm::cast<llvm::PointerType>(I2->first->getType())->getElementType();
-      const uint64_t I2Size = I2ElTy->isSized()
-                                  ? DL.getTypeStoreSize(I2ElTy)
-                                  : llvm::MemoryLocation::UnknownSize;
-      switch (AA.alias(I1->first, I1Size, I2->first, I2Size)) {
-      case llvm::NoAlias:
-        break;
-      case llvm::MayAlias: // no break
-        [[fallthrough]];
-      case llvm::PartialAlias: // no break
-        [[fallthrough]];
-      case llvm::MustAlias:
-        boost::add_edge(I1->second, I2->second, PAG);
-        break;
-      default:
-        break;
-      }
-    }
+  std::vector<const llvm::Value *> Values;
+  std::vector<vertex_t> Vertices;
+  std::vector<uint64_t> Sizes;
+  for (const auto &[V, Vertex] : ValueVertexMap) {
+    Values.push_back(V);
+    Vertices.push_back(Vertex);
+    llvm::Type *ElTy =
+        llvm::cast<llvm::PointerType>(V->getType())->getElementType();
+    Sizes.push_back(ElTy->isSized() ? DL.getTypeStoreSize(ElTy)
+                                    : llvm::MemoryLocation::UnknownSize);
   }
+  // query the alias analysis for all pairs that may alias, rather than
+  // running the full (n^2)/2 disambiguations
+  forEachPossiblyAliasingPair(Values, DL, [&](size_t I1, size_t I2) {
+    switch (AA.alias(Values[I1], Sizes[I1], Values[I2], Sizes[I2])) {
+    case llvm::NoAlias:
+      break;
+    case llvm::MayAlias: // no break
+      [[fallthrough]];
+    case llvm::PartialAlias: // no break
+      [[fallthrough]];
+    case llvm::MustAlias:
+      boost::add_edge(Vertices[I1], Vertices[I2], PAG);
+      break;
+    default:
+      break;
+    }
+  });
 }
 
 bool LLVMPointsToGraph::isInterProcedural() const { return false; }
@@ -7,21 +7,39 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <type_traits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
 
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
@@ -29,6 +47,7 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PAMMMacros.h"
 
 using namespace std;
 using namespace psr;
@@ -36,9 +55,18 @@ using namespace psr;
 namespace psr {
 
 LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB, bool UseLazyEvaluation,
-                                 PointerAnalysisType PATy)
-    : PTA(IRDB, UseLazyEvaluation, PATy) {
+                                 PointerAnalysisType PATy, unsigned NumThreads,
+                                 const std::string &CachePath)
+    : PTA(IRDB, UseLazyEvaluation || NumThreads > 1 || !CachePath.empty(),
+          PATy),
+      CachePath(CachePath) {
+  if (!CachePath.empty()) {
+    openCache();
+  }
   if (!UseLazyEvaluation) {
+    if (NumThreads > 1) {
+      computeFunctionsPointsToSetsConcurrently(IRDB, NumThreads);
+    }
     for (llvm::Module *M : IRDB.getAllModules()) {
       // compute points-to information for all globals
       for (const auto &G : M->globals()) {
@@ -54,6 +82,66 @@ LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB, bool UseLazyEvaluation,
   }
 }
 
+LLVMPointsToSet::~LLVMPointsToSet() {
+  // flushCache() reports whether the cache could be written, callers that
+  // care should call it explicitly
+  writeCache();
+}
+
+void LLVMPointsToSet::openCache() {
+  Cache = PointsToCache::open(CachePath);
+  if (Cache &&
+      Cache->getConfigHash() !=
+          PointsToCache::computeConfigHash(PTA.getPointerAnalysisType())) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Points-to cache at '" << CachePath
+                  << "' has been written for a different analysis");
+    Cache.reset();
+  }
+}
+
+bool LLVMPointsToSet::flushCache() {
+  std::lock_guard<std::mutex> Lock(Mtx);
+  return writeCache();
+}
+
+bool LLVMPointsToSet::writeCache() {
+  if (CachePath.empty()) {
+    return true;
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Points-to cache: reused " << NumCacheHits << " of "
+                << CacheResults.size() << " function(s)");
+  // keep the cache as it is if it already contains all functions, or if
+  // nothing has been analyzed since it has last been written
+  if ((Cache && NumCacheHits == CacheResults.size()) ||
+      NumWrittenResults == CacheResults.size()) {
+    return true;
+  }
+  auto Results = CacheResults;
+  if (Cache) {
+    // keep the functions that have not been queried in this run, e.g. under
+    // lazy evaluation; write() keeps the first of several results with the
+    // same hash, hence the results of this run supersede the old ones
+    auto OldResults = Cache->getResults();
+    Results.insert(Results.end(), std::make_move_iterator(OldResults.begin()),
+                   std::make_move_iterator(OldResults.end()));
+  }
+  // the results have been copied out of the mapped file, release it before
+  // the file is replaced
+  Cache.reset();
+  bool Written = PointsToCache::write(
+      CachePath, PointsToCache::computeConfigHash(PTA.getPointerAnalysisType()),
+      std::move(Results));
+  if (Written) {
+    NumWrittenResults = CacheResults.size();
+  }
+  // the functions that are analyzed later are still looked up in the cache,
+  // which is the old one if it could not be written
+  openCache();
+  return Written;
+}
+
 void LLVMPointsToSet::computeValuesPointsToSet(const llvm::Value *V) {
   if (!isInterestingPointer(V)) {
     // don't need to do anything
@@ -89,48 +177,42 @@ void LLVMPointsToSet::computeValuesPointsToSet(const llvm::Value *V) {
 }
 
 void LLVMPointsToSet::addSingletonPointsToSet(const llvm::Value *V) {
-  if (PointsToSets.find(V) != PointsToSets.end()) {
-    PointsToSets[V]->insert(V);
-  } else {
-    PointsToSets[V] = std::make_shared<std::unordered_set<const llvm::Value *>>(
-        std::unordered_set<const llvm::Value *>{V});
+  if (PointerIds.getOrCreateId(V) == PointsToSets.size()) {
+    PointsToSets.makeSet();
   }
 }
 
 void LLVMPointsToSet::mergePointsToSets(const llvm::Value *V1,
                                         const llvm::Value *V2) {
-  auto SearchV1 = PointsToSets.find(V1);
-  assert(SearchV1 != PointsToSets.end());
-  auto SearchV2 = PointsToSets.find(V2);
-  assert(SearchV2 != PointsToSets.end());
-  const auto *V1Ptr = SearchV1->first;
-  const auto *V2Ptr = SearchV2->first;
-  if (V1Ptr == V2Ptr) {
-    return;
-  }
-  auto V1Set = SearchV1->second;
-  auto V2Set = SearchV2->second;
+  auto V1Id = PointerIds.getId(V1);
+  assert(V1Id);
+  auto V2Id = PointerIds.getId(V2);
+  assert(V2Id);
+  auto V1Root = PointsToSets.find(*V1Id);
+  auto V2Root = PointsToSets.find(*V2Id);
   // check if we need to merge the sets
-  if (V1Set->find(V2) != V1Set->end()) {
+  if (V1Root == V2Root) {
     return;
   }
-  std::shared_ptr<std::unordered_set<const llvm::Value *>> SmallerSet;
-  std::shared_ptr<std::unordered_set<const llvm::Value *>> LargerSet;
-  if (V1Set->size() <= V2Set->size()) {
-    SmallerSet = V1Set;
-    LargerSet = V2Set;
-  } else {
-    SmallerSet = V2Set;
-    LargerSet = V1Set;
-  }
-  // add smaller set to larger one
-  LargerSet->insert(SmallerSet->begin(), SmallerSet->end());
-  // reindex the contents of the smaller set
-  for (const auto *Ptr : *SmallerSet) {
-    PointsToSets[Ptr] = LargerSet;
+  // the sets handed out so far remain valid, but must not be handed out
+  // again as they lack the members of the other set
+  MaterializedSets.erase(V1Root);
+  MaterializedSets.erase(V2Root);
+  PointsToSets.merge(V1Root, V2Root);
+}
+
+std::shared_ptr<std::unordered_set<const llvm::Value *>>
+LLVMPointsToSet::materializePointsToSet(UnionFind::IdTy Id) {
+  auto Root = PointsToSets.find(Id);
+  auto &PTS = MaterializedSets[Root];
+  if (!PTS) {
+    PTS = std::make_shared<std::unordered_set<const llvm::Value *>>();
+    PTS->reserve(PointsToSets.getSetSize(Root));
+    PointsToSets.forEachMember(Root, [this, &PTS](UnionFind::IdTy Member) {
+      PTS->insert(PointerIds.getValue(Member));
+    });
   }
-  // get rid of the smaller set
-  SmallerSet->clear();
+  return PTS;
 }
 
 void LLVMPointsToSet::computeFunctionsPointsToSet(llvm::Function *F) {
@@ -145,136 +227,380 @@ void LLVMPointsToSet::computeFunctionsPointsToSet(llvm::Function *F) {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Analyzing function: " << F->getName().str());
   AnalyzedFunctions.insert(F);
+  auto Pointers = collectPointers(*F);
+  uint64_t FunctionHash = 0;
+  if (!CachePath.empty()) {
+    FunctionHash = Hasher.getHash(*F);
+    if (addCachedPointsToSets(*F, Pointers, FunctionHash)) {
+      return;
+    }
+  }
+  auto AliasingPairs = computeAliasingPairs(
+      Pointers, *PTA.getAAResults(F), F->getParent()->getDataLayout());
+  addPointsToSets(Pointers, AliasingPairs);
+  if (!CachePath.empty()) {
+    CacheResults.push_back({FunctionHash,
+                            static_cast<uint32_t>(Pointers.size()),
+                            std::move(AliasingPairs)});
+  }
+  // we no longer need the LLVM representation
+  PTA.erase(F);
+}
+
+bool LLVMPointsToSet::addCachedPointsToSets(
+    const llvm::Function &F, llvm::ArrayRef<const llvm::Value *> Pointers,
+    uint64_t FunctionHash) {
+  if (!Cache) {
+    return false;
+  }
+  auto Cached = Cache->lookup(FunctionHash, Pointers.size());
+  if (!Cached) {
+    return false;
+  }
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                << "Using cached points-to sets of function: "
+                << F.getName().str());
+  std::vector<std::pair<uint32_t, uint32_t>> AliasingPairs;
+  AliasingPairs.reserve(Cached->size());
+  for (const auto &Pair : *Cached) {
+    AliasingPairs.emplace_back(Pair.First, Pair.Second);
+  }
+  addPointsToSets(Pointers, AliasingPairs);
+  CacheResults.push_back({FunctionHash, static_cast<uint32_t>(Pointers.size()),
+                          std::move(AliasingPairs)});
+  ++NumCacheHits;
+  return true;
+}
 
-  llvm::AAResults &AA = *PTA.getAAResults(F);
-  bool EvalAAMD = true;
+void LLVMPointsToSet::addPointsToSets(
+    llvm::ArrayRef<const llvm::Value *> Pointers,
+    llvm::ArrayRef<std::pair<uint32_t, uint32_t>> AliasingPairs) {
+  // introduce a singleton set for each pointer
+  // those sets will be merged as we discover aliases
+  for (const auto *Pointer : Pointers) {
+    addSingletonPointsToSet(Pointer);
+  }
+  for (auto [I1, I2] : AliasingPairs) {
+    mergePointsToSets(Pointers[I1], Pointers[I2]);
+  }
+}
 
+std::vector<const llvm::Value *>
+LLVMPointsToSet::collectPointers(const llvm::Function &F) {
   // taken from llvm/Analysis/AliasAnalysisEvaluator.cpp
-  const llvm::DataLayout &DL = F->getParent()->getDataLayout();
-
-  llvm::SetVector<llvm::Value *> Pointers;
-  llvm::SmallSetVector<llvm::CallBase *, 16> Calls;
-  llvm::SetVector<llvm::Value *> Loads;
-  llvm::SetVector<llvm::Value *> Stores;
+  llvm::SetVector<const llvm::Value *> Pointers;
 
-  for (auto &I : F->args()) {
+  for (const auto &I : F.args()) {
     if (I.getType()->isPointerTy()) { // Add all pointer arguments.
       Pointers.insert(&I);
     }
   }
 
-  for (llvm::inst_iterator I = inst_begin(*F), E = inst_end(*F); I != E; ++I) {
-    if (I->getType()->isPointerTy()) { // Add all pointer instructions.
-      Pointers.insert(&*I);
-    }
-    if (EvalAAMD && llvm::isa<llvm::LoadInst>(&*I)) {
-      Loads.insert(&*I);
-    }
-    if (EvalAAMD && llvm::isa<llvm::StoreInst>(&*I)) {
-      Stores.insert(&*I);
+  for (const auto &Inst : llvm::instructions(F)) {
+    if (Inst.getType()->isPointerTy()) { // Add all pointer instructions.
+      Pointers.insert(&Inst);
     }
-    llvm::Instruction &Inst = *I;
-    if (auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
-      llvm::Value *Callee = Call->getCalledValue();
+    if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
+      const llvm::Value *Callee = Call->getCalledValue();
       // Skip actual functions for direct function calls.
       if (!llvm::isa<llvm::Function>(Callee) && isInterestingPointer(Callee)) {
         Pointers.insert(Callee);
       }
       // Consider formals.
-      for (llvm::Use &DataOp : Call->data_ops()) {
+      for (const llvm::Use &DataOp : Call->data_ops()) {
         if (isInterestingPointer(DataOp)) {
           Pointers.insert(DataOp);
         }
       }
-      Calls.insert(Call);
     } else {
       // Consider all operands.
-      for (llvm::Instruction::op_iterator OI = Inst.op_begin(),
-                                          OE = Inst.op_end();
-           OI != OE; ++OI) {
-        if (isInterestingPointer(*OI)) {
-          Pointers.insert(*OI);
+      for (const llvm::Use &Op : Inst.operands()) {
+        if (isInterestingPointer(Op)) {
+          Pointers.insert(Op);
         }
       }
     }
   }
-  // introduce a singleton set for each pointer
-  // those sets will be merged as we discover aliases
-  for (auto *Pointer : Pointers) {
-    addSingletonPointsToSet(Pointer);
+  return Pointers.takeVector();
+}
+
+std::vector<std::pair<uint32_t, uint32_t>>
+LLVMPointsToSet::computeAliasingPairs(
+    llvm::ArrayRef<const llvm::Value *> Pointers, llvm::AAResults &AA,
+    const llvm::DataLayout &DL) {
+  std::vector<uint64_t> Sizes;
+  Sizes.reserve(Pointers.size());
+  for (const auto *Pointer : Pointers) {
+    llvm::Type *ElTy =
+        llvm::cast<llvm::PointerType>(Pointer->getType())->getElementType();
+    Sizes.push_back(ElTy->isSized() ? DL.getTypeStoreSize(ElTy)
+                                    : llvm::MemoryLocation::UnknownSize);
   }
-  // iterate over the worklist, and run the full (n^2)/2 disambiguations
-  for (auto I1 = Pointers.begin(), E = Pointers.end(); I1 != E; ++I1) {
-    llvm::Type *I1ElTy =
-        llvm::cast<llvm::PointerType>((*I1)->getType())->getElementType();
-    const uint64_t I1Size = I1ElTy->isSized()
-                                ? DL.getTypeStoreSize(I1ElTy)
-                                : llvm::MemoryLocation::UnknownSize;
-    for (auto I2 = Pointers.begin(); I2 != I1; ++I2) {
-      llvm::Type *I2ElTy =
-          llvm::cast<llvm::PointerType>((*I2)->getType())->getElementType();
-      const uint64_t I2Size = I2ElTy->isSized()
-                                  ? DL.getTypeStoreSize(I2ElTy)
-                                  : llvm::MemoryLocation::UnknownSize;
-      switch (AA.alias(*I1, I1Size, *I2, I2Size)) {
-      case llvm::NoAlias:
-        // both pointers already have corresponding points-to sets, we are
-        // fine
-        break;
-      case llvm::MayAlias: // NOLINT
-        [[fallthrough]];
-      case llvm::PartialAlias: // NOLINT
-        [[fallthrough]];
-      case llvm::MustAlias:
-        // merge points to sets
-        mergePointsToSets(*I1, *I2);
-        break;
+  std::vector<std::pair<uint32_t, uint32_t>> AliasingPairs;
+  // the sets are merged transitively, hence pointers that are already in the
+  // same set need not be queried
+  UnionFind Merged(Pointers.size());
+  // query the alias analysis for all pairs that may alias, rather than
+  // running the full (n^2)/2 disambiguations
+  forEachPossiblyAliasingPair(Pointers, DL, [&](size_t I1, size_t I2) {
+    if (Merged.connected(I1, I2)) {
+      return;
+    }
+    switch (AA.alias(Pointers[I1], Sizes[I1], Pointers[I2], Sizes[I2])) {
+    case llvm::NoAlias:
+      // both pointers already have corresponding points-to sets, we are
+      // fine
+      break;
+    case llvm::MayAlias: // NOLINT
+      [[fallthrough]];
+    case llvm::PartialAlias: // NOLINT
+      [[fallthrough]];
+    case llvm::MustAlias:
+      // merge points to sets
+      Merged.merge(I1, I2);
+      AliasingPairs.emplace_back(I1, I2);
+      break;
+    }
+  });
+  return AliasingPairs;
+}
+
+void LLVMPointsToSet::computeFunctionsPointsToSetsConcurrently(
+    ProjectIRDB &IRDB, unsigned NumThreads) {
+  struct FunctionResult {
+    // the kinds of the pointers, to check that they match the original ones
+    std::vector<unsigned> ValueIDs;
+    std::vector<std::pair<uint32_t, uint32_t>> AliasingPairs;
+  };
+  // the overhead of splitting the modules, reported to PAMM
+  struct {
+    size_t NumCopies = 0;
+    size_t NumCopiedFunctions = 0;
+    size_t NumBitcodeBytes = 0;
+    uint64_t ExtractionMicros = 0;
+    uint64_t ParseMicros = 0;
+    size_t NumFallbacks = 0;
+  } Stats;
+  auto GetValueIDs = [](llvm::ArrayRef<const llvm::Value *> Pointers) {
+    std::vector<unsigned> ValueIDs;
+    ValueIDs.reserve(Pointers.size());
+    for (const auto *Pointer : Pointers) {
+      ValueIDs.push_back(Pointer->getValueID());
+    }
+    return ValueIDs;
+  };
+  for (llvm::Module *M : IRDB.getAllModules()) {
+    std::vector<llvm::Function *> Functions;
+    for (auto &F : *M) {
+      if (!F.isDeclaration()) {
+        Functions.push_back(&F);
+      }
+    }
+    // functions that are cached need not be analyzed again
+    std::vector<size_t> Pending;
+    std::vector<uint64_t> FunctionHashes(Functions.size());
+    for (size_t Idx = 0; Idx < Functions.size(); ++Idx) {
+      auto *F = Functions[Idx];
+      if (!CachePath.empty()) {
+        FunctionHashes[Idx] = Hasher.getHash(*F);
+        if (addCachedPointsToSets(*F, collectPointers(*F),
+                                  FunctionHashes[Idx])) {
+          AnalyzedFunctions.insert(F);
+          continue;
+        }
+      }
+      Pending.push_back(Idx);
+    }
+    if (Pending.empty()) {
+      continue;
+    }
+    // LLVM may only be used concurrently on different contexts, hence each
+    // thread analyzes a module of its own context. To not parse the whole
+    // module once per thread, the module is split: the module of a thread
+    // only contains the definitions of the functions assigned to it and of
+    // the functions they transitively call, all other functions become
+    // declarations.
+    unsigned NumCopies = std::min<size_t>(NumThreads, Pending.size());
+    std::vector<std::vector<size_t>> Assigned(NumCopies);
+    for (size_t P = 0; P < Pending.size(); ++P) {
+      Assigned[P % NumCopies].push_back(Pending[P]);
+    }
+    auto ExtractionStart = std::chrono::steady_clock::now();
+    std::vector<llvm::SmallVector<char, 0>> Bitcodes(NumCopies);
+    for (unsigned Copy = 0; Copy < NumCopies; ++Copy) {
+      llvm::SmallPtrSet<const llvm::Function *, 16> Keep;
+      llvm::SmallVector<const llvm::Function *, 16> WorkList;
+      for (auto Idx : Assigned[Copy]) {
+        Keep.insert(Functions[Idx]);
+        WorkList.push_back(Functions[Idx]);
+      }
+      // the alias analyses use the summaries of the directly called functions,
+      // hence their definitions are kept as well
+      while (!WorkList.empty()) {
+        const auto *F = WorkList.pop_back_val();
+        for (const auto &I : llvm::instructions(F)) {
+          const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I);
+          const auto *Callee = Call ? Call->getCalledFunction() : nullptr;
+          if (Callee && !Callee->isDeclaration() &&
+              Keep.insert(Callee).second) {
+            WorkList.push_back(Callee);
+          }
+        }
+      }
+      Stats.NumCopiedFunctions += Keep.size();
+      llvm::ValueToValueMapTy VMap;
+      auto Extracted =
+          llvm::CloneModule(*M, VMap, [&Keep](const llvm::GlobalValue *GV) {
+            const auto *F = llvm::dyn_cast<llvm::Function>(GV);
+            return !F || Keep.count(F);
+          });
+      llvm::raw_svector_ostream OS(Bitcodes[Copy]);
+      llvm::WriteBitcodeToFile(*Extracted, OS);
+      Stats.NumBitcodeBytes += Bitcodes[Copy].size();
+    }
+    Stats.NumCopies += NumCopies;
+    Stats.ExtractionMicros += std::chrono::duration_cast<
+                                  std::chrono::microseconds>(
+                                  std::chrono::steady_clock::now() -
+                                  ExtractionStart)
+                                  .count();
+    std::vector<std::optional<FunctionResult>> Results(Functions.size());
+    std::vector<uint64_t> ParseMicros(NumCopies, 0);
+    auto Analyze = [&](unsigned Copy) {
+      llvm::LLVMContext Ctx;
+      auto ParseStart = std::chrono::steady_clock::now();
+      auto Extracted = llvm::parseBitcodeFile(
+          llvm::MemoryBufferRef(
+              llvm::StringRef(Bitcodes[Copy].data(), Bitcodes[Copy].size()),
+              M->getModuleIdentifier()),
+          Ctx);
+      ParseMicros[Copy] = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - ParseStart)
+                              .count();
+      if (!Extracted) {
+        llvm::consumeError(Extracted.takeError());
+        return;
+      }
+      LLVMBasedPointsToAnalysis ThreadPTA(IRDB, true,
+                                          PTA.getPointerAnalysisType());
+      const auto &DL = (*Extracted)->getDataLayout();
+      for (auto Idx : Assigned[Copy]) {
+        // the extracted functions keep their names
+        auto *F = (*Extracted)->getFunction(Functions[Idx]->getName());
+        if (!F || F->isDeclaration()) {
+          continue;
+        }
+        auto Pointers = collectPointers(*F);
+        Results[Idx] = FunctionResult{
+            GetValueIDs(Pointers),
+            computeAliasingPairs(Pointers, *ThreadPTA.getAAResults(F), DL)};
+        ThreadPTA.erase(F);
+      }
+    };
+    std::vector<std::thread> Threads;
+    for (unsigned Copy = 1; Copy < NumCopies; ++Copy) {
+      Threads.emplace_back(Analyze, Copy);
+    }
+    Analyze(0);
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+    for (auto Micros : ParseMicros) {
+      Stats.ParseMicros += Micros;
+    }
+    // the pointers of a function and its extracted copy are collected in the
+    // same order, which allows to map the results back to the original
+    // module; functions whose results cannot be mapped completely are
+    // analyzed once more
+    for (auto Idx : Pending) {
+      auto *F = Functions[Idx];
+      auto Pointers = collectPointers(*F);
+      if (!Results[Idx] || Results[Idx]->ValueIDs != GetValueIDs(Pointers)) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                      << "Could not analyze function " << F->getName().str()
+                      << " concurrently");
+        ++Stats.NumFallbacks;
+        computeFunctionsPointsToSet(F);
+        continue;
+      }
+      if (AnalyzedFunctions.insert(F).second) {
+        addPointsToSets(Pointers, Results[Idx]->AliasingPairs);
+        if (!CachePath.empty()) {
+          CacheResults.push_back({FunctionHashes[Idx],
+                                  static_cast<uint32_t>(Pointers.size()),
+                                  std::move(Results[Idx]->AliasingPairs)});
+        }
       }
     }
   }
-  // we no longer need the LLVM representation
-  PTA.erase(F);
+  PAMM_GET_INSTANCE;
+  REG_COUNTER("PT Concurrent Module Copies", Stats.NumCopies,
+              PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("PT Concurrent Module Functions", Stats.NumCopiedFunctions,
+              PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("PT Concurrent Module Bytes", Stats.NumBitcodeBytes,
+              PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("PT Concurrent Extraction [us]", Stats.ExtractionMicros,
+              PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("PT Concurrent Parsing [us]", Stats.ParseMicros,
+              PAMM_SEVERITY_LEVEL::Full);
+  REG_COUNTER("PT Concurrent Fallbacks", Stats.NumFallbacks,
+              PAMM_SEVERITY_LEVEL::Full);
 }
 
 AliasResult LLVMPointsToSet::alias(const llvm::Value *V1, const llvm::Value *V2,
                                    const llvm::Instruction *I) {
+  std::lock_guard<std::mutex> Lock(Mtx);
   // if V1 or V2 is not an interesting pointer those values cannot alias
   if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
     return AliasResult::NoAlias;
   }
   computeValuesPointsToSet(V1);
   computeValuesPointsToSet(V2);
-  return PointsToSets[V1]->count(V2) ? AliasResult::MustAlias
-                                     : AliasResult::NoAlias;
+  auto V1Id = PointerIds.getId(V1);
+  auto V2Id = PointerIds.getId(V2);
+  if (!V1Id || !V2Id) {
+    return AliasResult::NoAlias;
+  }
+  return PointsToSets.connected(*V1Id, *V2Id) ? AliasResult::MustAlias
+                                               : AliasResult::NoAlias;
 }
 
 std::shared_ptr<std::unordered_set<const llvm::Value *>>
 LLVMPointsToSet::getPointsToSet(const llvm::Value *V,
                                 const llvm::Instruction *I) {
+  std::lock_guard<std::mutex> Lock(Mtx);
   // if V is not a (interesting) pointer we can return an empty set
   if (!isInterestingPointer(V)) {
     return std::make_shared<std::unordered_set<const llvm::Value *>>();
   }
   // compute V's points-to set
   computeValuesPointsToSet(V);
-  if (PointsToSets.find(V) == PointsToSets.end()) {
+  auto VId = PointerIds.getId(V);
+  if (!VId) {
     // if we still can't find its value return an empty set
     return std::make_shared<std::unordered_set<const llvm::Value *>>();
   }
-  return PointsToSets[V];
+  return materializePointsToSet(*VId);
 }
 
 std::unordered_set<const llvm::Value *>
 LLVMPointsToSet::getReachableAllocationSites(const llvm::Value *V,
                                              const llvm::Instruction *I) {
+  std::lock_guard<std::mutex> Lock(Mtx);
   // if V is not a (interesting) pointer we can return an empty set
   if (!isInterestingPointer(V)) {
     return std::unordered_set<const llvm::Value *>();
   }
   computeValuesPointsToSet(V);
   std::unordered_set<const llvm::Value *> AllocSites;
-  const auto PTS = PointsToSets[V];
-  for (const auto *P : *PTS) {
+  auto VId = PointerIds.getId(V);
+  if (!VId) {
+    return AllocSites;
+  }
+  // walk the members directly rather than materializing the points-to set
+  PointsToSets.forEachMember(*VId, [this, &AllocSites](UnionFind::IdTy Id) {
+    const auto *P = PointerIds.getValue(Id);
     if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(P)) {
       AllocSites.insert(Alloca);
     }
@@ -286,7 +612,7 @@ LLVMPointsToSet::getReachableAllocationSites(const llvm::Value *V,
         AllocSites.insert(P);
       }
     }
-  }
+  });
   return AllocSites;
 }
 
@@ -296,33 +622,22 @@ void LLVMPointsToSet::mergeWith(const PointsToInfo &PTI) {
     llvm::report_fatal_error(
         "LLVMPointsToSet can only be merged with another LLVMPointsToSet!");
   }
+  if (OtherPTI == this) {
+    return;
+  }
+  std::scoped_lock Lock(Mtx, OtherPTI->Mtx);
   // merge analyzed functions
   AnalyzedFunctions.insert(OtherPTI->AnalyzedFunctions.begin(),
                            OtherPTI->AnalyzedFunctions.end());
-  // merge points-to sets
-  for (const auto &[KeyPtr, Set] : OtherPTI->PointsToSets) {
-    bool FoundElemPtr = false;
-    for (const auto *ElemPtr : *Set) {
-      // check if a pointer of other is already present in this
-      auto Search = PointsToSets.find(ElemPtr);
-      if (Search != PointsToSets.end()) {
-        // if so, copy its elements
-        FoundElemPtr = true;
-        Search->second->insert(Set->begin(), Set->end());
-        // and reindex its elements
-        for (const auto *ElemPtr : *Set) {
-          PointsToSets.insert({ElemPtr, Search->second});
-        }
-        break;
-      }
-    }
-    // if none of the pointers of a set of other is known in this, we need to
-    // perform a copy
-    if (!FoundElemPtr) {
-      PointsToSets.insert(
-          {KeyPtr,
-           std::make_shared<std::unordered_set<const llvm::Value *>>(*Set)});
-    }
+  // merge points-to sets: each pointer of other is merged with the
+  // representative of its class in other
+  for (UnionFind::IdTy Id = 0; Id < OtherPTI->PointerIds.size(); ++Id) {
+    const auto *Ptr = OtherPTI->PointerIds.getValue(Id);
+    const auto *Repr =
+        OtherPTI->PointerIds.getValue(OtherPTI->PointsToSets.findRoot(Id));
+    addSingletonPointsToSet(Ptr);
+    addSingletonPointsToSet(Repr);
+    mergePointsToSets(Ptr, Repr);
   }
 }
 
@@ -330,6 +645,7 @@ void LLVMPointsToSet::introduceAlias(const llvm::Value *V1,
                                      const llvm::Value *V2,
                                      const llvm::Instruction *I,
                                      AliasResult Kind) {
+  std::lock_guard<std::mutex> Lock(Mtx);
   //  only introduce aliases if both values are interesting pointer
   if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
     return;
@@ -346,11 +662,13 @@ nlohmann::json LLVMPointsToSet::getAsJson() const { return ""_json; }
 void LLVMPointsToSet::printAsJson(std::ostream &OS) const {}
 
 void LLVMPointsToSet::print(std::ostream &OS) const {
-  for (const auto &[V, PTS] : PointsToSets) {
-    OS << "V: " << llvmIRToString(V) << '\n';
-    for (const auto &Ptr : *PTS) {
-      OS << "\tpoints to -> " << llvmIRToString(Ptr) << '\n';
-    }
+  std::lock_guard<std::mutex> Lock(Mtx);
+  for (UnionFind::IdTy Id = 0; Id < PointerIds.size(); ++Id) {
+    OS << "V: " << llvmIRToString(PointerIds.getValue(Id)) << '\n';
+    PointsToSets.forEachMember(Id, [this, &OS](UnionFind::IdTy Member) {
+      OS << "\tpoints to -> " << llvmIRToString(PointerIds.getValue(Member))
+         << '\n';
+    });
   }
 }
 
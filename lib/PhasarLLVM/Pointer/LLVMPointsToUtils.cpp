@@ -7,6 +7,14 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/DataLayout.h"
+
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 
 namespace psr {
@@ -14,4 +22,47 @@ namespace psr {
 const std::set<llvm::StringRef> HeapAllocatingFunctions{
     "malloc", "calloc", "realloc", "_Znwm", "_Znam"};
 
+void forEachPossiblyAliasingPair(
+    llvm::ArrayRef<const llvm::Value *> Pointers, const llvm::DataLayout &DL,
+    llvm::function_ref<void(size_t, size_t)> Query) {
+  // the buckets of pointers that share an identified underlying object, in
+  // the order of their first pointer to keep the queries deterministic
+  llvm::DenseMap<const llvm::Value *, size_t> BucketIndices;
+  std::vector<std::vector<size_t>> Buckets;
+  std::vector<size_t> Unidentified;
+  std::vector<bool> IsIdentified(Pointers.size());
+  for (size_t Idx = 0; Idx < Pointers.size(); ++Idx) {
+    // look up the object the same way basic alias analysis does
+    const auto *Obj = llvm::GetUnderlyingObject(
+        Pointers[Idx]->stripPointerCastsAndInvariantGroups(), DL);
+    if (llvm::isIdentifiedObject(Obj)) {
+      IsIdentified[Idx] = true;
+      auto [It, Inserted] = BucketIndices.try_emplace(Obj, Buckets.size());
+      if (Inserted) {
+        Buckets.emplace_back();
+      }
+      Buckets[It->second].push_back(Idx);
+    } else {
+      Unidentified.push_back(Idx);
+    }
+  }
+  for (const auto &Bucket : Buckets) {
+    for (size_t I1 = 1; I1 < Bucket.size(); ++I1) {
+      for (size_t I2 = 0; I2 < I1; ++I2) {
+        Query(Bucket[I1], Bucket[I2]);
+      }
+    }
+  }
+  // a pointer with an unknown object may alias any other pointer
+  for (auto Idx1 : Unidentified) {
+    for (size_t Idx2 = 0; Idx2 < Pointers.size(); ++Idx2) {
+      if (IsIdentified[Idx2]) {
+        Query(std::max(Idx1, Idx2), std::min(Idx1, Idx2));
+      } else if (Idx2 < Idx1) {
+        Query(Idx1, Idx2);
+      }
+    }
+  }
+}
+
 } // namespace psr
@@ -0,0 +1,495 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <system_error>
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Attributes.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InlineAsm.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/Pointer/PointsToCache.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+// bump the version whenever the layout or the function hash changes
+constexpr char CacheMagic[8] = {'P', 'S', 'R', 'P', 'T', 'v', '0', '2'};
+
+// The file consists of the header, the entries sorted by their function hash
+// and the aliasing pairs of all entries.
+struct CacheHeader {
+  char Magic[8];
+  uint64_t ConfigHash;
+  uint64_t NumEntries;
+  uint64_t NumPairs;
+};
+
+// Writes a textual form of a function to a string, referring to its local
+// values by their position.
+class FunctionSerializer {
+private:
+  llvm::raw_string_ostream &OS;
+  llvm::DenseMap<const llvm::Value *, unsigned> LocalIds;
+  llvm::SmallPtrSet<const llvm::Type *, 16> SerializedStructs;
+  std::vector<const llvm::Function *> &ReferencedFunctions;
+
+  void serialize(const llvm::Type *Ty) {
+    OS << 't' << Ty->getTypeID();
+    if (const auto *IntTy = llvm::dyn_cast<llvm::IntegerType>(Ty)) {
+      OS << ':' << IntTy->getBitWidth();
+    } else if (const auto *StructTy = llvm::dyn_cast<llvm::StructType>(Ty)) {
+      if (StructTy->hasName()) {
+        OS << '%' << StructTy->getName();
+        // a named struct is serialized once, which also ends the recursion
+        // of recursive types
+        if (!SerializedStructs.insert(StructTy).second) {
+          return;
+        }
+      }
+      OS << (StructTy->isPacked() ? "<{" : "{");
+      for (const auto *ElTy : StructTy->elements()) {
+        serialize(ElTy);
+      }
+      OS << '}';
+    } else if (const auto *PtrTy = llvm::dyn_cast<llvm::PointerType>(Ty)) {
+      OS << ':' << PtrTy->getAddressSpace();
+      serialize(PtrTy->getElementType());
+    } else if (const auto *SeqTy = llvm::dyn_cast<llvm::ArrayType>(Ty)) {
+      OS << ':' << SeqTy->getNumElements();
+      serialize(SeqTy->getElementType());
+    } else if (const auto *VecTy = llvm::dyn_cast<llvm::VectorType>(Ty)) {
+      OS << ':' << VecTy->getElementCount().Min;
+      serialize(VecTy->getElementType());
+    } else if (const auto *FunTy = llvm::dyn_cast<llvm::FunctionType>(Ty)) {
+      OS << (FunTy->isVarArg() ? "(...)" : "()");
+      serialize(FunTy->getReturnType());
+      for (const auto *ParamTy : FunTy->params()) {
+        serialize(ParamTy);
+      }
+    }
+    OS << ';';
+  }
+
+  void serialize(const llvm::AttributeList &Attrs, unsigned NumArgs) {
+    OS << '[' << Attrs.getAsString(llvm::AttributeList::FunctionIndex) << '|'
+       << Attrs.getAsString(llvm::AttributeList::ReturnIndex);
+    for (unsigned Idx = 0; Idx < NumArgs; ++Idx) {
+      OS << '|'
+         << Attrs.getAsString(llvm::AttributeList::FirstArgIndex + Idx);
+    }
+    OS << ']';
+  }
+
+  void serialize(const llvm::Value *V) {
+    if (auto Search = LocalIds.find(V); Search != LocalIds.end()) {
+      OS << 'l' << Search->second << ';';
+      return;
+    }
+    if (llvm::isa<llvm::MetadataAsValue>(V)) {
+      OS << "m;";
+      return;
+    }
+    if (const auto *Asm = llvm::dyn_cast<llvm::InlineAsm>(V)) {
+      OS << "asm" << Asm->getAsmString() << '|' << Asm->getConstraintString()
+         << ';';
+      return;
+    }
+    serialize(V->getType());
+    if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      OS << '@' << G->getName() << ';';
+      if (const auto *F = llvm::dyn_cast<llvm::Function>(G)) {
+        ReferencedFunctions.push_back(F);
+      }
+      return;
+    }
+    OS << 'v' << V->getValueID();
+    if (const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(V)) {
+      OS << ':' << CI->getValue().toString(16, true);
+    } else if (const auto *CFP = llvm::dyn_cast<llvm::ConstantFP>(V)) {
+      OS << ':' << CFP->getValueAPF().bitcastToAPInt().toString(16, false);
+    } else if (const auto *CDS =
+                   llvm::dyn_cast<llvm::ConstantDataSequential>(V)) {
+      OS << ':' << llvm::toHex(CDS->getRawDataValues());
+    } else if (const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(V)) {
+      OS << ':' << CE->getOpcode();
+      if (CE->isCompare()) {
+        OS << ':' << CE->getPredicate();
+      }
+      if (const auto *GEP = llvm::dyn_cast<llvm::GEPOperator>(CE)) {
+        serialize(GEP->getSourceElementType());
+      }
+    }
+    OS << '(';
+    if (const auto *U = llvm::dyn_cast<llvm::User>(V)) {
+      for (const auto *Op : U->operand_values()) {
+        serialize(Op);
+      }
+    }
+    OS << ')';
+  }
+
+  void serialize(const llvm::Instruction &I) {
+    OS << 'i' << I.getOpcode();
+    serialize(I.getType());
+    if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      serialize(Alloca->getAllocatedType());
+    } else if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+      OS << (GEP->isInBounds() ? "inbounds" : "");
+      serialize(GEP->getSourceElementType());
+    } else if (const auto *Cmp = llvm::dyn_cast<llvm::CmpInst>(&I)) {
+      OS << ':' << Cmp->getPredicate();
+    } else if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I)) {
+      serialize(Call->getFunctionType());
+      serialize(Call->getAttributes(), Call->getNumArgOperands());
+    } else if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+      OS << (Load->isVolatile() ? "volatile" : "");
+    } else if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      OS << (Store->isVolatile() ? "volatile" : "");
+    } else if (const auto *Extract =
+                   llvm::dyn_cast<llvm::ExtractValueInst>(&I)) {
+      for (auto Idx : Extract->indices()) {
+        OS << ':' << Idx;
+      }
+    } else if (const auto *Insert = llvm::dyn_cast<llvm::InsertValueInst>(&I)) {
+      for (auto Idx : Insert->indices()) {
+        OS << ':' << Idx;
+      }
+    }
+    OS << '(';
+    for (const auto *Op : I.operand_values()) {
+      serialize(Op);
+    }
+    OS << ")\n";
+  }
+
+public:
+  FunctionSerializer(llvm::raw_string_ostream &OS,
+                     std::vector<const llvm::Function *> &ReferencedFunctions)
+      : OS(OS), ReferencedFunctions(ReferencedFunctions) {}
+
+  void serialize(const llvm::Function &F) {
+    serialize(F.getFunctionType());
+    serialize(F.getAttributes(), F.arg_size());
+    if (F.isDeclaration()) {
+      // the name of a declaration identifies its semantics, e.g. malloc
+      OS << '@' << F.getName();
+      return;
+    }
+    // number the local values up-front, as instructions may use values that
+    // are defined later on
+    for (const auto &Arg : F.args()) {
+      LocalIds.try_emplace(&Arg, LocalIds.size());
+    }
+    for (const auto &BB : F) {
+      LocalIds.try_emplace(&BB, LocalIds.size());
+      for (const auto &I : BB) {
+        if (!llvm::isa<llvm::DbgInfoIntrinsic>(I)) {
+          LocalIds.try_emplace(&I, LocalIds.size());
+        }
+      }
+    }
+    for (const auto &BB : F) {
+      OS << "bb\n";
+      for (const auto &I : BB) {
+        if (!llvm::isa<llvm::DbgInfoIntrinsic>(I)) {
+          serialize(I);
+        }
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+uint64_t FunctionIRHasher::getLocalHash(const llvm::Function &F) {
+  if (auto Search = LocalHashes.find(&F); Search != LocalHashes.end()) {
+    return Search->second;
+  }
+  std::string Buffer;
+  llvm::raw_string_ostream OS(Buffer);
+  std::vector<const llvm::Function *> Referenced;
+  FunctionSerializer(OS, Referenced).serialize(F);
+  OS.flush();
+  uint64_t Hash = std::hash<std::string>{}(Buffer);
+  LocalHashes[&F] = Hash;
+  ReferencedFunctions[&F] = std::move(Referenced);
+  return Hash;
+}
+
+void FunctionIRHasher::computeSCCHashes(const llvm::Function &F) {
+  // Tarjan's algorithm completes the SCCs callee-first, hence the hashes of
+  // all SCCs that an SCC references are known once it is completed
+  struct Frame {
+    const llvm::Function *F;
+    size_t NextRef;
+  };
+  llvm::DenseMap<const llvm::Function *, unsigned> Indices;
+  llvm::DenseMap<const llvm::Function *, unsigned> LowLinks;
+  std::vector<const llvm::Function *> Stack;
+  std::vector<Frame> CallStack;
+  auto Visit = [&](const llvm::Function *Curr) {
+    getLocalHash(*Curr);
+    unsigned Index = Indices.size();
+    Indices[Curr] = Index;
+    LowLinks[Curr] = Index;
+    Stack.push_back(Curr);
+    CallStack.push_back({Curr, 0});
+  };
+  Visit(&F);
+  while (!CallStack.empty()) {
+    const auto *Curr = CallStack.back().F;
+    const auto &Referenced = ReferencedFunctions[Curr];
+    if (CallStack.back().NextRef < Referenced.size()) {
+      const auto *Ref = Referenced[CallStack.back().NextRef++];
+      if (SCCHashes.count(Ref)) {
+        // the SCC of Ref has been completed before
+        continue;
+      }
+      if (auto Search = Indices.find(Ref); Search != Indices.end()) {
+        // Ref is on the stack, as its SCC has not been completed yet
+        LowLinks[Curr] = std::min(LowLinks[Curr], Search->second);
+      } else {
+        Visit(Ref);
+      }
+      continue;
+    }
+    CallStack.pop_back();
+    if (!CallStack.empty()) {
+      const auto *Caller = CallStack.back().F;
+      LowLinks[Caller] = std::min(LowLinks[Caller], LowLinks[Curr]);
+    }
+    if (LowLinks[Curr] != Indices[Curr]) {
+      continue;
+    }
+    // Curr is the root of an SCC, which is hashed by the local hashes of its
+    // functions and the hashes of the SCCs they reference; the local hashes
+    // contain the names of the referenced functions, so the hashes can be
+    // combined in sorted order, which does not depend on where the search
+    // started
+    auto RootPos = std::find(Stack.begin(), Stack.end(), Curr);
+    std::vector<uint64_t> Members;
+    std::vector<uint64_t> Callees;
+    for (auto It = RootPos; It != Stack.end(); ++It) {
+      Members.push_back(LocalHashes[*It]);
+      for (const auto *Ref : ReferencedFunctions[*It]) {
+        if (auto Search = SCCHashes.find(Ref); Search != SCCHashes.end()) {
+          Callees.push_back(Search->second);
+        }
+      }
+    }
+    std::sort(Members.begin(), Members.end());
+    std::sort(Callees.begin(), Callees.end());
+    Callees.erase(std::unique(Callees.begin(), Callees.end()), Callees.end());
+    std::string Buffer;
+    llvm::raw_string_ostream OS(Buffer);
+    for (auto Hash : Members) {
+      OS << Hash << ';';
+    }
+    OS << '|';
+    for (auto Hash : Callees) {
+      OS << Hash << ';';
+    }
+    OS.flush();
+    uint64_t Hash = std::hash<std::string>{}(Buffer);
+    for (auto It = RootPos; It != Stack.end(); ++It) {
+      SCCHashes[*It] = Hash;
+      Indices.erase(*It);
+    }
+    Stack.erase(RootPos, Stack.end());
+  }
+}
+
+uint64_t FunctionIRHasher::getHash(const llvm::Function &F) {
+  auto Search = SCCHashes.find(&F);
+  if (Search == SCCHashes.end()) {
+    computeSCCHashes(F);
+    Search = SCCHashes.find(&F);
+  }
+  // the functions of an SCC share the hash of the SCC, which is combined
+  // with the local hash to tell them apart
+  std::string Buffer;
+  llvm::raw_string_ostream OS(Buffer);
+  OS << F.getParent()->getDataLayoutStr() << ';' << getLocalHash(F) << ';'
+     << Search->second;
+  OS.flush();
+  return std::hash<std::string>{}(Buffer);
+}
+
+PointsToCache::~PointsToCache() = default;
+
+uint64_t PointsToCache::computeConfigHash(PointerAnalysisType PATy) {
+  return std::hash<std::string>{}(toString(PATy));
+}
+
+bool PointsToCache::write(const std::string &Path, uint64_t ConfigHash,
+                          std::vector<FunctionResult> Results) {
+  std::stable_sort(Results.begin(), Results.end(),
+                   [](const FunctionResult &LHS, const FunctionResult &RHS) {
+                     return LHS.FunctionHash < RHS.FunctionHash;
+                   });
+  Results.erase(std::unique(Results.begin(), Results.end(),
+                            [](const FunctionResult &LHS,
+                               const FunctionResult &RHS) {
+                              return LHS.FunctionHash == RHS.FunctionHash;
+                            }),
+                Results.end());
+  std::vector<Entry> Entries;
+  Entries.reserve(Results.size());
+  std::vector<AliasingPair> Pairs;
+  for (const auto &Result : Results) {
+    Entries.push_back({Result.FunctionHash, Result.NumPointers,
+                       static_cast<uint32_t>(Result.AliasingPairs.size()),
+                       Pairs.size()});
+    for (auto [First, Second] : Result.AliasingPairs) {
+      Pairs.push_back({First, Second});
+    }
+  }
+  CacheHeader Header;
+  std::memcpy(Header.Magic, CacheMagic, sizeof(CacheMagic));
+  Header.ConfigHash = ConfigHash;
+  Header.NumEntries = Entries.size();
+  Header.NumPairs = Pairs.size();
+  // write to a temporary file first, so that a concurrent or interrupted run
+  // never leaves a partially written cache behind
+  std::string TmpPath = Path + ".tmp";
+  {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(TmpPath, EC, llvm::sys::fs::OF_None);
+    if (EC) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Could not write points-to cache '" << TmpPath
+                    << "': " << EC.message());
+      return false;
+    }
+    OS.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+    OS.write(reinterpret_cast<const char *>(Entries.data()),
+             Entries.size() * sizeof(Entry));
+    OS.write(reinterpret_cast<const char *>(Pairs.data()),
+             Pairs.size() * sizeof(AliasingPair));
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TmpPath);
+      return false;
+    }
+  }
+  if (auto EC = llvm::sys::fs::rename(TmpPath, Path)) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                  << "Could not write points-to cache '" << Path
+                  << "': " << EC.message());
+    llvm::sys::fs::remove(TmpPath);
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<PointsToCache> PointsToCache::open(const std::string &Path) {
+  uint64_t FileSize;
+  if (llvm::sys::fs::file_size(Path, FileSize) ||
+      FileSize < sizeof(CacheHeader)) {
+    return nullptr;
+  }
+  auto FD = llvm::sys::fs::openNativeFileForRead(Path);
+  if (!FD) {
+    llvm::consumeError(FD.takeError());
+    return nullptr;
+  }
+  std::error_code EC;
+  auto Region = std::make_unique<llvm::sys::fs::mapped_file_region>(
+      *FD, llvm::sys::fs::mapped_file_region::readonly, FileSize, 0, EC);
+  llvm::sys::fs::closeFile(*FD);
+  if (EC) {
+    return nullptr;
+  }
+  const char *Data = Region->const_data();
+  CacheHeader Header;
+  std::memcpy(&Header, Data, sizeof(Header));
+  if (std::memcmp(Header.Magic, CacheMagic, sizeof(CacheMagic)) != 0 ||
+      Header.NumEntries > FileSize / sizeof(Entry) ||
+      Header.NumPairs > FileSize / sizeof(AliasingPair)) {
+    return nullptr;
+  }
+  size_t PairsStart = sizeof(Header) + Header.NumEntries * sizeof(Entry);
+  if (PairsStart + Header.NumPairs * sizeof(AliasingPair) != FileSize) {
+    return nullptr;
+  }
+  std::unique_ptr<PointsToCache> Cache(new PointsToCache());
+  Cache->ConfigHash = Header.ConfigHash;
+  Cache->Entries = llvm::ArrayRef<Entry>(
+      reinterpret_cast<const Entry *>(Data + sizeof(Header)),
+      Header.NumEntries);
+  Cache->Pairs = llvm::ArrayRef<AliasingPair>(
+      reinterpret_cast<const AliasingPair *>(Data + PairsStart),
+      Header.NumPairs);
+  // reject caches that are unsorted or whose indices point out of range
+  for (size_t Idx = 0; Idx < Cache->Entries.size(); ++Idx) {
+    const auto &E = Cache->Entries[Idx];
+    if ((Idx > 0 &&
+         Cache->Entries[Idx - 1].FunctionHash >= E.FunctionHash) ||
+        E.FirstPair > Header.NumPairs ||
+        E.NumPairs > Header.NumPairs - E.FirstPair) {
+      return nullptr;
+    }
+    for (const auto &P : Cache->Pairs.slice(E.FirstPair, E.NumPairs)) {
+      if (P.First >= E.NumPointers || P.Second >= E.NumPointers) {
+        return nullptr;
+      }
+    }
+  }
+  Cache->Region = std::move(Region);
+  return Cache;
+}
+
+std::vector<PointsToCache::FunctionResult> PointsToCache::getResults() const {
+  std::vector<FunctionResult> Results;
+  Results.reserve(Entries.size());
+  for (const auto &E : Entries) {
+    FunctionResult Result{E.FunctionHash, E.NumPointers, {}};
+    Result.AliasingPairs.reserve(E.NumPairs);
+    for (const auto &P : Pairs.slice(E.FirstPair, E.NumPairs)) {
+      Result.AliasingPairs.emplace_back(P.First, P.Second);
+    }
+    Results.push_back(std::move(Result));
+  }
+  return Results;
+}
+
+std::optional<llvm::ArrayRef<PointsToCache::AliasingPair>>
+PointsToCache::lookup(uint64_t FunctionHash, uint32_t NumPointers) const {
+  const auto *Search = std::lower_bound(
+      Entries.begin(), Entries.end(), FunctionHash,
+      [](const Entry &E, uint64_t Hash) { return E.FunctionHash < Hash; });
+  if (Search == Entries.end() || Search->FunctionHash != FunctionHash ||
+      Search->NumPointers != NumPointers) {
+    return std::nullopt;
+  }
+  return Pairs.slice(Search->FirstPair, Search->NumPairs);
+}
+
+} // namespace psr
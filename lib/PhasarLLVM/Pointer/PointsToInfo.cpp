@@ -48,7 +48,7 @@ std::ostream &operator<<(std::ostream &OS, const AliasResult &AR) {
   return OS << toString(AR);
 }
 
-std::string tostring(const PointerAnalysisType &PA) {
+std::string toString(const PointerAnalysisType &PA) {
   switch (PA) {
   default:
 #define ANALYSIS_SETUP_POINTER_TYPE(NAME, CMDFLAG, TYPE)                       \
@@ -76,7 +76,7 @@ PointerAnalysisType toPointerAnalysisType(const std::string &S) {
 }
 
 std::ostream &operator<<(std::ostream &os, const PointerAnalysisType &PA) {
-  return os << tostring(PA);
+  return os << toString(PA);
 }
 
 } // namespace psr
@@ -269,8 +269,10 @@ void LLVMTypeHierarchy::constructHierarchy(const llvm::Module &M) {
 
 std::set<const llvm::StructType *>
 LLVMTypeHierarchy::getSubTypes(const llvm::StructType *Type) {
-  if (TypeVertexMap.count(Type)) {
-    return TypeGraph[TypeVertexMap[Type]].ReachableTypes;
+  // only look up, the call graph construction queries concurrently
+  auto Search = TypeVertexMap.find(Type);
+  if (Search != TypeVertexMap.end()) {
+    return TypeGraph[Search->second].ReachableTypes;
   }
   return {};
 }
@@ -417,7 +419,10 @@ void LLVMTypeHierarchy::printAsDot(std::ostream &OS) const {
 }
 
 void LLVMTypeHierarchy::printAsJson(std::ostream &OS) const {
-  OS << getAsJson();
+  // stream the type graph, getAsJson() would first build it in memory
+  writeAdjacencyListsAsJson(
+      OS, PhasarConfig::JsonTypeHierarchyID(), TypeGraph,
+      [this](vertex_t V) { return TypeGraph[V].getTypeName(); });
 }
 
 // void LLVMTypeHierarchy::printGraphAsDot(ostream &out) {
@@ -17,6 +17,7 @@
 #include <cassert>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 
 #include "boost/filesystem.hpp"
@@ -36,6 +37,13 @@ PAMM &PAMM::getInstance() {
   return Instance;
 }
 
+std::unique_lock<std::mutex> PAMM::lockIfParallel() {
+  if (NumParallelSections.load(std::memory_order_acquire)) {
+    return std::unique_lock<std::mutex>(DataMtx);
+  }
+  return std::unique_lock<std::mutex>(DataMtx, std::defer_lock);
+}
+
 void PAMM::startTimer(const std::string &TimerId) {
   bool ValidTimerId =
       !RunningTimer.count(TimerId) && !StoppedTimer.count(TimerId);
@@ -142,6 +150,7 @@ void PAMM::regCounter(const std::string &CounterId, unsigned IntialValue) {
 }
 
 void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
+  auto Lock = lockIfParallel();
   bool ValidCounterId = Counter.count(CounterId);
   assert(ValidCounterId && "incCounter failed due to an invalid counter id");
   if (ValidCounterId) {
@@ -150,6 +159,7 @@ void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
 }
 
 void PAMM::decCounter(const std::string &CounterId, unsigned CValue) {
+  auto Lock = lockIfParallel();
   bool ValidCounterId = Counter.count(CounterId);
   assert(ValidCounterId && "decCounter failed due to an invalid counter id");
   if (ValidCounterId) {
@@ -192,6 +202,7 @@ void PAMM::regHistogram(const std::string &HistogramId) {
 void PAMM::addToHistogram(const std::string &HistogramId,
                           const std::string &DataPointId,
                           unsigned long DataPointValue) {
+  auto Lock = lockIfParallel();
   bool ValidHistoId = Histogram.count(HistogramId);
   assert(ValidHistoId &&
          "adding data point to histogram failed due to invalid id");
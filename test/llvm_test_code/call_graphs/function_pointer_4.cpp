@@ -0,0 +1,14 @@
+
+int foo() { return 42; }
+
+int baz() { return 7; }
+
+int apply(int (*fptr)()) { return fptr(); }
+
+int bar() { return apply(&baz); }
+
+int main() {
+  int result = apply(&foo);
+  result += apply(&bar);
+  return result;
+}
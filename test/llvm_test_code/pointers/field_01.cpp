@@ -0,0 +1,18 @@
+struct Pair {
+  int *First;
+  int *Second;
+};
+
+int *identity(int *p) { return p; }
+
+int main() {
+  int a = 1;
+  int b = 2;
+  Pair pair;
+  pair.First = &a;
+  pair.Second = &b;
+  int *(*fp)(int *) = &identity;
+  int *r = fp(pair.First);
+  *r = 42;
+  return 0;
+}
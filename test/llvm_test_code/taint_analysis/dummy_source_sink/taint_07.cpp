@@ -0,0 +1,11 @@
+int source() { return 0; } // dummy source
+void sink(int p) {}        // dummy sink
+int increment(int p) { return p + 1; }
+
+int main(int argc, char **argv) {
+	int a = source();
+	int b = increment(argc);
+	sink(a);
+	sink(b);
+	return 0;
+}
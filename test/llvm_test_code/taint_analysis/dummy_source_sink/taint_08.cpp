@@ -0,0 +1,15 @@
+int source() { return 0; } // dummy source
+void sink(int p) {}        // dummy sink
+int identity(int p) { return p; }
+int wrap(int p) { return identity(p); }
+void assign(int *p, int v) { *p = v; }
+
+int main(int argc, char **argv) {
+	int a = source();
+	int b = wrap(a);
+	int c = 0;
+	assign(&c, a);
+	sink(b);
+	sink(c);
+	return 0;
+}
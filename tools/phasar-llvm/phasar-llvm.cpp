@@ -20,6 +20,7 @@
 #include "boost/filesystem.hpp"
 #include "phasar/Config/Configuration.h"
 #include "phasar/Controller/AnalysisController.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 #include "phasar/PhasarLLVM/Plugins/AnalysisPluginController.h"
 #include "phasar/PhasarLLVM/Plugins/PluginFactories.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
@@ -123,6 +124,20 @@ void validateSoundnessFlag(const std::string &Flag) {
   }
 }
 
+void validateParamWorklist(const std::string &Worklist) {
+  if (toWorklistKind(Worklist) == WorklistKind::Invalid) {
+    throw boost::program_options::error_with_option_name(
+        "'" + Worklist + "' is not a valid solver worklist!");
+  }
+}
+
+void validateParamJumpFunctions(const std::string &JumpFunctions) {
+  if (toJumpFunctionsKind(JumpFunctions) == JumpFunctionsKind::Invalid) {
+    throw boost::program_options::error_with_option_name(
+        "'" + JumpFunctions + "' is not a valid jump function storage!");
+  }
+}
+
 void validateParamAnalysisPlugin(const std::vector<std::string> &Plugins) {
   for (const auto &Plugin : Plugins) {
     boost::filesystem::path PluginPath(Plugin);
@@ -179,9 +194,13 @@ int main(int Argc, const char **Argv) {
 			("data-flow-analysis,D", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()/*->notifier(&validateParamDataFlowAnalysis)*/, "Set the analysis to be run")
 			("analysis-strategy", boost::program_options::value<std::string>()->default_value("WPA")->notifier(&validateParamAnalysisStrategy))
       ("analysis-config", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()->notifier(&validateParamAnalysisConfig), "Set the analysis's configuration (if required)")
-      ("pointer-analysis,P", boost::program_options::value<std::string>()->notifier(&validateParamPointerAnalysis)->default_value("CFLAnders"), "Set the points-to analysis to be used (CFLSteens, CFLAnders)")
-      ("call-graph-analysis,C", boost::program_options::value<std::string>()->notifier(&validateParamCallGraphAnalysis)->default_value("OTF"), "Set the call-graph algorithm to be used (NORESOLVE, CHA, RTA, DTA, VTA, OTF)")
+      ("pointer-analysis,P", boost::program_options::value<std::string>()->notifier(&validateParamPointerAnalysis)->default_value("CFLAnders"), "Set the points-to analysis to be used (CFLSteens, CFLAnders, Andersen)")
+      ("eager-pointer-analysis", "Compute the points-to information of all functions up-front rather than on demand, using multiple threads with --right-to-ludicrous-speed")
+      ("points-to-cache", boost::program_options::value<std::string>(), "Reuse the points-to information of unchanged functions from the given cache file and update it with the functions analyzed")
+      ("call-graph-analysis,C", boost::program_options::value<std::string>()->notifier(&validateParamCallGraphAnalysis)->default_value("OTF"), "Set the call-graph algorithm to be used (NORESOLVE, CHA, RTA, DTA, VTA, OTF, SIG)")
       ("soundiness-flag", boost::program_options::value<std::string>()->notifier(&validateSoundnessFlag)->default_value("SOUNDY"), "Set the soundiness level to be used (SOUND,SOUNDY,UNSOUND)")
+      ("call-graph-snapshot", boost::program_options::value<std::string>(), "Load the call graph from the given snapshot file if it matches the IR and settings, otherwise construct the call graph and write the snapshot")
+      ("slice-call-graph", "Restrict the call graph of the taint analyses to the functions that may reach a source or sink function; the functions they call otherwise are summarized conservatively")
 			("classhierarchy-analysis,H", "Class-hierarchy analysis")
 			("statistical-analysis,S", "Statistics")
 			("mwa,M", "Enable Modulewise-program analysis mode")
@@ -206,6 +225,12 @@ int main(int Argc, const char **Argv) {
       ("emit-pta-as-text", "Emit the points-to information as text")
       ("emit-pta-as-dot", "Emit the points-to information as DOT graph")
       ("emit-pta-as-json", "Emit the points-to information as JSON")
+      ("solver-worklist", boost::program_options::value<std::string>()->notifier(&validateParamWorklist)->default_value("LIFO"), "Set the order in which the IFDS/IDE solver processes path edges (FIFO, LIFO, RPO)")
+      ("solver-jump-functions", boost::program_options::value<std::string>()->notifier(&validateParamJumpFunctions)->default_value("Nested"), "Set how the IFDS/IDE solver stores jump functions (Nested, Flat)")
+      ("solver-cache-capacity", boost::program_options::value<size_t>()->default_value(0), "Set the maximum number of functions in each of the IFDS/IDE solver's flow and edge function caches (0 = unbounded)")
+      ("solver-intern-edge-functions", "Hash-cons edge functions and memoize their compositions and joins in the IDE solver")
+      ("solver-collect-jump-functions", "Release the intra-procedural jump functions of procedures the sequential IFDS/IDE solver is done with and recompute them on demand in phase II")
+      ("solver-esg-record-file", boost::program_options::value<std::string>(), "Stream the path edges and edge functions recorded by the IFDS/IDE solver to the given file instead of keeping them in memory")
       ("pamm-out,A", boost::program_options::value<std::string>()->notifier(validateParamPammOutputFile)->default_value("PAMM_data.json"), "Filename for PAMM's gathered data")
       
 			("analysis-plugin", boost::program_options::value<std::vector<std::string>>()->notifier(&validateParamAnalysisPlugin), "Analysis plugin(s) (absolute path to the shared object file(s))")
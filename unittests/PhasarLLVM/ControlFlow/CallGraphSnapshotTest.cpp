@@ -0,0 +1,145 @@
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/ValueSymbolTable.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/CallGraphSnapshot.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/Logger.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class CallGraphSnapshotTest : public ::testing::Test {
+protected:
+  const std::set<std::string> EntryPoints = {"main"};
+  const std::string SnapshotFile =
+      (boost::filesystem::temp_directory_path() /
+       boost::filesystem::unique_path("phasar-%%%%-%%%%.cg"))
+          .string();
+
+  void SetUp() override { boost::log::core::get()->set_logging_enabled(false); }
+
+  void TearDown() override { boost::filesystem::remove(SnapshotFile); }
+
+  static std::string getAsDot(const LLVMBasedICFG &ICFG) {
+    std::stringstream OS;
+    ICFG.printAsDot(OS);
+    return OS.str();
+  }
+
+  void compareCallGraphs(const std::string &LlvmFilePath,
+                         CallGraphAnalysisType CGType) {
+    ProjectIRDB IRDB({unittest::PathToLLTestFiles + LlvmFilePath},
+                     IRDBOptions::WPA);
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    // the first construction writes the snapshot, the second one loads it
+    LLVMBasedICFG ICFG(IRDB, CGType, EntryPoints, &TH, &PT,
+                       SoundnessFlag::SOUNDY, 1, SnapshotFile);
+    ASSERT_TRUE(boost::filesystem::exists(SnapshotFile));
+    LLVMBasedICFG LoadedICFG(IRDB, CGType, EntryPoints, &TH, &PT,
+                             SoundnessFlag::SOUNDY, 1, SnapshotFile);
+    EXPECT_GT(LoadedICFG.getNumOfEdges(), 0U);
+    EXPECT_EQ(getAsDot(ICFG), getAsDot(LoadedICFG));
+    EXPECT_EQ(ICFG.getAsJson(), LoadedICFG.getAsJson());
+    EXPECT_EQ(ICFG.getAllVertexFunctions(),
+              LoadedICFG.getAllVertexFunctions());
+  }
+}; // Test Fixture
+
+TEST_F(CallGraphSnapshotTest, RoundTrip) {
+  std::vector<std::string> Functions = {"main", "_Z3foov", ""};
+  std::vector<CallGraphSnapshot::Edge> Edges = {{0, 1, 42}, {1, 2, 7}};
+  ASSERT_TRUE(CallGraphSnapshot::write(SnapshotFile, 1, 2, Functions, Edges));
+  auto Snapshot = CallGraphSnapshot::open(SnapshotFile);
+  ASSERT_TRUE(Snapshot);
+  EXPECT_EQ(Snapshot->getModuleHash(), 1U);
+  EXPECT_EQ(Snapshot->getConfigHash(), 2U);
+  ASSERT_EQ(Snapshot->getNumFunctions(), 3U);
+  EXPECT_EQ(Snapshot->getFunctionName(0), "main");
+  EXPECT_EQ(Snapshot->getFunctionName(1), "_Z3foov");
+  EXPECT_EQ(Snapshot->getFunctionName(2), "");
+  ASSERT_EQ(Snapshot->getEdges().size(), 2U);
+  EXPECT_EQ(Snapshot->getEdges()[0].Callee, 1U);
+  EXPECT_EQ(Snapshot->getEdges()[1].Caller, 1U);
+  EXPECT_EQ(Snapshot->getEdges()[1].CallSiteID, 7U);
+}
+
+TEST_F(CallGraphSnapshotTest, RejectInvalidFiles) {
+  EXPECT_FALSE(CallGraphSnapshot::open(SnapshotFile));
+  {
+    std::ofstream OFS(SnapshotFile);
+    OFS << "not a call graph";
+  }
+  EXPECT_FALSE(CallGraphSnapshot::open(SnapshotFile));
+}
+
+TEST_F(CallGraphSnapshotTest, SameCallGraphCHA) {
+  compareCallGraphs("call_graphs/virtual_call_7_cpp.ll",
+                    CallGraphAnalysisType::CHA);
+}
+
+TEST_F(CallGraphSnapshotTest, SameCallGraphOTF) {
+  compareCallGraphs("call_graphs/function_pointer_3_cpp.ll",
+                    CallGraphAnalysisType::OTF);
+}
+
+TEST_F(CallGraphSnapshotTest, SnapshotOfOtherAnalysisIsIgnored) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/virtual_call_7_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG NoResolveICFG(IRDB, CallGraphAnalysisType::NORESOLVE,
+                              EntryPoints, &TH, &PT, SoundnessFlag::SOUNDY, 1,
+                              SnapshotFile);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::CHA, EntryPoints, &TH, &PT);
+  LLVMBasedICFG SnapshotICFG(IRDB, CallGraphAnalysisType::CHA, EntryPoints,
+                             &TH, &PT, SoundnessFlag::SOUNDY, 1, SnapshotFile);
+  EXPECT_EQ(getAsDot(ICFG), getAsDot(SnapshotICFG));
+}
+
+TEST_F(CallGraphSnapshotTest, LoadedOTFCallGraphIntroducesAliases) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *SetInteger = IRDB.getFunctionDefinition("_Z10setIntegerPi");
+  ASSERT_TRUE(Main && SetInteger);
+  const auto *Formal = SetInteger->arg_begin();
+  const auto *I = Main->getValueSymbolTable()->lookup("i");
+  ASSERT_TRUE(I);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH, &PT,
+                     SoundnessFlag::SOUNDY, 1, SnapshotFile);
+  ASSERT_EQ(PT.alias(Formal, I), AliasResult::MayAlias);
+  // the intra-procedural points-to information only knows about the alias
+  // if the call of setInteger is replayed
+  LLVMPointsToSet LoadedPT(IRDB);
+  ASSERT_EQ(LoadedPT.alias(Formal, I), AliasResult::NoAlias);
+  LLVMBasedICFG LoadedICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                           &LoadedPT, SoundnessFlag::SOUNDY, 1, SnapshotFile);
+  EXPECT_EQ(getAsDot(ICFG), getAsDot(LoadedICFG));
+  EXPECT_EQ(LoadedPT.alias(Formal, I), AliasResult::MayAlias);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -129,6 +129,25 @@ TEST(LLVMBasedBackwardCFGTest, HandlesSingleOrEmptySuccessor) {
   ASSERT_EQ(SuccsOfInst, Successor);
 }
 
+TEST(LLVMBasedBackwardCFGTest, CachedControlFlowIsReversed) {
+  LLVMBasedCFG ForwardCfg(false);
+  LLVMBasedBackwardCFG Cfg;
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "control_flow/branch_cpp.ll"});
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      EXPECT_EQ(Cfg.getSuccsOfAsRange(&I).vec(), ForwardCfg.getPredsOf(&I));
+      EXPECT_EQ(Cfg.getPredsOfAsRange(&I).vec(), ForwardCfg.getSuccsOf(&I));
+      EXPECT_EQ(Cfg.getSuccsOf(&I), ForwardCfg.getPredsOf(&I));
+      EXPECT_EQ(Cfg.getPredsOf(&I), ForwardCfg.getSuccsOf(&I));
+    }
+    EXPECT_EQ(Cfg.getStartPointsOfAsRange(F),
+              ForwardCfg.getExitPointsOfAsRange(F));
+    EXPECT_EQ(Cfg.getExitPointsOfAsRange(F),
+              ForwardCfg.getStartPointsOfAsRange(F));
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
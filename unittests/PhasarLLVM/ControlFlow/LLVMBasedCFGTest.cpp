@@ -3,6 +3,7 @@
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFGCache.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/InstIterator.h"
@@ -428,6 +429,36 @@ TEST(LLVMBasedCFGTest, IgnoreMultiSubsequentDbgInstructionsInControlFlowEdges) {
   }
 }
 
+TEST(LLVMBasedCFGTest, CachedControlFlowMatchesIR) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "control_flow/ignore_dbg_insts_1_cpp_dbg.ll"});
+  for (bool IgnoreDbgInstructions : {false, true}) {
+    LLVMBasedCFG Cfg(IgnoreDbgInstructions);
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        auto Succs = Cfg.getSuccsOfAsRange(&I);
+        auto Preds = Cfg.getPredsOfAsRange(&I);
+        EXPECT_EQ(vector<const llvm::Instruction *>(Succs.begin(),
+                                                    Succs.end()),
+                  LLVMBasedCFGCache::computeSuccsOf(&I, IgnoreDbgInstructions));
+        EXPECT_EQ(vector<const llvm::Instruction *>(Preds.begin(),
+                                                    Preds.end()),
+                  LLVMBasedCFGCache::computePredsOf(&I, IgnoreDbgInstructions));
+        EXPECT_EQ(Cfg.getSuccsOf(&I), Succs.vec());
+        EXPECT_EQ(Cfg.getPredsOf(&I), Preds.vec());
+      }
+      auto StartPoints = Cfg.getStartPointsOfAsRange(F);
+      auto ExitPoints = Cfg.getExitPointsOfAsRange(F);
+      EXPECT_EQ(Cfg.getStartPointsOf(F),
+                set<const llvm::Instruction *>(StartPoints.begin(),
+                                               StartPoints.end()));
+      EXPECT_EQ(Cfg.getExitPointsOf(F),
+                set<const llvm::Instruction *>(ExitPoints.begin(),
+                                               ExitPoints.end()));
+    }
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -1,8 +1,18 @@
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
@@ -254,6 +264,254 @@ TEST(LLVMBasedICFGTest, StaticCallSite_8) {
   ASSERT_TRUE(ICFG.isStartPoint(I));
 }
 
+TEST(LLVMBasedICFGTest, CallGraphRanges) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/static_callsite_4_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH);
+  const llvm::Function *F = IRDB.getFunctionDefinition("main");
+  ASSERT_TRUE(F);
+  size_t NumCallees = 0;
+  for (const auto *Fun : IRDB.getAllFunctions()) {
+    auto Callers = ICFG.getCallersOfAsRange(Fun);
+    EXPECT_EQ(ICFG.getCallersOf(Fun),
+              set<const llvm::Instruction *>(Callers.begin(), Callers.end()));
+    for (const auto &I : llvm::instructions(Fun)) {
+      auto Callees = ICFG.getCalleesOfCallAtAsRange(&I);
+      EXPECT_EQ(ICFG.getCalleesOfCallAt(&I),
+                set<const llvm::Function *>(Callees.begin(), Callees.end()));
+      NumCallees += Callees.size();
+    }
+  }
+  EXPECT_EQ(NumCallees, ICFG.getNumOfEdges());
+  // the ranges follow modifications of the call graph
+  auto CallSites = ICFG.getResolvedCallSitesOfAsRange(F);
+  ASSERT_FALSE(CallSites.empty());
+  const llvm::Instruction *CS = CallSites.front();
+  size_t NumCSCallees = ICFG.getCalleesOfCallAtAsRange(CS).size();
+  EXPECT_EQ(ICFG.removeEdges(F, CS), NumCSCallees);
+  EXPECT_TRUE(ICFG.getCalleesOfCallAtAsRange(CS).empty());
+  EXPECT_TRUE(ICFG.getCalleesOfCallAt(CS).empty());
+}
+
+TEST(LLVMBasedICFGTest, StronglyConnectedComponents) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "linear_constant/recursion_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH);
+  const llvm::Function *Main = IRDB.getFunctionDefinition("main");
+  const llvm::Function *Decrement = IRDB.getFunctionDefinition("_Z9decrementi");
+  ASSERT_TRUE(Main);
+  ASSERT_TRUE(Decrement);
+  unsigned MainSCC = ICFG.getSCCOf(Main);
+  unsigned DecrementSCC = ICFG.getSCCOf(Decrement);
+  // callees come first
+  EXPECT_LT(DecrementSCC, MainSCC);
+  EXPECT_TRUE(ICFG.isRecursiveSCC(DecrementSCC));
+  EXPECT_FALSE(ICFG.isRecursiveSCC(MainSCC));
+  EXPECT_EQ(ICFG.getFunctionsOfSCC(DecrementSCC).vec(),
+            vector<const llvm::Function *>({Decrement}));
+  EXPECT_EQ(ICFG.getCalleeSCCsOf(MainSCC).vec(),
+            vector<unsigned>({DecrementSCC}));
+  EXPECT_TRUE(ICFG.getCalleeSCCsOf(DecrementSCC).empty());
+  size_t NumFunctions = 0;
+  for (unsigned SCC = 0; SCC < ICFG.getNumSCCs(); ++SCC) {
+    for (const auto *F : ICFG.getFunctionsOfSCC(SCC)) {
+      EXPECT_EQ(ICFG.getSCCOf(F), SCC);
+      for (const auto *CS : ICFG.getResolvedCallSitesOfAsRange(F)) {
+        for (const auto *Callee : ICFG.getCalleesOfCallAtAsRange(CS)) {
+          EXPECT_LE(ICFG.getSCCOf(Callee), SCC);
+        }
+      }
+      ++NumFunctions;
+    }
+  }
+  EXPECT_EQ(NumFunctions, ICFG.getNumOfVertices());
+}
+
+TEST(LLVMBasedICFGTest, ConcurrentConstruction) {
+  const std::vector<std::string> Files = {
+      "call_graphs/static_callsite_4_cpp.ll",
+      "call_graphs/function_pointer_2_cpp.ll",
+      "call_graphs/virtual_call_3_cpp.ll",
+      "call_graphs/virtual_call_7_cpp.ll",
+      "virtual_callsites/interproc_callsite_cpp.ll"};
+  for (const auto &File : Files) {
+    for (auto CGType :
+         {CallGraphAnalysisType::CHA, CallGraphAnalysisType::RTA}) {
+      ProjectIRDB IRDB({unittest::PathToLLTestFiles + File}, IRDBOptions::WPA);
+      LLVMTypeHierarchy TH(IRDB);
+      LLVMBasedICFG ICFG(IRDB, CGType, {"main"}, &TH);
+      LLVMBasedICFG ConcurrentICFG(IRDB, CGType, {"main"}, &TH, nullptr,
+                                   SoundnessFlag::SOUNDY, 4);
+      // the vertices and edges are even added in the same order
+      EXPECT_EQ(ICFG.getAsJson(), ConcurrentICFG.getAsJson()) << File;
+      EXPECT_EQ(ICFG.getNumOfEdges(), ConcurrentICFG.getNumOfEdges()) << File;
+      std::stringstream Dot;
+      std::stringstream ConcurrentDot;
+      ICFG.printAsDot(Dot);
+      ConcurrentICFG.printAsDot(ConcurrentDot);
+      EXPECT_EQ(Dot.str(), ConcurrentDot.str()) << File;
+    }
+  }
+}
+
+// Parses Copies copies of each of the given files into a separate module and
+// renames the main function of each module to main_<id>, which yields a large
+// program that consists of many independent call graphs.
+static std::vector<std::unique_ptr<llvm::Module>>
+makeScaledModules(llvm::LLVMContext &Ctx,
+                  const std::vector<std::string> &Files, size_t Copies,
+                  std::set<std::string> &EntryPoints) {
+  std::vector<std::unique_ptr<llvm::Module>> Modules;
+  for (size_t Copy = 0; Copy < Copies; ++Copy) {
+    for (const auto &File : Files) {
+      llvm::SMDiagnostic Diag;
+      auto M = llvm::parseIRFile(unittest::PathToLLTestFiles + File, Diag, Ctx);
+      if (!M) {
+        continue;
+      }
+      std::string EntryPoint = "main_" + std::to_string(Modules.size());
+      M->setModuleIdentifier(EntryPoint + "_" + File);
+      if (auto *Main = M->getFunction("main")) {
+        Main->setName(EntryPoint);
+        EntryPoints.insert(EntryPoint);
+      }
+      Modules.push_back(std::move(M));
+    }
+  }
+  return Modules;
+}
+
+// measures the serial and the concurrent call-graph construction on scaled up
+// copies of the call_graphs and virtual_callsites inputs, run with
+// --gtest_also_run_disabled_tests
+TEST(LLVMBasedICFGTest, DISABLED_ConcurrentConstructionBenchmark) {
+  std::vector<std::string> Files;
+  for (const auto *Stem :
+       {"function_pointer_1_c", "static_callsite_1_c", "static_callsite_2_c",
+        "static_callsite_3_c"}) {
+    Files.push_back("call_graphs/" + std::string(Stem) + ".ll");
+  }
+  for (const auto *Stem :
+       {"function_object_1", "function_pointer_2", "function_pointer_3",
+        "special_member_functions_1", "static_callsite_4",
+        "static_callsite_5", "static_callsite_6", "static_callsite_7",
+        "static_callsite_8", "static_callsite_9", "static_callsite_10",
+        "static_callsite_11", "static_callsite_12", "static_callsite_13",
+        "type_graph_1", "virtual_call_1", "virtual_call_2", "virtual_call_3",
+        "virtual_call_4", "virtual_call_5", "virtual_call_6", "virtual_call_7",
+        "virtual_call_8", "virtual_call_9"}) {
+    Files.push_back("call_graphs/" + std::string(Stem) + "_cpp.ll");
+  }
+  for (const auto *Stem :
+       {"callsite", "callsite_staticmemory", "interproc_callsite",
+        "callsite_dynmemory", "circular_dependencies",
+        "interproc_callsite_double"}) {
+    Files.push_back("virtual_callsites/" + std::string(Stem) + "_cpp.ll");
+  }
+  auto Measure = [](auto Fn) {
+    auto Start = std::chrono::steady_clock::now();
+    Fn();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - Start)
+        .count();
+  };
+  for (size_t Copies : {1, 10, 100}) {
+    llvm::LLVMContext Ctx;
+    std::set<std::string> EntryPoints;
+    auto Modules = makeScaledModules(Ctx, Files, Copies, EntryPoints);
+    std::vector<llvm::Module *> ModulePtrs;
+    for (auto &M : Modules) {
+      ModulePtrs.push_back(M.get());
+    }
+    ProjectIRDB IRDB(ModulePtrs, IRDBOptions::NONE);
+    LLVMTypeHierarchy TH(IRDB);
+    for (auto CGType : {CallGraphAnalysisType::CHA, CallGraphAnalysisType::RTA,
+                        CallGraphAnalysisType::DTA}) {
+      std::unique_ptr<LLVMBasedICFG> ICFG;
+      std::unique_ptr<LLVMBasedICFG> ConcurrentICFG;
+      auto Ms = Measure([&] {
+        ICFG = std::make_unique<LLVMBasedICFG>(IRDB, CGType, EntryPoints, &TH);
+      });
+      auto ConcurrentMs = Measure([&] {
+        ConcurrentICFG = std::make_unique<LLVMBasedICFG>(
+            IRDB, CGType, EntryPoints, &TH, nullptr, SoundnessFlag::SOUNDY, 4);
+      });
+      std::cout << Modules.size() << " modules, " << CGType << ": "
+                << ICFG->getNumOfEdges() << " edges, serial " << Ms
+                << " ms, 4 threads " << ConcurrentMs << " ms\n";
+      EXPECT_EQ(ICFG->getNumOfEdges(), ConcurrentICFG->getNumOfEdges());
+    }
+  }
+}
+
+TEST(LLVMBasedICFGTest, SliceTowardsTargets) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/static_callsite_4_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH);
+  const llvm::Function *Main = IRDB.getFunctionDefinition("main");
+  const llvm::Function *A = IRDB.getFunctionDefinition("_Z1Av");
+  const llvm::Function *B = IRDB.getFunctionDefinition("_Z1Bv");
+  const llvm::Function *C = IRDB.getFunctionDefinition("_Z1Cv");
+  const llvm::Function *D = IRDB.getFunctionDefinition("_Z1Dv");
+  ASSERT_TRUE(Main && A && B && C && D);
+  unsigned NumFunctions = ICFG.getNumOfVertices();
+  unsigned NumEdges = ICFG.getNumOfEdges();
+  // slicing towards a function that every path ends in keeps everything
+  LLVMBasedICFG FullSlice(ICFG);
+  auto FullReport = FullSlice.sliceTowards({Main}, {A});
+  EXPECT_EQ(FullReport.NumRemovedFunctions, 0U);
+  EXPECT_EQ(FullReport.NumRemovedCallEdges, 0U);
+  EXPECT_EQ(FullSlice.getAsJson(), ICFG.getAsJson());
+  EXPECT_EQ(FullReport.NumBoundaryFunctions, 0U);
+  // C is called by D and E, while B and A are only called below C; B is also
+  // called by D and therefore kept as a boundary function, A is removed
+  LLVMBasedICFG Slice(ICFG);
+  auto Report = Slice.sliceTowards({Main}, {C});
+  EXPECT_EQ(Report.NumFunctions, NumFunctions);
+  EXPECT_EQ(Report.NumCallEdges, NumEdges);
+  EXPECT_EQ(Report.NumRemovedFunctions, 1U);
+  EXPECT_EQ(Report.NumRemovedCallEdges, 1U);
+  EXPECT_EQ(Report.NumBoundaryFunctions, 1U);
+  EXPECT_EQ(Slice.getNumOfVertices(), NumFunctions - 1);
+  EXPECT_EQ(Slice.getNumOfEdges(), NumEdges - 1);
+  auto Functions = Slice.getAllVertexFunctions();
+  EXPECT_FALSE(Functions.count(A));
+  EXPECT_TRUE(Functions.count(B));
+  EXPECT_TRUE(Functions.count(C));
+  EXPECT_TRUE(Slice.isSliceBoundary(B));
+  EXPECT_FALSE(Slice.isSliceBoundary(C));
+  EXPECT_FALSE(Slice.isSliceBoundary(A));
+  // the calls of kept functions keep all of their callees, the calls of the
+  // boundary function have none
+  for (const auto *CS : ICFG.getResolvedCallSitesOfAsRange(D)) {
+    EXPECT_EQ(Slice.getCalleesOfCallAt(CS), ICFG.getCalleesOfCallAt(CS));
+  }
+  for (const auto *CS : ICFG.getResolvedCallSitesOfAsRange(B)) {
+    EXPECT_TRUE(Slice.getCalleesOfCallAt(CS).empty());
+  }
+  EXPECT_TRUE(Slice.getCallersOf(A).empty());
+  // the call graph queries and SCCs are rebuilt for the slice
+  size_t NumSCCFunctions = 0;
+  for (unsigned SCC = 0; SCC < Slice.getNumSCCs(); ++SCC) {
+    NumSCCFunctions += Slice.getFunctionsOfSCC(SCC).size();
+  }
+  EXPECT_EQ(NumSCCFunctions, Slice.getNumOfVertices());
+  // the entry points are kept even if they cannot reach any target, together
+  // with their callees as boundary functions
+  LLVMBasedICFG EmptySlice(ICFG);
+  EmptySlice.sliceTowards({Main}, {});
+  EXPECT_EQ(EmptySlice.getNumOfVertices(), 2U);
+  EXPECT_EQ(EmptySlice.getNumOfEdges(), 1U);
+  EXPECT_TRUE(EmptySlice.isSliceBoundary(
+      IRDB.getFunctionDefinition("_Z1Fv")));
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -1,12 +1,17 @@
 #include "gtest/gtest.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "llvm/IR/CallSite.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/VirtualCallCache.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/Utils/LLVMShorthands.h"
 
@@ -112,6 +117,49 @@ TEST(LLVMBasedICFG_CHATest, VirtualCallSite_7) {
   }
 }
 
+TEST(LLVMBasedICFG_CHATest, VirtualCallCache) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/virtual_call_7_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  auto Cache = std::make_shared<VirtualCallCache>();
+  CHAResolver Res(IRDB, TH, Cache);
+  const llvm::Function *F = IRDB.getFunctionDefinition("main");
+  ASSERT_TRUE(F);
+
+  std::vector<llvm::ImmutableCallSite> VirtualCallSites;
+  for (const auto &BB : *F) {
+    for (const auto &I : BB) {
+      if (llvm::isa<llvm::CallInst>(&I) || llvm::isa<llvm::InvokeInst>(&I)) {
+        llvm::ImmutableCallSite CS(&I);
+        if (getReceiverType(CS) && getVFTIndex(CS) >= 0) {
+          VirtualCallSites.push_back(CS);
+        }
+      }
+    }
+  }
+  // a->Vfunc() and b->Vfunc() share their receiver type and index
+  ASSERT_GE(VirtualCallSites.size(), 2U);
+  for (auto CS : VirtualCallSites) {
+    // the memoized targets are the ones computed from scratch
+    EXPECT_EQ(Res.resolveVirtualCall(CS),
+              CHAResolver(IRDB, TH).resolveVirtualCall(CS));
+  }
+  auto Stats = Res.getVirtualCallCacheStats();
+  EXPECT_EQ(Stats.Hits + Stats.Misses, VirtualCallSites.size());
+  EXPECT_EQ(Stats.Misses, Cache->size());
+  EXPECT_GE(Stats.Hits, 1U);
+
+  // a resolver that shares the cache does not compute any targets again
+  CHAResolver OtherRes(IRDB, TH, Cache);
+  for (auto CS : VirtualCallSites) {
+    OtherRes.resolveVirtualCall(CS);
+  }
+  auto SharedStats = OtherRes.getVirtualCallCacheStats();
+  EXPECT_EQ(SharedStats.Misses, Stats.Misses);
+  EXPECT_EQ(SharedStats.Hits, Stats.Hits + VirtualCallSites.size());
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
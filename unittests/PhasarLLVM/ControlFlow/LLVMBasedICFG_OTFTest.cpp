@@ -1,5 +1,12 @@
+#include <algorithm>
+#include <set>
+#include <string>
+
 #include "gtest/gtest.h"
 
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
@@ -101,6 +108,72 @@ TEST(LLVMBasedICFG_OTFTest, FunctionPtrCall_3) {
   ASSERT_EQ(Callees.count(Foo), 1U);
 }
 
+TEST(LLVMBasedICFG_OTFTest, SoundFixpointKeepsAllEdges) {
+  for (const std::string File :
+       {"call_graphs/virtual_call_7_cpp.ll",
+        "call_graphs/function_pointer_3_cpp.ll"}) {
+    ProjectIRDB IRDB({unittest::PathToLLTestFiles + File}, IRDBOptions::WPA);
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB, false);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+    LLVMPointsToSet SoundPT(IRDB, false);
+    LLVMBasedICFG SoundICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH,
+                            &SoundPT, SoundnessFlag::SOUND);
+
+    EXPECT_GE(SoundICFG.getNumOfEdges(), ICFG.getNumOfEdges());
+    for (const auto *F : ICFG.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        if (!ICFG.isCallStmt(&I)) {
+          continue;
+        }
+        auto Callees = ICFG.getCalleesOfCallAt(&I);
+        auto SoundCallees = SoundICFG.getCalleesOfCallAt(&I);
+        EXPECT_TRUE(std::includes(SoundCallees.begin(), SoundCallees.end(),
+                                  Callees.begin(), Callees.end()));
+      }
+    }
+  }
+}
+
+TEST(LLVMBasedICFG_OTFTest, SoundFixpointFindsLateTargets) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "call_graphs/function_pointer_4_cpp_m2r.ll"},
+                   IRDBOptions::WPA);
+  const llvm::Function *Apply = IRDB.getFunctionDefinition("_Z5applyPFivE");
+  const llvm::Function *Foo = IRDB.getFunctionDefinition("_Z3foov");
+  const llvm::Function *Bar = IRDB.getFunctionDefinition("_Z3barv");
+  const llvm::Function *Baz = IRDB.getFunctionDefinition("_Z3bazv");
+  ASSERT_TRUE(Apply && Foo && Bar && Baz);
+  const llvm::Instruction *FPtrCall = nullptr;
+  for (const auto &I : llvm::instructions(Apply)) {
+    if (const auto *Call = llvm::dyn_cast<llvm::CallInst>(&I);
+        Call && !Call->getCalledFunction()) {
+      FPtrCall = Call;
+    }
+  }
+  ASSERT_TRUE(FPtrCall);
+
+  // apply() is walked when it is called with foo, the calls with bar and baz
+  // only grow the points-to set of its parameter afterwards
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB, false);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  EXPECT_EQ(ICFG.getCalleesOfCallAt(FPtrCall),
+            std::set<const llvm::Function *>({Foo}));
+  EXPECT_EQ(ICFG.getNumFixpointRounds(), 0U);
+
+  // the first round finds bar, whose call of apply() with baz is only seen
+  // once bar is walked, the second round thus finds baz
+  LLVMPointsToSet SoundPT(IRDB, false);
+  LLVMBasedICFG SoundICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH,
+                          &SoundPT, SoundnessFlag::SOUND);
+  EXPECT_EQ(SoundICFG.getCalleesOfCallAt(FPtrCall),
+            std::set<const llvm::Function *>({Foo, Bar, Baz}));
+  EXPECT_EQ(SoundICFG.getCallersOf(Baz),
+            std::set<const llvm::Instruction *>({FPtrCall}));
+  EXPECT_GT(SoundICFG.getNumFixpointRounds(), 1U);
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
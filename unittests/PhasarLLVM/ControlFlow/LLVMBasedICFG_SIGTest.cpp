@@ -0,0 +1,82 @@
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/Config/Configuration.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace std;
+using namespace psr;
+
+static set<const llvm::Function *>
+getCalleesOfIndirectCalls(const LLVMBasedICFG &ICFG,
+                          const llvm::Function *F) {
+  set<const llvm::Function *> Callees;
+  for (const auto &I : llvm::instructions(F)) {
+    if (ICFG.isIndirectFunctionCall(&I)) {
+      auto CalleesOfCallAt = ICFG.getCalleesOfCallAt(&I);
+      Callees.insert(CalleesOfCallAt.begin(), CalleesOfCallAt.end());
+    }
+  }
+  return Callees;
+}
+
+TEST(LLVMBasedICFG_SIGTest, FunctionPointer_1) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/function_pointer_1_c.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::SIG, {"main"}, &TH);
+  const llvm::Function *Main = IRDB.getFunctionDefinition("main");
+  const llvm::Function *Bar = IRDB.getFunctionDefinition("bar");
+  ASSERT_TRUE(Main);
+  ASSERT_TRUE(Bar);
+  // foo and main have the same type as bar, but their address is not taken
+  EXPECT_EQ(getCalleesOfIndirectCalls(ICFG, Main),
+            set<const llvm::Function *>({Bar}));
+}
+
+TEST(LLVMBasedICFG_SIGTest, FunctionPointer_3) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/function_pointer_3_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::SIG, {"main"}, &TH);
+  const llvm::Function *Main = IRDB.getFunctionDefinition("main");
+  const llvm::Function *Foo = IRDB.getFunctionDefinition("_Z3foov");
+  ASSERT_TRUE(Main);
+  ASSERT_TRUE(Foo);
+  // the address of bar is taken, too, but bar is only called after a cast to
+  // a different function type, which is not followed
+  EXPECT_EQ(getCalleesOfIndirectCalls(ICFG, Main),
+            set<const llvm::Function *>({Foo}));
+}
+
+TEST(LLVMBasedICFG_SIGTest, VirtualCallsAsCHA) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/virtual_call_7_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG CHAICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH);
+  LLVMBasedICFG SIGICFG(IRDB, CallGraphAnalysisType::SIG, {"main"}, &TH);
+  const llvm::Function *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_TRUE(Main);
+  for (const auto &I : llvm::instructions(Main)) {
+    if (SIGICFG.isVirtualFunctionCall(&I)) {
+      EXPECT_EQ(SIGICFG.getCalleesOfCallAt(&I), CHAICFG.getCalleesOfCallAt(&I));
+    }
+  }
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
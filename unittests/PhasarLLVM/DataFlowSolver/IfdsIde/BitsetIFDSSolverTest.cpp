@@ -0,0 +1,111 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BitsetIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+using Findings_t = std::map<const llvm::Instruction *,
+                            std::set<const llvm::Value *>>;
+
+Findings_t getFindings(const IFDSTaintAnalysis &Problem) {
+  return Problem.Leaks;
+}
+
+Findings_t getFindings(const IFDSUninitializedVariables &Problem) {
+  return Problem.getAllUndefUses();
+}
+
+} // namespace
+
+/* ============== TEST FIXTURE ============== */
+class BitsetIFDSSolverTest : public ::testing::Test {
+protected:
+  const std::set<std::string> EntryPoints = {"main"};
+  TaintConfiguration<const llvm::Value *> TSF{
+      {TaintConfiguration<const llvm::Value *>::SourceFunction("source()",
+                                                               true)},
+      {TaintConfiguration<const llvm::Value *>::SinkFunction(
+          "sink(int)", std::vector<unsigned>({0}))}};
+
+  using RawResults_t =
+      std::map<const llvm::Instruction *, std::set<const llvm::Value *>>;
+
+  void SetUp() override { boost::log::core::get()->set_logging_enabled(false); }
+
+  template <typename ProblemTy, typename... ArgTys>
+  void compareResults(const std::string &LlvmFilePath, ArgTys &...Args) {
+    ProjectIRDB IRDB({unittest::PathToLLTestFiles + LlvmFilePath},
+                     IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    // the problems record their findings, so each solver gets its own
+    ProblemTy Problem(&IRDB, &TH, &ICFG, &PT, Args..., EntryPoints);
+    IFDSSolver_P<ProblemTy> Solver(Problem);
+    Solver.solve();
+    ProblemTy BitsetProblem(&IRDB, &TH, &ICFG, &PT, Args..., EntryPoints);
+    BitsetIFDSSolver_P<ProblemTy> BitsetSolver(BitsetProblem);
+    BitsetSolver.solve();
+
+    RawResults_t Results;
+    RawResults_t BitsetResults;
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        Results[&I] = Solver.ifdsResultsAt(&I);
+        BitsetResults[&I] = BitsetSolver.ifdsResultsAt(&I);
+      }
+    }
+    EXPECT_FALSE(Results.empty());
+    EXPECT_EQ(Results, BitsetResults);
+    EXPECT_EQ(getFindings(Problem), getFindings(BitsetProblem));
+  }
+}; // Test Fixture
+
+TEST_F(BitsetIFDSSolverTest, SameResultsForTaint) {
+  compareResults<IFDSTaintAnalysis>(
+      "taint_analysis/dummy_source_sink/taint_04_cpp_dbg.ll", TSF);
+}
+
+TEST_F(BitsetIFDSSolverTest, SameResultsForTaintM2R) {
+  compareResults<IFDSTaintAnalysis>(
+      "taint_analysis/dummy_source_sink/taint_06_cpp_m2r_dbg.ll", TSF);
+}
+
+TEST_F(BitsetIFDSSolverTest, SameResultsForUninitializedVariables) {
+  compareResults<IFDSUninitializedVariables>(
+      "uninitialized_variables/callnoret_c_dbg.ll");
+}
+
+TEST_F(BitsetIFDSSolverTest, SameResultsForUninitializedVariablesBinop) {
+  compareResults<IFDSUninitializedVariables>(
+      "uninitialized_variables/binop_uninit_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGRecordFile.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+
+#include "LCASolverConfigTest.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class ESGRecordFileTest : public unittest::LCASolverConfigTest {
+protected:
+  const std::string RecordFile =
+      (boost::filesystem::temp_directory_path() /
+       boost::filesystem::unique_path("phasar-%%%%-%%%%.esg"))
+          .string();
+
+  void TearDown() override { boost::filesystem::remove(RecordFile); }
+
+  RawResults_t doAnalysis(ProjectIRDB &IRDB, bool Stream, std::string &ESG) {
+    return LCASolverConfigTest::doAnalysis(
+        IRDB,
+        [&](IFDSIDESolverConfig &Config) {
+          Config.setEmitESG();
+          if (Stream) {
+            Config.setESGRecordFile(RecordFile);
+          }
+        },
+        [&](LCASolver_t &LCASolver) {
+          std::stringstream OS;
+          LCASolver.emitESGAsDot(OS);
+          ESG = OS.str();
+        });
+  }
+
+  void compareResults(const std::string &LlvmFilePath) {
+    ProjectIRDB IRDB({PathToLlFiles + LlvmFilePath}, IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    std::string ESG;
+    std::string StreamedESG;
+    auto Results = doAnalysis(IRDB, false, ESG);
+    auto StreamedResults = doAnalysis(IRDB, true, StreamedESG);
+    EXPECT_FALSE(Results.empty());
+    EXPECT_EQ(Results, StreamedResults);
+    EXPECT_EQ(ESG, StreamedESG);
+    EXPECT_GT(boost::filesystem::file_size(RecordFile), 0U);
+  }
+}; // Test Fixture
+
+TEST_F(ESGRecordFileTest, RoundTrip) {
+  ESGRecordFile<int, int> Records(RecordFile);
+  Records.recordPathEdges(1, 2, 0, std::set<int>{0, 10}, false);
+  Records.recordPathEdges(1, 2, 0, std::set<int>{20}, false);
+  Records.recordPathEdges(2, 3, 10, std::set<int>{}, true);
+  Records.recordEdgeFunction(1, 0, 2, 10, "EdgeIdentity");
+  Records.recordEdgeFunction(1, 0, 2, 10, "AllBottom");
+  EXPECT_EQ(Records.getNumRecords(), 5U);
+
+  ESGRecordFile<int, int>::PathEdgeTable<std::set<int>> IntraPathEdges;
+  ESGRecordFile<int, int>::PathEdgeTable<std::set<int>> InterPathEdges;
+  Records.readPathEdges(IntraPathEdges, InterPathEdges);
+  EXPECT_EQ(IntraPathEdges.get(1, 2).at(0), std::set<int>({0, 10, 20}));
+  ASSERT_TRUE(InterPathEdges.contains(2, 3));
+  EXPECT_TRUE(InterPathEdges.get(2, 3).at(10).empty());
+  EXPECT_FALSE(InterPathEdges.contains(1, 2));
+
+  std::vector<std::tuple<bool, int, int, int, std::set<int>>> PathEdges;
+  std::vector<std::string> Labels;
+  Records.forEachRecord(
+      [&](bool InterP, int Source, int Sink, int SourceVal,
+          const auto &DestVals) {
+        PathEdges.emplace_back(InterP, Source, Sink, SourceVal,
+                               std::set<int>(DestVals.begin(), DestVals.end()));
+      },
+      [&](int N1, int D1, int N2, int D2, llvm::StringRef Label) {
+        EXPECT_EQ(std::make_tuple(N1, D1, N2, D2),
+                  std::make_tuple(1, 0, 2, 10));
+        Labels.push_back(Label.str());
+      });
+  ASSERT_EQ(PathEdges.size(), 3U);
+  EXPECT_EQ(PathEdges[0],
+            std::make_tuple(false, 1, 2, 0, std::set<int>({0, 10})));
+  EXPECT_EQ(PathEdges[2], std::make_tuple(true, 2, 3, 10, std::set<int>()));
+  EXPECT_EQ(Labels, std::vector<std::string>({"EdgeIdentity", "AllBottom"}));
+  EXPECT_EQ(Records.getRecordedFacts(), std::set<int>({0, 10, 20}));
+}
+
+TEST_F(ESGRecordFileTest, SameResultsForCalls) {
+  compareResults("call_07_cpp_dbg.ll");
+}
+
+TEST_F(ESGRecordFileTest, SameResultsForRecursion) {
+  compareResults("recursion_01_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionInterner.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+#include "LCASolverConfigTest.h"
+
+using namespace psr;
+
+namespace {
+
+// adds a constant to its argument
+class AddConstant : public EdgeFunction<int>,
+                    public std::enable_shared_from_this<AddConstant> {
+public:
+  const int Constant;
+
+  explicit AddConstant(int Constant) : Constant(Constant) {}
+
+  int computeTarget(int Source) override { return Source + Constant; }
+
+  std::shared_ptr<EdgeFunction<int>>
+  composeWith(std::shared_ptr<EdgeFunction<int>> SecondFunction) override {
+    ++NumCompositions;
+    if (auto *AC = dynamic_cast<AddConstant *>(SecondFunction.get())) {
+      return std::make_shared<AddConstant>(Constant + AC->Constant);
+    }
+    return SecondFunction;
+  }
+
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> OtherFunction) override {
+    if (equal_to(OtherFunction)) {
+      return shared_from_this();
+    }
+    return std::make_shared<AllBottom<int>>(-1);
+  }
+
+  bool equal_to(std::shared_ptr<EdgeFunction<int>> Other) const override {
+    if (auto *AC = dynamic_cast<AddConstant *>(Other.get())) {
+      return AC->Constant == Constant;
+    }
+    return false;
+  }
+
+  size_t hash() const override { return std::hash<int>{}(Constant); }
+
+  static inline unsigned NumCompositions = 0;
+};
+
+} // namespace
+
+TEST(EdgeFunctionInterner, InternsEqualFunctions) {
+  EdgeFunctionInterner<int> Interner;
+  auto A = Interner.intern(std::make_shared<AddConstant>(1));
+  auto B = Interner.intern(std::make_shared<AddConstant>(1));
+  auto C = Interner.intern(std::make_shared<AddConstant>(2));
+  EXPECT_EQ(A, B);
+  EXPECT_NE(A, C);
+  EXPECT_EQ(Interner.intern(EdgeIdentity<int>::getInstance()),
+            EdgeIdentity<int>::getInstance());
+  EXPECT_EQ(Interner.size(), 3U);
+}
+
+TEST(EdgeFunctionInterner, MemoizesCompositions) {
+  EdgeFunctionInterner<int> Interner;
+  AddConstant::NumCompositions = 0;
+  auto AB = Interner.compose(std::make_shared<AddConstant>(1),
+                             std::make_shared<AddConstant>(2));
+  auto AB2 = Interner.compose(std::make_shared<AddConstant>(1),
+                              std::make_shared<AddConstant>(2));
+  EXPECT_EQ(AB, AB2);
+  EXPECT_EQ(AddConstant::NumCompositions, 1U);
+  // structurally equal results are canonicalized as well
+  EXPECT_EQ(Interner.compose(std::make_shared<AddConstant>(2),
+                             std::make_shared<AddConstant>(1)),
+            AB);
+  EXPECT_EQ(AB->computeTarget(0), 3);
+}
+
+TEST(EdgeFunctionInterner, MemoizesJoins) {
+  EdgeFunctionInterner<int> Interner;
+  auto A = std::make_shared<AddConstant>(1);
+  auto J1 = Interner.join(A, std::make_shared<AddConstant>(2));
+  auto J2 = Interner.join(A, std::make_shared<AddConstant>(2));
+  EXPECT_EQ(J1, J2);
+  EXPECT_EQ(J1->computeTarget(0), -1);
+  EXPECT_EQ(Interner.join(A, std::make_shared<AddConstant>(1)),
+            Interner.intern(A));
+}
+
+/* ============== TEST FIXTURE ============== */
+class EdgeFunctionInterningTest : public unittest::LCASolverConfigTest {
+protected:
+  void compareResults(const std::string &LlvmFilePath) {
+    compareConfigs(
+        LlvmFilePath,
+        {[](auto &Config) { Config.setInternEdgeFunctions(false); },
+         [](auto &Config) { Config.setInternEdgeFunctions(true); }});
+  }
+}; // Test Fixture
+
+TEST_F(EdgeFunctionInterningTest, SameResultsForBranches) {
+  compareResults("branch_07_cpp_dbg.ll");
+}
+
+TEST_F(EdgeFunctionInterningTest, SameResultsForCalls) {
+  compareResults("call_10_cpp_dbg.ll");
+}
+
+TEST_F(EdgeFunctionInterningTest, SameResultsForRecursion) {
+  compareResults("recursion_03_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
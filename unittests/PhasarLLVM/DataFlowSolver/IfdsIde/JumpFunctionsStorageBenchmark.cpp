@@ -0,0 +1,129 @@
+// Micro benchmark of the jump-function storages. It replaces the global
+// operator new and delete to measure the memory footprint, hence it is built
+// as a binary of its own and only if PHASAR_BUILD_BENCHMARKS is set.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FlatJumpFunctionsStorage.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctionsStorage.h"
+
+using namespace psr;
+
+// the number of bytes currently allocated through operator new, which is
+// replaced to compare the memory footprint of the storages
+static std::atomic<size_t> AllocatedBytes{0};
+
+void *operator new(size_t Size) {
+  // each allocation is prefixed with its size, keeping the default alignment
+  auto *Ptr =
+      static_cast<char *>(std::malloc(Size + alignof(std::max_align_t)));
+  if (!Ptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<size_t *>(Ptr) = Size;
+  AllocatedBytes += Size;
+  return Ptr + alignof(std::max_align_t);
+}
+
+void operator delete(void *Ptr) noexcept {
+  if (Ptr) {
+    auto *Base = static_cast<char *>(Ptr) - alignof(std::max_align_t);
+    AllocatedBytes -= *reinterpret_cast<size_t *>(Base);
+    std::free(Base);
+  }
+}
+
+namespace {
+
+struct IntDomain {
+  using n_t = int;
+  using d_t = int;
+  using l_t = int;
+};
+
+template <typename StorageTy>
+class JumpFunctionsStorageBenchmark : public ::testing::Test {
+protected:
+  std::shared_ptr<EdgeFunction<int>> Identity =
+      EdgeIdentity<int>::getInstance();
+};
+
+using StorageTypes = ::testing::Types<NestedJumpFunctionsStorage<IntDomain>,
+                                      FlatJumpFunctionsStorage<IntDomain>>;
+TYPED_TEST_SUITE(JumpFunctionsStorageBenchmark, StorageTypes);
+
+} // namespace
+
+// compares the memory footprint and the throughput of the storages on a
+// synthetic workload
+TYPED_TEST(JumpFunctionsStorageBenchmark, SyntheticWorkload) {
+  constexpr int NumNodes = 20000;
+  constexpr int NumFacts = 2000;
+  constexpr int TargetValsPerNode = 8;
+  constexpr int SourceValsPerTarget = 4;
+  constexpr size_t NumFunctions =
+      size_t(NumNodes) * TargetValsPerNode * SourceValsPerTarget;
+  auto forEachFunction = [](auto Fn) {
+    for (int N = 0; N < NumNodes; ++N) {
+      for (int I = 0; I < TargetValsPerNode; ++I) {
+        int TargetVal = (N * 7 + I * 13) % NumFacts;
+        for (int J = 0; J < SourceValsPerTarget; ++J) {
+          Fn((TargetVal * 31 + J * 17) % NumFacts, N, TargetVal);
+        }
+      }
+    }
+  };
+  auto Measure = [](auto Fn) {
+    auto Start = std::chrono::steady_clock::now();
+    Fn();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - Start)
+        .count();
+  };
+  size_t BytesBefore = AllocatedBytes;
+  auto Storage = std::make_unique<TypeParam>();
+  auto AddMs = Measure([&] {
+    forEachFunction([&](int SourceVal, int Target, int TargetVal) {
+      Storage->addFunction(SourceVal, Target, TargetVal, this->Identity);
+    });
+  });
+  size_t Bytes = AllocatedBytes - BytesBefore;
+  size_t NumReverse = 0;
+  size_t NumForward = 0;
+  auto LookupMs = Measure([&] {
+    forEachFunction([&](int SourceVal, int Target, int TargetVal) {
+      NumReverse += Storage->reverseLookup(Target, TargetVal)->size();
+      NumForward += Storage->forwardLookup(SourceVal, Target)->size();
+    });
+  });
+  size_t NumByTarget = 0;
+  auto ByTargetMs = Measure([&] {
+    for (int N = 0; N < NumNodes; ++N) {
+      NumByTarget += Storage->lookupByTarget(N).cellSet().size();
+    }
+  });
+  std::cout << ::testing::UnitTest::GetInstance()
+                   ->current_test_info()
+                   ->type_param()
+            << ":\n  memory:           " << Bytes / 1024 << " KiB\n"
+            << "  add:              " << AddMs << " ms\n"
+            << "  reverse/forward:  " << LookupMs << " ms\n"
+            << "  by target:        " << ByTargetMs << " ms\n";
+  EXPECT_EQ(NumReverse, NumFunctions * SourceValsPerTarget);
+  EXPECT_GE(NumForward, NumFunctions);
+  EXPECT_EQ(NumByTarget, NumFunctions);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FlatJumpFunctionsStorage.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctionsStorage.h"
+
+#include "LCASolverConfigTest.h"
+
+using namespace psr;
+
+namespace {
+
+struct IntDomain {
+  using n_t = int;
+  using d_t = int;
+  using l_t = int;
+};
+
+template <typename StorageTy>
+class JumpFunctionsStorageTest : public ::testing::Test {
+protected:
+  StorageTy Storage;
+  std::shared_ptr<EdgeFunction<int>> Identity =
+      EdgeIdentity<int>::getInstance();
+  std::shared_ptr<EdgeFunction<int>> Bottom =
+      std::make_shared<AllBottom<int>>(0);
+};
+
+using StorageTypes = ::testing::Types<NestedJumpFunctionsStorage<IntDomain>,
+                                      FlatJumpFunctionsStorage<IntDomain>>;
+TYPED_TEST_SUITE(JumpFunctionsStorageTest, StorageTypes);
+
+} // namespace
+
+TYPED_TEST(JumpFunctionsStorageTest, LookupsAgree) {
+  // jump functions <D1> --> <N, D2>
+  this->Storage.addFunction(0, 10, 1, this->Identity);
+  this->Storage.addFunction(0, 10, 2, this->Identity);
+  this->Storage.addFunction(3, 10, 2, this->Bottom);
+  this->Storage.addFunction(0, 20, 1, this->Identity);
+
+  auto *Rev = this->Storage.reverseLookup(10, 2);
+  ASSERT_NE(Rev, nullptr);
+  EXPECT_EQ(Rev->size(), 2U);
+  auto *Fwd = this->Storage.forwardLookup(0, 10);
+  ASSERT_NE(Fwd, nullptr);
+  EXPECT_EQ(Fwd->size(), 2U);
+  EXPECT_EQ(this->Storage.reverseLookup(20, 2), nullptr);
+  EXPECT_EQ(this->Storage.forwardLookup(3, 20), nullptr);
+
+  auto ByTarget = this->Storage.lookupByTarget(10);
+  EXPECT_EQ(ByTarget.cellSet().size(), 3U);
+  EXPECT_EQ(ByTarget.get(3, 2), this->Bottom);
+  EXPECT_TRUE(this->Storage.lookupByTarget(30).empty());
+}
+
+TYPED_TEST(JumpFunctionsStorageTest, OverwritesFunctions) {
+  this->Storage.addFunction(0, 10, 1, this->Identity);
+  this->Storage.addFunction(0, 10, 1, this->Bottom);
+  auto *Rev = this->Storage.reverseLookup(10, 1);
+  ASSERT_NE(Rev, nullptr);
+  ASSERT_EQ(Rev->size(), 1U);
+  EXPECT_EQ(Rev->front().second, this->Bottom);
+  EXPECT_EQ(this->Storage.lookupByTarget(10).get(0, 1), this->Bottom);
+}
+
+TYPED_TEST(JumpFunctionsStorageTest, RemovesFunctions) {
+  this->Storage.addFunction(0, 10, 1, this->Identity);
+  this->Storage.addFunction(2, 10, 1, this->Identity);
+  EXPECT_TRUE(this->Storage.removeFunction(0, 10, 1));
+  auto *Rev = this->Storage.reverseLookup(10, 1);
+  ASSERT_NE(Rev, nullptr);
+  EXPECT_EQ(Rev->size(), 1U);
+  this->Storage.clear();
+  EXPECT_EQ(this->Storage.reverseLookup(10, 1), nullptr);
+  EXPECT_TRUE(this->Storage.lookupByTarget(10).empty());
+}
+
+TYPED_TEST(JumpFunctionsStorageTest, RemovesFunctionsAtTarget) {
+  this->Storage.addFunction(0, 10, 1, this->Identity);
+  this->Storage.addFunction(0, 10, 2, this->Identity);
+  this->Storage.addFunction(3, 10, 2, this->Bottom);
+  this->Storage.addFunction(0, 20, 1, this->Identity);
+  EXPECT_EQ(this->Storage.removeFunctionsAt(10), 3U);
+  EXPECT_EQ(this->Storage.removeFunctionsAt(10), 0U);
+  EXPECT_EQ(this->Storage.reverseLookup(10, 2), nullptr);
+  EXPECT_EQ(this->Storage.forwardLookup(0, 10), nullptr);
+  EXPECT_TRUE(this->Storage.lookupByTarget(10).empty());
+  // the jump functions into other targets are kept
+  auto *Fwd = this->Storage.forwardLookup(0, 20);
+  ASSERT_NE(Fwd, nullptr);
+  EXPECT_EQ(Fwd->size(), 1U);
+  // removed targets can be filled again
+  this->Storage.addFunction(3, 10, 1, this->Identity);
+  EXPECT_EQ(this->Storage.lookupByTarget(10).get(3, 1), this->Identity);
+}
+
+/* ============== TEST FIXTURE ============== */
+class JumpFunctionsKindTest : public unittest::LCASolverConfigTest {
+protected:
+  static ConfigureFn useKind(JumpFunctionsKind JFK, bool Collect = false) {
+    return [JFK, Collect](IFDSIDESolverConfig &Config) {
+      Config.setJumpFunctionsKind(JFK);
+      Config.setCollectJumpFunctions(Collect);
+    };
+  }
+
+  void compareKinds(const std::string &LlvmFilePath) {
+    compareConfigs(LlvmFilePath, {useKind(JumpFunctionsKind::Nested),
+                                  useKind(JumpFunctionsKind::Flat)});
+  }
+
+  void compareCollected(const std::string &LlvmFilePath) {
+    compareConfigs(LlvmFilePath, {useKind(JumpFunctionsKind::Nested),
+                                  useKind(JumpFunctionsKind::Nested, true),
+                                  useKind(JumpFunctionsKind::Flat, true)});
+  }
+}; // Test Fixture
+
+TEST_F(JumpFunctionsKindTest, SameResultsForCalls) {
+  compareKinds("call_07_cpp_dbg.ll");
+}
+
+TEST_F(JumpFunctionsKindTest, SameResultsForRecursion) {
+  compareKinds("recursion_01_cpp_dbg.ll");
+}
+
+TEST_F(JumpFunctionsKindTest, SameResultsWithCollectionForCalls) {
+  compareCollected("call_10_cpp_dbg.ll");
+}
+
+TEST_F(JumpFunctionsKindTest, SameResultsWithCollectionForLoops) {
+  compareCollected("while_04_cpp_dbg.ll");
+}
+
+TEST_F(JumpFunctionsKindTest, SameResultsWithCollectionForRecursion) {
+  compareCollected("recursion_03_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/WorkStealingPool.h"
+
+#include "LCASolverConfigTest.h"
+#include "TestConfig.h"
+
+using namespace psr;
+
+TEST(WorkStealingPoolTest, ProcessesDiscoveredItems) {
+  WorkStealingPool<unsigned> Pool(4);
+  std::atomic<unsigned> Processed{0};
+  Pool.push(0);
+  Pool.run([&](unsigned Depth) {
+    ++Processed;
+    // every item below depth 10 spawns two new items
+    if (Depth < 10) {
+      Pool.push(Depth + 1);
+      Pool.push(Depth + 1);
+    }
+  });
+  EXPECT_EQ(Processed.load(), 2047U);
+  EXPECT_TRUE(Pool.empty());
+}
+
+TEST(WorkStealingPoolTest, RethrowsHandlerException) {
+  WorkStealingPool<int> Pool(4);
+  for (int I = 0; I < 100; ++I) {
+    Pool.push(I);
+  }
+  auto Handler = [](int I) {
+    if (I == 42) {
+      throw std::runtime_error("failed");
+    }
+  };
+  EXPECT_THROW(Pool.run(Handler), std::runtime_error);
+  EXPECT_TRUE(Pool.empty());
+}
+
+/* ============== TEST FIXTURE ============== */
+class ParallelIDESolverTest : public unittest::LCASolverConfigTest {
+protected:
+  using TaintResults_t = std::map<const llvm::Instruction *,
+                                  std::set<const llvm::Value *>>;
+
+  TaintResults_t doTaint(ProjectIRDB &IRDB, unsigned NumThreads) {
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    TaintConfiguration<const llvm::Value *> TSF(
+        {TaintConfiguration<const llvm::Value *>::SourceFunction("source()",
+                                                                 true)},
+        {TaintConfiguration<const llvm::Value *>::SinkFunction(
+            "sink(int)", std::vector<unsigned>({0}))});
+    IFDSTaintAnalysis TaintProblem(&IRDB, &TH, &ICFG, &PT, TSF, EntryPoints);
+    TaintProblem.getIFDSIDESolverConfig().setNumThreads(NumThreads);
+    IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(TaintProblem);
+    TaintSolver.solve();
+    return {TaintProblem.Leaks.begin(), TaintProblem.Leaks.end()};
+  }
+
+  void compareLCA(const std::string &LlvmFilePath) {
+    compareConfigs(LlvmFilePath,
+                   {[](auto &Config) { Config.setNumThreads(1); },
+                    [](auto &Config) { Config.setNumThreads(4); }});
+  }
+
+  void compareTaint(const std::string &LlvmFilePath) {
+    ProjectIRDB IRDB(
+        {unittest::PathToLLTestFiles + "taint_analysis/" + LlvmFilePath},
+        IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    auto SequentialLeaks = doTaint(IRDB, 1);
+    auto ParallelLeaks = doTaint(IRDB, 4);
+    EXPECT_FALSE(SequentialLeaks.empty());
+    EXPECT_EQ(SequentialLeaks, ParallelLeaks);
+  }
+}; // Test Fixture
+
+TEST_F(ParallelIDESolverTest, LCASameResultsForCalls) {
+  compareLCA("call_07_cpp_dbg.ll");
+}
+
+TEST_F(ParallelIDESolverTest, LCASameResultsForLoops) {
+  compareLCA("while_02_cpp_dbg.ll");
+}
+
+TEST_F(ParallelIDESolverTest, LCASameResultsForRecursion) {
+  compareLCA("recursion_01_cpp_dbg.ll");
+}
+
+TEST_F(ParallelIDESolverTest, TaintSameLeaks) {
+  compareTaint("dummy_source_sink/taint_01_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,69 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+
+#include "LCASolverConfigTest.h"
+
+using namespace psr;
+
+TEST(PathEdgeWorklistTest, FIFOOrder) {
+  FIFOPathEdgeWorklist<int, int> WL;
+  WL.push(PathEdge<int, int>(0, 1, 10));
+  WL.push(PathEdge<int, int>(0, 2, 20));
+  WL.push(PathEdge<int, int>(0, 3, 30));
+  EXPECT_EQ(WL.size(), 3U);
+  EXPECT_EQ(WL.pop().getTarget(), 1);
+  EXPECT_EQ(WL.pop().getTarget(), 2);
+  EXPECT_EQ(WL.pop().factAtTarget(), 30);
+  EXPECT_TRUE(WL.empty());
+}
+
+TEST(PathEdgeWorklistTest, LIFOOrder) {
+  LIFOPathEdgeWorklist<int, int> WL;
+  WL.push(PathEdge<int, int>(0, 1, 10));
+  WL.push(PathEdge<int, int>(0, 2, 20));
+  WL.push(PathEdge<int, int>(0, 3, 30));
+  EXPECT_EQ(WL.size(), 3U);
+  EXPECT_EQ(WL.pop().getTarget(), 3);
+  EXPECT_EQ(WL.pop().getTarget(), 2);
+  EXPECT_EQ(WL.pop().factAtTarget(), 10);
+  EXPECT_TRUE(WL.empty());
+}
+
+/* ============== TEST FIXTURE ============== */
+class PathEdgeWorklistSolverTest : public unittest::LCASolverConfigTest {
+protected:
+  void compareWorklists(const std::string &LlvmFilePath) {
+    compareConfigs(LlvmFilePath,
+                   {[](auto &Config) {
+                      Config.setWorklistKind(WorklistKind::LIFO);
+                    },
+                    [](auto &Config) {
+                      Config.setWorklistKind(WorklistKind::FIFO);
+                    },
+                    [](auto &Config) {
+                      Config.setWorklistKind(WorklistKind::ReversePostOrder);
+                    }});
+  }
+}; // Test Fixture
+
+TEST_F(PathEdgeWorklistSolverTest, SameResultsForCalls) {
+  compareWorklists("call_07_cpp_dbg.ll");
+}
+
+TEST_F(PathEdgeWorklistSolverTest, SameResultsForLoops) {
+  compareWorklists("while_02_cpp_dbg.ll");
+}
+
+TEST_F(PathEdgeWorklistSolverTest, SameResultsForRecursion) {
+  compareWorklists("recursion_01_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
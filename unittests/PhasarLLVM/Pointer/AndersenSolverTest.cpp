@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include <set>
+#include <vector>
+
+#include "phasar/PhasarLLVM/Pointer/AndersenSolver.h"
+
+using namespace psr;
+
+using IdTy = AndersenSolver::IdTy;
+
+static std::set<IdTy> getPts(AndersenSolver &Solver, IdTy N) {
+  std::set<IdTy> Pts;
+  for (auto Location : Solver.getPointsToSet(N)) {
+    Pts.insert(Location);
+  }
+  return Pts;
+}
+
+TEST(AndersenSolver, LoadsAndStores) {
+  AndersenSolver Solver;
+  IdTy A = Solver.addObject({0});
+  IdTy B = Solver.addObject({0});
+  IdTy P = Solver.addNode();
+  IdTy Q = Solver.addNode();
+  IdTy R = Solver.addNode();
+  IdTy S = Solver.addNode();
+  // p = &a; q = &b; *p = q; r = *p; s = r
+  Solver.addAddressOf(P, A);
+  Solver.addAddressOf(Q, B);
+  Solver.addStore(P, Q);
+  Solver.addLoad(R, P);
+  Solver.addCopy(S, R);
+  Solver.solve();
+  EXPECT_EQ(getPts(Solver, A), std::set<IdTy>({B}));
+  EXPECT_EQ(getPts(Solver, R), std::set<IdTy>({B}));
+  EXPECT_EQ(getPts(Solver, S), std::set<IdTy>({B}));
+  EXPECT_TRUE(getPts(Solver, B).empty());
+}
+
+TEST(AndersenSolver, FieldSensitivity) {
+  AndersenSolver Solver;
+  // struct { int *f0; int *f8; } s;
+  IdTy S = Solver.addObject({0, 8});
+  IdTy X = Solver.addObject({0});
+  IdTy Y = Solver.addObject({0});
+  IdTy PS = Solver.addNode();
+  IdTy F0 = Solver.addNode();
+  IdTy F8 = Solver.addNode();
+  IdTy PX = Solver.addNode();
+  IdTy PY = Solver.addNode();
+  IdTy L0 = Solver.addNode();
+  IdTy L8 = Solver.addNode();
+  IdTy Any = Solver.addNode();
+  Solver.addAddressOf(PS, S);
+  Solver.addOffset(F0, PS, 0);
+  Solver.addOffset(F8, PS, 8);
+  Solver.addOffset(Any, PS, AndersenSolver::AnyField);
+  Solver.addAddressOf(PX, X);
+  Solver.addAddressOf(PY, Y);
+  Solver.addStore(F0, PX);
+  Solver.addStore(F8, PY);
+  Solver.addLoad(L0, F0);
+  Solver.addLoad(L8, F8);
+  Solver.solve();
+  EXPECT_EQ(getPts(Solver, F8), std::set<IdTy>({S + 1}));
+  EXPECT_EQ(getPts(Solver, L0), std::set<IdTy>({X}));
+  EXPECT_EQ(getPts(Solver, L8), std::set<IdTy>({Y}));
+  EXPECT_EQ(getPts(Solver, Any), std::set<IdTy>({S, S + 1}));
+  EXPECT_EQ(Solver.getObjectBase(S + 1), S);
+}
+
+TEST(AndersenSolver, ArraysAndUnknownOffsets) {
+  AndersenSolver Solver;
+  // struct { int *f0; int *f8; } a[4];
+  IdTy A = Solver.addObject({0, 8}, 16);
+  IdTy PA = Solver.addNode();
+  IdTy Elem = Solver.addNode();
+  IdTy Punned = Solver.addNode();
+  Solver.addAddressOf(PA, A);
+  // &a[3].f8
+  Solver.addOffset(Elem, PA, 3 * 16 + 8);
+  Solver.addOffset(Punned, Elem, 4);
+  Solver.solve();
+  EXPECT_EQ(getPts(Solver, Elem), std::set<IdTy>({A + 1}));
+  EXPECT_EQ(getPts(Solver, Punned), std::set<IdTy>({A, A + 1}));
+}
+
+TEST(AndersenSolver, CyclesAreCollapsed) {
+  AndersenSolver Solver;
+  IdTy O = Solver.addObject({0});
+  std::vector<IdTy> Chain;
+  for (unsigned Idx = 0; Idx < 100; ++Idx) {
+    Chain.push_back(Solver.addNode());
+  }
+  for (unsigned Idx = 0; Idx < Chain.size(); ++Idx) {
+    Solver.addCopy(Chain[(Idx + 1) % Chain.size()], Chain[Idx]);
+  }
+  Solver.addAddressOf(Chain[42], O);
+  Solver.solve();
+  for (auto N : Chain) {
+    EXPECT_EQ(getPts(Solver, N), std::set<IdTy>({O}));
+    EXPECT_EQ(Solver.find(N), Solver.find(Chain.front()));
+  }
+  EXPECT_EQ(Solver.getNumCollapsedNodes(), Chain.size() - 1);
+  // constraints can still be added to collapsed nodes
+  IdTy P = Solver.addObject({0});
+  Solver.addAddressOf(Chain[7], P);
+  Solver.solve();
+  EXPECT_EQ(getPts(Solver, Chain[99]), std::set<IdTy>({O, P}));
+}
+
+TEST(AndersenSolver, IndirectCalls) {
+  AndersenSolver Solver;
+  IdTy Fun = Solver.addObject({0});
+  IdTy Formal = Solver.addNode();
+  IdTy Actual = Solver.addNode();
+  IdTy Arg = Solver.addObject({0});
+  IdTy FP = Solver.addNode();
+  IdTy FPSlot = Solver.addObject({0});
+  IdTy PSlot = Solver.addNode();
+  IdTy Callee = Solver.addNode();
+  Solver.setIndirectCallHandler([&](uint32_t CallId, IdTy Location) {
+    EXPECT_EQ(CallId, 7U);
+    if (Location == Fun) {
+      Solver.addCopy(Formal, Actual);
+    }
+  });
+  // fp = &fun; *slot = fp; callee = *slot; callee(&arg)
+  Solver.addAddressOf(FP, Fun);
+  Solver.addAddressOf(PSlot, FPSlot);
+  Solver.addStore(PSlot, FP);
+  Solver.addLoad(Callee, PSlot);
+  Solver.addIndirectCall(Callee, 7);
+  Solver.addAddressOf(Actual, Arg);
+  Solver.solve();
+  EXPECT_EQ(getPts(Solver, Formal), std::set<IdTy>({Arg}));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/ValueSymbolTable.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAndersenPointsToSet.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+static const llvm::Value *getValue(const llvm::Function *F,
+                                   const std::string &Name) {
+  return F->getValueSymbolTable()->lookup(Name);
+}
+
+static const llvm::Value *getCallTo(const llvm::Function *F,
+                                    const std::string &Callee) {
+  for (const auto &I : llvm::instructions(F)) {
+    if (const auto *Call = llvm::dyn_cast<llvm::CallInst>(&I)) {
+      if (Call->getCalledFunction() &&
+          Call->getCalledFunction()->getName() == Callee) {
+        return Call;
+      }
+    }
+  }
+  return nullptr;
+}
+
+TEST(LLVMAndersenPointsToSet, InterProcedural) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  LLVMAndersenPointsToSet PTS(IRDB);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *SetInteger = IRDB.getFunctionDefinition("_Z10setIntegerPi");
+  ASSERT_TRUE(Main && SetInteger);
+  const auto *X = SetInteger->arg_begin();
+  const auto *I = getValue(Main, "i");
+  const auto *P = getValue(Main, "p");
+  EXPECT_TRUE(PTS.isInterProcedural());
+  EXPECT_EQ(PTS.getReachableAllocationSites(X),
+            std::unordered_set<const llvm::Value *>({I}));
+  EXPECT_EQ(PTS.alias(X, I), AliasResult::MayAlias);
+  EXPECT_EQ(PTS.alias(X, P), AliasResult::NoAlias);
+  EXPECT_TRUE(PTS.getPointsToSet(X)->count(I));
+  EXPECT_FALSE(PTS.getPointsToSet(X)->count(P));
+}
+
+TEST(LLVMAndersenPointsToSet, HeapAllocation) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/inter_dynamic_01_cpp_dbg.ll"});
+  LLVMAndersenPointsToSet PTS(IRDB);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *Init = IRDB.getFunctionDefinition("_Z4initPi");
+  ASSERT_TRUE(Main && Init);
+  const auto *Malloc = getCallTo(Main, "malloc");
+  ASSERT_TRUE(Malloc);
+  EXPECT_EQ(PTS.getReachableAllocationSites(Init->arg_begin()),
+            std::unordered_set<const llvm::Value *>({Malloc}));
+}
+
+TEST(LLVMAndersenPointsToSet, Global) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/global_01_cpp_dbg.ll"});
+  LLVMAndersenPointsToSet PTS(IRDB);
+  const auto *Init = IRDB.getFunctionDefinition("__cxx_global_var_init");
+  const auto *Foo = IRDB.getFunctionDefinition("_Z3fooPi");
+  ASSERT_TRUE(Init && Foo);
+  const auto *New = getCallTo(Init, "_Znwm");
+  ASSERT_TRUE(New);
+  // the object is passed to foo through the global g
+  EXPECT_EQ(PTS.getReachableAllocationSites(Foo->arg_begin()),
+            std::unordered_set<const llvm::Value *>({New}));
+}
+
+TEST(LLVMAndersenPointsToSet, FieldsAndIndirectCalls) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/field_01_cpp_dbg.ll"});
+  LLVMAndersenPointsToSet PTS(IRDB);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_TRUE(Main);
+  const auto *A = getValue(Main, "a");
+  const auto *B = getValue(Main, "b");
+  // the result of the call of identity through a function pointer
+  const auto *Call = getValue(Main, "call");
+  ASSERT_TRUE(A && B && Call);
+  EXPECT_EQ(PTS.getReachableAllocationSites(Call),
+            std::unordered_set<const llvm::Value *>({A}));
+  EXPECT_EQ(PTS.alias(Call, B), AliasResult::NoAlias);
+  // the points-to set of the called value contains the callee
+  const auto *FP = llvm::cast<llvm::CallInst>(Call)->getCalledOperand();
+  EXPECT_TRUE(PTS.getPointsToSet(FP)->count(
+      IRDB.getFunctionDefinition("_Z8identityPi")));
+}
+
+TEST(LLVMAndersenPointsToSet, IntroduceAlias) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/field_01_cpp_dbg.ll"});
+  LLVMAndersenPointsToSet PTS(IRDB);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_TRUE(Main);
+  const auto *A = getValue(Main, "a");
+  const auto *B = getValue(Main, "b");
+  EXPECT_EQ(PTS.alias(A, B), AliasResult::NoAlias);
+  PTS.introduceAlias(A, B);
+  EXPECT_EQ(PTS.alias(A, B), AliasResult::MayAlias);
+  EXPECT_TRUE(PTS.getPointsToSet(A)->count(B));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
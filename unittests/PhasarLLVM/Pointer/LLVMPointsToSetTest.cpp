@@ -1,8 +1,23 @@
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
@@ -61,6 +76,231 @@ TEST(LLVMPointsToSet, Global_01) {
   std::cout << '\n';
 }
 
+TEST(LLVMPointsToSet, AliasMatchesPointsToSets) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/basic_01_cpp_dbg.ll"});
+  LLVMPointsToSet PTS(IRDB, false);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  std::vector<const llvm::Value *> Pointers;
+  for (const auto &BB : *Main) {
+    for (const auto &I : BB) {
+      if (isInterestingPointer(&I)) {
+        Pointers.push_back(&I);
+      }
+    }
+  }
+  ASSERT_GE(Pointers.size(), 2U);
+  for (const auto *P1 : Pointers) {
+    auto P1Set = PTS.getPointsToSet(P1);
+    EXPECT_TRUE(P1Set->count(P1));
+    for (const auto *P2 : Pointers) {
+      bool MustAlias = PTS.alias(P1, P2) == AliasResult::MustAlias;
+      EXPECT_EQ(MustAlias, P1Set->count(P2) == 1);
+      EXPECT_EQ(MustAlias, PTS.alias(P2, P1) == AliasResult::MustAlias);
+    }
+  }
+  // introducing an alias merges both points-to sets
+  const auto *First = Pointers.front();
+  const auto *Last = Pointers.back();
+  auto FirstSet = PTS.getPointsToSet(First);
+  auto LastSet = PTS.getPointsToSet(Last);
+  PTS.introduceAlias(First, Last);
+  EXPECT_EQ(PTS.alias(First, Last), AliasResult::MustAlias);
+  auto MergedSet = PTS.getPointsToSet(Last);
+  EXPECT_EQ(MergedSet, PTS.getPointsToSet(First));
+  for (const auto *P : *FirstSet) {
+    EXPECT_TRUE(MergedSet->count(P));
+  }
+  for (const auto *P : *LastSet) {
+    EXPECT_TRUE(MergedSet->count(P));
+  }
+}
+
+// Builds a function that contains about NumPointers pointers: each alloca is
+// accessed through a pointer into it, and every hundredth access is
+// preceded by a pointer to a global that is loaded from memory.
+static std::unique_ptr<llvm::Module>
+makeSyntheticModule(llvm::LLVMContext &Ctx, size_t NumPointers,
+                    std::vector<const llvm::Value *> &Allocas,
+                    std::vector<const llvm::Value *> &Loads) {
+  auto M = std::make_unique<llvm::Module>("synthetic", Ctx);
+  auto *Main = llvm::Function::Create(
+      llvm::FunctionType::get(llvm::Type::getVoidTy(Ctx), false),
+      llvm::Function::ExternalLinkage, "main", M.get());
+  llvm::IRBuilder<> Builder(llvm::BasicBlock::Create(Ctx, "entry", Main));
+  auto *Int32Ty = Builder.getInt32Ty();
+  auto *Global = new llvm::GlobalVariable(
+      *M, Int32Ty, false, llvm::GlobalValue::ExternalLinkage,
+      Builder.getInt32(0), "global");
+  auto *Slot = Builder.CreateAlloca(Int32Ty->getPointerTo());
+  Builder.CreateStore(Global, Slot);
+  for (size_t Idx = 1; Idx < NumPointers; Idx += 2) {
+    if (Idx % 100 == 1) {
+      auto *Loaded = Builder.CreateLoad(Int32Ty->getPointerTo(), Slot);
+      Builder.CreateStore(Builder.getInt32(Idx), Loaded);
+      Loads.push_back(Loaded);
+    }
+    auto *Alloca = Builder.CreateAlloca(Int32Ty, Builder.getInt32(2));
+    auto *GEP = Builder.CreateInBoundsGEP(Int32Ty, Alloca, Builder.getInt32(1));
+    Builder.CreateStore(Builder.getInt32(Idx), GEP);
+    Allocas.push_back(Alloca);
+  }
+  Builder.CreateRetVoid();
+  return M;
+}
+
+TEST(LLVMPointsToSet, SyntheticFunction) {
+  llvm::LLVMContext Ctx;
+  std::vector<const llvm::Value *> Allocas;
+  std::vector<const llvm::Value *> Loads;
+  auto M = makeSyntheticModule(Ctx, 400, Allocas, Loads);
+  ProjectIRDB IRDB({M.get()}, IRDBOptions::NONE);
+  LLVMPointsToSet PTS(IRDB, false);
+  ASSERT_GE(Loads.size(), 2U);
+  // pointers loaded from the same memory location may alias
+  for (const auto *Load : Loads) {
+    EXPECT_EQ(PTS.alias(Load, Loads.front()), AliasResult::MustAlias);
+  }
+  // distinct allocas never do
+  for (size_t Idx = 1; Idx < Allocas.size(); ++Idx) {
+    EXPECT_EQ(PTS.alias(Allocas[Idx - 1], Allocas[Idx]),
+              AliasResult::NoAlias);
+  }
+}
+
+static void expectSameAliases(ProjectIRDB &IRDB, LLVMPointsToSet &PTS1,
+                              LLVMPointsToSet &PTS2) {
+  for (const auto *F : IRDB.getAllFunctions()) {
+    std::vector<const llvm::Value *> Pointers;
+    for (const auto &BB : *F) {
+      for (const auto &I : BB) {
+        if (isInterestingPointer(&I)) {
+          Pointers.push_back(&I);
+        }
+      }
+    }
+    for (const auto *P1 : Pointers) {
+      EXPECT_EQ(*PTS1.getPointsToSet(P1), *PTS2.getPointsToSet(P1));
+    }
+  }
+}
+
+TEST(LLVMPointsToSet, ConcurrentMatchesSequential) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  LLVMPointsToSet Sequential(IRDB, false);
+  LLVMPointsToSet Concurrent(IRDB, false, PointerAnalysisType::CFLAnders, 4);
+  expectSameAliases(IRDB, Sequential, Concurrent);
+}
+
+TEST(LLVMPointsToSet, ConcurrentSyntheticFunction) {
+  llvm::LLVMContext Ctx;
+  std::vector<const llvm::Value *> Allocas;
+  std::vector<const llvm::Value *> Loads;
+  auto M = makeSyntheticModule(Ctx, 400, Allocas, Loads);
+  ProjectIRDB IRDB({M.get()}, IRDBOptions::NONE);
+  LLVMPointsToSet Sequential(IRDB, false);
+  LLVMPointsToSet Concurrent(IRDB, false, PointerAnalysisType::CFLAnders, 4);
+  expectSameAliases(IRDB, Sequential, Concurrent);
+}
+
+TEST(LLVMPointsToSet, QueriesFromSeveralThreads) {
+  llvm::LLVMContext Ctx;
+  std::vector<const llvm::Value *> Allocas;
+  std::vector<const llvm::Value *> Loads;
+  auto M = makeSyntheticModule(Ctx, 400, Allocas, Loads);
+  ProjectIRDB IRDB({M.get()}, IRDBOptions::NONE);
+  LLVMPointsToSet Sequential(IRDB, false);
+  // the points-to sets are computed lazily while the threads query them
+  LLVMPointsToSet Shared(IRDB);
+  ASSERT_TRUE(Shared.isThreadSafe());
+  constexpr unsigned NumThreads = 4;
+  std::vector<std::vector<std::unordered_set<const llvm::Value *>>> Results(
+      NumThreads);
+  std::vector<std::thread> Threads;
+  for (unsigned Thread = 0; Thread < NumThreads; ++Thread) {
+    Threads.emplace_back([&, Thread] {
+      for (const auto *Load : Loads) {
+        Results[Thread].push_back(*Shared.getPointsToSet(Load));
+        Shared.alias(Load, Allocas[Thread % Allocas.size()]);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  for (const auto &ThreadResults : Results) {
+    ASSERT_EQ(ThreadResults.size(), Loads.size());
+    for (size_t Idx = 0; Idx < Loads.size(); ++Idx) {
+      EXPECT_EQ(ThreadResults[Idx], *Sequential.getPointsToSet(Loads[Idx]));
+    }
+  }
+}
+
+// Queries the alias analysis for all pairs of pointers of F, as the points-to
+// sets were computed before the queries were restricted to the pairs that
+// may alias, and returns the number of queries.
+static size_t queryAllPairs(ProjectIRDB &IRDB, llvm::Function &F) {
+  LLVMBasedPointsToAnalysis PTA(IRDB);
+  auto &AA = *PTA.getAAResults(&F);
+  const auto &DL = F.getParent()->getDataLayout();
+  llvm::SetVector<const llvm::Value *> Pointers;
+  for (const auto &I : llvm::instructions(F)) {
+    if (I.getType()->isPointerTy()) {
+      Pointers.insert(&I);
+    }
+    for (const auto &Op : I.operands()) {
+      if (isInterestingPointer(Op)) {
+        Pointers.insert(Op);
+      }
+    }
+  }
+  std::vector<uint64_t> Sizes;
+  for (const auto *Pointer : Pointers) {
+    llvm::Type *ElTy =
+        llvm::cast<llvm::PointerType>(Pointer->getType())->getElementType();
+    Sizes.push_back(ElTy->isSized() ? DL.getTypeStoreSize(ElTy)
+                                    : llvm::MemoryLocation::UnknownSize);
+  }
+  size_t NumQueries = 0;
+  for (size_t I1 = 0; I1 < Pointers.size(); ++I1) {
+    for (size_t I2 = 0; I2 < I1; ++I2) {
+      AA.alias(Pointers[I1], Sizes[I1], Pointers[I2], Sizes[I2]);
+      ++NumQueries;
+    }
+  }
+  return NumQueries;
+}
+
+// measures the construction of the points-to sets of large functions and
+// compares it to querying all pairs of pointers, run with
+// --gtest_also_run_disabled_tests
+TEST(LLVMPointsToSet, DISABLED_SyntheticFunctionBenchmark) {
+  auto Measure = [](auto Fn) {
+    auto Start = std::chrono::steady_clock::now();
+    Fn();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - Start)
+        .count();
+  };
+  for (size_t NumPointers : {1000, 5000, 10000, 20000, 50000}) {
+    llvm::LLVMContext Ctx;
+    std::vector<const llvm::Value *> Allocas;
+    std::vector<const llvm::Value *> Loads;
+    auto M = makeSyntheticModule(Ctx, NumPointers, Allocas, Loads);
+    ProjectIRDB IRDB({M.get()}, IRDBOptions::NONE);
+    std::unique_ptr<LLVMPointsToSet> PTS;
+    auto Ms = Measure(
+        [&] { PTS = std::make_unique<LLVMPointsToSet>(IRDB, false); });
+    size_t NumQueries = 0;
+    auto AllPairsMs = Measure(
+        [&] { NumQueries = queryAllPairs(IRDB, *M->getFunction("main")); });
+    std::cout << NumPointers << " pointers: " << Ms << " ms, all "
+              << NumQueries << " pairs: " << AllPairsMs << " ms\n";
+    EXPECT_FALSE(PTS->empty());
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/PhasarLLVM/Pointer/PointsToCache.h"
+#include "phasar/Utils/Logger.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class PointsToCacheTest : public ::testing::Test {
+protected:
+  const std::string CacheFile =
+      (boost::filesystem::temp_directory_path() /
+       boost::filesystem::unique_path("phasar-%%%%-%%%%.pts"))
+          .string();
+
+  void SetUp() override { boost::log::core::get()->set_logging_enabled(false); }
+
+  void TearDown() override { boost::filesystem::remove(CacheFile); }
+
+  static std::vector<const llvm::Value *> getPointers(ProjectIRDB &IRDB) {
+    std::vector<const llvm::Value *> Pointers;
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &BB : *F) {
+        for (const auto &I : BB) {
+          if (isInterestingPointer(&I)) {
+            Pointers.push_back(&I);
+          }
+        }
+      }
+    }
+    return Pointers;
+  }
+}; // Test Fixture
+
+TEST_F(PointsToCacheTest, RoundTrip) {
+  std::vector<PointsToCache::FunctionResult> Results = {
+      {42, 3, {{0, 1}, {1, 2}}}, {7, 2, {}}, {42, 3, {{0, 2}}}};
+  ASSERT_TRUE(PointsToCache::write(CacheFile, 1, Results));
+  auto Cache = PointsToCache::open(CacheFile);
+  ASSERT_TRUE(Cache);
+  EXPECT_EQ(Cache->getConfigHash(), 1U);
+  // the second result of the same function is dropped
+  EXPECT_EQ(Cache->size(), 2U);
+  auto Pairs = Cache->lookup(42, 3);
+  ASSERT_TRUE(Pairs);
+  ASSERT_EQ(Pairs->size(), 2U);
+  EXPECT_EQ((*Pairs)[1].First, 1U);
+  EXPECT_EQ((*Pairs)[1].Second, 2U);
+  auto Empty = Cache->lookup(7, 2);
+  ASSERT_TRUE(Empty);
+  EXPECT_TRUE(Empty->empty());
+  EXPECT_FALSE(Cache->lookup(42, 4));
+  EXPECT_FALSE(Cache->lookup(13, 3));
+}
+
+TEST_F(PointsToCacheTest, RejectInvalidFiles) {
+  EXPECT_FALSE(PointsToCache::open(CacheFile));
+  {
+    std::ofstream OFS(CacheFile);
+    OFS << "not a points-to cache";
+  }
+  EXPECT_FALSE(PointsToCache::open(CacheFile));
+  // pointer indices beyond the number of pointers
+  ASSERT_TRUE(PointsToCache::write(CacheFile, 1, {{42, 2, {{0, 2}}}}));
+  EXPECT_FALSE(PointsToCache::open(CacheFile));
+}
+
+TEST_F(PointsToCacheTest, StableFunctionHashes) {
+  ProjectIRDB IRDB1(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  ProjectIRDB IRDB2(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  auto *Main1 = IRDB1.getFunctionDefinition("main");
+  auto *Main2 = const_cast<llvm::Function *>(
+      IRDB2.getFunctionDefinition("main"));
+  ASSERT_TRUE(Main1 && Main2);
+  auto MainHash = FunctionIRHasher().getHash(*Main1);
+  EXPECT_EQ(FunctionIRHasher().getHash(*Main2), MainHash);
+  // names of local values are not part of the hash
+  Main2->getEntryBlock().front().setName("renamed");
+  EXPECT_EQ(FunctionIRHasher().getHash(*Main2), MainHash);
+  // a change of the callee changes the hash of the caller
+  auto *Callee = const_cast<llvm::Function *>(
+      IRDB2.getFunctionDefinition("_Z10setIntegerPi"));
+  ASSERT_TRUE(Callee);
+  new llvm::AllocaInst(llvm::Type::getInt32Ty(Callee->getContext()), 0, "",
+                       &Callee->getEntryBlock().front());
+  EXPECT_NE(FunctionIRHasher().getHash(*Main2), MainHash);
+  // the hashes do not depend on the order in which they are queried
+  const auto *Callee1 = IRDB1.getFunctionDefinition("_Z10setIntegerPi");
+  ASSERT_TRUE(Callee1);
+  auto CalleeHash = FunctionIRHasher().getHash(*Callee1);
+  FunctionIRHasher Hasher;
+  EXPECT_EQ(Hasher.getHash(*Callee1), CalleeHash);
+  EXPECT_EQ(Hasher.getHash(*Main1), MainHash);
+  EXPECT_NE(CalleeHash, MainHash);
+}
+
+TEST_F(PointsToCacheTest, SamePointsToSets) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  LLVMPointsToSet Uncached(IRDB, false);
+  // the first points-to set writes the cache, the second one reads it
+  {
+    LLVMPointsToSet Writer(IRDB, false, PointerAnalysisType::CFLAnders, 1,
+                           CacheFile);
+    EXPECT_EQ(Writer.getNumCacheHits(), 0U);
+  }
+  auto Cache = PointsToCache::open(CacheFile);
+  ASSERT_TRUE(Cache);
+  // main and setInteger
+  EXPECT_EQ(Cache->size(), 2U);
+  LLVMPointsToSet Cached(IRDB, false, PointerAnalysisType::CFLAnders, 1,
+                         CacheFile);
+  EXPECT_EQ(Cached.getNumCacheHits(), 2U);
+  for (const auto *Pointer : getPointers(IRDB)) {
+    EXPECT_EQ(*Uncached.getPointsToSet(Pointer),
+              *Cached.getPointsToSet(Pointer));
+  }
+}
+
+TEST_F(PointsToCacheTest, UnqueriedFunctionsAreKept) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  auto *Main = const_cast<llvm::Function *>(IRDB.getFunctionDefinition("main"));
+  const auto *Callee = IRDB.getFunctionDefinition("_Z10setIntegerPi");
+  ASSERT_TRUE(Main && Callee);
+  {
+    LLVMPointsToSet Writer(IRDB, false, PointerAnalysisType::CFLAnders, 1,
+                           CacheFile);
+  }
+  auto CalleeHash = FunctionIRHasher().getHash(*Callee);
+  // change main and only query it lazily, setInteger is never analyzed
+  new llvm::AllocaInst(llvm::Type::getInt32Ty(Main->getContext()), 0, "",
+                       &Main->getEntryBlock().front());
+  {
+    LLVMPointsToSet Lazy(IRDB, true, PointerAnalysisType::CFLAnders, 1,
+                         CacheFile);
+    Lazy.getPointsToSet(&Main->getEntryBlock().front());
+    EXPECT_EQ(Lazy.getNumCacheHits(), 0U);
+  }
+  auto Cache = PointsToCache::open(CacheFile);
+  ASSERT_TRUE(Cache);
+  // both versions of main and setInteger
+  EXPECT_EQ(Cache->size(), 3U);
+  auto Results = Cache->getResults();
+  EXPECT_TRUE(std::any_of(Results.begin(), Results.end(),
+                          [CalleeHash](const auto &Result) {
+                            return Result.FunctionHash == CalleeHash;
+                          }));
+}
+
+TEST_F(PointsToCacheTest, CacheOfOtherAnalysisIsIgnored) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  ASSERT_TRUE(PointsToCache::write(
+      CacheFile,
+      PointsToCache::computeConfigHash(PointerAnalysisType::CFLSteens), {}));
+  {
+    LLVMPointsToSet PTS(IRDB, false, PointerAnalysisType::CFLAnders, 1,
+                        CacheFile);
+  }
+  auto Cache = PointsToCache::open(CacheFile);
+  ASSERT_TRUE(Cache);
+  EXPECT_EQ(Cache->getConfigHash(),
+            PointsToCache::computeConfigHash(PointerAnalysisType::CFLAnders));
+  EXPECT_GT(Cache->size(), 0U);
+}
+
+TEST_F(PointsToCacheTest, FlushReportsWriteFailures) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/call_01_cpp_dbg.ll"});
+  LLVMPointsToSet PTS(IRDB, false, PointerAnalysisType::CFLAnders, 1,
+                      CacheFile);
+  EXPECT_TRUE(PTS.flushCache());
+  auto Cache = PointsToCache::open(CacheFile);
+  ASSERT_TRUE(Cache);
+  EXPECT_EQ(Cache->size(), 2U);
+  // the directory of the cache does not exist
+  LLVMPointsToSet Unwritable(IRDB, false, PointerAnalysisType::CFLAnders, 1,
+                             CacheFile + ".missing/cache.pts");
+  EXPECT_FALSE(Unwritable.flushCache());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+#ifndef UNITTEST_TESTUTILS_LCASOLVERCONFIGTEST_H_
+#define UNITTEST_TESTUTILS_LCASOLVERCONFIGTEST_H_
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+namespace psr::unittest {
+
+/// Fixture for tests that check that a solver option does not change the
+/// results of the IDELinearConstantAnalysis on the linear_constant test files.
+class LCASolverConfigTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  using RawResults_t =
+      std::map<const llvm::Instruction *,
+               std::unordered_map<const llvm::Value *, int64_t>>;
+  using LCASolver_t = IDESolver_P<IDELinearConstantAnalysis>;
+  using ConfigureFn = std::function<void(IFDSIDESolverConfig &)>;
+  using InspectFn = std::function<void(LCASolver_t &)>;
+
+  void SetUp() override { boost::log::core::get()->set_logging_enabled(false); }
+
+  /// Solves the analysis on IRDB with the solver configuration adjusted by
+  /// Configure and returns the values at all instructions. Inspect, if given,
+  /// is called with the solver once it has finished.
+  RawResults_t doAnalysis(ProjectIRDB &IRDB, const ConfigureFn &Configure,
+                          const InspectFn &Inspect = nullptr) {
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    IDELinearConstantAnalysis LCAProblem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+    Configure(LCAProblem.getIFDSIDESolverConfig());
+    LCASolver_t LCASolver(LCAProblem);
+    LCASolver.solve();
+    if (Inspect) {
+      Inspect(LCASolver);
+    }
+    RawResults_t Results;
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        Results[&I] = LCASolver.resultsAt(&I, true);
+      }
+    }
+    return Results;
+  }
+
+  /// Expects that every configuration computes the same, non-empty results as
+  /// the first one on the given file.
+  void compareConfigs(const std::string &LlvmFilePath,
+                      const std::vector<ConfigureFn> &Configs) {
+    ASSERT_FALSE(Configs.empty());
+    ProjectIRDB IRDB({PathToLlFiles + LlvmFilePath}, IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    auto Results = doAnalysis(IRDB, Configs.front());
+    EXPECT_FALSE(Results.empty());
+    for (size_t Idx = 1; Idx < Configs.size(); ++Idx) {
+      EXPECT_EQ(Results, doAnalysis(IRDB, Configs[Idx])) << "config " << Idx;
+    }
+  }
+};
+
+} // namespace psr::unittest
+
+#endif // UNITTEST_TESTUTILS_LCASOLVERCONFIGTEST_H_
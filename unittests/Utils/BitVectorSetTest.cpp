@@ -256,6 +256,38 @@ TEST(BitVectorSet, setIntersect) {
   EXPECT_TRUE(A4.empty());
 }
 
+TEST(BitVectorSet, setDifference) {
+  BitVectorSet<int> A({1, 2, 3, 4, 5, 6});
+  BitVectorSet<int> B({5, 6, 42});
+
+  BitVectorSet<int> A2 = A.setDifference(B);
+  EXPECT_EQ(A2.size(), 4U);
+  EXPECT_EQ(A2.count(4), 1U);
+  EXPECT_EQ(A2.count(5), 0U);
+  EXPECT_EQ(A2.count(42), 0U);
+  BitVectorSet<int> B2 = B.setDifference(A);
+  EXPECT_EQ(B2.size(), 1U);
+  EXPECT_EQ(B2.count(42), 1U);
+  EXPECT_TRUE(A.setDifference(A).empty());
+  EXPECT_TRUE(BitVectorSet<int>().setDifference(A).empty());
+}
+
+TEST(BitVectorSet, eraseBitVectorSet) {
+  BitVectorSet<int> A({1, 2, 3, 4, 5, 6});
+  A.erase(BitVectorSet<int>({2, 4, 42}));
+  EXPECT_EQ(A.size(), 4U);
+  EXPECT_EQ(A.count(2), 0U);
+  EXPECT_EQ(A.count(4), 0U);
+  EXPECT_EQ(A.count(6), 1U);
+  A.erase(BitVectorSet<int>());
+  EXPECT_EQ(A.size(), 4U);
+
+  BitVectorSet<int> B;
+  B.erase(A);
+  B.erase(1);
+  EXPECT_TRUE(B.empty());
+}
+
 namespace std {
 
 template <> struct hash<pair<int, int>> {
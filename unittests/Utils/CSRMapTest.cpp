@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/CSRMap.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+
+using MapTy = CSRMap<int, std::string>;
+
+TEST(CSRMap, lookup) {
+  MapTy Map({{2, "b"}, {1, "x"}, {2, "a"}, {1, "x"}, {3, "c"}});
+  EXPECT_EQ(Map.size(), 3U);
+  EXPECT_EQ(Map.getNumValues(), 4U);
+  EXPECT_EQ(Map.lookup(1).vec(), std::vector<std::string>({"x"}));
+  EXPECT_EQ(Map.lookup(2).vec(), std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(Map.lookup(3).vec(), std::vector<std::string>({"c"}));
+  EXPECT_TRUE(Map.lookup(4).empty());
+  EXPECT_TRUE(Map.contains(3));
+  EXPECT_FALSE(Map.contains(4));
+}
+
+TEST(CSRMap, rebuild) {
+  MapTy Map;
+  EXPECT_TRUE(Map.empty());
+  EXPECT_TRUE(Map.lookup(1).empty());
+  Map.build({{1, "a"}, {2, "b"}});
+  Map.build({{2, "c"}});
+  EXPECT_EQ(Map.size(), 1U);
+  EXPECT_FALSE(Map.contains(1));
+  EXPECT_EQ(Map.lookup(2).vec(), std::vector<std::string>({"c"}));
+  Map.clear();
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(Map.getNumValues(), 0U);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/GraphExtensions.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+using namespace psr;
+
+struct Vertex {
+  std::string Name;
+};
+
+using GraphTy = boost::adjacency_list<boost::vecS, boost::vecS,
+                                      boost::bidirectionalS, Vertex>;
+using vertex_t = boost::graph_traits<GraphTy>::vertex_descriptor;
+
+// builds the JSON the way LLVMBasedICFG::getAsJson() and
+// LLVMTypeHierarchy::getAsJson() do
+static std::string getAsJsonTree(const GraphTy &G) {
+  nlohmann::json J;
+  for (auto V : boost::make_iterator_range(boost::vertices(G))) {
+    J["Graph"][G[V].Name];
+    for (auto E : boost::make_iterator_range(boost::out_edges(V, G))) {
+      J["Graph"][G[V].Name] += G[boost::target(E, G)].Name;
+    }
+  }
+  std::stringstream OS;
+  OS << J;
+  return OS.str();
+}
+
+static std::string getAsJsonStream(const GraphTy &G) {
+  std::stringstream OS;
+  writeAdjacencyListsAsJson(OS, "Graph", G,
+                            [&G](vertex_t V) { return G[V].Name; });
+  return OS.str();
+}
+
+TEST(GraphExtensions, writeAdjacencyListsAsJson) {
+  GraphTy G;
+  EXPECT_EQ(getAsJsonStream(G), getAsJsonTree(G));
+  auto Main = boost::add_vertex({"main"}, G);
+  auto Foo = boost::add_vertex({"foo"}, G);
+  auto Quoted = boost::add_vertex({"\"quoted\"\\n\t"}, G);
+  auto Isolated = boost::add_vertex({"isolated"}, G);
+  auto Decl = boost::add_vertex({"decl"}, G);
+  // vertices of the same name are merged
+  auto OtherFoo = boost::add_vertex({"foo"}, G);
+  boost::add_edge(Main, Foo, G);
+  boost::add_edge(Main, Quoted, G);
+  boost::add_edge(Main, Foo, G);
+  boost::add_edge(Quoted, Main, G);
+  boost::add_edge(OtherFoo, Decl, G);
+  boost::add_edge(Foo, Isolated, G);
+  EXPECT_EQ(getAsJsonStream(G), getAsJsonTree(G));
+  auto J = nlohmann::json::parse(getAsJsonStream(G));
+  EXPECT_TRUE(J["Graph"]["decl"].is_null());
+  EXPECT_EQ(J["Graph"]["foo"], nlohmann::json({"isolated", "decl"}));
+}
+
+// compares the memory-resident and the streaming JSON export on a large
+// graph, run with --gtest_also_run_disabled_tests
+TEST(GraphExtensions, DISABLED_writeAdjacencyListsAsJsonBenchmark) {
+  constexpr size_t NumVertices = 200000;
+  constexpr size_t NumEdgesPerVertex = 10;
+  GraphTy G;
+  for (size_t Idx = 0; Idx < NumVertices; ++Idx) {
+    boost::add_vertex({"_ZN9namespace8function" + std::to_string(Idx) + "Ev"},
+                      G);
+  }
+  for (size_t Idx = 0; Idx < NumVertices; ++Idx) {
+    for (size_t E = 1; E <= NumEdgesPerVertex; ++E) {
+      boost::add_edge(Idx, (Idx * 31 + E * 7919) % NumVertices, G);
+    }
+  }
+  auto Measure = [](auto Fn) {
+    auto Start = std::chrono::steady_clock::now();
+    auto Result = Fn();
+    auto Duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - Start);
+    return std::make_pair(Result, Duration.count());
+  };
+  auto [Tree, TreeMs] = Measure([&G] { return getAsJsonTree(G); });
+  auto [Stream, StreamMs] = Measure([&G] { return getAsJsonStream(G); });
+  std::cout << "nlohmann::json tree: " << TreeMs << " ms\n"
+            << "streaming writer:    " << StreamMs << " ms\n";
+  EXPECT_EQ(Tree, Stream);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/ShardedCache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace psr;
+
+using KeyTy = HashedKey<int, std::string>;
+using CacheTy = ShardedCache<KeyTy, int, KeyTy::Hasher>;
+
+TEST(HashedKey, equality) {
+  KeyTy A(1, "foo");
+  KeyTy B(1, "foo");
+  KeyTy C(2, "foo");
+  EXPECT_EQ(A, B);
+  EXPECT_EQ(A.hash(), B.hash());
+  EXPECT_NE(A, C);
+}
+
+TEST(ShardedCache, lookupAndInsert) {
+  CacheTy Cache;
+  size_t NumEvicted = 42;
+  EXPECT_FALSE(Cache.lookup(KeyTy(1, "foo")).has_value());
+  EXPECT_EQ(Cache.insert(KeyTy(1, "foo"), 10, NumEvicted), 10);
+  EXPECT_EQ(NumEvicted, 0U);
+  ASSERT_TRUE(Cache.lookup(KeyTy(1, "foo")).has_value());
+  EXPECT_EQ(*Cache.lookup(KeyTy(1, "foo")), 10);
+  // an existing value is never overwritten
+  EXPECT_EQ(Cache.insert(KeyTy(1, "foo"), 20, NumEvicted), 10);
+  EXPECT_EQ(Cache.size(), 1U);
+}
+
+TEST(ShardedCache, evictsAtCapacity) {
+  CacheTy Cache(1, 2);
+  size_t NumEvicted;
+  Cache.insert(KeyTy(1, "foo"), 1, NumEvicted);
+  Cache.insert(KeyTy(2, "foo"), 2, NumEvicted);
+  EXPECT_EQ(NumEvicted, 0U);
+  Cache.insert(KeyTy(3, "foo"), 3, NumEvicted);
+  EXPECT_EQ(NumEvicted, 2U);
+  EXPECT_EQ(Cache.size(), 1U);
+  EXPECT_FALSE(Cache.lookup(KeyTy(1, "foo")).has_value());
+  EXPECT_TRUE(Cache.lookup(KeyTy(3, "foo")).has_value());
+}
+
+TEST(ShardedCache, concurrentInsert) {
+  CacheTy Cache(8);
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < 4; ++T) {
+    Threads.emplace_back([&Cache, T] {
+      size_t NumEvicted;
+      for (int I = 0; I < 1000; ++I) {
+        // all threads compete for the same keys, the first one wins
+        int Value = Cache.insert(KeyTy(I, "bar"), I * 10 + T, NumEvicted);
+        EXPECT_EQ(Value / 10, I);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  EXPECT_EQ(Cache.size(), 1000U);
+  for (int I = 0; I < 1000; ++I) {
+    auto Value = Cache.lookup(KeyTy(I, "bar"));
+    ASSERT_TRUE(Value.has_value());
+    EXPECT_EQ(*Value / 10, I);
+  }
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/SmallFactSet.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+
+using namespace psr;
+
+using SetTy = SmallFactSet<int, 2, 4>;
+
+TEST(SmallFactSet, insertAndFind) {
+  SetTy S;
+  EXPECT_TRUE(S.empty());
+  EXPECT_TRUE(S.insert(3).second);
+  EXPECT_TRUE(S.insert(1).second);
+  EXPECT_FALSE(S.insert(3).second);
+  EXPECT_EQ(S.size(), 2U);
+  EXPECT_EQ(S.count(1), 1U);
+  EXPECT_EQ(S.count(2), 0U);
+  EXPECT_EQ(*S.find(3), 3);
+  EXPECT_EQ(S.find(2), S.end());
+}
+
+TEST(SmallFactSet, iteratesSortedWhenSmall) {
+  SetTy S = {4, 2, 3, 2};
+  EXPECT_EQ(std::vector<int>(S.begin(), S.end()),
+            std::vector<int>({2, 3, 4}));
+}
+
+TEST(SmallFactSet, switchesToHashSet) {
+  SetTy S;
+  for (int I = 0; I < 100; ++I) {
+    S.insert(I);
+    S.insert(I);
+  }
+  EXPECT_EQ(S.size(), 100U);
+  std::set<int> Facts(S.begin(), S.end());
+  EXPECT_EQ(Facts.size(), 100U);
+  EXPECT_EQ(*Facts.begin(), 0);
+  EXPECT_EQ(*Facts.rbegin(), 99);
+  EXPECT_EQ(S.count(42), 1U);
+  EXPECT_EQ(S.erase(42), 1U);
+  EXPECT_EQ(S.erase(42), 0U);
+  EXPECT_EQ(S.count(42), 0U);
+  EXPECT_EQ(S.size(), 99U);
+}
+
+TEST(SmallFactSet, eraseAndClear) {
+  SetTy S = {1, 2, 3};
+  EXPECT_EQ(S.erase(2), 1U);
+  EXPECT_EQ(S.erase(5), 0U);
+  EXPECT_EQ(S, SetTy({1, 3}));
+  S = SetTy({1, 2, 3, 4, 5, 6});
+  S.clear();
+  EXPECT_TRUE(S.empty());
+  // a cleared set can be reused and starts out small again
+  std::vector<int> Facts = {0, -1, 0};
+  std::copy(Facts.begin(), Facts.end(), std::inserter(S, S.end()));
+  EXPECT_EQ(std::vector<int>(S.begin(), S.end()), std::vector<int>({-1, 0}));
+}
+
+TEST(SmallFactSet, comparison) {
+  SetTy Small = {1, 2, 3};
+  SetTy Large = {9, 8, 7, 6, 5, 4, 3, 2, 1};
+  SetTy LargeReversed;
+  for (int I = 1; I <= 9; ++I) {
+    LargeReversed.insert(I);
+  }
+  EXPECT_EQ(Large, LargeReversed);
+  EXPECT_NE(Small, Large);
+  EXPECT_FALSE(Large < LargeReversed);
+  EXPECT_FALSE(LargeReversed < Large);
+  // the same order as for std::set
+  EXPECT_EQ(Small < Large, std::set<int>({1, 2, 3}) <
+                               std::set<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_TRUE(SetTy({1, 2}) < SetTy({1, 3}));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
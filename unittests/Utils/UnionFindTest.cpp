@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "phasar/Utils/UnionFind.h"
+
+using namespace psr;
+
+static std::vector<UnionFind::IdTy> getSortedMembers(const UnionFind &UF,
+                                                     UnionFind::IdTy Id) {
+  auto Members = UF.getMembers(Id);
+  std::sort(Members.begin(), Members.end());
+  return Members;
+}
+
+TEST(UnionFind, Singletons) {
+  UnionFind UF(3);
+  ASSERT_EQ(UF.size(), 3U);
+  for (UnionFind::IdTy Id = 0; Id < 3; ++Id) {
+    EXPECT_EQ(UF.find(Id), Id);
+    EXPECT_EQ(UF.getSetSize(Id), 1U);
+    EXPECT_EQ(UF.getMembers(Id), std::vector<UnionFind::IdTy>{Id});
+  }
+  EXPECT_FALSE(UF.connected(0, 1));
+  EXPECT_EQ(UF.makeSet(), 3U);
+}
+
+TEST(UnionFind, Merge) {
+  UnionFind UF(6);
+  UF.merge(0, 1);
+  UF.merge(2, 3);
+  EXPECT_TRUE(UF.connected(0, 1));
+  EXPECT_FALSE(UF.connected(1, 2));
+  auto Root = UF.merge(1, 3);
+  EXPECT_EQ(UF.find(0), Root);
+  EXPECT_EQ(UF.find(2), Root);
+  EXPECT_EQ(UF.findRoot(3), Root);
+  EXPECT_EQ(UF.getSetSize(2), 4U);
+  std::vector<UnionFind::IdTy> Expected = {0, 1, 2, 3};
+  for (UnionFind::IdTy Id = 0; Id < 4; ++Id) {
+    EXPECT_EQ(getSortedMembers(UF, Id), Expected);
+  }
+  // merging within the same set changes nothing
+  EXPECT_EQ(UF.merge(0, 3), Root);
+  EXPECT_EQ(UF.getSetSize(0), 4U);
+  EXPECT_EQ(getSortedMembers(UF, 4), std::vector<UnionFind::IdTy>{4});
+  EXPECT_EQ(getSortedMembers(UF, 5), std::vector<UnionFind::IdTy>{5});
+}
+
+TEST(UnionFind, Chain) {
+  constexpr UnionFind::IdTy NumElements = 1000;
+  UnionFind UF(NumElements);
+  for (UnionFind::IdTy Id = 1; Id < NumElements; ++Id) {
+    UF.merge(Id - 1, Id);
+  }
+  auto Root = UF.find(0);
+  for (UnionFind::IdTy Id = 0; Id < NumElements; ++Id) {
+    EXPECT_EQ(UF.find(Id), Root);
+  }
+  EXPECT_EQ(UF.getSetSize(NumElements - 1), NumElements);
+  EXPECT_EQ(getSortedMembers(UF, 42).size(), NumElements);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}